@@ -46,6 +46,7 @@
 #include <unistd.h>
 #include <pthread.h>
 #include <sched.h>
+#include <time.h>
 #endif
 
 #include <intel-ipsec-mb.h>
@@ -89,6 +90,24 @@
 
 #define MAX_NUM_THREADS 16 /* Maximum number of threads that can be created */
 
+/* maximum number of job sizes in IMIX distribution */
+#define IMIX_MAX_SIZES 16
+/* length of job size sequence generated from IMIX distribution */
+#define IMIX_SEQ_LEN 1024
+
+/* duration of a single core count step of the scaling test */
+#define SCALING_TIME_NS_SMOKE 10000000ULL   /* 10 ms */
+#define SCALING_TIME_NS_SHORT 200000000ULL  /* 200 ms */
+#define SCALING_TIME_NS_LONG  2000000000ULL /* 2 s */
+
+#ifdef _WIN32
+#define ATOMIC_INC(ptr) InterlockedIncrement((volatile LONG *)(ptr))
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define ATOMIC_INC(ptr) __sync_fetch_and_add((ptr), 1)
+#define THREAD_LOCAL __thread
+#endif
+
 #define CIPHER_MODES_AES 7	/* CBC, CNTR, CNTR+8, CNTR_BITLEN,
                                    CNTR_BITLEN-4, ECB, NULL_CIPHER */
 #define CIPHER_MODES_DOCSIS_AES 2 /* AES DOCSIS, AES DOCSIS+8 */
@@ -638,6 +657,21 @@ struct thread_info {
         IMB_MGR *p_mgr;
 } t_info[MAX_NUM_THREADS];
 
+/* Struct storing information of a scaling test thread */
+struct scaling_info {
+        int core;
+        uint32_t arch;
+        struct params_s params;
+        uint64_t bytes;    /* processed in the measured period */
+        uint64_t start_ns;
+        uint64_t end_ns;
+} s_info[MAX_NUM_THREADS + 1];
+
+/* scaling test threads synchronization */
+static volatile long scaling_ready = 0;
+static volatile long scaling_done = 0;
+static volatile int scaling_start = 0;
+
 enum cache_type_e {
         WARM = 0,
         COLD = 1
@@ -704,11 +738,21 @@ int use_gcm_job_api = 0;
 int use_unhalted_cycles = 0; /* read unhalted cycles instead of tsc */
 uint64_t rd_cycles_cost = 0; /* cost of reading unhalted cycles */
 uint64_t core_mask = 0; /* bitmap of selected cores */
+int scaling_test = 0; /* run selected algorithm on 1..N cores at once */
 
 uint64_t flags = 0; /* flags passed to alloc_mb_mgr() */
 
 uint32_t iter_scale = ITER_SCALE_LONG;
 
+/* IMIX job size distribution, imix_num_sizes = 0 - fixed job sizes */
+uint32_t imix_num_sizes = 0;
+uint32_t imix_sizes[IMIX_MAX_SIZES];
+uint32_t imix_weights[IMIX_MAX_SIZES];
+uint32_t imix_seq[IMIX_SEQ_LEN]; /* shuffled job sizes */
+uint32_t imix_mean_size = 0;
+uint64_t imix_seq_bytes = 0; /* sum of job sizes in imix_seq */
+static THREAD_LOCAL uint32_t imix_idx = 0;
+
 #define PB_INIT_SIZE 50
 #define PB_INIT_IDX  2 /* after \r and [ */
 static uint32_t PB_SIZE = PB_INIT_SIZE;
@@ -1006,6 +1050,73 @@ static uint32_t get_next_index(uint32_t index)
         return index;
 }
 
+/* Get size of the next job from IMIX sequence */
+static uint32_t get_imix_size(void)
+{
+        return imix_seq[imix_idx++ & (IMIX_SEQ_LEN - 1)];
+}
+
+/*
+ * Adjusts cipher and hash lengths of a job prepared for IMIX mean size
+ * to the size of the next job in IMIX sequence.
+ * Block cipher lengths get rounded down to the block size.
+ */
+static void set_imix_lengths(IMB_JOB *job, const uint32_t mean_size)
+{
+        const int64_t delta = (int64_t) get_imix_size() - mean_size;
+
+        switch (job->cipher_mode) {
+        case IMB_CIPHER_CNTR_BITLEN:
+        case IMB_CIPHER_SNOW3G_UEA2_BITLEN:
+        case IMB_CIPHER_KASUMI_UEA1_BITLEN:
+                job->msg_len_to_cipher_in_bits += delta * 8;
+                break;
+        case IMB_CIPHER_CBC:
+        case IMB_CIPHER_ECB:
+                job->msg_len_to_cipher_in_bytes =
+                        (job->msg_len_to_cipher_in_bytes + delta) & (~15ULL);
+                break;
+        case IMB_CIPHER_DES:
+        case IMB_CIPHER_DES3:
+                job->msg_len_to_cipher_in_bytes =
+                        (job->msg_len_to_cipher_in_bytes + delta) & (~7ULL);
+                break;
+        default:
+                /* keep zero length (e.g. PON without counter) */
+                if (job->msg_len_to_cipher_in_bytes != 0)
+                        job->msg_len_to_cipher_in_bytes += delta;
+                break;
+        }
+
+        switch (job->hash_alg) {
+        case IMB_AUTH_AES_CMAC_BITLEN:
+        case IMB_AUTH_ZUC_EIA3_BITLEN:
+        case IMB_AUTH_SNOW3G_UIA2_BITLEN:
+                job->msg_len_to_hash_in_bits += delta * 8;
+                break;
+        default:
+                job->msg_len_to_hash_in_bytes += delta;
+                break;
+        }
+}
+
+/* Creates XGEM header with PLI set to the payload length */
+static uint64_t get_xgem_hdr(const uint64_t payload_len)
+{
+        const uint64_t pli = (payload_len << 2) & 0xffff;
+
+        return ((pli >> 8) & 0xff) | ((pli & 0xff) << 8);
+}
+
+/* Get message size for the raw GCM API */
+static uint64_t get_gcm_size(const uint32_t size)
+{
+        if (imix_num_sizes == 0)
+                return size;
+
+        return get_imix_size();
+}
+
 static void init_buf(void *pb, const size_t length)
 {
         const size_t n = length / sizeof(uint64_t);
@@ -1188,14 +1299,14 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
         IMB_JOB *job;
         IMB_JOB job_template;
         uint32_t i;
-        static uint32_t index = 0;
-        static DECLARE_ALIGNED(imb_uint128_t iv, 16);
-        static DECLARE_ALIGNED(imb_uint128_t auth_iv, 16);
-        static uint32_t ipad[5], opad[5], digest[3];
-        static DECLARE_ALIGNED(uint32_t k1_expanded[11 * 4], 16);
-        static DECLARE_ALIGNED(uint8_t	k2[16], 16);
-        static DECLARE_ALIGNED(uint8_t	k3[16], 16);
-        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
+        static THREAD_LOCAL uint32_t index = 0;
+        static THREAD_LOCAL DECLARE_ALIGNED(imb_uint128_t iv, 16);
+        static THREAD_LOCAL DECLARE_ALIGNED(imb_uint128_t auth_iv, 16);
+        static THREAD_LOCAL uint32_t ipad[5], opad[5], digest[3];
+        static THREAD_LOCAL DECLARE_ALIGNED(uint32_t k1_expanded[11 * 4], 16);
+        static THREAD_LOCAL DECLARE_ALIGNED(uint8_t	k2[16], 16);
+        static THREAD_LOCAL DECLARE_ALIGNED(uint8_t	k3[16], 16);
+        static THREAD_LOCAL DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
         uint64_t xgem_hdr = 0;
         uint32_t size_aes;
         uint64_t time = 0;
@@ -1385,13 +1496,10 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
         } else if (job_template.cipher_mode == IMB_CIPHER_ECB)
                 job_template.iv_len_in_bytes = 0;
 
-        if (job_template.hash_alg == IMB_AUTH_PON_CRC_BIP) {
+        if (job_template.hash_alg == IMB_AUTH_PON_CRC_BIP)
                 /* create XGEM header template */
-                const uint64_t pli =
-                        (job_template.msg_len_to_cipher_in_bytes << 2) & 0xffff;
-
-                xgem_hdr = ((pli >> 8) & 0xff) | ((pli & 0xff) << 8);
-        }
+                xgem_hdr =
+                        get_xgem_hdr(job_template.msg_len_to_cipher_in_bytes);
 
 #ifndef _WIN32
         if (use_unhalted_cycles)
@@ -1404,12 +1512,20 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
                 job = IMB_GET_NEXT_JOB(mb_mgr);
                 *job = job_template;
 
+                if (imix_num_sizes != 0)
+                        set_imix_lengths(job, params->size_aes);
+
                 if (job->hash_alg == IMB_AUTH_PON_CRC_BIP) {
                         uint64_t *p_src =
                                 (uint64_t *) get_src_buffer(index, p_buffer);
 
                         job->src = (const uint8_t *)p_src;
-                        p_src[0] = xgem_hdr;
+                        /* PON takes CRC and BIP length from PLI */
+                        if (imix_num_sizes != 0)
+                                p_src[0] = get_xgem_hdr
+                                        (job->msg_len_to_cipher_in_bytes);
+                        else
+                                p_src[0] = xgem_hdr;
                 } else {
                         job->src = get_src_buffer(index, p_buffer);
                 }
@@ -1422,7 +1538,7 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
                                 (const uint32_t *) get_key_pointer(index,
                                                                    p_keys);
                 } else if (job->cipher_mode == IMB_CIPHER_DES3) {
-                        static const void *ks_ptr[3];
+                        static THREAD_LOCAL const void *ks_ptr[3];
 
                         ks_ptr[0] = ks_ptr[1] = ks_ptr[2] =
                                 get_key_pointer(index, p_keys);
@@ -1477,10 +1593,11 @@ do_test_gcm(struct params_s *params,
             const uint32_t num_iter, IMB_MGR *mb_mgr,
             uint8_t *p_buffer, imb_uint128_t *p_keys)
 {
-        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
-        static DECLARE_ALIGNED(struct gcm_context_data gdata_ctx, 64);
+        static THREAD_LOCAL DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
+        static THREAD_LOCAL DECLARE_ALIGNED(struct gcm_context_data gdata_ctx,
+                                            64);
         uint8_t *key;
-        static uint32_t index = 0;
+        static THREAD_LOCAL uint32_t index = 0;
         uint32_t size_aes = params->size_aes;
         uint32_t i;
         uint8_t *aad = NULL;
@@ -1533,7 +1650,8 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_gcm_size(size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1546,7 +1664,8 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_gcm_size(size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1559,7 +1678,8 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_gcm_size(size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1588,7 +1708,8 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_gcm_size(size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1601,7 +1722,8 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_gcm_size(size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1614,7 +1736,8 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_gcm_size(size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1983,6 +2106,28 @@ print_times(struct variant_s *variant_list, struct params_s *params,
                 }
                 printf("\n");
         }
+
+        /*
+         * IMIX job sizes vary around the (rounded) mean size,
+         * throughput comes from the bytes of the actual sequence.
+         * It goes to stderr, so that stdout stays parsable
+         * by ipsec_diff_tool.py.
+         */
+        if (imix_num_sizes != 0) {
+                const double job_bytes =
+                        (double) imix_seq_bytes / IMIX_SEQ_LEN;
+
+                fprintf(stderr, "BYTES/CYCLE");
+                for (col = 0; col < total_variants; col++) {
+                        const unsigned long long val =
+                                mean_median(variant_list[col].avg_times,
+                                            NUM_RUNS, p_buffer, p_keys);
+
+                        fprintf(stderr, "\t%.3f", (val != 0) ?
+                                job_bytes / (double) val : 0.0);
+                }
+                fprintf(stderr, "\n");
+        }
 }
 
 /* Prepares data structure for test variants storage, sets test configuration */
@@ -2207,6 +2352,225 @@ exit_failure:
         exit(EXIT_FAILURE);
 }
 
+/* Get monotonic wall clock time in nanoseconds */
+static uint64_t get_time_ns(void)
+{
+#ifdef _WIN32
+        LARGE_INTEGER cnt, freq;
+
+        QueryPerformanceCounter(&cnt);
+        QueryPerformanceFrequency(&freq);
+        return (uint64_t) ((double) cnt.QuadPart * 1e9 /
+                           (double) freq.QuadPart);
+#else
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+#endif
+}
+
+/* Runs the selected algorithm on one core of the scaling test */
+#ifdef _WIN32
+static void
+#else
+static void *
+#endif
+run_scaling_thread(void *arg)
+{
+        struct scaling_info *info = (struct scaling_info *)arg;
+        struct params_s *params = &info->params;
+        const uint64_t run_ns = (iter_scale == ITER_SCALE_SMOKE) ?
+                SCALING_TIME_NS_SMOKE : ((iter_scale == ITER_SCALE_SHORT) ?
+                SCALING_TIME_NS_SHORT : SCALING_TIME_NS_LONG);
+        const uint32_t size = (params->size_aes != 0) ?
+                params->size_aes : (uint32_t) params->aad_size;
+        const uint32_t num_iter = (job_iter != 0) ? job_iter :
+                ((iter_scale >= size) ? (iter_scale / size) : 1);
+        const int use_gcm_api = (params->cipher_mode == TEST_GCM &&
+                                 !use_gcm_job_api);
+        IMB_MGR *p_mgr = NULL;
+        uint8_t *buf = NULL;
+        imb_uint128_t *keys = NULL;
+
+        if (set_affinity(info->core) != 0) {
+                fprintf(stderr, "Failed to set cpu "
+                        "affinity on core %d\n", info->core);
+                exit(EXIT_FAILURE);
+        }
+
+        p_mgr = alloc_mb_mgr(flags);
+        if (p_mgr == NULL) {
+                fprintf(stderr, "Failed to allocate MB_MGR "
+                        "structure on core %d!\n", info->core);
+                exit(EXIT_FAILURE);
+        }
+
+        switch (info->arch) {
+        case ARCH_SSE:
+                init_mb_mgr_sse(p_mgr);
+                break;
+        case ARCH_AVX:
+                init_mb_mgr_avx(p_mgr);
+                break;
+        case ARCH_AVX2:
+                init_mb_mgr_avx2(p_mgr);
+                break;
+        default:
+        case ARCH_AVX512:
+                init_mb_mgr_avx512(p_mgr);
+                break;
+        }
+
+        /* memory is allocated and touched by the core using it */
+        init_mem(&buf, &keys);
+
+        /* warm up before all cores start together */
+        if (use_gcm_api)
+                (void) do_test_gcm(params, num_iter, p_mgr, buf, keys);
+        else
+                (void) do_test(p_mgr, params, num_iter, buf, keys);
+
+        ATOMIC_INC(&scaling_ready);
+        while (!scaling_start)
+                _mm_pause();
+
+        info->bytes = 0;
+        info->start_ns = get_time_ns();
+        do {
+                if (use_gcm_api)
+                        (void) do_test_gcm(params, num_iter, p_mgr, buf, keys);
+                else
+                        (void) do_test(p_mgr, params, num_iter, buf, keys);
+                info->bytes += (uint64_t) num_iter * size;
+                info->end_ns = get_time_ns();
+        } while ((info->end_ns - info->start_ns) < run_ns);
+
+        free_mem(&buf, &keys);
+        free_mb_mgr(p_mgr);
+        ATOMIC_INC(&scaling_done);
+#ifndef _WIN32
+        return NULL;
+#endif
+}
+
+/*
+ * Runs the selected algorithm concurrently on 1 to num_cores cores
+ * (taken from the core mask) for each selected architecture and prints
+ * aggregate throughput and per-core efficiency for each core count
+ */
+static void
+run_scaling_tests(const uint32_t num_cores)
+{
+        struct params_s params;
+        uint32_t arch;
+
+        memset(&params, 0, sizeof(params));
+        params.test_type = TTYPE_CUSTOM;
+        params.num_sizes = 1;
+        params.size_aes = job_sizes[RANGE_MAX];
+        if (test_types[TTYPE_CUSTOM]) {
+                params.cipher_mode = custom_job_params.cipher_mode;
+                params.hash_alg = custom_job_params.hash_alg;
+                params.aes_key_size = custom_job_params.aes_key_size;
+                params.cipher_dir = custom_job_params.cipher_dir;
+        } else {
+                /* AES128-CBC + HMAC-SHA1 unless algorithm selected */
+                params.cipher_mode = TEST_CBC;
+                params.hash_alg = TEST_SHA1;
+                params.aes_key_size = IMB_KEY_AES_128_BYTES;
+                params.cipher_dir = IMB_DIR_ENCRYPT;
+        }
+        if (params.cipher_mode == TEST_GCM)
+                params.aad_size = gcm_aad_size;
+        if (params.cipher_mode == TEST_CCM)
+                params.aad_size = ccm_aad_size;
+
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                double gbps_1core = 0.0;
+                uint32_t n;
+
+                if (archs[arch] == 0)
+                        continue;
+
+                printf("SCALING\t%s\tJOB_SIZE\t%u\n",
+                       arch_str_map[arch].name, params.size_aes);
+                printf("CORES\tGBPS\tGBPS/CORE\tMIN_GBPS/CORE"
+                       "\tEFFICIENCY\n");
+
+                for (n = 1; n <= num_cores; n++) {
+                        uint64_t first_ns = UINT64_MAX, last_ns = 0;
+                        uint64_t bytes = 0;
+                        double gbps, min_gbps = 0.0;
+                        uint32_t t;
+                        int core = 0;
+#ifndef _WIN32
+                        pthread_t tids[MAX_NUM_THREADS + 1];
+#endif
+
+                        scaling_ready = 0;
+                        scaling_done = 0;
+                        scaling_start = 0;
+
+                        for (t = 0; t < n; t++) {
+                                core = next_core(core_mask, core);
+                                s_info[t].core = core++;
+                                s_info[t].arch = arch;
+                                s_info[t].params = params;
+                                s_info[t].params.core =
+                                        (uint32_t) s_info[t].core;
+#ifdef _WIN32
+                                _beginthread(&run_scaling_thread, 0,
+                                             (void *)&s_info[t]);
+#else
+                                pthread_create(&tids[t], NULL,
+                                               run_scaling_thread,
+                                               (void *)&s_info[t]);
+#endif
+                        }
+
+                        /* start all cores at the same time */
+                        while (scaling_ready != (long) n)
+                                _mm_pause();
+                        scaling_start = 1;
+
+#ifdef _WIN32
+                        while (scaling_done != (long) n)
+                                Sleep(1);
+#else
+                        for (t = 0; t < n; t++)
+                                pthread_join(tids[t], NULL);
+#endif
+
+                        for (t = 0; t < n; t++) {
+                                const double core_gbps =
+                                        (double) s_info[t].bytes * 8.0 /
+                                        (double) (s_info[t].end_ns -
+                                                  s_info[t].start_ns);
+
+                                if (t == 0 || core_gbps < min_gbps)
+                                        min_gbps = core_gbps;
+                                if (s_info[t].start_ns < first_ns)
+                                        first_ns = s_info[t].start_ns;
+                                if (s_info[t].end_ns > last_ns)
+                                        last_ns = s_info[t].end_ns;
+                                bytes += s_info[t].bytes;
+                        }
+
+                        /* bits per nanosecond = Gbps */
+                        gbps = (double) bytes * 8.0 /
+                                (double) (last_ns - first_ns);
+                        if (n == 1)
+                                gbps_1core = gbps;
+
+                        printf("%u\t%.2f\t%.2f\t%.2f\t%.1f%%\n",
+                               n, gbps, gbps / n, min_gbps,
+                               (gbps * 100.0) / (gbps_1core * n));
+                }
+                printf("\n");
+        }
+}
+
 static void usage(void)
 {
         fprintf(stderr, "Usage: ipsec_perf [args], "
@@ -2242,6 +2606,13 @@ static void usage(void)
                 "--threads num: <num> for the number of threads to run"
                 " Max: %d\n"
                 "--cores mask: <mask> CPU's to run threads\n"
+                "--scaling: run selected algorithm (--cipher-algo,\n"
+                "           --hash-algo or --aead-algo, default is\n"
+                "           AES128-CBC + HMAC-SHA1) on 1 to N cores of\n"
+                "           --cores mask at the same time and report\n"
+                "           aggregate throughput for each core count\n"
+                "           (N = --threads value or cores in the mask,\n"
+                "           largest --job-size value is used)\n"
                 "--unhalted-cycles: measure using unhalted cycles (requires root).\n"
                 "                   Note: RDTSC is used by default.\n"
                 "--quick: reduces number of test iterations by x10\n"
@@ -2255,6 +2626,11 @@ static void usage(void)
                 "            (-o still applies for MAC)\n"
                 "--aad-size: size of AAD for AEAD algorithms\n"
                 "--job-iter: number of tests iterations for each job size\n"
+                "--imix dist: mix job sizes following distribution <dist>\n"
+                "             given as sizes:weights (e.g. 64,594,1518:7,4,1)\n"
+                "             or 'simple' (Simple IMIX), replaces --job-size\n"
+                "--imix-file file: read IMIX distribution from CSV <file>\n"
+                "                  with one 'size,weight' pair per line\n"
                 "--no-progress-bar: Don't display progress bar\n",
                 MAX_NUM_THREADS + 1);
 }
@@ -2455,6 +2831,173 @@ end_range:
 
 }
 
+/*
+ * Parses IMIX distribution given as comma separated lists of sizes
+ * and weights (e.g. "64,594,1518:7,4,1") or "simple" (Simple IMIX)
+ */
+static int
+parse_imix(const char * const *argv, const int index, const int argc)
+{
+        const char *arg;
+        char *copy_arg, *sizes_str, *weights_str, *token;
+        uint32_t n = 0, num_weights = 0;
+
+        if (index >= (argc - 1)) {
+                fprintf(stderr, "'%s' requires an argument!\n", argv[index]);
+                exit(EXIT_FAILURE);
+        }
+
+        arg = argv[index + 1];
+        if (strcmp(arg, "simple") == 0)
+                arg = "64,594,1518:7,4,1";
+
+        copy_arg = strdup(arg);
+        if (copy_arg == NULL) {
+                fprintf(stderr, "%s() internal error!\n", __func__);
+                exit(EXIT_FAILURE);
+        }
+
+        sizes_str = copy_arg;
+        weights_str = strchr(copy_arg, ':');
+        if (weights_str == NULL)
+                goto invalid_imix;
+        *weights_str++ = '\0';
+
+        for (token = strtok(sizes_str, ","); token != NULL;
+             token = strtok(NULL, ",")) {
+                if (n >= IMIX_MAX_SIZES)
+                        goto invalid_imix;
+                imix_sizes[n++] = (uint32_t) strtoul(token, NULL, 10);
+        }
+
+        for (token = strtok(weights_str, ","); token != NULL;
+             token = strtok(NULL, ",")) {
+                if (num_weights >= n)
+                        goto invalid_imix;
+                imix_weights[num_weights++] =
+                        (uint32_t) strtoul(token, NULL, 10);
+        }
+
+        if (n == 0 || num_weights != n)
+                goto invalid_imix;
+
+        imix_num_sizes = n;
+        free(copy_arg);
+        return index + 1;
+
+invalid_imix:
+        fprintf(stderr, "Invalid IMIX distribution '%s' (expected "
+                "size,...:weight,... with up to %u sizes)\n",
+                argv[index + 1], IMIX_MAX_SIZES);
+        free(copy_arg);
+        exit(EXIT_FAILURE);
+}
+
+/*
+ * Loads IMIX distribution from CSV file,
+ * one "size,weight" pair per line, '#' starts a comment
+ */
+static int
+load_imix_file(const char * const *argv, const int index, const int argc)
+{
+        char line[256];
+        uint32_t n = 0;
+        FILE *f;
+
+        if (index >= (argc - 1)) {
+                fprintf(stderr, "'%s' requires an argument!\n", argv[index]);
+                exit(EXIT_FAILURE);
+        }
+
+        f = fopen(argv[index + 1], "r");
+        if (f == NULL) {
+                fprintf(stderr, "Could not open IMIX file '%s'!\n",
+                        argv[index + 1]);
+                exit(EXIT_FAILURE);
+        }
+
+        while (fgets(line, sizeof(line), f) != NULL) {
+                unsigned size, weight;
+
+                if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+                        continue;
+
+                if (sscanf(line, "%u , %u", &size, &weight) != 2 ||
+                    n >= IMIX_MAX_SIZES) {
+                        fprintf(stderr, "Invalid IMIX file line: %s\n", line);
+                        fclose(f);
+                        exit(EXIT_FAILURE);
+                }
+                imix_sizes[n] = size;
+                imix_weights[n] = weight;
+                n++;
+        }
+        fclose(f);
+
+        if (n == 0) {
+                fprintf(stderr, "No sizes in IMIX file '%s'!\n",
+                        argv[index + 1]);
+                exit(EXIT_FAILURE);
+        }
+
+        imix_num_sizes = n;
+        return index + 1;
+}
+
+/*
+ * Generates shuffled sequence of job sizes following IMIX weights
+ * and calculates mean job size
+ */
+static int
+init_imix(void)
+{
+        uint64_t total_weight = 0, acc_weight = 0, sum = 0;
+        uint32_t i, j, pos = 0;
+
+        for (i = 0; i < imix_num_sizes; i++) {
+                if (imix_sizes[i] < DEFAULT_JOB_SIZE_MIN ||
+                    imix_sizes[i] > JOB_SIZE_TOP) {
+                        fprintf(stderr, "Invalid IMIX job size %u "
+                                "(min %u, max %u)\n", imix_sizes[i],
+                                DEFAULT_JOB_SIZE_MIN, JOB_SIZE_TOP);
+                        return -1;
+                }
+                total_weight += imix_weights[i];
+        }
+
+        if (total_weight == 0) {
+                fprintf(stderr, "Invalid IMIX weights\n");
+                return -1;
+        }
+
+        /* number of jobs of each size proportional to the weight */
+        for (i = 0; i < imix_num_sizes; i++) {
+                const uint32_t end = (uint32_t)
+                        (((acc_weight + imix_weights[i]) * IMIX_SEQ_LEN +
+                          total_weight / 2) / total_weight);
+
+                acc_weight += imix_weights[i];
+                for (; pos < end; pos++)
+                        imix_seq[pos] = imix_sizes[i];
+        }
+
+        /* shuffle, so that jobs of different sizes share the lanes */
+        for (i = IMIX_SEQ_LEN - 1; i > 0; i--) {
+                const uint32_t tmp = imix_seq[i];
+
+                j = (uint32_t) rand() % (i + 1);
+                imix_seq[i] = imix_seq[j];
+                imix_seq[j] = tmp;
+        }
+
+        for (i = 0; i < IMIX_SEQ_LEN; i++)
+                sum += imix_seq[i];
+        imix_seq_bytes = sum;
+        imix_mean_size = (uint32_t) ((sum + IMIX_SEQ_LEN / 2) / IMIX_SEQ_LEN);
+
+        return 0;
+}
+
 int main(int argc, char *argv[])
 {
         uint32_t num_t = 0;
@@ -2635,6 +3178,13 @@ int main(int argc, char *argv[])
                         i = get_next_num_arg((const char * const *)argv, i,
                                              argc, &core_mask,
                                              sizeof(core_mask));
+                } else if (strcmp(argv[i], "--imix") == 0) {
+                        i = parse_imix((const char * const *)argv, i, argc);
+                } else if (strcmp(argv[i], "--imix-file") == 0) {
+                        i = load_imix_file((const char * const *)argv, i,
+                                           argc);
+                } else if (strcmp(argv[i], "--scaling") == 0) {
+                        scaling_test = 1;
                 } else if (strcmp(argv[i], "--unhalted-cycles") == 0) {
                         use_unhalted_cycles = 1;
                 } else if (strcmp(argv[i], "--no-progress-bar") == 0) {
@@ -2691,6 +3241,25 @@ int main(int argc, char *argv[])
                 return EXIT_FAILURE;
         }
 
+        if (scaling_test) {
+                if (core_mask == 0) {
+                        fprintf(stderr, "Must specify core mask "
+                                "for the scaling test!\n");
+                        return EXIT_FAILURE;
+                }
+                if (num_t == 0)
+                        num_t = bitcount(core_mask);
+                if (num_t > (MAX_NUM_THREADS + 1)) {
+                        fprintf(stderr, "Invalid number of threads!\n");
+                        return EXIT_FAILURE;
+                }
+                if (use_unhalted_cycles) {
+                        fprintf(stderr, "Unhalted cycles not supported "
+                                "by the scaling test!\n");
+                        return EXIT_FAILURE;
+                }
+        }
+
         /* if cycles selected then init MSR module */
         if (use_unhalted_cycles) {
                 if (core_mask == 0) {
@@ -2748,6 +3317,22 @@ int main(int argc, char *argv[])
 
         srand(ITER_SCALE_LONG + ITER_SCALE_SHORT + ITER_SCALE_SMOKE);
 
+        if (imix_num_sizes != 0) {
+                if (init_imix() != 0)
+                        return EXIT_FAILURE;
+
+                /* results are reported for the mean job size */
+                job_sizes[RANGE_MIN] = imix_mean_size;
+                job_sizes[RANGE_MAX] = imix_mean_size;
+                fprintf(stderr, "IMIX mean job size = %u, "
+                        "results are cycles per job\n", imix_mean_size);
+        }
+
+        if (scaling_test) {
+                run_scaling_tests(num_t);
+                return EXIT_SUCCESS;
+        }
+
         if (num_t > 1) {
                 uint32_t n;
 
@@ -32,6 +32,7 @@
 
 #include <intel-ipsec-mb.h>
 #include "gcm_ctr_vectors_test.h"
+#include "utils.h"
 
 int api_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
 
@@ -608,16 +609,636 @@ test_job_invalid_cipher_args(struct IMB_MGR *mb_mgr)
         return 0;
 }
 
+/*
+ * @brief Prepares HMAC-SHA1 job for the flush budget test
+ */
+static void
+fill_in_budget_job(struct IMB_JOB *job, const uint8_t *msg,
+                   const uint64_t msg_len, const uint8_t *pad, uint8_t *tag)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_mode = IMB_CIPHER_NULL;
+        job->hash_alg = IMB_AUTH_HMAC_SHA_1;
+        job->chain_order = IMB_ORDER_HASH_CIPHER;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->src = msg;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = msg_len;
+        job->u.HMAC._hashed_auth_key_xor_ipad = pad;
+        job->u.HMAC._hashed_auth_key_xor_opad = pad;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = 12;
+}
+
+/*
+ * @brief Checks that flush budget returns the oldest job without flush
+ */
+static int
+test_job_flush_budget(struct IMB_MGR *mb_mgr)
+{
+        DECLARE_ALIGNED(uint8_t pad[SHA1_DIGEST_SIZE_IN_BYTES], 16);
+        uint8_t msg[64], tag[2][SHA1_DIGEST_SIZE_IN_BYTES];
+        struct IMB_JOB *job, *first = NULL;
+        int i, first_returned = 0;
+
+	printf("Flush budget test:\n");
+
+        memset(pad, 0x36, sizeof(pad));
+        memset(msg, 0xa5, sizeof(msg));
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        /* ======== budget in jobs */
+        if (imb_set_flush_budget(mb_mgr, 1, 0) != 0) {
+                printf("%s: imb_set_flush_budget() failed\n", __func__);
+                return 1;
+        }
+
+        for (i = 0; i < 2; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                fill_in_budget_job(job, msg, sizeof(msg), pad, tag[i]);
+                if (i == 0)
+                        first = job;
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (i == 0 && job != NULL && job != first) {
+                        printf("%s: unexpected job returned\n", __func__);
+                        goto err;
+                }
+                if (i == 1 && !first_returned && job != first) {
+                        /*
+                         * With a budget of one job, the first job has
+                         * to be returned latest by the second submit
+                         */
+                        printf("%s: budget not enforced\n", __func__);
+                        goto err;
+                }
+                if (job == first)
+                        first_returned = 1;
+                if (job != NULL && job->status != STS_COMPLETED) {
+                        printf("%s: unexpected job status\n", __func__);
+                        goto err;
+                }
+                printf(".");
+        }
+
+        if (imb_set_flush_budget(mb_mgr, MAX_JOBS, 0) == 0) {
+                printf("%s: invalid budget accepted\n", __func__);
+                goto err;
+        }
+        printf(".");
+
+        imb_set_flush_budget(mb_mgr, 0, 0);
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        /*
+         * ======== budget in cycles, enforced by get completed job
+         * - job is submitted with a budget that can't be exceeded
+         * - the budget is then lowered to one cycle
+         */
+        imb_set_flush_budget(mb_mgr, 0, UINT64_MAX);
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        fill_in_budget_job(job, msg, sizeof(msg), pad, tag[0]);
+        first = job;
+        if (IMB_SUBMIT_JOB(mb_mgr) != NULL) {
+                printf("%s: unexpected job returned\n", __func__);
+                goto err;
+        }
+        if (IMB_GET_COMPLETED_JOB(mb_mgr) != NULL) {
+                printf("%s: job returned within budget\n", __func__);
+                goto err;
+        }
+        imb_set_flush_budget(mb_mgr, 0, 1);
+        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+        if (job != first || job->status != STS_COMPLETED) {
+                printf("%s: cycle budget not enforced\n", __func__);
+                goto err;
+        }
+        printf(".");
+
+        /* ======== budget in cycles, enforced by get completed burst */
+        imb_set_flush_budget(mb_mgr, 0, UINT64_MAX);
+        if (IMB_GET_NEXT_BURST(mb_mgr, &job, 1) != 1) {
+                printf("%s: no job slot available\n", __func__);
+                goto err;
+        }
+        fill_in_budget_job(job, msg, sizeof(msg), pad, tag[0]);
+        first = job;
+        if (IMB_SUBMIT_BURST(mb_mgr, &job, 1) != 1) {
+                printf("%s: submit burst failed\n", __func__);
+                goto err;
+        }
+        if (IMB_GET_COMPLETED_BURST(mb_mgr, &job, 1) != 0) {
+                printf("%s: burst job returned within budget\n", __func__);
+                goto err;
+        }
+        imb_set_flush_budget(mb_mgr, 0, 1);
+        if (IMB_GET_COMPLETED_BURST(mb_mgr, &job, 1) != 1 || job != first ||
+            job->status != STS_COMPLETED) {
+                printf("%s: cycle budget not enforced on burst\n", __func__);
+                goto err;
+        }
+        printf(".");
+
+        imb_set_flush_budget(mb_mgr, 0, 0);
+	printf("\n");
+        return 0;
+ err:
+        imb_set_flush_budget(mb_mgr, 0, 0);
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+        return 1;
+}
+
+/*
+ * @brief Flushes single jobs with the message at the end of a guarded page
+ *
+ * Empty lanes of the multi-buffer managers must not read past
+ * the end of the message of the flushed job.
+ */
+static int
+test_job_flush_page_end(struct IMB_MGR *mb_mgr)
+{
+        static const struct {
+                JOB_HASH_ALG hash_alg;
+                uint64_t tag_len;
+                uint64_t msg_len;
+        } tab[] = {
+                { IMB_AUTH_AES_XCBC, 12, 17 },
+                { IMB_AUTH_AES_XCBC, 12, 20 },
+                { IMB_AUTH_AES_XCBC, 12, 47 },
+                { IMB_AUTH_AES_CMAC, 16, 17 },
+                { IMB_AUTH_AES_CMAC, 16, 20 },
+                { IMB_AUTH_AES_CMAC, 16, 47 },
+                { IMB_AUTH_SHA_1, 20, 64 },
+                { IMB_AUTH_SHA_1, 20, 100 },
+                { IMB_AUTH_SHA_1, 20, 128 },
+                { IMB_AUTH_SHA_256, 32, 64 },
+                { IMB_AUTH_SHA_256, 32, 100 },
+                { IMB_AUTH_SHA_512, 64, 128 },
+                { IMB_AUTH_SHA_512, 64, 200 },
+                { IMB_AUTH_MD5, 12, 64 },
+                { IMB_AUTH_MD5, 12, 100 },
+        };
+        DECLARE_ALIGNED(uint8_t keys[16 * 15], 16);
+        uint8_t tag[64];
+        struct IMB_JOB *job;
+        unsigned i;
+
+	printf("Flush at page end test:\n");
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        memset(keys, 0xa5, sizeof(keys));
+
+        for (i = 0; i < DIM(tab); i++) {
+                uint8_t *msg = alloc_guarded_buf(tab[i].msg_len);
+
+                if (msg == NULL) {
+                        printf("%s: could not allocate memory\n", __func__);
+                        return 1;
+                }
+                memset(msg, 0x5a, tab[i].msg_len);
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                memset(job, 0, sizeof(*job));
+                job->cipher_mode = IMB_CIPHER_NULL;
+                job->hash_alg = tab[i].hash_alg;
+                job->chain_order = IMB_ORDER_HASH_CIPHER;
+                job->cipher_direction = IMB_DIR_ENCRYPT;
+                job->src = msg;
+                job->msg_len_to_hash_in_bytes = tab[i].msg_len;
+                job->auth_tag_output = tag;
+                job->auth_tag_output_len_in_bytes = tab[i].tag_len;
+
+                switch (tab[i].hash_alg) {
+                case IMB_AUTH_AES_XCBC:
+                        job->u.XCBC._k1_expanded = (const uint32_t *) keys;
+                        job->u.XCBC._k2 = keys;
+                        job->u.XCBC._k3 = keys;
+                        break;
+                case IMB_AUTH_AES_CMAC:
+                        job->u.CMAC._key_expanded = keys;
+                        job->u.CMAC._skey1 = keys;
+                        job->u.CMAC._skey2 = keys;
+                        break;
+                case IMB_AUTH_MD5:
+                        job->u.HMAC._hashed_auth_key_xor_ipad = keys;
+                        job->u.HMAC._hashed_auth_key_xor_opad = keys;
+                        break;
+                default:
+                        break;
+                }
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job == NULL)
+                        job = IMB_FLUSH_JOB(mb_mgr);
+                free_guarded_buf(msg, tab[i].msg_len);
+                if (job == NULL || job->status != STS_COMPLETED) {
+                        printf("%s: job not completed, hash %d, len %u\n",
+                               __func__, (int) tab[i].hash_alg,
+                               (unsigned) tab[i].msg_len);
+                        return 1;
+                }
+                printf(".");
+        }
+	printf("\n");
+        return 0;
+}
+
+#define MIXED_LENS_NUM_JOBS 11
+#define MIXED_LENS_MAX_LEN  512
+
+/*
+ * @brief Submits jobs of mixed lengths, flushing part-way through
+ *
+ * Lanes of the multi-buffer managers complete out of order and
+ * empty lanes run along with the busy ones on flush.
+ * Results have to match the ones of the same jobs
+ * submitted and flushed one at a time.
+ */
+static int
+test_job_mixed_lens(struct IMB_MGR *mb_mgr)
+{
+        static const struct {
+                JOB_CIPHER_MODE cipher_mode;
+                JOB_HASH_ALG hash_alg;
+                uint64_t tag_len;
+        } tab[] = {
+                { IMB_CIPHER_CBC, IMB_AUTH_NULL, 0 },
+                { IMB_CIPHER_NULL, IMB_AUTH_AES_XCBC, 12 },
+                { IMB_CIPHER_NULL, IMB_AUTH_AES_CMAC, 16 },
+                { IMB_CIPHER_DOCSIS_SEC_BPI, IMB_AUTH_NULL, 0 },
+        };
+        static const uint64_t msg_lens[MIXED_LENS_NUM_JOBS] = {
+                1, 500, 17, 15, 33, 250, 16, 48, 3, 129, 64
+        };
+        DECLARE_ALIGNED(uint32_t enc_keys[15 * 4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15 * 4], 16);
+        DECLARE_ALIGNED(uint32_t xcbc_k1[15 * 4], 16);
+        uint8_t xcbc_k2[16], xcbc_k3[16];
+        uint8_t cmac_k1[16], cmac_k2[16];
+        uint8_t key[16], iv[16];
+        uint8_t src[MIXED_LENS_NUM_JOBS][MIXED_LENS_MAX_LEN];
+        /* [0] - jobs completed one at a time, [1] - in a batch */
+        uint8_t dst[2][MIXED_LENS_NUM_JOBS][MIXED_LENS_MAX_LEN];
+        uint8_t tag[2][MIXED_LENS_NUM_JOBS][16];
+        struct IMB_JOB *job;
+        unsigned i, j, batch;
+
+	printf("Mixed lengths with flush test:\n");
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        memset(key, 0x6b, sizeof(key));
+        memset(iv, 0x3c, sizeof(iv));
+        for (i = 0; i < MIXED_LENS_NUM_JOBS; i++)
+                for (j = 0; j < MIXED_LENS_MAX_LEN; j++)
+                        src[i][j] = (uint8_t) (i * 31 + j);
+
+        IMB_AES_KEYEXP_128(mb_mgr, key, enc_keys, dec_keys);
+        IMB_AES_XCBC_KEYEXP(mb_mgr, key, xcbc_k1, xcbc_k2, xcbc_k3);
+        IMB_AES_CMAC_SUBKEY_GEN_128(mb_mgr, enc_keys, cmac_k1, cmac_k2);
+
+        for (i = 0; i < DIM(tab); i++) {
+                for (batch = 0; batch < 2; batch++) {
+                        unsigned completed = 0;
+
+                        memset(dst[batch], 0, sizeof(dst[batch]));
+                        memset(tag[batch], 0, sizeof(tag[batch]));
+
+                        for (j = 0; j < MIXED_LENS_NUM_JOBS; j++) {
+                                uint64_t len = msg_lens[j];
+
+                                /* CBC takes whole blocks only */
+                                if (tab[i].cipher_mode == IMB_CIPHER_CBC)
+                                        len = (len + 15) & ~UINT64_C(15);
+
+                                job = IMB_GET_NEXT_JOB(mb_mgr);
+                                memset(job, 0, sizeof(*job));
+                                job->cipher_mode = tab[i].cipher_mode;
+                                job->hash_alg = tab[i].hash_alg;
+                                job->cipher_direction = IMB_DIR_ENCRYPT;
+                                job->src = src[j];
+                                job->dst = dst[batch][j];
+                                job->auth_tag_output = tag[batch][j];
+                                job->auth_tag_output_len_in_bytes =
+                                        tab[i].tag_len;
+
+                                if (tab[i].cipher_mode != IMB_CIPHER_NULL) {
+                                        job->chain_order =
+                                                IMB_ORDER_CIPHER_HASH;
+                                        job->msg_len_to_cipher_in_bytes = len;
+                                        job->enc_keys = enc_keys;
+                                        job->dec_keys = dec_keys;
+                                        job->key_len_in_bytes = 16;
+                                        job->iv = iv;
+                                        job->iv_len_in_bytes = sizeof(iv);
+                                } else {
+                                        job->chain_order =
+                                                IMB_ORDER_HASH_CIPHER;
+                                        job->msg_len_to_hash_in_bytes = len;
+                                }
+
+                                if (tab[i].hash_alg == IMB_AUTH_AES_XCBC) {
+                                        job->u.XCBC._k1_expanded = xcbc_k1;
+                                        job->u.XCBC._k2 = xcbc_k2;
+                                        job->u.XCBC._k3 = xcbc_k3;
+                                } else if (tab[i].hash_alg ==
+                                           IMB_AUTH_AES_CMAC) {
+                                        job->u.CMAC._key_expanded = enc_keys;
+                                        job->u.CMAC._skey1 = cmac_k1;
+                                        job->u.CMAC._skey2 = cmac_k2;
+                                }
+
+                                job = IMB_SUBMIT_JOB(mb_mgr);
+                                if (job != NULL &&
+                                    job->status == STS_COMPLETED)
+                                        completed++;
+
+                                /* flush part-way through the batch */
+                                if (batch && j != MIXED_LENS_NUM_JOBS / 2)
+                                        continue;
+
+                                while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                                        if (job->status == STS_COMPLETED)
+                                                completed++;
+                        }
+
+                        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                                if (job->status == STS_COMPLETED)
+                                        completed++;
+
+                        if (completed != MIXED_LENS_NUM_JOBS) {
+                                printf("%s: cipher %d, hash %d: "
+                                       "%u of %u jobs completed\n",
+                                       __func__, (int) tab[i].cipher_mode,
+                                       (int) tab[i].hash_alg, completed,
+                                       MIXED_LENS_NUM_JOBS);
+                                return 1;
+                        }
+                }
+
+                if (memcmp(dst[0], dst[1], sizeof(dst[0])) != 0 ||
+                    memcmp(tag[0], tag[1], sizeof(tag[0])) != 0) {
+                        printf("%s: cipher %d, hash %d: batch mismatch\n",
+                               __func__, (int) tab[i].cipher_mode,
+                               (int) tab[i].hash_alg);
+                        return 1;
+                }
+                printf(".");
+        }
+	printf("\n");
+        return 0;
+}
+
+/*
+ * @brief Initializes manager for given architecture
+ */
+static void
+init_mgr(const enum arch_type arch, struct IMB_MGR *mgr)
+{
+        switch (arch) {
+        case ARCH_AVX:
+                init_mb_mgr_avx(mgr);
+                break;
+        case ARCH_AVX2:
+                init_mb_mgr_avx2(mgr);
+                break;
+        case ARCH_AVX512:
+                init_mb_mgr_avx512(mgr);
+                break;
+        default:
+                init_mb_mgr_sse(mgr);
+                break;
+        }
+}
+
+/*
+ * @brief Checks IMB_MGR set up in caller provided memory
+ */
+static int
+test_mb_mgr_arena(const enum arch_type arch, struct IMB_MGR *mb_mgr)
+{
+        const size_t size = imb_get_mb_mgr_size();
+        uint8_t *mem, *arena;
+        struct IMB_MGR *mgr;
+        struct IMB_JOB *job;
+        uint8_t msg[64], digest[SHA1_DIGEST_SIZE_IN_BYTES];
+        int ret = 1;
+
+	printf("IMB_MGR arena test:\n");
+
+        if (size < sizeof(*mgr)) {
+                printf("%s: unexpected IMB_MGR size\n", __func__);
+                return 1;
+        }
+
+        mem = malloc(size + 64);
+        if (mem == NULL) {
+                printf("%s: could not allocate memory\n", __func__);
+                return 1;
+        }
+        arena = mem + (64 - ((uintptr_t) mem & 63));
+
+        if (imb_set_pointers_mb_mgr(arena + 1, mb_mgr->flags, 1) != NULL) {
+                printf("%s: misaligned memory accepted\n", __func__);
+                goto end;
+        }
+	printf(".");
+
+        mgr = imb_set_pointers_mb_mgr(arena, mb_mgr->flags, 1);
+        if (mgr != (struct IMB_MGR *) arena) {
+                printf("%s: unexpected IMB_MGR pointer\n", __func__);
+                goto end;
+        }
+        if ((uint8_t *) mgr->aes128_ooo < arena + sizeof(*mgr) ||
+            (uint8_t *) mgr->sha_512_ooo >= arena + size ||
+            ((uintptr_t) mgr->hmac_sha_1_ooo & 63) != 0) {
+                printf("%s: OOO manager outside of the arena\n", __func__);
+                goto end;
+        }
+	printf(".");
+
+        init_mgr(arch, mgr);
+
+        memset(msg, 0xa5, sizeof(msg));
+        job = IMB_GET_NEXT_JOB(mgr);
+        memset(job, 0, sizeof(*job));
+        job->cipher_mode = IMB_CIPHER_NULL;
+        job->hash_alg = IMB_AUTH_SHA_1;
+        job->chain_order = IMB_ORDER_HASH_CIPHER;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->src = msg;
+        job->msg_len_to_hash_in_bytes = sizeof(msg);
+        job->auth_tag_output = digest;
+        job->auth_tag_output_len_in_bytes = sizeof(digest);
+        job = IMB_SUBMIT_JOB(mgr);
+        if (job == NULL)
+                job = IMB_FLUSH_JOB(mgr);
+        if (job == NULL || job->status != STS_COMPLETED) {
+                printf("%s: job not completed\n", __func__);
+                goto end;
+        }
+	printf(".");
+	printf("\n");
+        ret = 0;
+ end:
+        free(mem);
+        return ret;
+}
+
+/*
+ * @brief Checks IMB_MGR allocated for selected algorithms only
+ */
+static int
+test_mb_mgr_algos(const enum arch_type arch, struct IMB_MGR *mb_mgr)
+{
+        const uint64_t algos = IMB_ALGO_AES_GCM | IMB_ALGO_SHA;
+        struct IMB_MGR *mgr;
+        struct IMB_JOB *job;
+        uint8_t msg[64], digest[SHA1_DIGEST_SIZE_IN_BYTES];
+        int i, ret = 1;
+
+	printf("IMB_MGR algorithm selection test:\n");
+
+        if (imb_get_mb_mgr_size_algos(algos) >= imb_get_mb_mgr_size()) {
+                printf("%s: unexpected IMB_MGR size\n", __func__);
+                return 1;
+        }
+
+        mgr = alloc_mb_mgr_algos(mb_mgr->flags, algos);
+        if (mgr == NULL) {
+                printf("%s: could not allocate manager\n", __func__);
+                return 1;
+        }
+        if (mgr->aes128_gcm_ooo == NULL || mgr->sha_1_ooo == NULL ||
+            mgr->hmac_sha_1_ooo != NULL || mgr->docsis128_sec_ooo != NULL) {
+                printf("%s: unexpected OOO manager pointers\n", __func__);
+                goto end;
+        }
+	printf(".");
+
+        init_mgr(arch, mgr);
+
+        memset(msg, 0xa5, sizeof(msg));
+        for (i = 0; i < 2; i++) {
+                const int hmac = (i == 1);
+
+                job = IMB_GET_NEXT_JOB(mgr);
+                memset(job, 0, sizeof(*job));
+                job->cipher_mode = IMB_CIPHER_NULL;
+                job->hash_alg = hmac ? IMB_AUTH_HMAC_SHA_1 : IMB_AUTH_SHA_1;
+                job->chain_order = IMB_ORDER_HASH_CIPHER;
+                job->cipher_direction = IMB_DIR_ENCRYPT;
+                job->src = msg;
+                job->msg_len_to_hash_in_bytes = sizeof(msg);
+                job->u.HMAC._hashed_auth_key_xor_ipad = msg;
+                job->u.HMAC._hashed_auth_key_xor_opad = msg;
+                job->auth_tag_output = digest;
+                job->auth_tag_output_len_in_bytes =
+                        hmac ? 12 : sizeof(digest);
+                job = IMB_SUBMIT_JOB(mgr);
+                if (job == NULL)
+                        job = IMB_FLUSH_JOB(mgr);
+                if (job == NULL) {
+                        printf("%s: job not returned\n", __func__);
+                        goto end;
+                }
+                /* HMAC-SHA1 manager is not allocated */
+                if (job->status != (hmac ? STS_INVALID_ARGS : STS_COMPLETED)) {
+                        printf("%s: unexpected job status\n", __func__);
+                        goto end;
+                }
+                printf(".");
+        }
+	printf("\n");
+        ret = 0;
+ end:
+        free_mb_mgr(mgr);
+        return ret;
+}
+
+static int
+test_mb_mgr_stats(struct IMB_MGR *mb_mgr)
+{
+        IMB_MGR_STATS stats;
+        struct IMB_JOB *job;
+        uint8_t msg[64], digest[SHA1_DIGEST_SIZE_IN_BYTES];
+        uint64_t lanes = 0;
+        int i;
+
+	printf("IMB_MGR performance counters test:\n");
+
+        if (!(mb_mgr->features & IMB_FEATURE_STATS)) {
+                /* library built without MB_STATS */
+                if (imb_get_mb_mgr_stats(mb_mgr, &stats) != -1) {
+                        printf("%s: unexpected counters\n", __func__);
+                        return 1;
+                }
+                printf("counters not available, skipping\n");
+                return 0;
+        }
+
+        while (IMB_FLUSH_JOB(mb_mgr) != NULL)
+                ;
+        if (imb_reset_mb_mgr_stats(mb_mgr) != 0) {
+                printf("%s: could not reset counters\n", __func__);
+                return 1;
+        }
+
+        memset(msg, 0xa5, sizeof(msg));
+        for (i = 0; i < 2; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                memset(job, 0, sizeof(*job));
+                job->cipher_mode = IMB_CIPHER_NULL;
+                job->hash_alg = IMB_AUTH_SHA_1;
+                job->chain_order = IMB_ORDER_HASH_CIPHER;
+                job->cipher_direction = IMB_DIR_ENCRYPT;
+                job->src = msg;
+                job->msg_len_to_hash_in_bytes = sizeof(msg);
+                job->auth_tag_output = digest;
+                job->auth_tag_output_len_in_bytes = sizeof(digest);
+                (void) IMB_SUBMIT_JOB(mb_mgr);
+        }
+        while (IMB_FLUSH_JOB(mb_mgr) != NULL)
+                ;
+
+        if (imb_get_mb_mgr_stats(mb_mgr, &stats) != 0) {
+                printf("%s: could not read counters\n", __func__);
+                return 1;
+        }
+        for (i = 0; i <= IMB_STATS_MAX_LANES; i++)
+                lanes += stats.hash_lanes[IMB_AUTH_SHA_1][i];
+
+        if (stats.submit_calls != 2 ||
+            stats.hash_jobs[IMB_AUTH_SHA_1] != 2 ||
+            stats.hash_bytes[IMB_AUTH_SHA_1] != 2 * sizeof(msg) ||
+            stats.cipher_jobs[IMB_CIPHER_NULL] != 2 || lanes != 2) {
+                printf("%s: unexpected counter values\n", __func__);
+                return 1;
+        }
+	printf(".\n");
+        return 0;
+}
+
 int
 api_test(const enum arch_type arch, struct IMB_MGR *mb_mgr)
 {
         int errors = 0;
 
-        (void) arch; /* unused */
-
         errors += test_job_api(mb_mgr);
         errors += test_job_invalid_mac_args(mb_mgr);
         errors += test_job_invalid_cipher_args(mb_mgr);
+        errors += test_job_flush_budget(mb_mgr);
+        errors += test_job_flush_page_end(mb_mgr);
+        errors += test_job_mixed_lens(mb_mgr);
+        errors += test_mb_mgr_arena(arch, mb_mgr);
+        errors += test_mb_mgr_algos(arch, mb_mgr);
+        errors += test_mb_mgr_stats(mb_mgr);
 
 	if (0 == errors)
 		printf("...Pass\n");
@@ -0,0 +1,395 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <intel-ipsec-mb.h>
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+#define NUM_BURST_JOBS  300
+#define MAX_BUF_SIZE    2048
+#define BURST_TAG_SIZE  12
+
+int burst_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
+
+struct burst_test_ctx {
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        DECLARE_ALIGNED(uint8_t ipad_hash[32], 16);
+        DECLARE_ALIGNED(uint8_t opad_hash[32], 16);
+        uint8_t iv[NUM_BURST_JOBS][16];
+        uint8_t src[NUM_BURST_JOBS][MAX_BUF_SIZE];
+        uint32_t len[NUM_BURST_JOBS];
+};
+
+/*
+ * @brief Generates keys and random input for AES-CBC + HMAC-SHA1 jobs
+ */
+static void
+burst_ctx_init(struct IMB_MGR *mb_mgr, struct burst_test_ctx *ctx)
+{
+        uint8_t key[16];
+        uint8_t buf[64];
+        unsigned i, j;
+
+        for (i = 0; i < sizeof(key); i++)
+                key[i] = (uint8_t) rand();
+        IMB_AES_KEYEXP_128(mb_mgr, key, ctx->enc_keys, ctx->dec_keys);
+
+        memset(buf, 0x36, sizeof(buf));
+        for (i = 0; i < sizeof(key); i++)
+                buf[i] ^= key[i];
+        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, ctx->ipad_hash);
+
+        memset(buf, 0x5c, sizeof(buf));
+        for (i = 0; i < sizeof(key); i++)
+                buf[i] ^= key[i];
+        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, ctx->opad_hash);
+
+        for (i = 0; i < NUM_BURST_JOBS; i++) {
+                /* 16 to MAX_BUF_SIZE bytes, multiple of AES block size */
+                ctx->len[i] = ((rand() % (MAX_BUF_SIZE / 16)) + 1) * 16;
+                for (j = 0; j < sizeof(ctx->iv[i]); j++)
+                        ctx->iv[i][j] = (uint8_t) rand();
+                for (j = 0; j < ctx->len[i]; j++)
+                        ctx->src[i][j] = (uint8_t) rand();
+        }
+}
+
+static void
+burst_fill_job(struct IMB_JOB *job, const struct burst_test_ctx *ctx,
+               const unsigned idx, uint8_t *dst, uint8_t *tag)
+{
+        job->cipher_mode = IMB_CIPHER_CBC;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->chain_order = IMB_ORDER_CIPHER_HASH;
+        job->hash_alg = IMB_AUTH_HMAC_SHA_1;
+        job->enc_keys = ctx->enc_keys;
+        job->dec_keys = ctx->dec_keys;
+        job->key_len_in_bytes = IMB_KEY_AES_128_BYTES;
+        job->iv = ctx->iv[idx];
+        job->iv_len_in_bytes = 16;
+        job->src = ctx->src[idx];
+        job->dst = dst;
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = ctx->len[idx];
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = ctx->len[idx];
+        job->u.HMAC._hashed_auth_key_xor_ipad = ctx->ipad_hash;
+        job->u.HMAC._hashed_auth_key_xor_opad = ctx->opad_hash;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = BURST_TAG_SIZE;
+        job->user_data = (void *)((uintptr_t) idx);
+}
+
+/*
+ * @brief Processes all jobs through the single job API (reference output)
+ */
+static int
+burst_ref_run(struct IMB_MGR *mb_mgr, const struct burst_test_ctx *ctx,
+              uint8_t (*dst)[MAX_BUF_SIZE], uint8_t (*tag)[BURST_TAG_SIZE])
+{
+        struct IMB_JOB *job;
+        unsigned i, jobs_rx = 0;
+
+        for (i = 0; i < NUM_BURST_JOBS; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                burst_fill_job(job, ctx, i, dst[i], tag[i]);
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        if (job->status != STS_COMPLETED) {
+                                printf("%s: job %u status %d\n", __func__,
+                                       (unsigned)(uintptr_t) job->user_data,
+                                       (int) job->status);
+                                return 1;
+                        }
+                        jobs_rx++;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                if (job->status != STS_COMPLETED) {
+                        printf("%s: job %u status %d\n", __func__,
+                               (unsigned)(uintptr_t) job->user_data,
+                               (int) job->status);
+                        return 1;
+                }
+                jobs_rx++;
+        }
+
+        if (jobs_rx != NUM_BURST_JOBS) {
+                printf("%s: expected %u jobs, received %u\n", __func__,
+                       NUM_BURST_JOBS, jobs_rx);
+                return 1;
+        }
+        return 0;
+}
+
+/*
+ * @brief Checks that completed jobs come back in submission order
+ */
+static int
+burst_check_jobs(struct IMB_JOB **jobs, const uint32_t n_jobs,
+                 unsigned *next_idx)
+{
+        uint32_t i;
+
+        for (i = 0; i < n_jobs; i++) {
+                const unsigned idx = (unsigned)(uintptr_t) jobs[i]->user_data;
+
+                if (jobs[i]->status != STS_COMPLETED) {
+                        printf("burst job %u status %d\n", idx,
+                               (int) jobs[i]->status);
+                        return 1;
+                }
+                if (idx != *next_idx) {
+                        printf("burst job %u returned, expected %u\n",
+                               idx, *next_idx);
+                        return 1;
+                }
+                (*next_idx)++;
+        }
+        return 0;
+}
+
+/*
+ * @brief Processes all jobs through the burst API
+ */
+static int
+burst_run(struct IMB_MGR *mb_mgr, const struct burst_test_ctx *ctx,
+          const uint32_t burst_size, uint8_t (*dst)[MAX_BUF_SIZE],
+          uint8_t (*tag)[BURST_TAG_SIZE])
+{
+        struct IMB_JOB *jobs[MAX_JOBS];
+        unsigned submitted = 0, next_idx = 0;
+        uint32_t i, n;
+
+        while (submitted < NUM_BURST_JOBS) {
+                uint32_t n_req = NUM_BURST_JOBS - submitted;
+
+                if (n_req > burst_size)
+                        n_req = burst_size;
+
+                n = IMB_GET_NEXT_BURST(mb_mgr, jobs, n_req);
+                if (n == 0) {
+                        /* queue full - make space for the next burst */
+                        n = IMB_FLUSH_BURST(mb_mgr, jobs, n_req);
+                        if (n == 0) {
+                                printf("%s: no jobs to flush\n", __func__);
+                                return 1;
+                        }
+                        if (burst_check_jobs(jobs, n, &next_idx))
+                                return 1;
+                        continue;
+                }
+
+                for (i = 0; i < n; i++)
+                        burst_fill_job(jobs[i], ctx, submitted + i,
+                                       dst[submitted + i], tag[submitted + i]);
+
+                if (IMB_SUBMIT_BURST(mb_mgr, jobs, n) != n) {
+                        printf("%s: submit burst failed\n", __func__);
+                        return 1;
+                }
+                submitted += n;
+
+                n = IMB_GET_COMPLETED_BURST(mb_mgr, jobs, MAX_JOBS);
+                if (burst_check_jobs(jobs, n, &next_idx))
+                        return 1;
+        }
+
+        while ((n = IMB_FLUSH_BURST(mb_mgr, jobs, burst_size)) != 0)
+                if (burst_check_jobs(jobs, n, &next_idx))
+                        return 1;
+
+        if (next_idx != NUM_BURST_JOBS) {
+                printf("%s: expected %u jobs, received %u\n", __func__,
+                       NUM_BURST_JOBS, next_idx);
+                return 1;
+        }
+        if (IMB_QUEUE_SIZE(mb_mgr) != 0) {
+                printf("%s: queue not empty\n", __func__);
+                return 1;
+        }
+        return 0;
+}
+
+/*
+ * @brief Performs burst API behavior tests
+ */
+static int
+test_burst_api(struct IMB_MGR *mb_mgr)
+{
+        struct IMB_JOB *jobs[MAX_JOBS + 1];
+        struct IMB_JOB *job;
+        uint32_t n;
+
+        /* ======== test 1 : number of jobs limited by queue space */
+        n = IMB_GET_NEXT_BURST(mb_mgr, jobs, MAX_JOBS + 1);
+        if (n != (MAX_JOBS - 1)) {
+                printf("%s: test 1, unexpected number of jobs %u\n",
+                       __func__, n);
+                return 1;
+        }
+        if (jobs[0] != IMB_GET_NEXT_JOB(mb_mgr)) {
+                printf("%s: test 1, unexpected first job\n", __func__);
+                return 1;
+        }
+        printf(".");
+
+        /* ======== test 2 : invalid jobs */
+        n = IMB_GET_NEXT_BURST(mb_mgr, jobs, 2);
+        if (n != 2) {
+                printf("%s: test 2, unexpected number of jobs %u\n",
+                       __func__, n);
+                return 1;
+        }
+        memset(jobs[0], 0, sizeof(*jobs[0]));
+        memset(jobs[1], 0, sizeof(*jobs[1]));
+        if (IMB_SUBMIT_BURST(mb_mgr, jobs, n) != n) {
+                printf("%s: test 2, submit burst failed\n", __func__);
+                return 1;
+        }
+        if (IMB_QUEUE_SIZE(mb_mgr) != n) {
+                printf("%s: test 2, unexpected queue size\n", __func__);
+                return 1;
+        }
+        job = jobs[0];
+        n = IMB_GET_COMPLETED_BURST(mb_mgr, jobs, MAX_JOBS);
+        if (n != 2 || jobs[0] != job) {
+                printf("%s: test 2, unexpected completed jobs\n", __func__);
+                return 1;
+        }
+        if (jobs[0]->status != STS_INVALID_ARGS ||
+            jobs[1]->status != STS_INVALID_ARGS) {
+                printf("%s: test 2, unexpected job->status != "
+                       "STS_INVALID_ARGS\n", __func__);
+                return 1;
+        }
+        printf(".");
+
+        /* ======== test 3 : empty queue */
+        if (IMB_GET_COMPLETED_BURST(mb_mgr, jobs, MAX_JOBS) != 0 ||
+            IMB_FLUSH_BURST(mb_mgr, jobs, MAX_JOBS) != 0) {
+                printf("%s: test 3, unexpected completed job\n", __func__);
+                return 1;
+        }
+        printf(".");
+
+        return 0;
+}
+
+int
+burst_test(const enum arch_type arch, struct IMB_MGR *mb_mgr)
+{
+        const uint32_t burst_sizes[] = { 1, 4, 16, 32, 64, 100, MAX_JOBS };
+        struct burst_test_ctx *ctx = NULL;
+        uint8_t (*ref_dst)[MAX_BUF_SIZE] = NULL;
+        uint8_t (*dst)[MAX_BUF_SIZE] = NULL;
+        uint8_t (*ref_tag)[BURST_TAG_SIZE] = NULL;
+        uint8_t (*tag)[BURST_TAG_SIZE] = NULL;
+        struct IMB_JOB *job;
+        int errors = 1;
+        unsigned i;
+
+        (void) arch; /* unused */
+
+        printf("Burst API test:\n");
+
+        /* empty the manager before the test */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        if (test_burst_api(mb_mgr))
+                goto end;
+
+        ctx = malloc(sizeof(*ctx));
+        ref_dst = malloc(NUM_BURST_JOBS * sizeof(*ref_dst));
+        dst = malloc(NUM_BURST_JOBS * sizeof(*dst));
+        ref_tag = malloc(NUM_BURST_JOBS * sizeof(*ref_tag));
+        tag = malloc(NUM_BURST_JOBS * sizeof(*tag));
+        if (ctx == NULL || ref_dst == NULL || dst == NULL ||
+            ref_tag == NULL || tag == NULL) {
+                fprintf(stderr, "Can't allocate buffer memory\n");
+                goto end;
+        }
+
+        burst_ctx_init(mb_mgr, ctx);
+
+        if (burst_ref_run(mb_mgr, ctx, ref_dst, ref_tag))
+                goto end;
+
+        for (i = 0; i < DIM(burst_sizes); i++) {
+                unsigned j;
+
+                memset(dst, 0, NUM_BURST_JOBS * sizeof(*dst));
+                memset(tag, 0, NUM_BURST_JOBS * sizeof(*tag));
+
+                if (burst_run(mb_mgr, ctx, burst_sizes[i], dst, tag)) {
+                        printf("burst size %u failed\n", burst_sizes[i]);
+                        goto end;
+                }
+
+                for (j = 0; j < NUM_BURST_JOBS; j++) {
+                        if (memcmp(dst[j], ref_dst[j], ctx->len[j]) != 0) {
+                                printf("burst size %u: job %u cipher text "
+                                       "mismatch\n", burst_sizes[i], j);
+                                goto end;
+                        }
+                        if (memcmp(tag[j], ref_tag[j], BURST_TAG_SIZE) != 0) {
+                                printf("burst size %u: job %u tag mismatch\n",
+                                       burst_sizes[i], j);
+                                hexdump(stderr, "Received", tag[j],
+                                        BURST_TAG_SIZE);
+                                hexdump(stderr, "Expected", ref_tag[j],
+                                        BURST_TAG_SIZE);
+                                goto end;
+                        }
+                }
+                printf(".");
+        }
+        errors = 0;
+
+ end:
+        /* empty the manager before next tests */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        free(ctx);
+        free(ref_dst);
+        free(dst);
+        free(ref_tag);
+        free(tag);
+
+        printf("\n");
+        return errors;
+}
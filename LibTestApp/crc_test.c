@@ -0,0 +1,243 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <intel-ipsec-mb.h>
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+#define CRC_MAX_BUF_SIZE 2048
+#define CRC_NUM_BUFS     8
+
+int crc_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
+
+struct crc_test_def {
+        IMB_CRC_TYPE type;
+        const char *name;
+        uint32_t check;         /* CRC of "123456789" */
+};
+
+static const struct crc_test_def crc_tests[] = {
+        { IMB_CRC_TYPE_CRC32_ETHERNET_FCS, "CRC32 Ethernet FCS", 0xcbf43926 },
+        { IMB_CRC_TYPE_CRC16_CCITT, "CRC16 CCITT", 0x31c3 },
+        { IMB_CRC_TYPE_CRC24_A, "CRC24A", 0xcde703 },
+        { IMB_CRC_TYPE_CRC24_B, "CRC24B", 0x23ef52 },
+        { IMB_CRC_TYPE_CRC11, "CRC11", 0x5ca },
+        { IMB_CRC_TYPE_CRC6, "CRC6", 0x15 }
+};
+
+/*
+ * @brief Bit at a time reference implementation
+ */
+static uint32_t
+crc_ref(const IMB_CRC_TYPE type, const uint8_t *in, const uint64_t len)
+{
+        uint32_t poly, width, crc = 0;
+        uint64_t i;
+        int bit;
+
+        if (type == IMB_CRC_TYPE_CRC32_ETHERNET_FCS) {
+                /* reflected, initial value and final XOR all ones */
+                crc = 0xffffffff;
+                for (i = 0; i < len; i++) {
+                        crc ^= in[i];
+                        for (bit = 0; bit < 8; bit++)
+                                crc = (crc >> 1) ^
+                                        ((crc & 1) ? 0xedb88320 : 0);
+                }
+                return ~crc;
+        }
+
+        switch (type) {
+        case IMB_CRC_TYPE_CRC16_CCITT:
+                poly = 0x1021;
+                width = 16;
+                break;
+        case IMB_CRC_TYPE_CRC24_A:
+                poly = 0x864cfb;
+                width = 24;
+                break;
+        case IMB_CRC_TYPE_CRC24_B:
+                poly = 0x800063;
+                width = 24;
+                break;
+        case IMB_CRC_TYPE_CRC11:
+                poly = 0x621;
+                width = 11;
+                break;
+        case IMB_CRC_TYPE_CRC6:
+        default:
+                poly = 0x21;
+                width = 6;
+                break;
+        }
+
+        /* non-reflected, zero initial value, no final XOR */
+        for (i = 0; i < len; i++)
+                for (bit = 7; bit >= 0; bit--) {
+                        const uint32_t msb = (crc >> (width - 1)) & 1;
+
+                        crc = (crc << 1) & ((1 << width) - 1);
+                        if (msb ^ ((in[i] >> bit) & 1))
+                                crc ^= poly;
+                }
+
+        return crc;
+}
+
+static uint32_t
+crc_one_buffer(struct IMB_MGR *mb_mgr, const IMB_CRC_TYPE type,
+               const void *in, const uint64_t len)
+{
+        switch (type) {
+        case IMB_CRC_TYPE_CRC32_ETHERNET_FCS:
+                return IMB_CRC32_ETHERNET_FCS(mb_mgr, in, len);
+        case IMB_CRC_TYPE_CRC16_CCITT:
+                return IMB_CRC16_CCITT(mb_mgr, in, len);
+        case IMB_CRC_TYPE_CRC24_A:
+                return IMB_CRC24_A(mb_mgr, in, len);
+        case IMB_CRC_TYPE_CRC24_B:
+                return IMB_CRC24_B(mb_mgr, in, len);
+        case IMB_CRC_TYPE_CRC11:
+                return IMB_CRC11(mb_mgr, in, len);
+        case IMB_CRC_TYPE_CRC6:
+        default:
+                return IMB_CRC6(mb_mgr, in, len);
+        }
+}
+
+/*
+ * @brief Checks single buffer API against the check value and
+ *        the reference implementation
+ */
+static int
+test_crc_one_buffer(struct IMB_MGR *mb_mgr, const struct crc_test_def *def,
+                    const uint8_t *buf)
+{
+        const uint8_t check_msg[] = "123456789";
+        uint32_t crc;
+        uint64_t len;
+
+        crc = crc_one_buffer(mb_mgr, def->type, check_msg, 9);
+        if (crc != def->check) {
+                printf("%s: check value mismatch, "
+                       "expected 0x%x, got 0x%x\n",
+                       def->name, def->check, crc);
+                return 1;
+        }
+
+        for (len = 0; len <= CRC_MAX_BUF_SIZE; len++) {
+                const uint8_t *in = &buf[len & 7]; /* vary alignment */
+
+                /* all short lengths, random steps above */
+                if (len > 300)
+                        len += (uint64_t) (rand() % 64);
+                if (len > CRC_MAX_BUF_SIZE)
+                        break;
+
+                crc = crc_one_buffer(mb_mgr, def->type, in, len);
+                if (crc != crc_ref(def->type, in, len)) {
+                        printf("%s: mismatch for %u byte buffer, "
+                               "expected 0x%x, got 0x%x\n",
+                               def->name, (unsigned) len,
+                               crc_ref(def->type, in, len), crc);
+                        return 1;
+                }
+        }
+
+        return 0;
+}
+
+/*
+ * @brief Checks N buffer API against the reference implementation
+ */
+static int
+test_crc_n_buffer(struct IMB_MGR *mb_mgr, const struct crc_test_def *def,
+                  const uint8_t *buf)
+{
+        const void *in[CRC_NUM_BUFS];
+        uint64_t len[CRC_NUM_BUFS];
+        uint32_t out[CRC_NUM_BUFS];
+        uint32_t i;
+
+        for (i = 0; i < CRC_NUM_BUFS; i++) {
+                in[i] = &buf[i * 3];
+                len[i] = (i == 0) ? 0 : (uint64_t) (rand() % 1024);
+        }
+
+        IMB_CRC_N_BUFFER(mb_mgr, def->type, in, len, out, CRC_NUM_BUFS);
+
+        for (i = 0; i < CRC_NUM_BUFS; i++)
+                if (out[i] != crc_ref(def->type, in[i], len[i])) {
+                        printf("%s: N buffer mismatch on buffer %u\n",
+                               def->name, i);
+                        return 1;
+                }
+
+        return 0;
+}
+
+int
+crc_test(const enum arch_type arch, struct IMB_MGR *mb_mgr)
+{
+        uint8_t *buf = NULL;
+        int errors = 0;
+        unsigned i;
+
+        (void) arch; /* unused */
+
+        printf("CRC test:\n");
+
+        buf = malloc(CRC_MAX_BUF_SIZE + 8);
+        if (buf == NULL) {
+                fprintf(stderr, "Can't allocate buffer memory\n");
+                return 1;
+        }
+
+        for (i = 0; i < (CRC_MAX_BUF_SIZE + 8); i++)
+                buf[i] = (uint8_t) rand();
+
+        for (i = 0; i < DIM(crc_tests); i++) {
+                if (test_crc_one_buffer(mb_mgr, &crc_tests[i], buf) ||
+                    test_crc_n_buffer(mb_mgr, &crc_tests[i], buf))
+                        errors++;
+                printf(".");
+        }
+
+        free(buf);
+
+        if (errors)
+                printf("...Fail\n");
+        else
+                printf("...Pass\n");
+
+        return errors;
+}
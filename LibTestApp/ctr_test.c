@@ -1264,23 +1264,65 @@ static const struct gcm_ctr_vector ctr_bit_vectors[] = {
 };
 
 static int
-test_ctr(struct IMB_MGR *mb_mgr,
-         const void *expkey,
-         unsigned key_len,
-         const void *iv,
-         unsigned iv_len,
-         const uint8_t *in_text,
-         const uint8_t *out_text,
-         unsigned text_len,
-         int dir,
-         int order,
-         const JOB_CIPHER_MODE alg)
+ctr_job_ok(const struct IMB_JOB *job,
+           const uint8_t *out_text,
+           const uint8_t *target,
+           const uint8_t *padding,
+           const size_t sizeof_padding,
+           const unsigned text_len)
+{
+        if (job->status != STS_COMPLETED) {
+                printf("%d Error status:%d", __LINE__, job->status);
+                return 0;
+        }
+
+        if (memcmp(out_text, target + sizeof_padding, text_len)) {
+                printf("mismatched\n");
+                hexdump(stderr, "Target", target,
+                        text_len + (2 * sizeof_padding));
+                hexdump(stderr, "Expected", out_text, text_len);
+                return 0;
+        }
+        if (memcmp(padding, target, sizeof_padding)) {
+                printf("overwrite head\n");
+                hexdump(stderr, "Target", target,
+                        text_len + (2 * sizeof_padding));
+                return 0;
+        }
+        if (memcmp(padding, target + sizeof_padding + text_len,
+                   sizeof_padding)) {
+                printf("overwrite tail\n");
+                hexdump(stderr, "Target", target,
+                        text_len + (2 * sizeof_padding));
+                return 0;
+        }
+        return 1;
+}
+
+static int
+test_ctr_jobs(struct IMB_MGR *mb_mgr,
+              const void *expkey,
+              unsigned key_len,
+              const void *iv,
+              unsigned iv_len,
+              const uint8_t *in_text,
+              const uint8_t *out_text,
+              unsigned text_len,
+              int dir,
+              int order,
+              const JOB_CIPHER_MODE alg,
+              const int num_jobs)
 {
         uint32_t text_byte_len;
         struct IMB_JOB *job;
         uint8_t padding[16];
-        uint8_t *target;
-        int ret = -1;
+        uint8_t **targets = malloc(num_jobs * sizeof(void *));
+        int i, jobs_rx = 0, ret = -1;
+
+        if (targets == NULL) {
+		fprintf(stderr, "Can't allocate buffer memory\n");
+		goto end2;
+        }
 
         /* Get number of bytes (in case algo is CNTR_BITLEN) */
         if (alg == IMB_CIPHER_CNTR)
@@ -1288,78 +1330,109 @@ test_ctr(struct IMB_MGR *mb_mgr,
         else
                 text_byte_len = BYTE_ROUND_UP(text_len);
 
-        target = malloc(text_byte_len + (sizeof(padding) * 2));
-        if (target == NULL) {
-		fprintf(stderr, "Can't allocate buffer memory\n");
-		goto end;
-        }
-
-        memset(target, -1, text_byte_len + (sizeof(padding) * 2));
         memset(padding, -1, sizeof(padding));
+        memset(targets, 0, num_jobs * sizeof(void *));
+
+        for (i = 0; i < num_jobs; i++) {
+                targets[i] = malloc(text_byte_len + (sizeof(padding) * 2));
+                if (targets[i] == NULL) {
+                        fprintf(stderr, "Can't allocate buffer memory\n");
+                        goto end;
+                }
+                memset(targets[i], -1, text_byte_len + (sizeof(padding) * 2));
+        }
 
         while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
                 ;
 
-        job = IMB_GET_NEXT_JOB(mb_mgr);
-        job->cipher_direction = dir;
-        job->chain_order = order;
-        job->dst = target + 16;
-        job->src = in_text;
-        job->cipher_mode = alg;
-        job->enc_keys = expkey;
-        job->dec_keys = expkey;
-        job->key_len_in_bytes = key_len;
-        job->iv = iv;
-        job->iv_len_in_bytes = iv_len;
-        job->cipher_start_src_offset_in_bytes = 0;
-        if (alg == IMB_CIPHER_CNTR)
-                job->msg_len_to_cipher_in_bytes = text_byte_len;
-        else
-                job->msg_len_to_cipher_in_bits = text_len;
-
-        job->hash_alg = IMB_AUTH_NULL;
-
-        job = IMB_SUBMIT_JOB(mb_mgr);
-        if (!job) {
-                printf("%d Unexpected null return from submit_job\n", __LINE__);
-                goto end;
-        }
-        if (job->status != STS_COMPLETED) {
-                printf("%d Error status:%d", __LINE__, job->status);
-                goto end;
-        }
-        job = IMB_FLUSH_JOB(mb_mgr);
-        if (job) {
-                printf("%u Unexpected return from flush_job\n", __LINE__);
-                goto end;
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = order;
+                job->dst = targets[i] + sizeof(padding);
+                job->src = in_text;
+                job->cipher_mode = alg;
+                job->enc_keys = expkey;
+                job->dec_keys = expkey;
+                job->key_len_in_bytes = key_len;
+                job->iv = iv;
+                job->iv_len_in_bytes = iv_len;
+                job->cipher_start_src_offset_in_bytes = 0;
+                if (alg == IMB_CIPHER_CNTR)
+                        job->msg_len_to_cipher_in_bytes = text_byte_len;
+                else
+                        job->msg_len_to_cipher_in_bits = text_len;
+
+                job->hash_alg = IMB_AUTH_NULL;
+                job->user_data = targets[i];
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                /*
+                 * Short CNTR jobs go through the multi-buffer manager
+                 * and may be returned later
+                 */
+                while (job != NULL) {
+                        jobs_rx++;
+                        if (!ctr_job_ok(job, out_text, job->user_data,
+                                        padding, sizeof(padding),
+                                        text_byte_len))
+                                goto end;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
         }
 
-        if (memcmp(out_text, target + 16, text_byte_len)) {
-                printf("mismatched\n");
-                hexdump(stderr, "Target", target, text_byte_len + 32);
-                hexdump(stderr, "Expected", out_text, text_byte_len);
-                goto end;
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (!ctr_job_ok(job, out_text, job->user_data,
+                                padding, sizeof(padding), text_byte_len))
+                        goto end;
         }
-        if (memcmp(padding, target, sizeof(padding))) {
-                printf("overwrite head\n");
-                hexdump(stderr, "Target", target, text_byte_len + 32);
-                goto end;
-        }
-        if (memcmp(padding, target + sizeof(padding) + text_byte_len,
-                   sizeof(padding))) {
-                printf("overwrite tail\n");
-                hexdump(stderr, "Target", target, text_byte_len + 32);
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
                 goto end;
         }
         ret = 0;
+
+ end:
         while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
                 ;
- end:
-        if (target != NULL)
-                free(target);
+
+        for (i = 0; i < num_jobs; i++) {
+                if (targets[i] != NULL)
+                        free(targets[i]);
+        }
+        free(targets);
+
+ end2:
         return ret;
 }
 
+static int
+test_ctr(struct IMB_MGR *mb_mgr,
+         const void *expkey,
+         unsigned key_len,
+         const void *iv,
+         unsigned iv_len,
+         const uint8_t *in_text,
+         const uint8_t *out_text,
+         unsigned text_len,
+         int dir,
+         int order,
+         const JOB_CIPHER_MODE alg)
+{
+        /* exercise partially and fully occupied multi-buffer managers */
+        const int num_jobs_tab[] = { 1, 3, 8, 9, 17 };
+        unsigned i;
+
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                if (test_ctr_jobs(mb_mgr, expkey, key_len, iv, iv_len,
+                                  in_text, out_text, text_len, dir, order,
+                                  alg, num_jobs_tab[i]))
+                        return -1;
+        return 0;
+}
+
 static int
 test_ctr_vectors(struct IMB_MGR *mb_mgr, const struct gcm_ctr_vector *vectors,
                  const uint32_t vectors_cnt, const JOB_CIPHER_MODE alg)
@@ -708,6 +708,129 @@ test_des3_vectors(struct IMB_MGR *mb_mgr, const enum arch_type arch,
 	return errors;
 }
 
+static int
+check_des_mixed_job(const struct IMB_JOB *job,
+                    const struct des_vector *vec_tab,
+                    const int vec_cnt,
+                    uint8_t **targets,
+                    const int dir)
+{
+        const int num = (const int)((uint64_t)job->user_data);
+        const struct des_vector *v = &vec_tab[num % vec_cnt];
+
+        if (job->status != STS_COMPLETED) {
+                printf("%d error status:%d, job %d\n",
+                       __LINE__, job->status, num);
+                return -1;
+        }
+        if (memcmp(targets[num], (dir == IMB_DIR_ENCRYPT) ? v->C : v->P,
+                   v->Plen)) {
+                printf("job %d mismatched\n", num);
+                return -1;
+        }
+        return 0;
+}
+
+/*
+ * Submits jobs of all vectors in a row, so that lanes of
+ * multi-buffer managers hold buffers of different lengths
+ */
+static int
+test_des_mixed(struct IMB_MGR *mb_mgr,
+               const int vec_cnt,
+               const struct des_vector *vec_tab,
+               const char *banner,
+               const JOB_CIPHER_MODE cipher,
+               const int dir)
+{
+        const int num_jobs = 64;
+        uint64_t (*ks)[16] = malloc(vec_cnt * sizeof(*ks));
+        const void *(*ks_ptr)[3] = malloc(vec_cnt * sizeof(*ks_ptr));
+        uint8_t **targets = malloc(num_jobs * sizeof(void *));
+        struct IMB_JOB *job;
+        int i, jobs_rx = 0, ret = -1;
+
+        assert(ks != NULL);
+        assert(ks_ptr != NULL);
+        assert(targets != NULL);
+
+        printf("%s:\n", banner);
+
+        for (i = 0; i < vec_cnt; i++) {
+                des_key_schedule(ks[i], vec_tab[i].K);
+                /* 3DES with a single key */
+                ks_ptr[i][0] = ks[i];
+                ks_ptr[i][1] = ks[i];
+                ks_ptr[i][2] = ks[i];
+        }
+
+        for (i = 0; i < num_jobs; i++) {
+                targets[i] = malloc(vec_tab[i % vec_cnt].Plen);
+                assert(targets[i] != NULL);
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct des_vector *v = &vec_tab[i % vec_cnt];
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                        IMB_ORDER_CIPHER_HASH : IMB_ORDER_HASH_CIPHER;
+                job->cipher_mode = cipher;
+                if (cipher == IMB_CIPHER_DES3) {
+                        job->enc_keys = (const void *) ks_ptr[i % vec_cnt];
+                        job->dec_keys = (const void *) ks_ptr[i % vec_cnt];
+                        job->key_len_in_bytes = 24;
+                } else {
+                        job->enc_keys = ks[i % vec_cnt];
+                        job->dec_keys = ks[i % vec_cnt];
+                        job->key_len_in_bytes = 8;
+                }
+                job->src = (dir == IMB_DIR_ENCRYPT) ? v->P : v->C;
+                job->dst = targets[i];
+                job->iv = v->IV;
+                job->iv_len_in_bytes = 8;
+                job->cipher_start_src_offset_in_bytes = 0;
+                job->msg_len_to_cipher_in_bytes = v->Plen;
+                job->user_data = (void *)((uint64_t)i);
+                job->hash_alg = IMB_AUTH_NULL;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job != NULL) {
+                        jobs_rx++;
+                        if (check_des_mixed_job(job, vec_tab, vec_cnt,
+                                                targets, dir))
+                                goto end;
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (check_des_mixed_job(job, vec_tab, vec_cnt, targets, dir))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++)
+                free(targets[i]);
+        free(targets);
+        free(ks_ptr);
+        free(ks);
+        return ret;
+}
+
 int
 des_test(const enum arch_type arch,
          struct IMB_MGR *mb_mgr)
@@ -730,6 +853,26 @@ des_test(const enum arch_type arch,
                                     des3_vectors,
                                     "3DES (multiple keys) test vectors");
 
+        if (test_des_mixed(mb_mgr, DIM(docsis_vectors), docsis_vectors,
+                           "DOCSIS DES mixed length encrypt",
+                           IMB_CIPHER_DOCSIS_DES, IMB_DIR_ENCRYPT))
+                errors++;
+
+        if (test_des_mixed(mb_mgr, DIM(docsis_vectors), docsis_vectors,
+                           "DOCSIS DES mixed length decrypt",
+                           IMB_CIPHER_DOCSIS_DES, IMB_DIR_DECRYPT))
+                errors++;
+
+        if (test_des_mixed(mb_mgr, DIM(vectors), vectors,
+                           "DES mixed length encrypt",
+                           IMB_CIPHER_DES, IMB_DIR_ENCRYPT))
+                errors++;
+
+        if (test_des_mixed(mb_mgr, DIM(vectors), vectors,
+                           "3DES mixed length decrypt",
+                           IMB_CIPHER_DES3, IMB_DIR_DECRYPT))
+                errors++;
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
@@ -1687,6 +1687,116 @@ static int test_gcm_std_vectors(void)
 	return is_error;
 }
 
+/*****************************************************************************
+ * job API - all vectors in flight at the same time
+ *****************************************************************************/
+#define GCM_NUM_VECTORS (sizeof(gcm_vectors) / sizeof(gcm_vectors[0]))
+
+static int test_gcm_multi_job(const JOB_CIPHER_DIRECTION dir)
+{
+        static struct gcm_key_data keys[GCM_NUM_VECTORS];
+        uint8_t *out[GCM_NUM_VECTORS];
+        uint8_t tags[GCM_NUM_VECTORS][16];
+        unsigned i, num_jobs = 0;
+        int is_error = 0;
+        IMB_JOB *job;
+
+        printf("AES-GCM multi-job test vectors (%s):\n",
+               dir == IMB_DIR_ENCRYPT ? "encrypt" : "decrypt");
+
+        memset(out, 0, sizeof(out));
+        for (i = 0; i < GCM_NUM_VECTORS; i++) {
+                const struct gcm_ctr_vector *vector = &gcm_vectors[i];
+
+                out[i] = malloc(vector->Plen + 1);
+                if (out[i] == NULL) {
+                        fprintf(stderr, "Can't allocate output memory\n");
+                        is_error = 1;
+                        goto test_gcm_multi_job_exit;
+                }
+
+                switch (vector->Klen) {
+                case BITS_128:
+                        IMB_AES128_GCM_PRE(p_gcm_mgr, vector->K, &keys[i]);
+                        break;
+                case BITS_192:
+                        IMB_AES192_GCM_PRE(p_gcm_mgr, vector->K, &keys[i]);
+                        break;
+                case BITS_256:
+                default:
+                        IMB_AES256_GCM_PRE(p_gcm_mgr, vector->K, &keys[i]);
+                        break;
+                }
+
+                job = IMB_GET_NEXT_JOB(p_gcm_mgr);
+                job->cipher_mode = IMB_CIPHER_GCM;
+                job->hash_alg = IMB_AUTH_AES_GMAC;
+                job->cipher_direction = dir;
+                job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                        IMB_ORDER_CIPHER_HASH : IMB_ORDER_HASH_CIPHER;
+                job->enc_keys = &keys[i];
+                job->dec_keys = &keys[i];
+                job->key_len_in_bytes = vector->Klen;
+                job->src = (dir == IMB_DIR_ENCRYPT) ? vector->P : vector->C;
+                job->dst = out[i];
+                job->msg_len_to_cipher_in_bytes = vector->Plen;
+                job->cipher_start_src_offset_in_bytes = UINT64_C(0);
+                job->iv = vector->IV;
+                job->iv_len_in_bytes = vector->IVlen;
+                job->u.GCM.aad = vector->A;
+                job->u.GCM.aad_len_in_bytes = vector->Alen;
+                job->auth_tag_output = tags[i];
+                job->auth_tag_output_len_in_bytes = vector->Tlen;
+
+                job = IMB_SUBMIT_JOB(p_gcm_mgr);
+                while (job) {
+                        if (job->status != STS_COMPLETED) {
+                                fprintf(stderr, "failed job, status:%d\n",
+                                        job->status);
+                                is_error = 1;
+                        }
+                        num_jobs++;
+                        job = IMB_GET_COMPLETED_JOB(p_gcm_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(p_gcm_mgr)) != NULL) {
+                if (job->status != STS_COMPLETED) {
+                        fprintf(stderr, "failed job, status:%d\n",
+                                job->status);
+                        is_error = 1;
+                }
+                num_jobs++;
+        }
+
+        if (num_jobs != GCM_NUM_VECTORS) {
+                printf("  expected %u jobs, received %u\n",
+                       (unsigned) GCM_NUM_VECTORS, num_jobs);
+                is_error = 1;
+                goto test_gcm_multi_job_exit;
+        }
+
+        for (i = 0; i < GCM_NUM_VECTORS; i++) {
+                const struct gcm_ctr_vector *vector = &gcm_vectors[i];
+
+                if (dir == IMB_DIR_ENCRYPT)
+                        is_error |= check_data(out[i], vector->C, vector->Plen,
+                                               "encrypted cypher text (C)");
+                else
+                        is_error |= check_data(out[i], vector->P, vector->Plen,
+                                               "decrypted plain text (P)");
+                is_error |= check_data(tags[i], vector->T, vector->Tlen,
+                                       "tag (T)");
+        }
+
+ test_gcm_multi_job_exit:
+        for (i = 0; i < GCM_NUM_VECTORS; i++)
+                if (out[i] != NULL)
+                        free(out[i]);
+
+        return is_error;
+}
+
 static int test_ghash(void)
 {
 	int const vectors_cnt = sizeof(ghash_vectors) /
@@ -1731,6 +1841,9 @@ int gcm_test(IMB_MGR *p_mgr)
 
 	errors = test_gcm_std_vectors();
 
+        errors += test_gcm_multi_job(IMB_DIR_ENCRYPT);
+        errors += test_gcm_multi_job(IMB_DIR_DECRYPT);
+
         errors += test_ghash();
 
 	if (0 == errors)
@@ -548,6 +548,9 @@ hmac_md5_test(const enum arch_type arch,
         errors += test_hmac_md5_std_vectors(mb_mgr, 15);
         errors += test_hmac_md5_std_vectors(mb_mgr, 16);
         errors += test_hmac_md5_std_vectors(mb_mgr, 17);
+        errors += test_hmac_md5_std_vectors(mb_mgr, 31);
+        errors += test_hmac_md5_std_vectors(mb_mgr, 32);
+        errors += test_hmac_md5_std_vectors(mb_mgr, 33);
 
 	if (0 == errors)
 		printf("...Pass\n");
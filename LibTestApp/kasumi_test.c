@@ -193,8 +193,15 @@ submit_kasumi_f8_jobs(struct IMB_MGR *mb_mgr, kasumi_key_sched_t **keys,
                                        __LINE__, job->status, i);
                                 return -1;
                         }
-                } else {
-                        printf("Expected returned job, but got nothing\n");
+                }
+        }
+
+        /* byte length jobs can be held by the out-of-order manager */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (job->status != STS_COMPLETED) {
+                        printf("%d error status:%d, job %d",
+                               __LINE__, job->status, jobs_rx - 1);
                         return -1;
                 }
         }
@@ -226,6 +233,9 @@ submit_kasumi_f9_job(struct IMB_MGR *mb_mgr, kasumi_key_sched_t *key,
         job->auth_tag_output_len_in_bytes = 4;
 
         job = IMB_SUBMIT_JOB(mb_mgr);
+        /* job can be held by the out-of-order manager */
+        if (job == NULL)
+                job = IMB_FLUSH_JOB(mb_mgr);
         if (job != NULL) {
                 if (job->status != STS_COMPLETED) {
                         printf("%d error status:%d",
@@ -53,6 +53,8 @@ extern int kasumi_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
 extern int snow3g_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
 extern int direct_api_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
 extern int clear_mem_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
+extern int burst_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
+extern int crc_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
 
 #include "do_test.h"
 
@@ -303,6 +305,8 @@ main(int argc, char **argv)
                 errors += api_test(atype, p_mgr);
                 errors += direct_api_test(atype, p_mgr);
                 errors += clear_mem_test(atype, p_mgr);
+                errors += burst_test(atype, p_mgr);
+                errors += crc_test(atype, p_mgr);
                 free_mb_mgr(p_mgr);
         }
 
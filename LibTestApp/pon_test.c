@@ -505,8 +505,12 @@ test_pon(struct IMB_MGR *mb_mgr,
         job->auth_tag_output_len_in_bytes = (uint64_t) sizeof(tag_output);
         job = IMB_SUBMIT_JOB(mb_mgr);
 
+        /* the job may wait in a lane of the out-of-order manager */
+        if (job == NULL)
+                job = IMB_FLUSH_JOB(mb_mgr);
+
         if (job == NULL) {
-                printf("%d NULL job after submit()", __LINE__);
+                printf("%d NULL job after submit() and flush()", __LINE__);
                 goto end;
         }
 
@@ -678,12 +682,152 @@ test_pon_std_vectors(struct IMB_MGR *mb_mgr)
 	return errors;
 }
 
+/*
+ * Submits all test vectors in one go (PON_BURST_COPIES times),
+ * so that frames share the lanes of the out-of-order manager
+ */
+#define PON_NUM_VECTORS  (sizeof(pon_vectors) / sizeof(pon_vectors[0]))
+#define PON_BURST_COPIES 3
+#define PON_BURST_JOBS   (PON_BURST_COPIES * PON_NUM_VECTORS)
+
+static int
+test_pon_burst(struct IMB_MGR *mb_mgr, const int dir)
+{
+        DECLARE_ALIGNED(uint32_t expkey[PON_NUM_VECTORS][4*15], 16);
+        DECLARE_ALIGNED(uint32_t dust[4*15], 16);
+        uint8_t *target[PON_BURST_JOBS];
+        uint64_t tag_output[PON_BURST_JOBS];
+        unsigned i, num_jobs = 0;
+        struct IMB_JOB *job;
+        int errors = 0;
+
+        memset(target, 0, sizeof(target));
+
+        for (i = 0; i < PON_NUM_VECTORS; i++)
+                if (pon_vectors[i].key != NULL)
+                        IMB_AES_KEYEXP_128(mb_mgr, pon_vectors[i].key,
+                                           expkey[i], dust);
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < PON_BURST_JOBS; i++) {
+                const struct pon_test_vector *v =
+                        &pon_vectors[i % PON_NUM_VECTORS];
+
+                target[i] = malloc(v->length_to_bip);
+                if (target[i] == NULL) {
+                        fprintf(stderr, "Can't allocate buffer memory\n");
+                        errors++;
+                        goto end;
+                }
+                if (dir == IMB_DIR_ENCRYPT) {
+                        memcpy(target[i], v->in, v->length_to_bip);
+                        /* HEC gets updated by the library */
+                        target[i][7] ^= 0xff;
+                } else {
+                        memcpy(target[i], v->out, v->length_to_bip);
+                }
+                tag_output[i] = 0;
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                        IMB_ORDER_CIPHER_HASH : IMB_ORDER_HASH_CIPHER;
+                job->src = target[i];
+                job->dst = target[i] + v->offset_to_crc_cipher;
+                job->cipher_mode = IMB_CIPHER_PON_AES_CNTR;
+                job->cipher_start_src_offset_in_bytes =
+                        (uint64_t) v->offset_to_crc_cipher;
+                if (v->iv != NULL) {
+                        job->enc_keys = expkey[i % PON_NUM_VECTORS];
+                        job->dec_keys = expkey[i % PON_NUM_VECTORS];
+                        job->key_len_in_bytes = IMB_KEY_AES_128_BYTES;
+                        job->iv = v->iv;
+                        job->iv_len_in_bytes = 16;
+                        job->msg_len_to_cipher_in_bytes =
+                                (uint64_t) v->length_to_cipher;
+                } else {
+                        job->enc_keys = NULL;
+                        job->dec_keys = NULL;
+                        job->key_len_in_bytes = 0;
+                        job->iv = NULL;
+                        job->iv_len_in_bytes = 0;
+                        job->msg_len_to_cipher_in_bytes = 0;
+                }
+                job->hash_alg = IMB_AUTH_PON_CRC_BIP;
+                job->hash_start_src_offset_in_bytes = 0;
+                job->msg_len_to_hash_in_bytes = (uint64_t) v->length_to_bip;
+                job->auth_tag_output = (void *) &tag_output[i];
+                job->auth_tag_output_len_in_bytes = sizeof(tag_output[i]);
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        if (job->status != STS_COMPLETED) {
+                                printf("%d Error status:%d\n", __LINE__,
+                                       job->status);
+                                errors++;
+                        }
+                        num_jobs++;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                if (job->status != STS_COMPLETED) {
+                        printf("%d Error status:%d\n", __LINE__,
+                               job->status);
+                        errors++;
+                }
+                num_jobs++;
+        }
+
+        if (num_jobs != PON_BURST_JOBS) {
+                printf("Expected %u jobs, received %u\n",
+                       (unsigned) PON_BURST_JOBS, num_jobs);
+                errors++;
+        }
+
+        for (i = 0; i < PON_BURST_JOBS; i++) {
+                const struct pon_test_vector *v =
+                        &pon_vectors[i % PON_NUM_VECTORS];
+                const uint8_t *exp = (dir == IMB_DIR_ENCRYPT) ?
+                        v->out : v->in;
+                const size_t cmp_len = (dir == IMB_DIR_ENCRYPT) ?
+                        v->length_to_bip : v->length_to_bip - 4;
+
+                if ((uint32_t) tag_output[i] != v->bip_out) {
+                        printf("burst job %u BIP mismatch! "
+                               "expected 0x%08x, received 0x%08x\n",
+                               i, v->bip_out, (uint32_t) tag_output[i]);
+                        errors++;
+                }
+                if (memcmp(exp, target[i], cmp_len)) {
+                        printf("burst job %u output mismatch\n", i);
+                        hexdump(stderr, "Target", target[i],
+                                v->length_to_bip);
+                        errors++;
+                }
+        }
+
+ end:
+        for (i = 0; i < PON_BURST_JOBS; i++)
+                if (target[i] != NULL)
+                        free(target[i]);
+
+        return errors;
+}
+
 int pon_test(const enum arch_type arch, struct IMB_MGR *mb_mgr)
 {
         int errors = 0;
 
-        if (arch != ARCH_NO_AESNI)
+        if (arch != ARCH_NO_AESNI) {
                 errors = test_pon_std_vectors(mb_mgr);
+                printf("PON (AES128-CTR/CRC/BIP) burst test:\n");
+                errors += test_pon_burst(mb_mgr, IMB_DIR_ENCRYPT);
+                errors += test_pon_burst(mb_mgr, IMB_DIR_DECRYPT);
+        }
 
 	if (0 == errors)
 		printf("...Pass\n");
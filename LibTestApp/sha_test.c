@@ -578,6 +578,15 @@ sha_test(const enum arch_type arch,
         (void) arch; /* unused */
 
         errors += test_sha_vectors(mb_mgr, 1);
+        errors += test_sha_vectors(mb_mgr, 3);
+        errors += test_sha_vectors(mb_mgr, 4);
+        errors += test_sha_vectors(mb_mgr, 5);
+        errors += test_sha_vectors(mb_mgr, 7);
+        errors += test_sha_vectors(mb_mgr, 8);
+        errors += test_sha_vectors(mb_mgr, 9);
+        errors += test_sha_vectors(mb_mgr, 15);
+        errors += test_sha_vectors(mb_mgr, 16);
+        errors += test_sha_vectors(mb_mgr, 17);
 
 	if (0 == errors)
 		printf("...Pass\n");
@@ -55,6 +55,9 @@ static
 int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
                                           uint32_t job_api);
 static
+int validate_snow3g_f8_16_blocks_multi_key(struct IMB_MGR *mb_mgr,
+                                           uint32_t job_api);
+static
 int validate_snow3g_f8_n_blocks(struct IMB_MGR *mb_mgr, uint32_t job_api);
 static
 int validate_snow3g_f8_n_blocks_multi(struct IMB_MGR *mb_mgr,
@@ -62,6 +65,8 @@ int validate_snow3g_f8_n_blocks_multi(struct IMB_MGR *mb_mgr,
 static
 int validate_snow3g_f9(struct IMB_MGR *mb_mgr, uint32_t job_api);
 static
+int validate_snow3g_f9_n_blocks(struct IMB_MGR *mb_mgr, uint32_t job_api);
+static
 int membitcmp(const uint8_t *input, const uint8_t *output,
               const uint32_t bitlength, const uint32_t offset);
 
@@ -82,12 +87,16 @@ struct {
          "validate_snow3g_f8_8_blocks"},
         {validate_snow3g_f8_8_blocks_multi_key,
          "validate_snow3g_f8_8_blocks_multi_key"},
+        {validate_snow3g_f8_16_blocks_multi_key,
+         "validate_snow3g_f8_16_blocks_multi_key"},
         {validate_snow3g_f8_n_blocks,
          "validate_snow3g_f8_n_blocks"},
         {validate_snow3g_f8_n_blocks_multi,
          "validate_snow3g_f8_n_blocks_multi"},
         {validate_snow3g_f9,
-         "validate_snow3g_f9"}
+         "validate_snow3g_f9"},
+        {validate_snow3g_f9_n_blocks,
+         "validate_snow3g_f9_n_blocks"}
 };
 
 /******************************************************************************
@@ -145,8 +154,15 @@ submit_uea2_jobs(struct IMB_MGR *mb_mgr, uint8_t **keys, uint8_t **ivs,
                                        __LINE__, job->status, i);
                                 return -1;
                         }
-                } else {
-                        printf("Expected returned job, but got nothing\n");
+                }
+        }
+
+        /* byte length jobs can be held by the out-of-order manager */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (job->status != STS_COMPLETED) {
+                        printf("%d error status:%d, job %d",
+                               __LINE__, job->status, jobs_rx - 1);
                         return -1;
                 }
         }
@@ -179,6 +195,9 @@ submit_uia2_job(struct IMB_MGR *mb_mgr, uint8_t *key, uint8_t *iv,
         job->auth_tag_output_len_in_bytes = 4;
 
         job = IMB_SUBMIT_JOB(mb_mgr);
+        /* job can be held by the out-of-order manager */
+        if (job == NULL)
+                job = IMB_FLUSH_JOB(mb_mgr);
         if (job != NULL) {
                 if (job->status != STS_COMPLETED) {
                         printf("%d error status:%d",
@@ -193,6 +212,57 @@ submit_uia2_job(struct IMB_MGR *mb_mgr, uint8_t *key, uint8_t *iv,
         return 0;
 }
 
+static inline int
+submit_uia2_jobs(struct IMB_MGR *mb_mgr, uint8_t **keys, uint8_t **ivs,
+                 uint8_t **src, uint8_t **tags, const uint32_t *bitlens,
+                 const unsigned int num_jobs)
+{
+        IMB_JOB *job;
+        unsigned int i;
+        unsigned int jobs_rx = 0;
+
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->chain_order = IMB_ORDER_CIPHER_HASH;
+                job->cipher_mode = IMB_CIPHER_NULL;
+                job->src = src[i];
+                job->u.SNOW3G_UIA2._iv = ivs[i];
+                job->u.SNOW3G_UIA2._key = keys[i];
+
+                job->hash_start_src_offset_in_bytes = 0;
+                job->msg_len_to_hash_in_bits = bitlens[i];
+                job->hash_alg = IMB_AUTH_SNOW3G_UIA2_BITLEN;
+                job->auth_tag_output = tags[i];
+                job->auth_tag_output_len_in_bytes = 4;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job != NULL) {
+                        jobs_rx++;
+                        if (job->status != STS_COMPLETED) {
+                                printf("%d error status:%d, job %d",
+                                       __LINE__, job->status, i);
+                                return -1;
+                        }
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (job->status != STS_COMPLETED) {
+                        printf("%d error status:%d, job %d",
+                               __LINE__, job->status, jobs_rx - 1);
+                        return -1;
+                }
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                return -1;
+        }
+
+        return 0;
+}
+
 static int validate_snow3g_f8_1_block(struct IMB_MGR *mb_mgr, uint32_t job_api)
 {
         int numVectors, i, length;
@@ -1581,10 +1651,15 @@ snow3g_f8_8_buffer_exit:
         return ret;
 }
 
-static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
-                                                 uint32_t job_api)
+/*
+ * Multi-key F8 of 8 or 16 buffers,
+ * buffer i uses test vector (i % number of vectors)
+ */
+static int validate_snow3g_f8_multi_key(struct IMB_MGR *mb_mgr,
+                                        uint32_t job_api,
+                                        int numPackets)
 {
-        int length, numVectors, i, j, numPackets = 8;
+        int length, numVectors, i, j;
         size_t size = 0;
 
         if (numPackets > NUM_SUPPORTED_BUFFERS) {
@@ -1609,8 +1684,8 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
 
         int ret = 1;
 
-        printf("Testing IMB_SNOW3G_F8_8_BUFFER_MULTIKEY: (%s):\n",
-               job_api ? "Job API" : "Direct API");
+        printf("Testing IMB_SNOW3G_F8_%d_BUFFER_MULTIKEY: (%s):\n",
+               numPackets, job_api ? "Job API" : "Direct API");
 
         memset(pSrcBuff, 0, sizeof(pSrcBuff));
         memset(pDstBuff, 0, sizeof(pDstBuff));
@@ -1641,27 +1716,27 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
                 pKeySched[i] = malloc(size);
                 if (!pKeySched[i]) {
                         printf("malloc(pKeySched[%d]):failed !\n", i);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
                 pSrcBuff[i] = malloc(length);
                 if (!pSrcBuff[i]) {
                         printf("malloc(pSrcBuff[%d]):failed !\n", i);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
                 pDstBuff[i] = malloc(length);
                 if (!pDstBuff[i]) {
                         printf("malloc(pDstBuff[%d]):failed !\n", i);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
                 pKey[i] = malloc(testVectors[j].keyLenInBytes);
                 if (!pKey[i]) {
                         printf("malloc(pKey[%d]):failed !\n", i);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
                 pIV[i] = malloc(SNOW3G_IV_LEN_IN_BYTES);
                 if (!pIV[i]) {
                         printf("malloc(pIV[%d]):failed !\n", i);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
 
                 memcpy(pKey[i], testVectors[j].key,
@@ -1673,7 +1748,7 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
 
                 if (IMB_SNOW3G_INIT_KEY_SCHED(mb_mgr, pKey[i], pKeySched[i])) {
                         printf("IMB_SNOW3G_INIT_KEY_SCHED(mb_mgr) error\n");
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
         }
 
@@ -1681,7 +1756,15 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
         if (job_api)
                 submit_uea2_jobs(mb_mgr, (uint8_t **)&pKeySched, pIV, pSrcBuff,
                                  pDstBuff, bitLens, bitOffsets,
-                                 IMB_DIR_ENCRYPT, 8);
+                                 IMB_DIR_ENCRYPT, numPackets);
+        else if (numPackets == 16)
+                IMB_SNOW3G_F8_16_BUFFER_MULTIKEY(mb_mgr,
+                                        (const snow3g_key_schedule_t * const *)
+                                        pKeySched,
+                                        (const void * const *)pIV,
+                                        (const void * const *)pSrcBuff,
+                                        (void **)pDstBuff,
+                                        packetLen);
         else
                 IMB_SNOW3G_F8_8_BUFFER_MULTIKEY(mb_mgr,
                                         (const snow3g_key_schedule_t * const *)
@@ -1696,13 +1779,13 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
                 j = i % numVectors;
                 if (memcmp(pDstBuff[i], testVectors[j].ciphertext,
                            packetLen[i]) != 0) {
-                        printf("snow3g_f8_8_multi_buffer(Enc) vector:%d "
+                        printf("snow3g_f8_%d_multi_buffer(Enc) vector:%d "
                                "buffer:%d\n",
-                               j, i);
+                               numPackets, j, i);
                         snow3g_hexdump("Actual:", pDstBuff[i], packetLen[i]);
                         snow3g_hexdump("Expected:", testVectors[j].ciphertext,
                                        packetLen[i]);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
                 printf(".");
         }
@@ -1711,7 +1794,13 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
         if (job_api)
                 submit_uea2_jobs(mb_mgr, (uint8_t **)&pKeySched, pIV, pSrcBuff,
                                  pDstBuff, bitLens, bitOffsets,
-                                 IMB_DIR_DECRYPT, 8);
+                                 IMB_DIR_DECRYPT, numPackets);
+        else if (numPackets == 16)
+                IMB_SNOW3G_F8_16_BUFFER_MULTIKEY(mb_mgr,
+                        (const snow3g_key_schedule_t * const *) pKeySched,
+                        (const void * const *)pIV,
+                        (const void * const *)pDstBuff,
+                        (void **)pSrcBuff, packetLen);
         else
                 IMB_SNOW3G_F8_8_BUFFER_MULTIKEY(mb_mgr,
                         (const snow3g_key_schedule_t * const *) pKeySched,
@@ -1724,19 +1813,19 @@ static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
                 j = i % numVectors;
                 if (memcmp(pSrcBuff[i], testVectors[j].plaintext,
                            packetLen[i]) != 0) {
-                        printf("snow3g_f8_8_multi_buffer(Dec) vector:%d "
-                               "buffer:%d\n", j, i);
+                        printf("snow3g_f8_%d_multi_buffer(Dec) vector:%d "
+                               "buffer:%d\n", numPackets, j, i);
                         snow3g_hexdump("Actual:", pSrcBuff[i], packetLen[i]);
                         snow3g_hexdump("Expected:", testVectors[j].plaintext,
                                        packetLen[i]);
-                        goto snow3g_f8_8_buffer_multikey_exit;
+                        goto snow3g_f8_multikey_exit;
                 }
                 printf(".");
         }
         /* no errors detected */
         ret = 0;
 
-snow3g_f8_8_buffer_multikey_exit:
+snow3g_f8_multikey_exit:
         for (i = 0; i < numPackets; i++) {
                 if (pSrcBuff[i] != NULL)
                         free(pSrcBuff[i]);
@@ -1755,6 +1844,18 @@ snow3g_f8_8_buffer_multikey_exit:
         return ret;
 }
 
+static int validate_snow3g_f8_8_blocks_multi_key(struct IMB_MGR *mb_mgr,
+                                                 uint32_t job_api)
+{
+        return validate_snow3g_f8_multi_key(mb_mgr, job_api, 8);
+}
+
+static int validate_snow3g_f8_16_blocks_multi_key(struct IMB_MGR *mb_mgr,
+                                                  uint32_t job_api)
+{
+        return validate_snow3g_f8_multi_key(mb_mgr, job_api, 16);
+}
+
 static int validate_snow3g_f8_n_blocks(struct IMB_MGR *mb_mgr, uint32_t job_api)
 {
         int length, numVectors, i, numPackets = 16;
@@ -2197,6 +2298,145 @@ snow3g_f9_1_buffer_exit:
         return ret;
 }
 
+static int validate_snow3g_f9_n_blocks(struct IMB_MGR *mb_mgr,
+                                       uint32_t job_api)
+{
+        int numVectors, i, j, numBuffs;
+        size_t size = 0;
+        hash_test_vector_t *testVectors = snow3g_hash_test_vectors[2];
+        /* snow3g f9 test vectors are located at index 2 */
+        numVectors = numSnow3gHashTestVectors[2];
+
+        snow3g_key_schedule_t *pKeySched[NUM_SUPPORTED_BUFFERS];
+        uint8_t *pSrcBuff[NUM_SUPPORTED_BUFFERS];
+        uint8_t *pIV[NUM_SUPPORTED_BUFFERS];
+        uint8_t *pDigest[NUM_SUPPORTED_BUFFERS];
+        uint8_t digest[NUM_SUPPORTED_BUFFERS][DIGEST_LEN];
+        uint64_t bitLens[NUM_SUPPORTED_BUFFERS];
+        uint32_t jobBitLens[NUM_SUPPORTED_BUFFERS];
+        int ret = 1;
+
+        printf("Testing IMB_SNOW3G_F9_N_BUFFER: (%s):\n",
+               job_api ? "Job API" : "Direct API");
+
+        if (!numVectors) {
+                printf("No Snow3G test vectors found !\n");
+                return ret;
+        }
+
+        size = IMB_SNOW3G_KEY_SCHED_SIZE(mb_mgr);
+        if (!size)
+                return ret;
+
+        memset(pKeySched, 0, sizeof(pKeySched));
+        for (i = 0; i < NUM_SUPPORTED_BUFFERS; i++) {
+                pKeySched[i] = malloc(size);
+                if (!pKeySched[i]) {
+                        printf("malloc(IMB_SNOW3G_KEY_SCHED_SIZE(mb_mgr)): "
+                               "failed !\n");
+                        goto snow3g_f9_n_buffer_exit;
+                }
+        }
+
+        /* buffer i uses test vector (i % numVectors), with its own key */
+        for (i = 0; i < NUM_SUPPORTED_BUFFERS; i++) {
+                const int v = i % numVectors;
+
+                if (IMB_SNOW3G_INIT_KEY_SCHED(mb_mgr, testVectors[v].key,
+                                              pKeySched[i])) {
+                        printf("IMB_SNOW3G_INIT_KEY_SCHED() error\n");
+                        goto snow3g_f9_n_buffer_exit;
+                }
+                pSrcBuff[i] = testVectors[v].input;
+                pIV[i] = testVectors[v].iv;
+                pDigest[i] = digest[i];
+                bitLens[i] = testVectors[v].lengthInBits;
+                jobBitLens[i] = testVectors[v].lengthInBits;
+        }
+
+        for (numBuffs = 1; numBuffs <= NUM_SUPPORTED_BUFFERS; numBuffs++) {
+                memset(digest, 0, sizeof(digest));
+
+                if (job_api) {
+                        if (submit_uia2_jobs(mb_mgr, (uint8_t **)pKeySched,
+                                             pIV, pSrcBuff, pDigest,
+                                             jobBitLens, numBuffs))
+                                goto snow3g_f9_n_buffer_exit;
+                } else
+                        IMB_SNOW3G_F9_N_BUFFER_MULTIKEY(mb_mgr,
+                                (const snow3g_key_schedule_t * const *)
+                                pKeySched,
+                                (const void * const *)pIV,
+                                (const void * const *)pSrcBuff,
+                                bitLens, (void **)pDigest, numBuffs);
+
+                for (i = 0; i < numBuffs; i++) {
+                        const int v = i % numVectors;
+
+                        if (memcmp(digest[i], testVectors[v].exp_out,
+                                   DIGEST_LEN) != 0) {
+                                printf("IMB_SNOW3G_F9_N_BUFFER_MULTIKEY() "
+                                       "buffers:%d buffer num:%d\n",
+                                       numBuffs, i);
+                                snow3g_hexdump("Actual:", digest[i],
+                                               DIGEST_LEN);
+                                snow3g_hexdump("Expected:",
+                                               testVectors[v].exp_out,
+                                               DIGEST_LEN);
+                                goto snow3g_f9_n_buffer_exit;
+                        }
+                }
+                printf(".");
+
+                if (job_api)
+                        continue;
+
+                /* single key: all buffers use the same test vector */
+                for (j = 0; j < numVectors && j < NUM_SUPPORTED_BUFFERS;
+                     j++) {
+                        const void *pSameSrc[NUM_SUPPORTED_BUFFERS];
+                        const void *pSameIV[NUM_SUPPORTED_BUFFERS];
+                        uint64_t sameBitLens[NUM_SUPPORTED_BUFFERS];
+
+                        for (i = 0; i < numBuffs; i++) {
+                                pSameSrc[i] = testVectors[j].input;
+                                pSameIV[i] = testVectors[j].iv;
+                                sameBitLens[i] = testVectors[j].lengthInBits;
+                        }
+                        memset(digest, 0, sizeof(digest));
+
+                        IMB_SNOW3G_F9_N_BUFFER(mb_mgr, pKeySched[j], pSameIV,
+                                               pSameSrc, sameBitLens,
+                                               (void **)pDigest, numBuffs);
+
+                        for (i = 0; i < numBuffs; i++) {
+                                if (memcmp(digest[i], testVectors[j].exp_out,
+                                           DIGEST_LEN) != 0) {
+                                        printf("IMB_SNOW3G_F9_N_BUFFER() "
+                                               "vector num:%d buffers:%d "
+                                               "buffer num:%d\n",
+                                               j, numBuffs, i);
+                                        snow3g_hexdump("Actual:", digest[i],
+                                                       DIGEST_LEN);
+                                        snow3g_hexdump("Expected:",
+                                                       testVectors[j].exp_out,
+                                                       DIGEST_LEN);
+                                        goto snow3g_f9_n_buffer_exit;
+                                }
+                        }
+                }
+        }
+        /* no errors detected */
+        ret = 0;
+
+snow3g_f9_n_buffer_exit:
+        for (i = 0; i < NUM_SUPPORTED_BUFFERS; i++)
+                free(pKeySched[i]);
+        printf("\n");
+
+        return ret;
+}
+
 static int validate_f8_iv_gen(void)
 {
         uint32_t i;
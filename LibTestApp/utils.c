@@ -30,6 +30,13 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "utils.h"
 
 #ifdef _WIN32
@@ -68,3 +75,78 @@ hexdump(FILE *fp,
                 fprintf(fp, "%s\n", line);
         }
 }
+
+static size_t
+get_page_size(void)
+{
+#ifdef _WIN32
+        SYSTEM_INFO si;
+
+        GetSystemInfo(&si);
+        return (size_t) si.dwPageSize;
+#else
+        return (size_t) sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/*
+ * @brief Allocates buffer that ends at a page with no access rights
+ *
+ * Any read past the end of the buffer causes an access violation.
+ *
+ * @param size  buffer size in bytes
+ *
+ * @return pointer to the buffer
+ * @retval NULL on allocation failure
+ */
+void *
+alloc_guarded_buf(const size_t size)
+{
+        const size_t page = get_page_size();
+        const size_t data_size = ((size + page - 1) / page) * page;
+        uint8_t *mem;
+#ifdef _WIN32
+        DWORD old;
+
+        mem = VirtualAlloc(NULL, data_size + page, MEM_COMMIT | MEM_RESERVE,
+                           PAGE_READWRITE);
+        if (mem == NULL)
+                return NULL;
+        if (!VirtualProtect(mem + data_size, page, PAGE_NOACCESS, &old)) {
+                VirtualFree(mem, 0, MEM_RELEASE);
+                return NULL;
+        }
+#else
+        mem = mmap(NULL, data_size + page, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED)
+                return NULL;
+        if (mprotect(mem + data_size, page, PROT_NONE) != 0) {
+                munmap(mem, data_size + page);
+                return NULL;
+        }
+#endif
+        return mem + data_size - size;
+}
+
+/*
+ * @brief Frees buffer allocated with alloc_guarded_buf()
+ *
+ * @param buf   pointer to the buffer
+ * @param size  buffer size in bytes, as passed to alloc_guarded_buf()
+ */
+void
+free_guarded_buf(void *buf, const size_t size)
+{
+        const size_t page = get_page_size();
+        const size_t data_size = ((size + page - 1) / page) * page;
+        uint8_t *mem = (uint8_t *) buf + size - data_size;
+
+        if (buf == NULL)
+                return;
+#ifdef _WIN32
+        VirtualFree(mem, 0, MEM_RELEASE);
+#else
+        munmap(mem, data_size + page);
+#endif
+}
@@ -32,4 +32,7 @@
 
 void hexdump(FILE *fp, const char *msg, const void *p, size_t len);
 
+void *alloc_guarded_buf(const size_t size);
+void free_guarded_buf(void *buf, const size_t size);
+
 #endif /* TESTAPP_UTILS_H */
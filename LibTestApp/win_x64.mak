@@ -63,7 +63,7 @@ XVALID_LFLAGS = /out:$(XVALID_APP).exe $(DLFLAGS)
 AS = nasm
 AFLAGS = -fwin64 -Xvc -DWIN_ABI
 
-TEST_OBJS = main.obj gcm_test.obj ctr_test.obj customop_test.obj des_test.obj ccm_test.obj cmac_test.obj hmac_sha1_test.obj hmac_sha256_sha512_test.obj utils.obj hmac_md5_test.obj aes_test.obj sha_test.obj chained_test.obj api_test.obj pon_test.obj ecb_test.obj zuc_test.obj kasumi_test.obj snow3g_test.obj direct_api_test.obj clear_mem_test.obj
+TEST_OBJS = main.obj gcm_test.obj ctr_test.obj customop_test.obj des_test.obj ccm_test.obj cmac_test.obj hmac_sha1_test.obj hmac_sha256_sha512_test.obj utils.obj hmac_md5_test.obj aes_test.obj sha_test.obj chained_test.obj api_test.obj pon_test.obj ecb_test.obj zuc_test.obj kasumi_test.obj snow3g_test.obj direct_api_test.obj clear_mem_test.obj burst_test.obj crc_test.obj
 
 XVALID_OBJS = ipsec_xvalid.obj misc.obj
 
@@ -126,7 +126,7 @@ sha_test.obj: sha_test.c utils.h
 chained_test.obj: chained_test.c utils.h
         $(CC) /c $(CFLAGS) chained_test.c
 
-api_test.obj: api_test.c gcm_ctr_vectors_test.h
+api_test.obj: api_test.c gcm_ctr_vectors_test.h utils.h
         $(CC) /c $(CFLAGS) api_test.c
 
 zuc_test.obj: zuc_test.c zuc_test_vectors.h
@@ -147,5 +147,11 @@ ipsec_xvalid.obj: ipsec_xvalid.c misc.h
 clear_mem_test.obj: clear_mem_test.c gcm_ctr_vectors_test.h
         $(CC) /c $(CFLAGS) clear_mem_test.c
 
+burst_test.obj: burst_test.c gcm_ctr_vectors_test.h utils.h
+        $(CC) /c $(CFLAGS) burst_test.c
+
+crc_test.obj: crc_test.c gcm_ctr_vectors_test.h utils.h
+        $(CC) /c $(CFLAGS) crc_test.c
+
 clean:
         del /q $(TEST_OBJS) $(TEST_APP).* $(XVALID_OBJS) $(XVALID_APP).*
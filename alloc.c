@@ -31,17 +31,21 @@
 #else
 #include <malloc.h> /* _aligned_malloc() and aligned_free() */
 #endif
+#include <stddef.h> /* offsetof() */
 #include <string.h>
 #include "intel-ipsec-mb.h"
 #include "ipsec_ooo_mgr.h"
 #include "cpu_feature.h"
 
+#define ALIGNMENT 64
+#define ALIGN(x, y) (((x) + ((y) - 1)) & ~((y) - 1))
+
 static void *
 alloc_aligned_mem(const size_t size)
 {
         void *ptr;
 
-        const size_t alignment = 64;
+        const size_t alignment = ALIGNMENT;
 #ifdef LINUX
         if (posix_memalign((void **)&ptr, alignment, size))
                 return NULL;
@@ -66,6 +70,180 @@ free_mem(void *ptr)
 #endif
 }
 
+#define OOO_INFO(name, type, algo) \
+        { offsetof(IMB_MGR, name), sizeof(type), algo }
+
+/*
+ * Out-of-order manager pointers in IMB_MGR, sizes of their structures
+ * and algorithm groups using them.
+ * Order of the table defines layout of the managers in memory,
+ * the most commonly used ones are kept together, next to IMB_MGR.
+ */
+static const struct {
+        size_t ptr_offset;
+        size_t size;
+        uint64_t algo;
+} ooo_mgr_table[] = {
+        OOO_INFO(aes128_ooo, MB_MGR_AES_OOO, IMB_ALGO_AES_CBC),
+        OOO_INFO(hmac_sha_1_ooo, MB_MGR_HMAC_SHA_1_OOO, IMB_ALGO_HMAC_SHA1),
+        OOO_INFO(hmac_sha_256_ooo, MB_MGR_HMAC_SHA_256_OOO, IMB_ALGO_HMAC_SHA2),
+        OOO_INFO(aes256_ooo, MB_MGR_AES_OOO, IMB_ALGO_AES_CBC),
+        OOO_INFO(aes128_gcm_ooo, MB_MGR_GCM_OOO, IMB_ALGO_AES_GCM),
+        OOO_INFO(aes256_gcm_ooo, MB_MGR_GCM_OOO, IMB_ALGO_AES_GCM),
+        OOO_INFO(aes128_cntr_ooo, MB_MGR_AES_OOO, IMB_ALGO_AES_CTR),
+        OOO_INFO(aes256_cntr_ooo, MB_MGR_AES_OOO, IMB_ALGO_AES_CTR),
+        OOO_INFO(hmac_sha_1_ni_ooo, MB_MGR_HMAC_SHA_1_OOO, IMB_ALGO_HMAC_SHA1),
+        OOO_INFO(hmac_sha_256_ni_ooo, MB_MGR_HMAC_SHA_256_OOO,
+                 IMB_ALGO_HMAC_SHA2),
+        OOO_INFO(hmac_sha_384_ooo, MB_MGR_HMAC_SHA_512_OOO, IMB_ALGO_HMAC_SHA2),
+        OOO_INFO(hmac_sha_512_ooo, MB_MGR_HMAC_SHA_512_OOO, IMB_ALGO_HMAC_SHA2),
+        OOO_INFO(aes_xcbc_ooo, MB_MGR_AES_XCBC_OOO, IMB_ALGO_AES_XCBC),
+        OOO_INFO(aes192_ooo, MB_MGR_AES_OOO, IMB_ALGO_AES_CBC),
+        OOO_INFO(aes192_cntr_ooo, MB_MGR_AES_OOO, IMB_ALGO_AES_CTR),
+        OOO_INFO(aes192_gcm_ooo, MB_MGR_GCM_OOO, IMB_ALGO_AES_GCM),
+        OOO_INFO(hmac_sha_224_ooo, MB_MGR_HMAC_SHA_256_OOO, IMB_ALGO_HMAC_SHA2),
+        OOO_INFO(hmac_sha_224_ni_ooo, MB_MGR_HMAC_SHA_256_OOO,
+                 IMB_ALGO_HMAC_SHA2),
+        OOO_INFO(hmac_md5_ooo, MB_MGR_HMAC_MD5_OOO, IMB_ALGO_HMAC_MD5),
+        OOO_INFO(aes_ccm_ooo, MB_MGR_CCM_OOO, IMB_ALGO_AES_CCM),
+        OOO_INFO(aes_cmac_ooo, MB_MGR_CMAC_OOO, IMB_ALGO_AES_CMAC),
+        OOO_INFO(docsis128_sec_ooo, MB_MGR_DOCSIS_AES_OOO, IMB_ALGO_DOCSIS),
+        OOO_INFO(docsis128_crc32_sec_ooo, MB_MGR_DOCSIS_AES_OOO,
+                 IMB_ALGO_DOCSIS),
+        OOO_INFO(docsis256_sec_ooo, MB_MGR_DOCSIS_AES_OOO, IMB_ALGO_DOCSIS),
+        OOO_INFO(docsis256_crc32_sec_ooo, MB_MGR_DOCSIS_AES_OOO,
+                 IMB_ALGO_DOCSIS),
+        OOO_INFO(des_enc_ooo, MB_MGR_DES_OOO, IMB_ALGO_DES),
+        OOO_INFO(des_dec_ooo, MB_MGR_DES_OOO, IMB_ALGO_DES),
+        OOO_INFO(des3_enc_ooo, MB_MGR_DES_OOO, IMB_ALGO_DES),
+        OOO_INFO(des3_dec_ooo, MB_MGR_DES_OOO, IMB_ALGO_DES),
+        OOO_INFO(docsis_des_enc_ooo, MB_MGR_DES_OOO, IMB_ALGO_DOCSIS),
+        OOO_INFO(docsis_des_dec_ooo, MB_MGR_DES_OOO, IMB_ALGO_DOCSIS),
+        OOO_INFO(zuc_eea3_ooo, MB_MGR_ZUC_OOO, IMB_ALGO_ZUC),
+        OOO_INFO(zuc_eia3_ooo, MB_MGR_ZUC_OOO, IMB_ALGO_ZUC),
+        OOO_INFO(snow3g_uea2_ooo, MB_MGR_SNOW3G_OOO, IMB_ALGO_SNOW3G),
+        OOO_INFO(snow3g_uia2_ooo, MB_MGR_SNOW3G_OOO, IMB_ALGO_SNOW3G),
+        OOO_INFO(kasumi_uea1_ooo, MB_MGR_KASUMI_OOO, IMB_ALGO_KASUMI),
+        OOO_INFO(kasumi_uia1_ooo, MB_MGR_KASUMI_OOO, IMB_ALGO_KASUMI),
+        OOO_INFO(sha_1_ooo, MB_MGR_SHA_OOO, IMB_ALGO_SHA),
+        OOO_INFO(sha_224_ooo, MB_MGR_SHA_OOO, IMB_ALGO_SHA),
+        OOO_INFO(sha_256_ooo, MB_MGR_SHA_OOO, IMB_ALGO_SHA),
+        OOO_INFO(sha_384_ooo, MB_MGR_SHA_OOO, IMB_ALGO_SHA),
+        OOO_INFO(sha_512_ooo, MB_MGR_SHA_OOO, IMB_ALGO_SHA),
+        OOO_INFO(pon_enc_ooo, MB_MGR_PON_OOO, IMB_ALGO_PON),
+        OOO_INFO(pon_dec_ooo, MB_MGR_PON_OOO, IMB_ALGO_PON),
+        OOO_INFO(docsis128_dec_ooo, MB_MGR_DOCSIS_AES_OOO, IMB_ALGO_DOCSIS),
+        OOO_INFO(docsis256_dec_ooo, MB_MGR_DOCSIS_AES_OOO, IMB_ALGO_DOCSIS),
+#ifdef MB_STATS
+        /* performance counters, with any algorithm group selected */
+        OOO_INFO(stats, MB_MGR_STATS, IMB_ALGO_ALL),
+#endif
+};
+
+/**
+ * @brief Calculates necessary memory size for IMB_MGR
+ *        with out-of-order managers for selected algorithms
+ *
+ * @param algos algorithm groups (IMB_ALGO_xxx)
+ *
+ * @return Size for IMB_MGR (aligned to 64 bytes)
+ */
+size_t imb_get_mb_mgr_size_algos(const uint64_t algos)
+{
+        size_t size = ALIGN(sizeof(IMB_MGR), ALIGNMENT);
+        unsigned i;
+
+        for (i = 0; i < IMB_DIM(ooo_mgr_table); i++)
+                if (ooo_mgr_table[i].algo & algos)
+                        size += ALIGN(ooo_mgr_table[i].size, ALIGNMENT);
+
+        return size;
+}
+
+/**
+ * @brief Calculates necessary memory size for IMB_MGR.
+ *
+ * @return Size for IMB_MGR (aligned to 64 bytes)
+ */
+size_t imb_get_mb_mgr_size(void)
+{
+        return imb_get_mb_mgr_size_algos(IMB_ALGO_ALL);
+}
+
+/**
+ * @brief Initializes IMB_MGR pointers to out-of-order managers
+ *        of selected algorithms
+ *
+ * IMB_MGR and out-of-order managers are placed in
+ * the contiguous memory block provided by the caller.
+ * Pointers to managers of unselected algorithms are set to NULL.
+ *
+ * @param mem_ptr   pointer to 64 byte aligned memory
+ *                  of imb_get_mb_mgr_size_algos() bytes
+ * @param flags     multi-buffer manager flags
+ * @param reset_mgr if non-zero, memory block gets zeroed first
+ * @param algos     algorithm groups (IMB_ALGO_xxx)
+ *
+ * @return Pointer to IMB_MGR structure (equal to \a mem_ptr)
+ * @retval NULL on invalid parameters
+ */
+IMB_MGR *imb_set_pointers_mb_mgr_algos(void *mem_ptr, const uint64_t flags,
+                                       const unsigned reset_mgr,
+                                       const uint64_t algos)
+{
+        IMB_MGR *ptr = (IMB_MGR *) mem_ptr;
+        uint8_t *ooo_ptr = (uint8_t *) mem_ptr;
+        unsigned i;
+
+        if (mem_ptr == NULL || ((uintptr_t) mem_ptr & (ALIGNMENT - 1)))
+                return NULL;
+
+        if (reset_mgr)
+                memset(mem_ptr, 0, imb_get_mb_mgr_size_algos(algos));
+
+        ptr->flags = flags; /* save the flags for future use in init */
+        ptr->features = cpu_feature_adjust(flags, cpu_feature_detect());
+        ptr->algos = algos & IMB_ALGO_ALL;
+
+        ptr->stats = NULL;
+        ooo_ptr += ALIGN(sizeof(IMB_MGR), ALIGNMENT);
+        for (i = 0; i < IMB_DIM(ooo_mgr_table); i++) {
+                void **ooo_mgr =
+                        (void **) ((uint8_t *) ptr +
+                                   ooo_mgr_table[i].ptr_offset);
+
+                if (!(ooo_mgr_table[i].algo & algos)) {
+                        *ooo_mgr = NULL;
+                        continue;
+                }
+                *ooo_mgr = ooo_ptr;
+                ooo_ptr += ALIGN(ooo_mgr_table[i].size, ALIGNMENT);
+        }
+
+        return ptr;
+}
+
+/**
+ * @brief Initializes IMB_MGR pointers to out-of-order managers
+ *
+ * IMB_MGR and all out-of-order managers are placed in
+ * the contiguous memory block provided by the caller.
+ *
+ * @param mem_ptr   pointer to 64 byte aligned memory
+ *                  of imb_get_mb_mgr_size() bytes
+ * @param flags     multi-buffer manager flags
+ * @param reset_mgr if non-zero, memory block gets zeroed first
+ *
+ * @return Pointer to IMB_MGR structure (equal to \a mem_ptr)
+ * @retval NULL on invalid parameters
+ */
+IMB_MGR *imb_set_pointers_mb_mgr(void *mem_ptr, const uint64_t flags,
+                                 const unsigned reset_mgr)
+{
+        return imb_set_pointers_mb_mgr_algos(mem_ptr, flags, reset_mgr,
+                                             IMB_ALGO_ALL);
+}
+
 /**
  * @brief Allocates memory for multi-buffer manager instance
  *
@@ -81,137 +259,36 @@ free_mem(void *ptr)
  */
 IMB_MGR *alloc_mb_mgr(uint64_t flags)
 {
-        IMB_MGR *ptr = NULL;
+        return alloc_mb_mgr_algos(flags, IMB_ALGO_ALL);
+}
+
+/**
+ * @brief Allocates memory for multi-buffer manager instance
+ *        with out-of-order managers for selected algorithms only
+ *
+ * @param flags multi-buffer manager flags (see alloc_mb_mgr())
+ * @param algos algorithm groups (IMB_ALGO_xxx)
+ *
+ * @return Pointer to allocated memory for MB_MGR structure
+ * @retval NULL on allocation error
+ */
+IMB_MGR *alloc_mb_mgr_algos(uint64_t flags, uint64_t algos)
+{
+        void *ptr = alloc_aligned_mem(imb_get_mb_mgr_size_algos(algos));
 
-        ptr = alloc_aligned_mem(sizeof(IMB_MGR));
         IMB_ASSERT(ptr != NULL);
-        if (ptr != NULL) {
-                ptr->flags = flags; /* save the flags for future use in init */
-                ptr->features = cpu_feature_adjust(flags, cpu_feature_detect());
-        } else
+        if (ptr == NULL)
                 return NULL;
 
-
-        /* Allocate memory for OOO */
-        ptr->aes128_ooo = alloc_aligned_mem(sizeof(MB_MGR_AES_OOO));
-        if (ptr->aes128_ooo == NULL)
-                goto exit_fail;
-        ptr->aes192_ooo = alloc_aligned_mem(sizeof(MB_MGR_AES_OOO));
-        if (ptr->aes192_ooo == NULL)
-                goto exit_fail;
-        ptr->aes256_ooo = alloc_aligned_mem(sizeof(MB_MGR_AES_OOO));
-        if (ptr->aes256_ooo == NULL)
-                goto exit_fail;
-        ptr->docsis128_sec_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_DOCSIS_AES_OOO));
-        if (ptr->docsis128_sec_ooo == NULL)
-                goto exit_fail;
-        ptr->docsis128_crc32_sec_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_DOCSIS_AES_OOO));
-        if (ptr->docsis128_crc32_sec_ooo == NULL)
-                goto exit_fail;
-        ptr->docsis256_sec_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_DOCSIS_AES_OOO));
-        if (ptr->docsis256_sec_ooo == NULL)
-                goto exit_fail;
-        ptr->docsis256_crc32_sec_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_DOCSIS_AES_OOO));
-        if (ptr->docsis256_crc32_sec_ooo == NULL)
-                goto exit_fail;
-        ptr->des_enc_ooo = alloc_aligned_mem(sizeof(MB_MGR_DES_OOO));
-        if (ptr->des_enc_ooo == NULL)
-                goto exit_fail;
-        ptr->des_dec_ooo = alloc_aligned_mem(sizeof(MB_MGR_DES_OOO));
-        if (ptr->des_dec_ooo == NULL)
-                goto exit_fail;
-        ptr->des3_enc_ooo = alloc_aligned_mem(sizeof(MB_MGR_DES_OOO));
-        if (ptr->des3_enc_ooo == NULL)
-                goto exit_fail;
-        ptr->des3_dec_ooo = alloc_aligned_mem(sizeof(MB_MGR_DES_OOO));
-        if (ptr->des3_dec_ooo == NULL)
-                goto exit_fail;
-        ptr->docsis_des_enc_ooo = alloc_aligned_mem(sizeof(MB_MGR_DES_OOO));
-        if (ptr->docsis_des_enc_ooo == NULL)
-                goto exit_fail;
-        ptr->docsis_des_dec_ooo = alloc_aligned_mem(sizeof(MB_MGR_DES_OOO));
-        if (ptr->docsis_des_dec_ooo == NULL)
-                goto exit_fail;
-        ptr->zuc_eea3_ooo = alloc_aligned_mem(sizeof(MB_MGR_ZUC_OOO));
-        if (ptr->zuc_eea3_ooo == NULL)
-                goto exit_fail;
-
-        ptr->hmac_sha_1_ooo = alloc_aligned_mem(sizeof(MB_MGR_HMAC_SHA_1_OOO));
-        if (ptr->hmac_sha_1_ooo == NULL)
-                goto exit_fail;
-        ptr->hmac_sha_224_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_HMAC_SHA_256_OOO));
-        if (ptr->hmac_sha_224_ooo == NULL)
-                goto exit_fail;
-        ptr->hmac_sha_256_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_HMAC_SHA_256_OOO));
-        if (ptr->hmac_sha_256_ooo == NULL)
-                goto exit_fail;
-        ptr->hmac_sha_384_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_HMAC_SHA_512_OOO));
-        if (ptr->hmac_sha_384_ooo == NULL)
-                goto exit_fail;
-        ptr->hmac_sha_512_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_HMAC_SHA_512_OOO));
-        if (ptr->hmac_sha_512_ooo == NULL)
-                goto exit_fail;
-        ptr->hmac_md5_ooo =
-                alloc_aligned_mem(sizeof(MB_MGR_HMAC_MD5_OOO));
-        if (ptr->hmac_md5_ooo == NULL)
-                goto exit_fail;
-        ptr->aes_xcbc_ooo = alloc_aligned_mem(sizeof(MB_MGR_AES_XCBC_OOO));
-        if (ptr->aes_xcbc_ooo == NULL)
-                goto exit_fail;
-        ptr->aes_ccm_ooo = alloc_aligned_mem(sizeof(MB_MGR_CCM_OOO));
-        if (ptr->aes_ccm_ooo == NULL)
-                goto exit_fail;
-        ptr->aes_cmac_ooo = alloc_aligned_mem(sizeof(MB_MGR_CMAC_OOO));
-        if (ptr->aes_cmac_ooo == NULL)
-                goto exit_fail;
-        ptr->zuc_eia3_ooo = alloc_aligned_mem(sizeof(MB_MGR_ZUC_OOO));
-        if (ptr->zuc_eia3_ooo == NULL)
-                goto exit_fail;
-
-        return ptr;
-
-exit_fail:
-        free_mem(ptr->aes128_ooo);
-        free_mem(ptr->aes192_ooo);
-        free_mem(ptr->aes256_ooo);
-        free_mem(ptr->docsis128_sec_ooo);
-        free_mem(ptr->docsis128_crc32_sec_ooo);
-        free_mem(ptr->docsis256_sec_ooo);
-        free_mem(ptr->docsis256_crc32_sec_ooo);
-        free_mem(ptr->des_enc_ooo);
-        free_mem(ptr->des_dec_ooo);
-        free_mem(ptr->des3_enc_ooo);
-        free_mem(ptr->des3_dec_ooo);
-        free_mem(ptr->docsis_des_enc_ooo);
-        free_mem(ptr->docsis_des_dec_ooo);
-        free_mem(ptr->zuc_eea3_ooo);
-
-        free_mem(ptr->hmac_sha_1_ooo);
-        free_mem(ptr->hmac_sha_224_ooo);
-        free_mem(ptr->hmac_sha_256_ooo);
-        free_mem(ptr->hmac_sha_384_ooo);
-        free_mem(ptr->hmac_sha_512_ooo);
-        free_mem(ptr->hmac_md5_ooo);
-        free_mem(ptr->aes_xcbc_ooo);
-        free_mem(ptr->aes_ccm_ooo);
-        free_mem(ptr->aes_cmac_ooo);
-        free_mem(ptr->zuc_eia3_ooo);
-        free(ptr);
-
-        return NULL;
+        return imb_set_pointers_mb_mgr_algos(ptr, flags, 0, algos);
 }
 
 /**
  * @brief Frees memory allocated previously by alloc_mb_mgr()
  *
+ * Out-of-order managers are allocated together with IMB_MGR
+ * so a single block of memory is released.
+ *
  * @param ptr a pointer to allocated MB_MGR structure
  *
  */
@@ -219,35 +296,70 @@ void free_mb_mgr(IMB_MGR *ptr)
 {
         IMB_ASSERT(ptr != NULL);
 
-        /* Free memory for OOO */
-        if (ptr != NULL) {
-                free_mem(ptr->aes128_ooo);
-                free_mem(ptr->aes192_ooo);
-                free_mem(ptr->aes256_ooo);
-                free_mem(ptr->docsis128_sec_ooo);
-                free_mem(ptr->docsis128_crc32_sec_ooo);
-                free_mem(ptr->docsis256_sec_ooo);
-                free_mem(ptr->docsis256_crc32_sec_ooo);
-                free_mem(ptr->des_enc_ooo);
-                free_mem(ptr->des_dec_ooo);
-                free_mem(ptr->des3_enc_ooo);
-                free_mem(ptr->des3_dec_ooo);
-                free_mem(ptr->docsis_des_enc_ooo);
-                free_mem(ptr->docsis_des_dec_ooo);
-                free_mem(ptr->zuc_eea3_ooo);
-
-                free_mem(ptr->hmac_sha_1_ooo);
-                free_mem(ptr->hmac_sha_224_ooo);
-                free_mem(ptr->hmac_sha_256_ooo);
-                free_mem(ptr->hmac_sha_384_ooo);
-                free_mem(ptr->hmac_sha_512_ooo);
-                free_mem(ptr->hmac_md5_ooo);
-                free_mem(ptr->aes_xcbc_ooo);
-                free_mem(ptr->aes_ccm_ooo);
-                free_mem(ptr->aes_cmac_ooo);
-                free_mem(ptr->zuc_eia3_ooo);
-        }
-
-        /* Free IMB_MGR */
+        /* Free IMB_MGR and OOO managers */
         free_mem(ptr);
 }
+
+/**
+ * @brief Sets latency budget of jobs waiting in partially filled lanes
+ *
+ * @param state      pointer to initialized IMB_MGR structure
+ * @param max_jobs   budget in submitted jobs, 0 - no limit
+ * @param max_cycles budget in TSC cycles, 0 - no limit
+ *
+ * @return 0 on success, -1 on invalid parameters
+ */
+int imb_set_flush_budget(IMB_MGR *state, const uint32_t max_jobs,
+                         const uint64_t max_cycles)
+{
+        if (state == NULL)
+                return -1;
+
+        /* one slot of the job queue is always free */
+        if (max_jobs >= MAX_JOBS - 1)
+                return -1;
+
+        state->flush_budget_jobs = max_jobs;
+        state->flush_budget_cycles = max_cycles;
+        return 0;
+}
+
+/**
+ * @brief Retrieves performance counters of multi-buffer manager
+ *
+ * @param state pointer to IMB_MGR structure
+ * @param stats pointer to structure to store the counters in
+ *
+ * @return 0 on success, -1 on invalid parameters
+ *         or when counters are not available
+ */
+int imb_get_mb_mgr_stats(const IMB_MGR *state, IMB_MGR_STATS *stats)
+{
+        if (state == NULL || stats == NULL || state->stats == NULL)
+                return -1;
+
+        memcpy(stats, &((const MB_MGR_STATS *) state->stats)->pub,
+               sizeof(*stats));
+        return 0;
+}
+
+/**
+ * @brief Clears performance counters of multi-buffer manager
+ *
+ * Jobs in flight remain accounted for, so that lane occupancy
+ * stays correct.
+ *
+ * @param state pointer to IMB_MGR structure
+ *
+ * @return 0 on success, -1 on invalid parameters
+ *         or when counters are not available
+ */
+int imb_reset_mb_mgr_stats(IMB_MGR *state)
+{
+        if (state == NULL || state->stats == NULL)
+                return -1;
+
+        memset(&((MB_MGR_STATS *) state->stats)->pub, 0,
+               sizeof(IMB_MGR_STATS));
+        return 0;
+}
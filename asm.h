@@ -189,6 +189,19 @@ void aes_ecb_dec_192_avx(const void *in, const void *keys,
 void aes_ecb_dec_128_avx(const void *in, const void *keys,
                          void *out, uint64_t len_bytes);
 
+void aes_ecb_enc_256_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_enc_192_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_enc_128_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_dec_256_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_dec_192_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_dec_128_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+
 /* AES128-ECBENC */
 void aes128_ecbenc_x3_sse(const void *in, void *keys,
                           void *out1, void *out2, void *out3);
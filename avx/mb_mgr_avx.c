@@ -36,6 +36,7 @@
 #include "include/kasumi_internal.h"
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
+#include "include/crc.h"
 #include "include/gcm.h"
 
 #include "save_xmms.h"
@@ -72,6 +73,65 @@ IMB_JOB *submit_job_zuc_eia3_avx(MB_MGR_ZUC_OOO *state,
                                         IMB_JOB *job);
 IMB_JOB *flush_job_zuc_eia3_avx(MB_MGR_ZUC_OOO *state);
 
+IMB_JOB *submit_job_aes128_cntr_avx(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes128_cntr_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes192_cntr_avx(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes192_cntr_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes256_cntr_avx(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes256_cntr_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes128_gcm_avx(MB_MGR_GCM_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_aes128_gcm_avx(MB_MGR_GCM_OOO *state);
+IMB_JOB *submit_job_aes192_gcm_avx(MB_MGR_GCM_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_aes192_gcm_avx(MB_MGR_GCM_OOO *state);
+IMB_JOB *submit_job_aes256_gcm_avx(MB_MGR_GCM_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_aes256_gcm_avx(MB_MGR_GCM_OOO *state);
+IMB_JOB *submit_job_snow3g_uea2_avx(MB_MGR_SNOW3G_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_snow3g_uea2_avx(MB_MGR_SNOW3G_OOO *state);
+IMB_JOB *submit_job_snow3g_uia2_avx(MB_MGR_SNOW3G_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_snow3g_uia2_avx(MB_MGR_SNOW3G_OOO *state);
+IMB_JOB *submit_job_kasumi_uea1_avx(MB_MGR_KASUMI_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_kasumi_uea1_avx(MB_MGR_KASUMI_OOO *state);
+IMB_JOB *submit_job_kasumi_uia1_avx(MB_MGR_KASUMI_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_kasumi_uia1_avx(MB_MGR_KASUMI_OOO *state);
+IMB_JOB *submit_job_des_cbc_enc_avx(MB_MGR_DES_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_enc_avx(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_des_cbc_dec_avx(MB_MGR_DES_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_dec_avx(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_3des_cbc_enc_avx(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_enc_avx(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_3des_cbc_dec_avx(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_dec_avx(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_docsis_des_enc_avx(MB_MGR_DES_OOO *state,
+                                       IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_enc_avx(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_docsis_des_dec_avx(MB_MGR_DES_OOO *state,
+                                       IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_dec_avx(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_sha1_avx(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha1_avx(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha224_avx(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha224_avx(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha256_avx(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha256_avx(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha384_avx(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha384_avx(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha512_avx(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha512_avx(MB_MGR_SHA_OOO *state);
+
 #define SAVE_XMMS               save_xmms_avx
 #define RESTORE_XMMS            restore_xmms_avx
 
@@ -93,6 +153,49 @@ IMB_JOB *flush_job_zuc_eia3_avx(MB_MGR_ZUC_OOO *state);
 
 #define SUBMIT_JOB_AES_CNTR   submit_job_aes_cntr_avx
 #define SUBMIT_JOB_AES_CNTR_BIT   submit_job_aes_cntr_bit_avx
+#define SUBMIT_JOB_AES128_CNTR submit_job_aes128_cntr_avx
+#define FLUSH_JOB_AES128_CNTR  flush_job_aes128_cntr_avx
+#define SUBMIT_JOB_AES192_CNTR submit_job_aes192_cntr_avx
+#define FLUSH_JOB_AES192_CNTR  flush_job_aes192_cntr_avx
+#define SUBMIT_JOB_AES256_CNTR submit_job_aes256_cntr_avx
+#define FLUSH_JOB_AES256_CNTR  flush_job_aes256_cntr_avx
+#define SUBMIT_JOB_AES128_GCM submit_job_aes128_gcm_avx
+#define FLUSH_JOB_AES128_GCM  flush_job_aes128_gcm_avx
+#define SUBMIT_JOB_AES192_GCM submit_job_aes192_gcm_avx
+#define FLUSH_JOB_AES192_GCM  flush_job_aes192_gcm_avx
+#define SUBMIT_JOB_AES256_GCM submit_job_aes256_gcm_avx
+#define FLUSH_JOB_AES256_GCM  flush_job_aes256_gcm_avx
+#define SUBMIT_JOB_SNOW3G_UEA2 submit_job_snow3g_uea2_avx
+#define FLUSH_JOB_SNOW3G_UEA2  flush_job_snow3g_uea2_avx
+#define SUBMIT_JOB_SNOW3G_UIA2 submit_job_snow3g_uia2_avx
+#define FLUSH_JOB_SNOW3G_UIA2  flush_job_snow3g_uia2_avx
+#define SUBMIT_JOB_KASUMI_UEA1 submit_job_kasumi_uea1_avx
+#define FLUSH_JOB_KASUMI_UEA1  flush_job_kasumi_uea1_avx
+#define SUBMIT_JOB_KASUMI_UIA1 submit_job_kasumi_uia1_avx
+#define FLUSH_JOB_KASUMI_UIA1  flush_job_kasumi_uia1_avx
+
+#define SUBMIT_JOB_DES_CBC_ENC submit_job_des_cbc_enc_avx
+#define FLUSH_JOB_DES_CBC_ENC  flush_job_des_cbc_enc_avx
+#define SUBMIT_JOB_DES_CBC_DEC submit_job_des_cbc_dec_avx
+#define FLUSH_JOB_DES_CBC_DEC  flush_job_des_cbc_dec_avx
+#define SUBMIT_JOB_3DES_CBC_ENC submit_job_3des_cbc_enc_avx
+#define FLUSH_JOB_3DES_CBC_ENC  flush_job_3des_cbc_enc_avx
+#define SUBMIT_JOB_3DES_CBC_DEC submit_job_3des_cbc_dec_avx
+#define FLUSH_JOB_3DES_CBC_DEC  flush_job_3des_cbc_dec_avx
+#define SUBMIT_JOB_DOCSIS_DES_ENC submit_job_docsis_des_enc_avx
+#define FLUSH_JOB_DOCSIS_DES_ENC  flush_job_docsis_des_enc_avx
+#define SUBMIT_JOB_DOCSIS_DES_DEC submit_job_docsis_des_dec_avx
+#define FLUSH_JOB_DOCSIS_DES_DEC  flush_job_docsis_des_dec_avx
+#define SUBMIT_JOB_SHA1    submit_job_sha1_avx
+#define FLUSH_JOB_SHA1     flush_job_sha1_avx
+#define SUBMIT_JOB_SHA224  submit_job_sha224_avx
+#define FLUSH_JOB_SHA224   flush_job_sha224_avx
+#define SUBMIT_JOB_SHA256  submit_job_sha256_avx
+#define FLUSH_JOB_SHA256   flush_job_sha256_avx
+#define SUBMIT_JOB_SHA384  submit_job_sha384_avx
+#define FLUSH_JOB_SHA384   flush_job_sha384_avx
+#define SUBMIT_JOB_SHA512  submit_job_sha512_avx
+#define FLUSH_JOB_SHA512   flush_job_sha512_avx
 
 #define SUBMIT_JOB_ZUC_EEA3   submit_job_zuc_eea3_avx
 #define FLUSH_JOB_ZUC_EEA3    flush_job_zuc_eea3_avx
@@ -209,6 +312,11 @@ IMB_JOB *flush_job_aes_ccm_auth_avx(MB_MGR_CCM_OOO *state);
 #define SUBMIT_JOB_NOCHECK submit_job_nocheck_avx
 #define GET_NEXT_JOB       get_next_job_avx
 #define GET_COMPLETED_JOB  get_completed_job_avx
+#define GET_NEXT_BURST       get_next_burst_avx
+#define SUBMIT_BURST         submit_burst_avx
+#define SUBMIT_BURST_NOCHECK submit_burst_nocheck_avx
+#define GET_COMPLETED_BURST  get_completed_burst_avx
+#define FLUSH_BURST          flush_burst_avx
 
 /* ====================================================================== */
 
@@ -437,6 +545,27 @@ init_mb_mgr_avx(IMB_MGR *state)
         MB_MGR_CMAC_OOO *aes_cmac_ooo = state->aes_cmac_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
+        MB_MGR_AES_OOO *aes128_cntr_ooo = state->aes128_cntr_ooo;
+        MB_MGR_AES_OOO *aes192_cntr_ooo = state->aes192_cntr_ooo;
+        MB_MGR_AES_OOO *aes256_cntr_ooo = state->aes256_cntr_ooo;
+        MB_MGR_GCM_OOO *aes128_gcm_ooo = state->aes128_gcm_ooo;
+        MB_MGR_GCM_OOO *aes192_gcm_ooo = state->aes192_gcm_ooo;
+        MB_MGR_GCM_OOO *aes256_gcm_ooo = state->aes256_gcm_ooo;
+        MB_MGR_SNOW3G_OOO *snow3g_uea2_ooo = state->snow3g_uea2_ooo;
+        MB_MGR_SNOW3G_OOO *snow3g_uia2_ooo = state->snow3g_uia2_ooo;
+        MB_MGR_KASUMI_OOO *kasumi_uea1_ooo = state->kasumi_uea1_ooo;
+        MB_MGR_KASUMI_OOO *kasumi_uia1_ooo = state->kasumi_uia1_ooo;
+        MB_MGR_DES_OOO *des_enc_ooo = state->des_enc_ooo;
+        MB_MGR_DES_OOO *des_dec_ooo = state->des_dec_ooo;
+        MB_MGR_DES_OOO *des3_enc_ooo = state->des3_enc_ooo;
+        MB_MGR_DES_OOO *des3_dec_ooo = state->des3_dec_ooo;
+        MB_MGR_DES_OOO *docsis_des_enc_ooo = state->docsis_des_enc_ooo;
+        MB_MGR_DES_OOO *docsis_des_dec_ooo = state->docsis_des_dec_ooo;
+        MB_MGR_SHA_OOO *sha_1_ooo = state->sha_1_ooo;
+        MB_MGR_SHA_OOO *sha_224_ooo = state->sha_224_ooo;
+        MB_MGR_SHA_OOO *sha_256_ooo = state->sha_256_ooo;
+        MB_MGR_SHA_OOO *sha_384_ooo = state->sha_384_ooo;
+        MB_MGR_SHA_OOO *sha_512_ooo = state->sha_512_ooo;
 
 
         state->features = cpu_feature_adjust(state->flags,
@@ -447,311 +576,465 @@ init_mb_mgr_avx(IMB_MGR *state)
                 return;
         }
 
-            /* Init AES out-of-order fields */
-        memset(aes128_ooo->lens, 0xFF,
-               sizeof(aes128_ooo->lens));
-        memset(&aes128_ooo->lens[0], 0,
-               sizeof(aes128_ooo->lens[0]) * 8);
-        memset(aes128_ooo->job_in_lane, 0,
-               sizeof(aes128_ooo->job_in_lane));
-        aes128_ooo->unused_lanes = 0xF76543210;
-        aes128_ooo->num_lanes_inuse = 0;
-
-        memset(aes192_ooo->lens, 0xFF,
-               sizeof(aes192_ooo->lens));
-        memset(&aes192_ooo->lens[0], 0,
-               sizeof(aes192_ooo->lens[0]) * 8);
-        memset(aes192_ooo->job_in_lane, 0,
-               sizeof(aes192_ooo->job_in_lane));
-        aes192_ooo->unused_lanes = 0xF76543210;
-        aes192_ooo->num_lanes_inuse = 0;
-
-        memset(&aes256_ooo->lens, 0xFF,
-               sizeof(aes256_ooo->lens));
-        memset(&aes256_ooo->lens[0], 0,
-               sizeof(aes256_ooo->lens[0]) * 8);
-        memset(aes256_ooo->job_in_lane, 0,
-               sizeof(aes256_ooo->job_in_lane));
-        aes256_ooo->unused_lanes = 0xF76543210;
-        aes256_ooo->num_lanes_inuse = 0;
+        /* Init AES out-of-order fields */
+        if (state->algos & IMB_ALGO_AES_CBC) {
+                memset(aes128_ooo->lens, 0xFF,
+                       sizeof(aes128_ooo->lens));
+                memset(&aes128_ooo->lens[0], 0,
+                       sizeof(aes128_ooo->lens[0]) * 8);
+                memset(aes128_ooo->job_in_lane, 0,
+                       sizeof(aes128_ooo->job_in_lane));
+                aes128_ooo->unused_lanes = 0xF76543210;
+                aes128_ooo->num_lanes_inuse = 0;
+
+                memset(aes192_ooo->lens, 0xFF,
+                       sizeof(aes192_ooo->lens));
+                memset(&aes192_ooo->lens[0], 0,
+                       sizeof(aes192_ooo->lens[0]) * 8);
+                memset(aes192_ooo->job_in_lane, 0,
+                       sizeof(aes192_ooo->job_in_lane));
+                aes192_ooo->unused_lanes = 0xF76543210;
+                aes192_ooo->num_lanes_inuse = 0;
+
+                memset(&aes256_ooo->lens, 0xFF,
+                       sizeof(aes256_ooo->lens));
+                memset(&aes256_ooo->lens[0], 0,
+                       sizeof(aes256_ooo->lens[0]) * 8);
+                memset(aes256_ooo->job_in_lane, 0,
+                       sizeof(aes256_ooo->job_in_lane));
+                aes256_ooo->unused_lanes = 0xF76543210;
+                aes256_ooo->num_lanes_inuse = 0;
+        }
 
         /* DOCSIS SEC BPI (AES CBC + AES CFB for partial block)
          * uses same settings as AES CBC.
          */
-        memset(docsis128_sec_ooo->lens, 0xFF,
-               sizeof(docsis128_sec_ooo->lens));
-        memset(&docsis128_sec_ooo->lens[0], 0,
-               sizeof(docsis128_sec_ooo->lens[0]) * 8);
-        memset(docsis128_sec_ooo->job_in_lane, 0,
-               sizeof(docsis128_sec_ooo->job_in_lane));
-        docsis128_sec_ooo->unused_lanes = 0xF76543210;
-        docsis128_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis128_crc32_sec_ooo->lens, 0xFF,
-               sizeof(docsis128_crc32_sec_ooo->lens));
-        memset(&docsis128_crc32_sec_ooo->lens[0], 0,
-               sizeof(docsis128_crc32_sec_ooo->lens[0]) * 8);
-        memset(docsis128_crc32_sec_ooo->job_in_lane, 0,
-               sizeof(docsis128_crc32_sec_ooo->job_in_lane));
-        docsis128_crc32_sec_ooo->unused_lanes = 0xF76543210;
-        docsis128_crc32_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis256_sec_ooo->lens, 0xFF,
-               sizeof(docsis256_sec_ooo->lens));
-        memset(&docsis256_sec_ooo->lens[0], 0,
-               sizeof(docsis256_sec_ooo->lens[0]) * 8);
-        memset(docsis256_sec_ooo->job_in_lane, 0,
-               sizeof(docsis256_sec_ooo->job_in_lane));
-        docsis256_sec_ooo->unused_lanes = 0xF76543210;
-        docsis256_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis256_crc32_sec_ooo->lens, 0xFF,
-               sizeof(docsis256_crc32_sec_ooo->lens));
-        memset(&docsis256_crc32_sec_ooo->lens[0], 0,
-               sizeof(docsis256_crc32_sec_ooo->lens[0]) * 8);
-        memset(docsis256_crc32_sec_ooo->job_in_lane, 0,
-               sizeof(docsis256_crc32_sec_ooo->job_in_lane));
-        docsis256_crc32_sec_ooo->unused_lanes = 0xF76543210;
-        docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_DOCSIS) {
+                memset(docsis128_sec_ooo->lens, 0xFF,
+                       sizeof(docsis128_sec_ooo->lens));
+                memset(&docsis128_sec_ooo->lens[0], 0,
+                       sizeof(docsis128_sec_ooo->lens[0]) * 8);
+                memset(docsis128_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_sec_ooo->job_in_lane));
+                docsis128_sec_ooo->unused_lanes = 0xF76543210;
+                docsis128_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis128_crc32_sec_ooo->lens, 0xFF,
+                       sizeof(docsis128_crc32_sec_ooo->lens));
+                memset(&docsis128_crc32_sec_ooo->lens[0], 0,
+                       sizeof(docsis128_crc32_sec_ooo->lens[0]) * 8);
+                memset(docsis128_crc32_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_crc32_sec_ooo->job_in_lane));
+                docsis128_crc32_sec_ooo->unused_lanes = 0xF76543210;
+                docsis128_crc32_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_sec_ooo->lens, 0xFF,
+                       sizeof(docsis256_sec_ooo->lens));
+                memset(&docsis256_sec_ooo->lens[0], 0,
+                       sizeof(docsis256_sec_ooo->lens[0]) * 8);
+                memset(docsis256_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_sec_ooo->job_in_lane));
+                docsis256_sec_ooo->unused_lanes = 0xF76543210;
+                docsis256_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_crc32_sec_ooo->lens, 0xFF,
+                       sizeof(docsis256_crc32_sec_ooo->lens));
+                memset(&docsis256_crc32_sec_ooo->lens[0], 0,
+                       sizeof(docsis256_crc32_sec_ooo->lens[0]) * 8);
+                memset(docsis256_crc32_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_crc32_sec_ooo->job_in_lane));
+                docsis256_crc32_sec_ooo->unused_lanes = 0xF76543210;
+                docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
+        }
 
         /* Init ZUC out-of-order fields */
-        memset(zuc_eea3_ooo->lens, 0xFF,
-               sizeof(zuc_eea3_ooo->lens));
-        memset(zuc_eea3_ooo->job_in_lane, 0,
-               sizeof(zuc_eea3_ooo->job_in_lane));
-        zuc_eea3_ooo->unused_lanes = 0xFF03020100;
-        zuc_eea3_ooo->num_lanes_inuse = 0;
-
-        memset(zuc_eia3_ooo->lens, 0xFF,
-               sizeof(zuc_eia3_ooo->lens));
-        memset(zuc_eia3_ooo->job_in_lane, 0,
-               sizeof(zuc_eia3_ooo->job_in_lane));
-        zuc_eia3_ooo->unused_lanes = 0xFF03020100;
-        zuc_eia3_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_ZUC) {
+                memset(zuc_eea3_ooo->lens, 0xFF,
+                       sizeof(zuc_eea3_ooo->lens));
+                memset(zuc_eea3_ooo->job_in_lane, 0,
+                       sizeof(zuc_eea3_ooo->job_in_lane));
+                zuc_eea3_ooo->unused_lanes = 0xFF03020100;
+                zuc_eea3_ooo->num_lanes_inuse = 0;
+
+                memset(zuc_eia3_ooo->lens, 0xFF,
+                       sizeof(zuc_eia3_ooo->lens));
+                memset(zuc_eia3_ooo->job_in_lane, 0,
+                       sizeof(zuc_eia3_ooo->job_in_lane));
+                zuc_eia3_ooo->unused_lanes = 0xFF03020100;
+                zuc_eia3_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init AES-CTR out-of-order fields */
+        if (state->algos & IMB_ALGO_AES_CTR) {
+                memset(aes128_cntr_ooo->lens, 0xFF,
+                       sizeof(aes128_cntr_ooo->lens));
+                memset(aes128_cntr_ooo->job_in_lane, 0,
+                       sizeof(aes128_cntr_ooo->job_in_lane));
+                aes128_cntr_ooo->unused_lanes = 0xF76543210;
+                aes128_cntr_ooo->num_lanes_inuse = 0;
+
+                memset(aes192_cntr_ooo->lens, 0xFF,
+                       sizeof(aes192_cntr_ooo->lens));
+                memset(aes192_cntr_ooo->job_in_lane, 0,
+                       sizeof(aes192_cntr_ooo->job_in_lane));
+                aes192_cntr_ooo->unused_lanes = 0xF76543210;
+                aes192_cntr_ooo->num_lanes_inuse = 0;
+
+                memset(aes256_cntr_ooo->lens, 0xFF,
+                       sizeof(aes256_cntr_ooo->lens));
+                memset(aes256_cntr_ooo->job_in_lane, 0,
+                       sizeof(aes256_cntr_ooo->job_in_lane));
+                aes256_cntr_ooo->unused_lanes = 0xF76543210;
+                aes256_cntr_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init AES-GCM out-of-order fields */
+        if (state->algos & IMB_ALGO_AES_GCM) {
+                memset(aes128_gcm_ooo->lens, 0xFF,
+                       sizeof(aes128_gcm_ooo->lens));
+                memset(aes128_gcm_ooo->job_in_lane, 0,
+                       sizeof(aes128_gcm_ooo->job_in_lane));
+                aes128_gcm_ooo->unused_lanes = 0xF76543210;
+                aes128_gcm_ooo->num_lanes_inuse = 0;
+
+                memset(aes192_gcm_ooo->lens, 0xFF,
+                       sizeof(aes192_gcm_ooo->lens));
+                memset(aes192_gcm_ooo->job_in_lane, 0,
+                       sizeof(aes192_gcm_ooo->job_in_lane));
+                aes192_gcm_ooo->unused_lanes = 0xF76543210;
+                aes192_gcm_ooo->num_lanes_inuse = 0;
+
+                memset(aes256_gcm_ooo->lens, 0xFF,
+                       sizeof(aes256_gcm_ooo->lens));
+                memset(aes256_gcm_ooo->job_in_lane, 0,
+                       sizeof(aes256_gcm_ooo->job_in_lane));
+                aes256_gcm_ooo->unused_lanes = 0xF76543210;
+                aes256_gcm_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init SNOW3G-UEA2 out-of-order fields */
+        if (state->algos & IMB_ALGO_SNOW3G) {
+                memset(snow3g_uea2_ooo->job_in_lane, 0,
+                       sizeof(snow3g_uea2_ooo->job_in_lane));
+                snow3g_uea2_ooo->unused_lanes = 0xF76543210;
+                snow3g_uea2_ooo->num_lanes_inuse = 0;
+                snow3g_uea2_ooo->done_lanes = 0;
+        }
+
+        /* Init SNOW3G-UIA2 out-of-order fields */
+        if (state->algos & IMB_ALGO_SNOW3G) {
+                memset(snow3g_uia2_ooo->job_in_lane, 0,
+                       sizeof(snow3g_uia2_ooo->job_in_lane));
+                snow3g_uia2_ooo->unused_lanes = 0xF76543210;
+                snow3g_uia2_ooo->num_lanes_inuse = 0;
+                snow3g_uia2_ooo->done_lanes = 0;
+        }
+
+        /* Init KASUMI-UEA1 out-of-order fields */
+        if (state->algos & IMB_ALGO_KASUMI) {
+                memset(kasumi_uea1_ooo->job_in_lane, 0,
+                       sizeof(kasumi_uea1_ooo->job_in_lane));
+                kasumi_uea1_ooo->unused_lanes = 0xFEDCBA9876543210;
+                kasumi_uea1_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init KASUMI-UIA1 out-of-order fields */
+        if (state->algos & IMB_ALGO_KASUMI) {
+                memset(kasumi_uia1_ooo->job_in_lane, 0,
+                       sizeof(kasumi_uia1_ooo->job_in_lane));
+                kasumi_uia1_ooo->unused_lanes = 0xFEDCBA9876543210;
+                kasumi_uia1_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init DES, 3DES and DOCSIS DES out-of-order fields */
+        if (state->algos & IMB_ALGO_DES) {
+                memset(des_enc_ooo, 0, sizeof(*des_enc_ooo));
+                des_enc_ooo->unused_lanes = 0xF3210;
+                memset(des_dec_ooo, 0, sizeof(*des_dec_ooo));
+                des_dec_ooo->unused_lanes = 0xF3210;
+                memset(des3_enc_ooo, 0, sizeof(*des3_enc_ooo));
+                des3_enc_ooo->unused_lanes = 0xF3210;
+                memset(des3_dec_ooo, 0, sizeof(*des3_dec_ooo));
+                des3_dec_ooo->unused_lanes = 0xF3210;
+        }
+
+        if (state->algos & IMB_ALGO_DOCSIS) {
+                memset(docsis_des_enc_ooo, 0, sizeof(*docsis_des_enc_ooo));
+                docsis_des_enc_ooo->unused_lanes = 0xF3210;
+                memset(docsis_des_dec_ooo, 0, sizeof(*docsis_des_dec_ooo));
+                docsis_des_dec_ooo->unused_lanes = 0xF3210;
+        }
+
+        /* Init SHA-1/224/256/384/512 out-of-order fields */
+        if (state->algos & IMB_ALGO_SHA) {
+                memset(sha_1_ooo, 0, sizeof(*sha_1_ooo));
+                memset(sha_1_ooo->lens, 0xFF, sizeof(sha_1_ooo->lens));
+                sha_1_ooo->unused_lanes = 0xF3210;
+                memset(sha_224_ooo, 0, sizeof(*sha_224_ooo));
+                memset(sha_224_ooo->lens, 0xFF, sizeof(sha_224_ooo->lens));
+                sha_224_ooo->unused_lanes = 0xF3210;
+                memset(sha_256_ooo, 0, sizeof(*sha_256_ooo));
+                memset(sha_256_ooo->lens, 0xFF, sizeof(sha_256_ooo->lens));
+                sha_256_ooo->unused_lanes = 0xF3210;
+                memset(sha_384_ooo, 0, sizeof(*sha_384_ooo));
+                memset(sha_384_ooo->lens, 0xFF, sizeof(sha_384_ooo->lens));
+                sha_384_ooo->unused_lanes = 0xF10;
+                memset(sha_512_ooo, 0, sizeof(*sha_512_ooo));
+                memset(sha_512_ooo->lens, 0xFF, sizeof(sha_512_ooo->lens));
+                sha_512_ooo->unused_lanes = 0xF10;
+        }
 
         /* Init HMAC/SHA1 out-of-order fields */
-        hmac_sha_1_ooo->lens[0] = 0;
-        hmac_sha_1_ooo->lens[1] = 0;
-        hmac_sha_1_ooo->lens[2] = 0;
-        hmac_sha_1_ooo->lens[3] = 0;
-        hmac_sha_1_ooo->lens[4] = 0xFFFF;
-        hmac_sha_1_ooo->lens[5] = 0xFFFF;
-        hmac_sha_1_ooo->lens[6] = 0xFFFF;
-        hmac_sha_1_ooo->lens[7] = 0xFFFF;
-        hmac_sha_1_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < AVX_NUM_SHA1_LANES; j++) {
-                hmac_sha_1_ooo->ldata[j].job_in_lane = NULL;
-                hmac_sha_1_ooo->ldata[j].extra_block[64] = 0x80;
-                memset(hmac_sha_1_ooo->ldata[j].extra_block + 65,
-                       0x00,
-                       64+7);
-                p = hmac_sha_1_ooo->ldata[j].outer_block;
-                memset(p + 5*4 + 1,
-                       0x00,
-                       64 - 5*4 - 1 - 2);
-                p[5*4] = 0x80;
-                p[64-2] = 0x02;
-                p[64-1] = 0xA0;
+        if (state->algos & IMB_ALGO_HMAC_SHA1) {
+                hmac_sha_1_ooo->lens[0] = 0;
+                hmac_sha_1_ooo->lens[1] = 0;
+                hmac_sha_1_ooo->lens[2] = 0;
+                hmac_sha_1_ooo->lens[3] = 0;
+                hmac_sha_1_ooo->lens[4] = 0xFFFF;
+                hmac_sha_1_ooo->lens[5] = 0xFFFF;
+                hmac_sha_1_ooo->lens[6] = 0xFFFF;
+                hmac_sha_1_ooo->lens[7] = 0xFFFF;
+                hmac_sha_1_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < AVX_NUM_SHA1_LANES; j++) {
+                        hmac_sha_1_ooo->ldata[j].job_in_lane = NULL;
+                        hmac_sha_1_ooo->ldata[j].extra_block[64] = 0x80;
+                        memset(hmac_sha_1_ooo->ldata[j].extra_block + 65,
+                               0x00,
+                               64+7);
+                        p = hmac_sha_1_ooo->ldata[j].outer_block;
+                        memset(p + 5*4 + 1,
+                               0x00,
+                               64 - 5*4 - 1 - 2);
+                        p[5*4] = 0x80;
+                        p[64-2] = 0x02;
+                        p[64-1] = 0xA0;
+                }
         }
         /* Init HMAC/SHA224 out-of-order fields */
-        hmac_sha_224_ooo->lens[0] = 0;
-        hmac_sha_224_ooo->lens[1] = 0;
-        hmac_sha_224_ooo->lens[2] = 0;
-        hmac_sha_224_ooo->lens[3] = 0;
-        hmac_sha_224_ooo->lens[4] = 0xFFFF;
-        hmac_sha_224_ooo->lens[5] = 0xFFFF;
-        hmac_sha_224_ooo->lens[6] = 0xFFFF;
-        hmac_sha_224_ooo->lens[7] = 0xFFFF;
-        hmac_sha_224_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < AVX_NUM_SHA256_LANES; j++) {
-                hmac_sha_224_ooo->ldata[j].job_in_lane = NULL;
-
-                p = hmac_sha_224_ooo->ldata[j].extra_block;
-                size = sizeof(hmac_sha_224_ooo->ldata[j].extra_block);
-                memset (p, 0x00, size);
-                p[64] = 0x80;
-
-                p = hmac_sha_224_ooo->ldata[j].outer_block;
-                size = sizeof(hmac_sha_224_ooo->ldata[j].outer_block);
-                memset(p, 0x00, size);
-                p[7 * 4] = 0x80;  /* digest 7 words long */
-                p[64 - 2] = 0x02; /* length in little endian = 0x02E0 */
-                p[64 - 1] = 0xE0;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_224_ooo->lens[0] = 0;
+                hmac_sha_224_ooo->lens[1] = 0;
+                hmac_sha_224_ooo->lens[2] = 0;
+                hmac_sha_224_ooo->lens[3] = 0;
+                hmac_sha_224_ooo->lens[4] = 0xFFFF;
+                hmac_sha_224_ooo->lens[5] = 0xFFFF;
+                hmac_sha_224_ooo->lens[6] = 0xFFFF;
+                hmac_sha_224_ooo->lens[7] = 0xFFFF;
+                hmac_sha_224_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < AVX_NUM_SHA256_LANES; j++) {
+                        hmac_sha_224_ooo->ldata[j].job_in_lane = NULL;
+
+                        p = hmac_sha_224_ooo->ldata[j].extra_block;
+                        size = sizeof(hmac_sha_224_ooo->ldata[j].extra_block);
+                        memset (p, 0x00, size);
+                        p[64] = 0x80;
+
+                        p = hmac_sha_224_ooo->ldata[j].outer_block;
+                        size = sizeof(hmac_sha_224_ooo->ldata[j].outer_block);
+                        memset(p, 0x00, size);
+                        p[7 * 4] = 0x80;  /* digest 7 words long */
+                        p[64 - 2] = 0x02; /* length in little endian = 0x02E0 */
+                        p[64 - 1] = 0xE0;
+                }
         }
 
         /* Init HMAC/SHA256 out-of-order fields */
-        hmac_sha_256_ooo->lens[0] = 0;
-        hmac_sha_256_ooo->lens[1] = 0;
-        hmac_sha_256_ooo->lens[2] = 0;
-        hmac_sha_256_ooo->lens[3] = 0;
-        hmac_sha_256_ooo->lens[4] = 0xFFFF;
-        hmac_sha_256_ooo->lens[5] = 0xFFFF;
-        hmac_sha_256_ooo->lens[6] = 0xFFFF;
-        hmac_sha_256_ooo->lens[7] = 0xFFFF;
-        hmac_sha_256_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < AVX_NUM_SHA256_LANES; j++) {
-                hmac_sha_256_ooo->ldata[j].job_in_lane = NULL;
-                hmac_sha_256_ooo->ldata[j].extra_block[64] = 0x80;
-                memset(hmac_sha_256_ooo->ldata[j].extra_block + 65,
-                       0x00,
-                       64+7);
-                p = hmac_sha_256_ooo->ldata[j].outer_block;
-                memset(p + 8*4 + 1,
-                       0x00,
-                       64 - 8*4 - 1 - 2);
-                p[8 * 4] = 0x80;  /* 8 digest words */
-                p[64 - 2] = 0x03; /* length */
-                p[64 - 1] = 0x00;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_256_ooo->lens[0] = 0;
+                hmac_sha_256_ooo->lens[1] = 0;
+                hmac_sha_256_ooo->lens[2] = 0;
+                hmac_sha_256_ooo->lens[3] = 0;
+                hmac_sha_256_ooo->lens[4] = 0xFFFF;
+                hmac_sha_256_ooo->lens[5] = 0xFFFF;
+                hmac_sha_256_ooo->lens[6] = 0xFFFF;
+                hmac_sha_256_ooo->lens[7] = 0xFFFF;
+                hmac_sha_256_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < AVX_NUM_SHA256_LANES; j++) {
+                        hmac_sha_256_ooo->ldata[j].job_in_lane = NULL;
+                        hmac_sha_256_ooo->ldata[j].extra_block[64] = 0x80;
+                        memset(hmac_sha_256_ooo->ldata[j].extra_block + 65,
+                               0x00,
+                               64+7);
+                        p = hmac_sha_256_ooo->ldata[j].outer_block;
+                        memset(p + 8*4 + 1,
+                               0x00,
+                               64 - 8*4 - 1 - 2);
+                        p[8 * 4] = 0x80;  /* 8 digest words */
+                        p[64 - 2] = 0x03; /* length */
+                        p[64 - 1] = 0x00;
+                }
         }
 
 
         /* Init HMAC/SHA384 out-of-order fields */
-        hmac_sha_384_ooo->lens[0] = 0;
-        hmac_sha_384_ooo->lens[1] = 0;
-        hmac_sha_384_ooo->lens[2] = 0xFFFF;
-        hmac_sha_384_ooo->lens[3] = 0xFFFF;
-        hmac_sha_384_ooo->lens[4] = 0xFFFF;
-        hmac_sha_384_ooo->lens[5] = 0xFFFF;
-        hmac_sha_384_ooo->lens[6] = 0xFFFF;
-        hmac_sha_384_ooo->lens[7] = 0xFFFF;
-        hmac_sha_384_ooo->unused_lanes = 0xFF0100;
-        for (j = 0; j < AVX_NUM_SHA512_LANES; j++) {
-                MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_384_ooo;
-
-                ctx->ldata[j].job_in_lane = NULL;
-                ctx->ldata[j].extra_block[SHA_384_BLOCK_SIZE] = 0x80;
-                memset(ctx->ldata[j].extra_block + (SHA_384_BLOCK_SIZE + 1),
-                       0x00, SHA_384_BLOCK_SIZE + 7);
-
-                p = ctx->ldata[j].outer_block;
-                memset(p + SHA384_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
-                       /* special end point because this length is constant */
-                       SHA_384_BLOCK_SIZE -
-                       SHA384_DIGEST_SIZE_IN_BYTES  - 1 - 2);
-                /* mark the end */
-                p[SHA384_DIGEST_SIZE_IN_BYTES] = 0x80;
-                /* hmac outer block length always of fixed size,
-                 * it is OKey length, a whole message block length, 1024 bits,
-                 * with padding plus the length of the inner digest,
-                 * which is 384 bits, 1408 bits == 0x0580.
-                 * The input message block needs to be converted to big endian
-                 * within the sha implementation before use.
-                 */
-                p[SHA_384_BLOCK_SIZE - 2] = 0x05;
-                p[SHA_384_BLOCK_SIZE - 1] = 0x80;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_384_ooo->lens[0] = 0;
+                hmac_sha_384_ooo->lens[1] = 0;
+                hmac_sha_384_ooo->lens[2] = 0xFFFF;
+                hmac_sha_384_ooo->lens[3] = 0xFFFF;
+                hmac_sha_384_ooo->lens[4] = 0xFFFF;
+                hmac_sha_384_ooo->lens[5] = 0xFFFF;
+                hmac_sha_384_ooo->lens[6] = 0xFFFF;
+                hmac_sha_384_ooo->lens[7] = 0xFFFF;
+                hmac_sha_384_ooo->unused_lanes = 0xFF0100;
+                for (j = 0; j < AVX_NUM_SHA512_LANES; j++) {
+                        MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_384_ooo;
+
+                        ctx->ldata[j].job_in_lane = NULL;
+                        ctx->ldata[j].extra_block[SHA_384_BLOCK_SIZE] = 0x80;
+                        memset(ctx->ldata[j].extra_block +
+                               (SHA_384_BLOCK_SIZE + 1),
+                               0x00, SHA_384_BLOCK_SIZE + 7);
+
+                        p = ctx->ldata[j].outer_block;
+                        memset(p + SHA384_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
+                               /* special end point, constant length */
+                               SHA_384_BLOCK_SIZE -
+                               SHA384_DIGEST_SIZE_IN_BYTES  - 1 - 2);
+                        /* mark the end */
+                        p[SHA384_DIGEST_SIZE_IN_BYTES] = 0x80;
+                        /*
+                         * hmac outer block length always of fixed size, it is
+                         * OKey length, a whole message block length, 1024 bits,
+                         * with padding plus the length of the inner digest,
+                         * which is 384 bits, 1408 bits == 0x0580. The input
+                         * message block needs to be converted to big endian
+                         * within the sha implementation before use.
+                         */
+                        p[SHA_384_BLOCK_SIZE - 2] = 0x05;
+                        p[SHA_384_BLOCK_SIZE - 1] = 0x80;
+                }
         }
 
         /* Init HMAC/SHA512 out-of-order fields */
-        hmac_sha_512_ooo->lens[0] = 0;
-        hmac_sha_512_ooo->lens[1] = 0;
-        hmac_sha_512_ooo->lens[2] = 0xFFFF;
-        hmac_sha_512_ooo->lens[3] = 0xFFFF;
-        hmac_sha_512_ooo->lens[4] = 0xFFFF;
-        hmac_sha_512_ooo->lens[5] = 0xFFFF;
-        hmac_sha_512_ooo->lens[6] = 0xFFFF;
-        hmac_sha_512_ooo->lens[7] = 0xFFFF;
-        hmac_sha_512_ooo->unused_lanes = 0xFF0100;
-        for (j = 0; j < AVX_NUM_SHA512_LANES; j++) {
-                MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_512_ooo;
-
-                ctx->ldata[j].job_in_lane = NULL;
-                ctx->ldata[j].extra_block[SHA_512_BLOCK_SIZE] = 0x80;
-                memset(ctx->ldata[j].extra_block + (SHA_512_BLOCK_SIZE + 1),
-                       0x00, SHA_512_BLOCK_SIZE + 7);
-                p = ctx->ldata[j].outer_block;
-                memset(p + SHA512_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
-                       /* special end point because this length is constant */
-                       SHA_512_BLOCK_SIZE -
-                       SHA512_DIGEST_SIZE_IN_BYTES - 1 - 2);
-                /* mark the end */
-                p[SHA512_DIGEST_SIZE_IN_BYTES] = 0x80;
-                /*
-                 * hmac outer block length always of fixed size,
-                 * it is OKey length, a whole message block length, 1024 bits,
-                 * with padding plus the length of the inner digest,
-                 * which is 512 bits, 1536 bits == 0x600.
-                 * The input message block needs to be converted to big endian
-                 * within the sha implementation before use.
-                 */
-                p[SHA_512_BLOCK_SIZE - 2] = 0x06;
-                p[SHA_512_BLOCK_SIZE - 1] = 0x00;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_512_ooo->lens[0] = 0;
+                hmac_sha_512_ooo->lens[1] = 0;
+                hmac_sha_512_ooo->lens[2] = 0xFFFF;
+                hmac_sha_512_ooo->lens[3] = 0xFFFF;
+                hmac_sha_512_ooo->lens[4] = 0xFFFF;
+                hmac_sha_512_ooo->lens[5] = 0xFFFF;
+                hmac_sha_512_ooo->lens[6] = 0xFFFF;
+                hmac_sha_512_ooo->lens[7] = 0xFFFF;
+                hmac_sha_512_ooo->unused_lanes = 0xFF0100;
+                for (j = 0; j < AVX_NUM_SHA512_LANES; j++) {
+                        MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_512_ooo;
+
+                        ctx->ldata[j].job_in_lane = NULL;
+                        ctx->ldata[j].extra_block[SHA_512_BLOCK_SIZE] = 0x80;
+                        memset(ctx->ldata[j].extra_block +
+                               (SHA_512_BLOCK_SIZE + 1),
+                               0x00, SHA_512_BLOCK_SIZE + 7);
+                        p = ctx->ldata[j].outer_block;
+                        memset(p + SHA512_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
+                               /* special end point, constant length */
+                               SHA_512_BLOCK_SIZE -
+                               SHA512_DIGEST_SIZE_IN_BYTES - 1 - 2);
+                        /* mark the end */
+                        p[SHA512_DIGEST_SIZE_IN_BYTES] = 0x80;
+                        /*
+                         * hmac outer block length always of fixed size, it is
+                         * OKey length, a whole message block length, 1024 bits,
+                         * with padding plus the length of the inner digest,
+                         * which is 512 bits, 1536 bits == 0x600. The input
+                         * message block needs to be converted to big endian
+                         * within the sha implementation before use.
+                         */
+                        p[SHA_512_BLOCK_SIZE - 2] = 0x06;
+                        p[SHA_512_BLOCK_SIZE - 1] = 0x00;
+                }
         }
 
 
         /* Init HMAC/MD5 out-of-order fields */
-        hmac_md5_ooo->lens[0] = 0;
-        hmac_md5_ooo->lens[1] = 0;
-        hmac_md5_ooo->lens[2] = 0;
-        hmac_md5_ooo->lens[3] = 0;
-        hmac_md5_ooo->lens[4] = 0;
-        hmac_md5_ooo->lens[5] = 0;
-        hmac_md5_ooo->lens[6] = 0;
-        hmac_md5_ooo->lens[7] = 0;
-        hmac_md5_ooo->lens[8] = 0xFFFF;
-        hmac_md5_ooo->lens[9] = 0xFFFF;
-        hmac_md5_ooo->lens[10] = 0xFFFF;
-        hmac_md5_ooo->lens[11] = 0xFFFF;
-        hmac_md5_ooo->lens[12] = 0xFFFF;
-        hmac_md5_ooo->lens[13] = 0xFFFF;
-        hmac_md5_ooo->lens[14] = 0xFFFF;
-        hmac_md5_ooo->lens[15] = 0xFFFF;
-        hmac_md5_ooo->unused_lanes = 0xF76543210;
-        for (j = 0; j < AVX_NUM_MD5_LANES; j++) {
-                hmac_md5_ooo->ldata[j].job_in_lane = NULL;
-
-                p = hmac_md5_ooo->ldata[j].extra_block;
-                size = sizeof(hmac_md5_ooo->ldata[j].extra_block);
-                memset (p, 0x00, size);
-                p[64] = 0x80;
-
-                p = hmac_md5_ooo->ldata[j].outer_block;
-                size = sizeof(hmac_md5_ooo->ldata[j].outer_block);
-                memset(p, 0x00, size);
-                p[4 * 4] = 0x80;
-                p[64 - 7] = 0x02;
-                p[64 - 8] = 0x80;
+        if (state->algos & IMB_ALGO_HMAC_MD5) {
+                hmac_md5_ooo->lens[0] = 0;
+                hmac_md5_ooo->lens[1] = 0;
+                hmac_md5_ooo->lens[2] = 0;
+                hmac_md5_ooo->lens[3] = 0;
+                hmac_md5_ooo->lens[4] = 0;
+                hmac_md5_ooo->lens[5] = 0;
+                hmac_md5_ooo->lens[6] = 0;
+                hmac_md5_ooo->lens[7] = 0;
+                hmac_md5_ooo->lens[8] = 0xFFFF;
+                hmac_md5_ooo->lens[9] = 0xFFFF;
+                hmac_md5_ooo->lens[10] = 0xFFFF;
+                hmac_md5_ooo->lens[11] = 0xFFFF;
+                hmac_md5_ooo->lens[12] = 0xFFFF;
+                hmac_md5_ooo->lens[13] = 0xFFFF;
+                hmac_md5_ooo->lens[14] = 0xFFFF;
+                hmac_md5_ooo->lens[15] = 0xFFFF;
+                hmac_md5_ooo->unused_lanes = 0xF76543210;
+                for (j = 0; j < AVX_NUM_MD5_LANES; j++) {
+                        hmac_md5_ooo->ldata[j].job_in_lane = NULL;
+
+                        p = hmac_md5_ooo->ldata[j].extra_block;
+                        size = sizeof(hmac_md5_ooo->ldata[j].extra_block);
+                        memset (p, 0x00, size);
+                        p[64] = 0x80;
+
+                        p = hmac_md5_ooo->ldata[j].outer_block;
+                        size = sizeof(hmac_md5_ooo->ldata[j].outer_block);
+                        memset(p, 0x00, size);
+                        p[4 * 4] = 0x80;
+                        p[64 - 7] = 0x02;
+                        p[64 - 8] = 0x80;
+                }
         }
 
         /* Init AES/XCBC OOO fields */
-        aes_xcbc_ooo->lens[0] = 0;
-        aes_xcbc_ooo->lens[1] = 0;
-        aes_xcbc_ooo->lens[2] = 0;
-        aes_xcbc_ooo->lens[3] = 0;
-        aes_xcbc_ooo->lens[4] = 0;
-        aes_xcbc_ooo->lens[5] = 0;
-        aes_xcbc_ooo->lens[6] = 0;
-        aes_xcbc_ooo->lens[7] = 0;
-        aes_xcbc_ooo->unused_lanes = 0xF76543210;
-        for (j = 0; j < 8; j++) {
-                aes_xcbc_ooo->ldata[j].job_in_lane = NULL;
-                aes_xcbc_ooo->ldata[j].final_block[16] = 0x80;
-                memset(aes_xcbc_ooo->ldata[j].final_block + 17, 0x00, 15);
+        if (state->algos & IMB_ALGO_AES_XCBC) {
+                aes_xcbc_ooo->lens[0] = 0;
+                aes_xcbc_ooo->lens[1] = 0;
+                aes_xcbc_ooo->lens[2] = 0;
+                aes_xcbc_ooo->lens[3] = 0;
+                aes_xcbc_ooo->lens[4] = 0;
+                aes_xcbc_ooo->lens[5] = 0;
+                aes_xcbc_ooo->lens[6] = 0;
+                aes_xcbc_ooo->lens[7] = 0;
+                aes_xcbc_ooo->unused_lanes = 0xF76543210;
+                for (j = 0; j < 8; j++) {
+                        aes_xcbc_ooo->ldata[j].job_in_lane = NULL;
+                        aes_xcbc_ooo->ldata[j].final_block[16] = 0x80;
+                        memset(aes_xcbc_ooo->ldata[j].final_block +
+                               17, 0x00, 15);
+                }
         }
 
         /* Init AES-CCM auth out-of-order fields */
-        for (j = 0; j < 8; j++) {
-                aes_ccm_ooo->init_done[j] = 0;
-                aes_ccm_ooo->lens[j] = 0;
-                aes_ccm_ooo->job_in_lane[j] = NULL;
+        if (state->algos & IMB_ALGO_AES_CCM) {
+                for (j = 0; j < 8; j++) {
+                        aes_ccm_ooo->init_done[j] = 0;
+                        aes_ccm_ooo->lens[j] = 0;
+                        aes_ccm_ooo->job_in_lane[j] = NULL;
+                }
+                for (; j < 16; j++)
+                        aes_ccm_ooo->lens[j] = 0xFFFF;
+
+                aes_ccm_ooo->unused_lanes = 0xF76543210;
+                aes_ccm_ooo->num_lanes_inuse = 0;
         }
-        for (; j < 16; j++)
-                aes_ccm_ooo->lens[j] = 0xFFFF;
-
-        aes_ccm_ooo->unused_lanes = 0xF76543210;
-        aes_ccm_ooo->num_lanes_inuse = 0;
 
         /* Init AES-CMAC auth out-of-order fields */
-        for (j = 0; j < 8; j++) {
-                aes_cmac_ooo->init_done[j] = 0;
-                aes_cmac_ooo->lens[j] = 0;
-                aes_cmac_ooo->job_in_lane[j] = NULL;
+        if (state->algos & IMB_ALGO_AES_CMAC) {
+                for (j = 0; j < 8; j++) {
+                        aes_cmac_ooo->init_done[j] = 0;
+                        aes_cmac_ooo->lens[j] = 0;
+                        aes_cmac_ooo->job_in_lane[j] = NULL;
+                }
+                aes_cmac_ooo->unused_lanes = 0xF76543210;
+                aes_cmac_ooo->num_lanes_inuse = 0;
         }
-        aes_cmac_ooo->unused_lanes = 0xF76543210;
-        aes_cmac_ooo->num_lanes_inuse = 0;
 
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->flush_budget_jobs = 0;
+        state->flush_budget_cycles = 0;
+#ifdef MB_STATS
+        if (state->stats != NULL)
+                memset(state->stats, 0, sizeof(MB_MGR_STATS));
+#endif
 
         /* set AVX handlers */
         state->get_next_job        = get_next_job_avx;
@@ -760,6 +1043,11 @@ init_mb_mgr_avx(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_avx;
         state->flush_job           = flush_job_avx;
         state->queue_size          = queue_size_avx;
+        state->get_next_burst      = get_next_burst_avx;
+        state->submit_burst        = submit_burst_avx;
+        state->submit_burst_nocheck = submit_burst_nocheck_avx;
+        state->get_completed_burst = get_completed_burst_avx;
+        state->flush_burst         = flush_burst_avx;
         state->keyexp_128          = aes_keyexp_128_avx;
         state->keyexp_192          = aes_keyexp_192_avx;
         state->keyexp_256          = aes_keyexp_256_avx;
@@ -804,11 +1092,23 @@ init_mb_mgr_avx(IMB_MGR *state)
         state->snow3g_f8_8_buffer  = snow3g_f8_8_buffer_avx;
         state->snow3g_f8_n_buffer  = snow3g_f8_n_buffer_avx;
         state->snow3g_f8_8_buffer_multikey = snow3g_f8_8_buffer_multikey_avx;
+        state->snow3g_f8_16_buffer_multikey =
+                snow3g_f8_16_buffer_multikey_avx;
         state->snow3g_f8_n_buffer_multikey = snow3g_f8_n_buffer_multikey_avx;
         state->snow3g_f9_1_buffer = snow3g_f9_1_buffer_avx;
+        state->snow3g_f9_n_buffer = snow3g_f9_n_buffer_avx;
+        state->snow3g_f9_n_buffer_multikey = snow3g_f9_n_buffer_multikey_avx;
         state->snow3g_init_key_sched = snow3g_init_key_sched_avx;
         state->snow3g_key_sched_size = snow3g_key_sched_size_avx;
 
+        state->crc32_ethernet_fcs  = crc32_ethernet_fcs_avx;
+        state->crc16_ccitt         = crc16_ccitt_avx;
+        state->crc24_a             = crc24_a_avx;
+        state->crc24_b             = crc24_b_avx;
+        state->crc11               = crc11_avx;
+        state->crc6                = crc6_avx;
+        state->crc_n_buffer        = crc_n_buffer_avx;
+
         state->gcm128_enc          = aes_gcm_enc_128_avx_gen2;
         state->gcm192_enc          = aes_gcm_enc_192_avx_gen2;
         state->gcm256_enc          = aes_gcm_enc_256_avx_gen2;
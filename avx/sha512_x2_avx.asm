@@ -42,6 +42,7 @@
 %include "include/os.asm"
 %include "mb_mgr_datastruct.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 extern K512_2
 
 section .data
@@ -377,6 +378,9 @@ Lrounds_16_xx:
 	; outer calling routine restores XMM and other GP registers
 	ret
 
+;; void call_sha512_x2_avx_from_c(SHA512_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha512_x2_avx_from_c, sha512_x2_avx, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
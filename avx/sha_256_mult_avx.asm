@@ -41,6 +41,7 @@
 %include "include/os.asm"
 %include "mb_mgr_datastruct.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 extern K256_4
 
@@ -387,6 +388,9 @@ Lrounds_16_xx:
 	; outer calling routine restores XMM and other GP registers
 	ret
 
+;; void call_sha_256_mult_avx_from_c(SHA256_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha_256_mult_avx_from_c, sha_256_mult_avx, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
@@ -0,0 +1,879 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * DOCSIS SEC BPI (AES-CBC + AES-CFB for the last partial block) with
+ * CRC32 (Ethernet FCS) for AVX2.
+ *
+ * Encryption and decryption are 8 lane out-of-order managers. Each kernel
+ * step does one 16 byte block of all 8 frames: AES-CBC rounds of the 8
+ * lanes are interleaved and the plain text block is folded into the lane
+ * CRC with PCLMULQDQ. Lanes fold the CRC blocks inside of the cipher region.
+ * CRC of the bytes ahead of the cipher start is computed on submit and the
+ * CRC tail when the lane CRC gets finished, both with a lookup table.
+ *
+ * Encryption: the CRC field is written into the source buffer before
+ * the block holding it gets encrypted. Semantics follow the AVX512 code
+ * (avx512/aes_docsis_enc_avx512.asm).
+ *
+ * Decryption: takes jobs with and without CRC. Lanes left with a partial
+ * block only, including frames shorter than a block, get their AES-CFB
+ * block done together in one interleaved pass. CRC tail is read from the
+ * decrypted frame (in-place operation).
+ *
+ * There is no VAES nor VPCLMULQDQ on AVX2 platforms so AES and CRC
+ * folding operate on 128-bit lanes.
+ */
+
+#include <string.h>
+#include <stdint.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/clear_regs_mem.h"
+#include "include/crc.h"
+#include "include/aes_x8_common.h"
+
+#define DOCSIS_NUM_LANES  8
+#define DOCSIS_BLOCK_SIZE 16
+
+/* CRC32 folding constants (reflected Ethernet FCS) */
+#define DOCSIS_CRC_K1 UINT64_C(0x00000000ccaa009e)
+#define DOCSIS_CRC_K2 UINT64_C(0x00000001751997d0)
+
+/* lane CRC states (same as avx512/aes_docsis_enc_avx512.asm) */
+#define CRC_LANE_STATE_DONE        0x00
+#define CRC_LANE_STATE_TO_START    0x01
+#define CRC_LANE_STATE_IN_PROGRESS 0xff
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis128_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state,
+                                        IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis128_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis256_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state,
+                                        IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis256_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis128_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis128_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis256_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis256_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+
+uint32_t ethernet_fcs_avx(const void *msg, uint64_t len, const void *tag_ouput);
+
+/* CRC32 of the bytes with byte lookup table (no final XOR) */
+__forceinline uint32_t
+docsis_crc_lut(uint32_t crc, const uint8_t *p, const uint64_t len)
+{
+        uint64_t i;
+
+        for (i = 0; i < len; i++)
+                crc = ethernet_fcs_lut[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+
+        return crc;
+}
+
+/* Folds CRC state by one block and adds next block to it */
+__forceinline __m128i
+docsis_crc_fold(const __m128i crc, const __m128i crc_k, const __m128i d)
+{
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(crc, crc_k,
+                                                                 0x01),
+                                           _mm_clmulepi64_si128(crc, crc_k,
+                                                                0x10)), d);
+}
+
+/* Reduces folded CRC state to 32 bits (no final XOR) */
+__forceinline uint32_t
+docsis_crc_reduce(const __m128i crc)
+{
+        DECLARE_ALIGNED(uint8_t blk[DOCSIS_BLOCK_SIZE], 16);
+        uint32_t r;
+
+        _mm_store_si128((__m128i *) blk, crc);
+        r = docsis_crc_lut(0, blk, sizeof(blk));
+#ifdef SAFE_DATA
+        clear_mem(blk, sizeof(blk));
+#endif
+        return r;
+}
+
+/**
+ * @brief XOR's up to one block of text with a key stream block
+ *
+ * @param [out] out     Output text
+ * @param [in] in       Input text
+ * @param [in] ks       Key stream block
+ * @param [in] len      Number of bytes (up to 16)
+ */
+__forceinline void
+docsis_xor_partial(uint8_t *out, const uint8_t *in, const __m128i ks,
+                   const uint64_t len)
+{
+        DECLARE_ALIGNED(uint8_t blk[DOCSIS_BLOCK_SIZE], 16);
+
+        memset(blk, 0, sizeof(blk));
+        memcpy(blk, in, len);
+        _mm_store_si128((__m128i *) blk,
+                        _mm_xor_si128(ks, _mm_load_si128((__m128i *) blk)));
+        memcpy(out, blk, len);
+#ifdef SAFE_DATA
+        clear_mem(blk, sizeof(blk));
+#endif
+}
+
+/**
+ * @brief AES-CFB on up to one block (DOCSIS first or last partial block)
+ *
+ * @param [out] out     Output text
+ * @param [in] in       Input text
+ * @param [in] iv       Initialization vector
+ * @param [in] keys     Expanded encryption keys
+ * @param [in] len      Number of bytes (up to 16)
+ * @param [in] nrounds  Number of AES rounds
+ */
+__forceinline void
+docsis_cfb_x1(uint8_t *out, const uint8_t *in, const void *iv,
+              const void *keys, const uint64_t len, const unsigned nrounds)
+{
+        docsis_xor_partial(out, in,
+                           aes_x1_enc_block(_mm_loadu_si128((const __m128i *)
+                                                            iv),
+                                            keys, nrounds),
+                           len);
+}
+
+/* Checks if CRC is to be computed for the job */
+__forceinline int
+docsis_crc_needed(const IMB_JOB *job)
+{
+        return job->hash_alg == IMB_AUTH_DOCSIS_CRC32 &&
+                job->msg_len_to_hash_in_bytes >= DOCSIS_CRC32_MIN_ETH_PDU_SIZE;
+}
+
+/**
+ * @brief Computes CRC of the whole Ethernet PDU in one go
+ *
+ * CRC value is written into the source buffer (encrypt direction)
+ * and authentication tag.
+ *
+ * @param [in] job    DOCSIS job
+ * @param [in] enc    1 - encrypt, 0 - decrypt direction
+ */
+__forceinline void
+docsis_crc_x1(IMB_JOB *job, const int enc)
+{
+        const uint8_t *hash_start = job->src +
+                job->hash_start_src_offset_in_bytes;
+        const uint32_t crc =
+                ethernet_fcs_avx(hash_start, job->msg_len_to_hash_in_bytes,
+                                 enc ? &hash_start
+                                 [job->msg_len_to_hash_in_bytes] : NULL);
+
+        memcpy(job->auth_tag_output, &crc, sizeof(crc));
+}
+
+/**
+ * @brief Gets number of bytes of the full CRC blocks in the cipher region
+ *
+ * These are the blocks that can be folded on the go with the cipher.
+ * CRC region has to start ahead of the cipher region.
+ *
+ * @param [in] job    DOCSIS job
+ *
+ * @return Number of bytes (multiple of 16) or 0
+ */
+__forceinline uint64_t
+docsis_crc_blocks_len(const IMB_JOB *job)
+{
+        const uint64_t hash_end = job->hash_start_src_offset_in_bytes +
+                job->msg_len_to_hash_in_bytes;
+        const uint64_t cipher_start = job->cipher_start_src_offset_in_bytes;
+        uint64_t len;
+
+        if (!docsis_crc_needed(job) ||
+            cipher_start < job->hash_start_src_offset_in_bytes ||
+            hash_end < cipher_start)
+                return 0;
+
+        len = hash_end - cipher_start;
+        if (len > job->msg_len_to_cipher_in_bytes)
+                len = job->msg_len_to_cipher_in_bytes;
+
+        return len & ~(uint64_t) (DOCSIS_BLOCK_SIZE - 1);
+}
+
+/**
+ * @brief Sets up CRC of a job going into a lane
+ *
+ * CRC of the bytes ahead of the cipher text is computed here.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] lane       Lane index
+ * @param [in] job        DOCSIS job
+ * @param [in] crc_blocks_len  Number of bytes of the full CRC blocks
+ */
+__forceinline void
+docsis_crc_start(MB_MGR_DOCSIS_AES_OOO *state, const unsigned lane,
+                 const IMB_JOB *job, const uint64_t crc_blocks_len)
+{
+        const uint8_t *hash_start = job->src +
+                job->hash_start_src_offset_in_bytes;
+        uint32_t crc;
+
+        if (crc_blocks_len == 0) {
+                state->crc_done[lane] = CRC_LANE_STATE_DONE;
+                state->crc_len[lane] = 0;
+                return;
+        }
+
+        crc = docsis_crc_lut(0xffffffff, hash_start,
+                             job->cipher_start_src_offset_in_bytes -
+                             job->hash_start_src_offset_in_bytes);
+        _mm_store_si128((__m128i *) &state->crc_init[lane],
+                        _mm_cvtsi32_si128((int) crc));
+        state->crc_done[lane] = CRC_LANE_STATE_TO_START;
+        state->crc_len[lane] = (uint16_t) crc_blocks_len;
+}
+
+/**
+ * @brief Finishes CRC of a job
+ *
+ * Lane CRC state is reduced to 32 bits and the CRC tail
+ * (bytes past the full CRC blocks) is added.
+ *
+ * @param [in] state  DOCSIS OOO manager
+ * @param [in] lane   Lane index
+ * @param [in] job    Job in the lane
+ *
+ * @return CRC value
+ */
+__forceinline uint32_t
+docsis_crc_finish(const MB_MGR_DOCSIS_AES_OOO *state, const unsigned lane,
+                  const IMB_JOB *job)
+{
+        const uint8_t *tail = job->src + job->cipher_start_src_offset_in_bytes +
+                docsis_crc_blocks_len(job);
+        const uint8_t *hash_end = job->src +
+                job->hash_start_src_offset_in_bytes +
+                job->msg_len_to_hash_in_bytes;
+        const uint32_t crc =
+                docsis_crc_reduce(_mm_load_si128((const __m128i *)
+                                                 &state->crc_init[lane]));
+
+        return ~docsis_crc_lut(crc, tail, hash_end - tail);
+}
+
+/**
+ * @brief AES-CBC and CRC fold on given number of bytes of all 8 lanes
+ *
+ * CRC is folded on lanes in CRC_LANE_STATE_TO_START and
+ * CRC_LANE_STATE_IN_PROGRESS states, the caller makes sure \a len
+ * doesn't go past the full CRC blocks of these lanes.
+ * Encryption folds the input, decryption folds the output.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] len        Number of bytes (multiple of 16)
+ * @param [in] nrounds    Number of AES rounds
+ * @param [in] enc        1 - encrypt, 0 - decrypt direction
+ */
+__forceinline void
+docsis_cbc_crc_x8(MB_MGR_DOCSIS_AES_OOO *state, const uint64_t len,
+                  const unsigned nrounds, const int enc)
+{
+        const __m128i crc_k = _mm_set_epi64x((long long) DOCSIS_CRC_K2,
+                                             (long long) DOCSIS_CRC_K1);
+        AES_ARGS *args = &state->args;
+        __m128i iv[DOCSIS_NUM_LANES], crc[DOCSIS_NUM_LANES];
+        __m128i fold_mask[DOCSIS_NUM_LANES];
+        const __m128i *keys[DOCSIS_NUM_LANES];
+        uint64_t i;
+        unsigned lane, r;
+
+        for (lane = 0; lane < DOCSIS_NUM_LANES; lane++) {
+                const uint8_t crc_state = state->crc_done[lane];
+
+                iv[lane] = _mm_load_si128((const __m128i *) &args->IV[lane]);
+                crc[lane] = _mm_load_si128((const __m128i *)
+                                           &state->crc_init[lane]);
+                keys[lane] = (const __m128i *) args->keys[lane];
+                /* first CRC block gets initial value added, not folded */
+                fold_mask[lane] = _mm_set1_epi32((crc_state ==
+                                                  CRC_LANE_STATE_TO_START) ?
+                                                 0 : -1);
+                if (crc_state == CRC_LANE_STATE_TO_START)
+                        state->crc_done[lane] = CRC_LANE_STATE_IN_PROGRESS;
+        }
+
+        for (i = 0; i < len; i += DOCSIS_BLOCK_SIZE) {
+                __m128i d[DOCSIS_NUM_LANES], b[DOCSIS_NUM_LANES];
+
+                for (lane = 0; lane < DOCSIS_NUM_LANES; lane++) {
+                        d[lane] = _mm_loadu_si128((const __m128i *)
+                                                  &args->in[lane][i]);
+                        b[lane] = _mm_xor_si128(d[lane], _mm_loadu_si128
+                                                (&keys[lane][0]));
+                        if (enc)
+                                b[lane] = _mm_xor_si128(b[lane], iv[lane]);
+                }
+
+                if (enc) {
+                        for (r = 1; r < nrounds; r++)
+                                for (lane = 0; lane < DOCSIS_NUM_LANES; lane++)
+                                        b[lane] = _mm_aesenc_si128
+                                                (b[lane], _mm_loadu_si128
+                                                 (&keys[lane][r]));
+                } else {
+                        for (r = 1; r < nrounds; r++)
+                                for (lane = 0; lane < DOCSIS_NUM_LANES; lane++)
+                                        b[lane] = _mm_aesdec_si128
+                                                (b[lane], _mm_loadu_si128
+                                                 (&keys[lane][r]));
+                }
+
+                for (lane = 0; lane < DOCSIS_NUM_LANES; lane++) {
+                        const __m128i k = _mm_loadu_si128
+                                (&keys[lane][nrounds]);
+                        const __m128i c = crc[lane];
+                        __m128i plain;
+
+                        if (enc) {
+                                plain = d[lane];
+                                iv[lane] = _mm_aesenclast_si128(b[lane], k);
+                                b[lane] = iv[lane];
+                        } else {
+                                b[lane] = _mm_xor_si128
+                                        (_mm_aesdeclast_si128(b[lane], k),
+                                         iv[lane]);
+                                plain = b[lane];
+                                iv[lane] = d[lane];
+                        }
+                        _mm_storeu_si128((__m128i *) &args->out[lane][i],
+                                         b[lane]);
+
+                        crc[lane] = _mm_xor_si128
+                                (docsis_crc_fold(_mm_and_si128(c,
+                                                               fold_mask[lane]),
+                                                 crc_k, plain),
+                                 _mm_andnot_si128(fold_mask[lane], c));
+                        fold_mask[lane] = _mm_set1_epi32(-1);
+                }
+        }
+
+        for (lane = 0; lane < DOCSIS_NUM_LANES; lane++) {
+                _mm_store_si128((__m128i *) &args->IV[lane], iv[lane]);
+                /* finished lanes keep their CRC state until job completes */
+                if (state->crc_done[lane] != CRC_LANE_STATE_DONE)
+                        _mm_store_si128((__m128i *) &state->crc_init[lane],
+                                        crc[lane]);
+                args->in[lane] += len;
+                args->out[lane] += len;
+        }
+}
+
+/* Gets mask of the lanes with no job (0xFFFF) */
+__forceinline __m128i
+docsis_idle_lanes(const MB_MGR_DOCSIS_AES_OOO *state)
+{
+        DECLARE_ALIGNED(uint16_t idle_lanes[DOCSIS_NUM_LANES], 16);
+        unsigned lane;
+
+        for (lane = 0; lane < DOCSIS_NUM_LANES; lane++)
+                idle_lanes[lane] = (state->job_in_lane[lane] == NULL) ?
+                        0xFFFF : 0;
+        return _mm_load_si128((const __m128i *) idle_lanes);
+}
+
+/**
+ * @brief Runs the lanes up to the shortest full block CBC or CRC run
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] idle       Mask of the lanes with no job
+ * @param [in] nrounds    Number of AES rounds
+ * @param [in] enc        1 - encrypt, 0 - decrypt direction
+ */
+__forceinline void
+docsis_x8_run(MB_MGR_DOCSIS_AES_OOO *state, const __m128i idle,
+              const unsigned nrounds, const int enc)
+{
+        const __m128i lens = _mm_load_si128((const __m128i *) state->lens);
+        const __m128i crc_lens = _mm_load_si128((const __m128i *)
+                                                state->crc_len);
+        const __m128i crc_off =
+                _mm_cmpeq_epi16(_mm_cvtepu8_epi16
+                                (_mm_loadl_epi64((const __m128i *)
+                                                 state->crc_done)),
+                                _mm_set1_epi16(CRC_LANE_STATE_DONE));
+        const __m128i blocks =
+                _mm_and_si128(lens, _mm_set1_epi16(~(DOCSIS_BLOCK_SIZE - 1)));
+        const __m128i minpos =
+                _mm_minpos_epu16(_mm_or_si128(_mm_min_epu16
+                                              (blocks,
+                                               _mm_or_si128(crc_lens,
+                                                            crc_off)),
+                                              idle));
+        const uint16_t min_len = (uint16_t) _mm_extract_epi16(minpos, 0);
+        const __m128i sub = _mm_set1_epi16((short) min_len);
+
+        if (min_len == 0)
+                return;
+
+        docsis_cbc_crc_x8(state, min_len, nrounds, enc);
+
+        _mm_store_si128((__m128i *) state->lens, _mm_sub_epi16(lens, sub));
+        _mm_store_si128((__m128i *) state->crc_len,
+                        _mm_andnot_si128(crc_off,
+                                         _mm_sub_epi16(crc_lens, sub)));
+}
+
+/* Puts job into a lane */
+__forceinline void
+docsis_lane_take(MB_MGR_DOCSIS_AES_OOO *state, const unsigned lane,
+                 IMB_JOB *job, const void *keys, const uint64_t len)
+{
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = (uint16_t) len;
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = (const uint32_t *) keys;
+        _mm_store_si128((__m128i *) &state->args.IV[lane],
+                        _mm_loadu_si128((const __m128i *) job->iv));
+}
+
+/* Releases the lane and returns its job */
+__forceinline IMB_JOB *
+docsis_lane_release(MB_MGR_DOCSIS_AES_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        job->status |= STS_COMPLETED_AES;
+
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+        state->job_in_lane[lane] = NULL;
+        state->crc_done[lane] = CRC_LANE_STATE_DONE;
+#ifdef SAFE_DATA
+        memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+        memset(&state->crc_init[lane], 0, sizeof(state->crc_init[lane]));
+#endif
+        return job;
+}
+
+/**
+ * @brief Prepares the lanes for flush
+ *
+ * Empty lanes repeat the cipher operation of a valid lane,
+ * they produce the same output and don't do CRC.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ *
+ * @return 0 if there are no jobs in the lanes, 1 otherwise
+ */
+__forceinline int
+docsis_flush_prepare(MB_MGR_DOCSIS_AES_OOO *state)
+{
+        unsigned lane, good_lane = 0;
+
+        if (state->num_lanes_inuse == 0)
+                return 0;
+
+        while (state->job_in_lane[good_lane] == NULL)
+                good_lane++;
+
+        for (lane = 0; lane < DOCSIS_NUM_LANES; lane++)
+                if (state->job_in_lane[lane] == NULL) {
+                        state->args.in[lane] = state->args.in[good_lane];
+                        state->args.out[lane] = state->args.out[good_lane];
+                        state->args.keys[lane] = state->args.keys[good_lane];
+                        state->args.IV[lane] = state->args.IV[good_lane];
+                        state->crc_done[lane] = CRC_LANE_STATE_DONE;
+                }
+
+        return 1;
+}
+
+/* ========================================================================= */
+/* Encryption */
+/* ========================================================================= */
+
+/**
+ * @brief Completes encrypt job in a lane
+ *
+ * Encrypts the last partial block with AES-CFB and
+ * releases the lane.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] lane       Lane index
+ * @param [in] nrounds    Number of AES rounds
+ *
+ * @return Completed job
+ */
+__forceinline IMB_JOB *
+docsis_enc_complete(MB_MGR_DOCSIS_AES_OOO *state, const unsigned lane,
+                    const unsigned nrounds)
+{
+        const IMB_JOB *job = state->job_in_lane[lane];
+        const uint64_t partial_bytes = job->msg_len_to_cipher_in_bytes &
+                (DOCSIS_BLOCK_SIZE - 1);
+
+        if (partial_bytes)
+                docsis_cfb_x1(state->args.out[lane], state->args.in[lane],
+                              &state->args.IV[lane], job->enc_keys,
+                              partial_bytes, nrounds);
+
+        return docsis_lane_release(state, lane);
+}
+
+/**
+ * @brief Runs the lanes until one of the encrypt jobs is complete
+ *
+ * Runs are cut short at the end of the full CRC blocks of the lanes,
+ * so that CRC can be finished and written before its block gets encrypted.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] nrounds    Number of AES rounds
+ *
+ * @return Completed job
+ */
+__forceinline IMB_JOB *
+docsis_enc_x8_process(MB_MGR_DOCSIS_AES_OOO *state, const unsigned nrounds)
+{
+        /* lanes with no job don't count towards the run length */
+        const __m128i idle = docsis_idle_lanes(state);
+        __m128i minpos;
+        unsigned lane;
+
+        while (1) {
+                docsis_x8_run(state, idle, nrounds, 1);
+
+                /* write CRC of the lanes that got to the CRC tail */
+                for (lane = 0; lane < DOCSIS_NUM_LANES; lane++) {
+                        IMB_JOB *job = state->job_in_lane[lane];
+                        uint8_t *hash_end;
+                        uint32_t crc;
+
+                        if (job == NULL ||
+                            state->crc_done[lane] == CRC_LANE_STATE_DONE ||
+                            state->crc_len[lane] != 0)
+                                continue;
+
+                        /* CRC field is written into the source buffer */
+                        hash_end = (uint8_t *) (uintptr_t)
+                                (job->src +
+                                 job->hash_start_src_offset_in_bytes +
+                                 job->msg_len_to_hash_in_bytes);
+                        crc = docsis_crc_finish(state, lane, job);
+                        memcpy(hash_end, &crc, sizeof(crc));
+                        memcpy(job->auth_tag_output, &crc, sizeof(crc));
+                        state->crc_done[lane] = CRC_LANE_STATE_DONE;
+                }
+
+                minpos = _mm_minpos_epu16
+                        (_mm_or_si128(_mm_load_si128((const __m128i *)
+                                                     state->lens), idle));
+                if (_mm_extract_epi16(minpos, 0) == 0)
+                        return docsis_enc_complete
+                                (state,
+                                 (unsigned) _mm_extract_epi16(minpos, 1),
+                                 nrounds);
+        }
+}
+
+__forceinline IMB_JOB *
+docsis_enc_submit(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
+                  const unsigned nrounds)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        const uint8_t *cipher_start = job->src +
+                job->cipher_start_src_offset_in_bytes;
+        const uint64_t cipher_blocks_len = job->msg_len_to_cipher_in_bytes &
+                ~(uint64_t) (DOCSIS_BLOCK_SIZE - 1);
+        const uint64_t crc_blocks_len = docsis_crc_blocks_len(job);
+
+        if (crc_blocks_len == 0) {
+                /* CRC (if any) in one go */
+                if (docsis_crc_needed(job))
+                        docsis_crc_x1(job, 1);
+
+                if (cipher_blocks_len == 0) {
+                        /* single partial block gets done on the spot */
+                        if (job->msg_len_to_cipher_in_bytes != 0)
+                                docsis_cfb_x1(job->dst, cipher_start, job->iv,
+                                              job->enc_keys,
+                                              job->msg_len_to_cipher_in_bytes,
+                                              nrounds);
+                        job->status |= STS_COMPLETED_AES;
+                        return job;
+                }
+        }
+
+        docsis_crc_start(state, lane, job, crc_blocks_len);
+        docsis_lane_take(state, lane, job, job->enc_keys, cipher_blocks_len);
+
+        if (state->num_lanes_inuse < DOCSIS_NUM_LANES)
+                return NULL;
+
+        return docsis_enc_x8_process(state, nrounds);
+}
+
+__forceinline IMB_JOB *
+docsis_enc_flush(MB_MGR_DOCSIS_AES_OOO *state, const unsigned nrounds)
+{
+        if (!docsis_flush_prepare(state))
+                return NULL;
+
+        return docsis_enc_x8_process(state, nrounds);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis128_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state,
+                                        IMB_JOB *job)
+{
+        return docsis_enc_submit(state, job, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis128_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state)
+{
+        return docsis_enc_flush(state, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis256_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state,
+                                        IMB_JOB *job)
+{
+        return docsis_enc_submit(state, job, 14);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis256_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state)
+{
+        return docsis_enc_flush(state, 14);
+}
+
+/* ========================================================================= */
+/* Decryption */
+/* ========================================================================= */
+
+/**
+ * @brief AES-CFB on the lanes left with a partial block only
+ *
+ * AES rounds of the selected lanes are interleaved. IV of a lane is
+ * the last full cipher text block or the job IV for frames shorter
+ * than a block.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] sel        Mask of the selected lanes (bit per lane)
+ * @param [in] nrounds    Number of AES rounds
+ */
+__forceinline void
+docsis_cfb_x8(MB_MGR_DOCSIS_AES_OOO *state, const unsigned sel,
+              const unsigned nrounds)
+{
+        __m128i ks[DOCSIS_NUM_LANES];
+        const __m128i *keys[DOCSIS_NUM_LANES];
+        unsigned lanes[DOCSIS_NUM_LANES];
+        unsigned i, n = 0, r;
+
+        for (i = 0; i < DOCSIS_NUM_LANES; i++)
+                if (sel & (1 << i)) {
+                        /* key stream uses the encryption keys */
+                        keys[n] = (const __m128i *)
+                                state->job_in_lane[i]->enc_keys;
+                        ks[n] = _mm_xor_si128(_mm_load_si128
+                                              ((const __m128i *)
+                                               &state->args.IV[i]),
+                                              _mm_loadu_si128(&keys[n][0]));
+                        lanes[n++] = i;
+                }
+
+        for (r = 1; r < nrounds; r++)
+                for (i = 0; i < n; i++)
+                        ks[i] = _mm_aesenc_si128(ks[i],
+                                                 _mm_loadu_si128(&keys[i][r]));
+
+        for (i = 0; i < n; i++) {
+                const unsigned lane = lanes[i];
+
+                docsis_xor_partial(state->args.out[lane], state->args.in[lane],
+                                   _mm_aesenclast_si128
+                                   (ks[i], _mm_loadu_si128(&keys[i][nrounds])),
+                                   state->lens[lane]);
+                state->lens[lane] = 0;
+        }
+}
+
+/**
+ * @brief Completes decrypt job in a lane
+ *
+ * Puts CRC into authentication tag and releases the lane.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] lane       Lane index
+ *
+ * @return Completed job
+ */
+__forceinline IMB_JOB *
+docsis_dec_complete(MB_MGR_DOCSIS_AES_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        if (docsis_crc_blocks_len(job) != 0) {
+                const uint32_t crc = docsis_crc_finish(state, lane, job);
+
+                memcpy(job->auth_tag_output, &crc, sizeof(crc));
+        } else if (docsis_crc_needed(job)) {
+                docsis_crc_x1(job, 0);
+        }
+
+        return docsis_lane_release(state, lane);
+}
+
+/**
+ * @brief Runs the lanes until one of the decrypt jobs is complete
+ *
+ * Full blocks of all lanes are decrypted together. Once any lane is left
+ * with a partial block only, the partial blocks of all such lanes
+ * get decrypted.
+ *
+ * @param [in/out] state  DOCSIS OOO manager
+ * @param [in] nrounds    Number of AES rounds
+ *
+ * @return Completed job
+ */
+__forceinline IMB_JOB *
+docsis_dec_x8_process(MB_MGR_DOCSIS_AES_OOO *state, const unsigned nrounds)
+{
+        /* lanes with no job don't count towards the run length */
+        const __m128i idle = docsis_idle_lanes(state);
+        const __m128i partial = _mm_set1_epi16(DOCSIS_BLOCK_SIZE - 1);
+        unsigned lane;
+
+        while (1) {
+                const __m128i lens = _mm_load_si128((const __m128i *)
+                                                    state->lens);
+                const __m128i minpos =
+                        _mm_minpos_epu16(_mm_or_si128(lens, idle));
+                unsigned sel;
+
+                if (_mm_extract_epi16(minpos, 0) == 0)
+                        return docsis_dec_complete
+                                (state,
+                                 (unsigned) _mm_extract_epi16(minpos, 1));
+
+                /* lanes with less than a block to go */
+                sel = (unsigned) _mm_movemask_epi8
+                        (_mm_packs_epi16(_mm_andnot_si128
+                                         (idle,
+                                          _mm_cmpeq_epi16(_mm_min_epu16
+                                                          (lens, partial),
+                                                          lens)),
+                                         _mm_setzero_si128()));
+                if (sel != 0) {
+                        docsis_cfb_x8(state, sel, nrounds);
+                        continue;
+                }
+
+                docsis_x8_run(state, idle, nrounds, 0);
+
+                /* lanes that got to the CRC tail stop folding */
+                for (lane = 0; lane < DOCSIS_NUM_LANES; lane++)
+                        if (state->crc_done[lane] != CRC_LANE_STATE_DONE &&
+                            state->crc_len[lane] == 0)
+                                state->crc_done[lane] = CRC_LANE_STATE_DONE;
+        }
+}
+
+__forceinline IMB_JOB *
+docsis_dec_submit(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
+                  const unsigned nrounds)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+
+        if (job->msg_len_to_cipher_in_bytes == 0) {
+                if (docsis_crc_needed(job))
+                        docsis_crc_x1(job, 0);
+                job->status |= STS_COMPLETED_AES;
+                return job;
+        }
+
+        docsis_crc_start(state, lane, job, docsis_crc_blocks_len(job));
+        docsis_lane_take(state, lane, job, job->dec_keys,
+                         job->msg_len_to_cipher_in_bytes);
+
+        if (state->num_lanes_inuse < DOCSIS_NUM_LANES)
+                return NULL;
+
+        return docsis_dec_x8_process(state, nrounds);
+}
+
+__forceinline IMB_JOB *
+docsis_dec_flush(MB_MGR_DOCSIS_AES_OOO *state, const unsigned nrounds)
+{
+        if (!docsis_flush_prepare(state))
+                return NULL;
+
+        return docsis_dec_x8_process(state, nrounds);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis128_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job)
+{
+        return docsis_dec_submit(state, job, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis128_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state)
+{
+        return docsis_dec_flush(state, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_docsis256_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job)
+{
+        return docsis_dec_submit(state, job, 14);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_docsis256_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state)
+{
+        return docsis_dec_flush(state, 14);
+}
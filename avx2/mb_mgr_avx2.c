@@ -37,6 +37,7 @@
 #include "include/kasumi_internal.h"
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
+#include "include/crc.h"
 #include "include/gcm.h"
 
 #include "save_xmms.h"
@@ -45,21 +46,21 @@
 #include "cpu_feature.h"
 #include "noaesni.h"
 
-IMB_JOB *submit_job_aes128_enc_avx(MB_MGR_AES_OOO *state,
-                                        IMB_JOB *job);
-IMB_JOB *flush_job_aes128_enc_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes128_enc_avx2(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes128_enc_avx2(MB_MGR_AES_OOO *state);
 
-IMB_JOB *submit_job_aes192_enc_avx(MB_MGR_AES_OOO *state,
-                                        IMB_JOB *job);
-IMB_JOB *flush_job_aes192_enc_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes192_enc_avx2(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes192_enc_avx2(MB_MGR_AES_OOO *state);
 
-IMB_JOB *submit_job_aes256_enc_avx(MB_MGR_AES_OOO *state,
-                                        IMB_JOB *job);
-IMB_JOB *flush_job_aes256_enc_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes256_enc_avx2(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes256_enc_avx2(MB_MGR_AES_OOO *state);
 
-IMB_JOB *submit_job_aes_xcbc_avx(MB_MGR_AES_XCBC_OOO *state,
-                                      IMB_JOB *job);
-IMB_JOB *flush_job_aes_xcbc_avx(MB_MGR_AES_XCBC_OOO *state);
+IMB_JOB *submit_job_aes_xcbc_avx2(MB_MGR_AES_XCBC_OOO *state,
+                                  IMB_JOB *job);
+IMB_JOB *flush_job_aes_xcbc_avx2(MB_MGR_AES_XCBC_OOO *state);
 
 IMB_JOB *submit_job_aes_cntr_avx(IMB_JOB *job);
 
@@ -73,20 +74,79 @@ IMB_JOB *submit_job_zuc_eia3_avx2(MB_MGR_ZUC_OOO *state,
                                         IMB_JOB *job);
 IMB_JOB *flush_job_zuc_eia3_avx2(MB_MGR_ZUC_OOO *state);
 
+IMB_JOB *submit_job_aes128_cntr_avx(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes128_cntr_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes192_cntr_avx(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes192_cntr_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes256_cntr_avx(MB_MGR_AES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_aes256_cntr_avx(MB_MGR_AES_OOO *state);
+IMB_JOB *submit_job_aes128_gcm_avx(MB_MGR_GCM_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_aes128_gcm_avx(MB_MGR_GCM_OOO *state);
+IMB_JOB *submit_job_aes192_gcm_avx(MB_MGR_GCM_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_aes192_gcm_avx(MB_MGR_GCM_OOO *state);
+IMB_JOB *submit_job_aes256_gcm_avx(MB_MGR_GCM_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_aes256_gcm_avx(MB_MGR_GCM_OOO *state);
+IMB_JOB *submit_job_snow3g_uea2_avx2(MB_MGR_SNOW3G_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_snow3g_uea2_avx2(MB_MGR_SNOW3G_OOO *state);
+IMB_JOB *submit_job_snow3g_uia2_avx2(MB_MGR_SNOW3G_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_snow3g_uia2_avx2(MB_MGR_SNOW3G_OOO *state);
+IMB_JOB *submit_job_kasumi_uea1_avx2(MB_MGR_KASUMI_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_kasumi_uea1_avx2(MB_MGR_KASUMI_OOO *state);
+IMB_JOB *submit_job_kasumi_uia1_avx2(MB_MGR_KASUMI_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_kasumi_uia1_avx2(MB_MGR_KASUMI_OOO *state);
+IMB_JOB *submit_job_des_cbc_enc_avx2(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_enc_avx2(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_des_cbc_dec_avx2(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_dec_avx2(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_3des_cbc_enc_avx2(MB_MGR_DES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_enc_avx2(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_3des_cbc_dec_avx2(MB_MGR_DES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_dec_avx2(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_docsis_des_enc_avx2(MB_MGR_DES_OOO *state,
+                                        IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_enc_avx2(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_docsis_des_dec_avx2(MB_MGR_DES_OOO *state,
+                                        IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_dec_avx2(MB_MGR_DES_OOO *state);
+IMB_JOB *submit_job_sha1_avx2(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha1_avx2(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha224_avx2(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha224_avx2(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha256_avx2(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha256_avx2(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha384_avx2(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha384_avx2(MB_MGR_SHA_OOO *state);
+IMB_JOB *submit_job_sha512_avx2(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_JOB *flush_job_sha512_avx2(MB_MGR_SHA_OOO *state);
+
 #define SAVE_XMMS               save_xmms_avx
 #define RESTORE_XMMS            restore_xmms_avx
 
-#define SUBMIT_JOB_AES128_ENC submit_job_aes128_enc_avx
+#define SUBMIT_JOB_AES128_ENC submit_job_aes128_enc_avx2
 #define SUBMIT_JOB_AES128_DEC submit_job_aes128_dec_avx
-#define FLUSH_JOB_AES128_ENC  flush_job_aes128_enc_avx
+#define FLUSH_JOB_AES128_ENC  flush_job_aes128_enc_avx2
 
-#define SUBMIT_JOB_AES192_ENC submit_job_aes192_enc_avx
+#define SUBMIT_JOB_AES192_ENC submit_job_aes192_enc_avx2
 #define SUBMIT_JOB_AES192_DEC submit_job_aes192_dec_avx
-#define FLUSH_JOB_AES192_ENC  flush_job_aes192_enc_avx
+#define FLUSH_JOB_AES192_ENC  flush_job_aes192_enc_avx2
 
-#define SUBMIT_JOB_AES256_ENC submit_job_aes256_enc_avx
+#define SUBMIT_JOB_AES256_ENC submit_job_aes256_enc_avx2
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_avx
-#define FLUSH_JOB_AES256_ENC  flush_job_aes256_enc_avx
+#define FLUSH_JOB_AES256_ENC  flush_job_aes256_enc_avx2
 
 #define SUBMIT_JOB_AES_ECB_128_ENC submit_job_aes_ecb_128_enc_avx
 #define SUBMIT_JOB_AES_ECB_128_DEC submit_job_aes_ecb_128_dec_avx
@@ -97,6 +157,49 @@ IMB_JOB *flush_job_zuc_eia3_avx2(MB_MGR_ZUC_OOO *state);
 
 #define SUBMIT_JOB_AES_CNTR   submit_job_aes_cntr_avx
 #define SUBMIT_JOB_AES_CNTR_BIT   submit_job_aes_cntr_bit_avx
+#define SUBMIT_JOB_AES128_CNTR submit_job_aes128_cntr_avx
+#define FLUSH_JOB_AES128_CNTR  flush_job_aes128_cntr_avx
+#define SUBMIT_JOB_AES192_CNTR submit_job_aes192_cntr_avx
+#define FLUSH_JOB_AES192_CNTR  flush_job_aes192_cntr_avx
+#define SUBMIT_JOB_AES256_CNTR submit_job_aes256_cntr_avx
+#define FLUSH_JOB_AES256_CNTR  flush_job_aes256_cntr_avx
+#define SUBMIT_JOB_AES128_GCM submit_job_aes128_gcm_avx
+#define FLUSH_JOB_AES128_GCM  flush_job_aes128_gcm_avx
+#define SUBMIT_JOB_AES192_GCM submit_job_aes192_gcm_avx
+#define FLUSH_JOB_AES192_GCM  flush_job_aes192_gcm_avx
+#define SUBMIT_JOB_AES256_GCM submit_job_aes256_gcm_avx
+#define FLUSH_JOB_AES256_GCM  flush_job_aes256_gcm_avx
+#define SUBMIT_JOB_SNOW3G_UEA2 submit_job_snow3g_uea2_avx2
+#define FLUSH_JOB_SNOW3G_UEA2  flush_job_snow3g_uea2_avx2
+#define SUBMIT_JOB_SNOW3G_UIA2 submit_job_snow3g_uia2_avx2
+#define FLUSH_JOB_SNOW3G_UIA2  flush_job_snow3g_uia2_avx2
+#define SUBMIT_JOB_KASUMI_UEA1 submit_job_kasumi_uea1_avx2
+#define FLUSH_JOB_KASUMI_UEA1  flush_job_kasumi_uea1_avx2
+#define SUBMIT_JOB_KASUMI_UIA1 submit_job_kasumi_uia1_avx2
+#define FLUSH_JOB_KASUMI_UIA1  flush_job_kasumi_uia1_avx2
+
+#define SUBMIT_JOB_DES_CBC_ENC submit_job_des_cbc_enc_avx2
+#define FLUSH_JOB_DES_CBC_ENC  flush_job_des_cbc_enc_avx2
+#define SUBMIT_JOB_DES_CBC_DEC submit_job_des_cbc_dec_avx2
+#define FLUSH_JOB_DES_CBC_DEC  flush_job_des_cbc_dec_avx2
+#define SUBMIT_JOB_3DES_CBC_ENC submit_job_3des_cbc_enc_avx2
+#define FLUSH_JOB_3DES_CBC_ENC  flush_job_3des_cbc_enc_avx2
+#define SUBMIT_JOB_3DES_CBC_DEC submit_job_3des_cbc_dec_avx2
+#define FLUSH_JOB_3DES_CBC_DEC  flush_job_3des_cbc_dec_avx2
+#define SUBMIT_JOB_DOCSIS_DES_ENC submit_job_docsis_des_enc_avx2
+#define FLUSH_JOB_DOCSIS_DES_ENC  flush_job_docsis_des_enc_avx2
+#define SUBMIT_JOB_DOCSIS_DES_DEC submit_job_docsis_des_dec_avx2
+#define FLUSH_JOB_DOCSIS_DES_DEC  flush_job_docsis_des_dec_avx2
+#define SUBMIT_JOB_SHA1    submit_job_sha1_avx2
+#define FLUSH_JOB_SHA1     flush_job_sha1_avx2
+#define SUBMIT_JOB_SHA224  submit_job_sha224_avx2
+#define FLUSH_JOB_SHA224   flush_job_sha224_avx2
+#define SUBMIT_JOB_SHA256  submit_job_sha256_avx2
+#define FLUSH_JOB_SHA256   flush_job_sha256_avx2
+#define SUBMIT_JOB_SHA384  submit_job_sha384_avx2
+#define FLUSH_JOB_SHA384   flush_job_sha384_avx2
+#define SUBMIT_JOB_SHA512  submit_job_sha512_avx2
+#define FLUSH_JOB_SHA512   flush_job_sha512_avx2
 
 #define SUBMIT_JOB_ZUC_EEA3   submit_job_zuc_eea3_avx2
 #define FLUSH_JOB_ZUC_EEA3    flush_job_zuc_eea3_avx2
@@ -144,8 +247,8 @@ IMB_JOB *flush_job_zuc_eia3_avx2(MB_MGR_ZUC_OOO *state);
 #define SUBMIT_JOB_AES_GCM_ENC submit_job_aes_gcm_enc_avx2
 #define FLUSH_JOB_AES_GCM_ENC  flush_job_aes_gcm_enc_avx2
 
-#define SUBMIT_JOB_AES_XCBC   submit_job_aes_xcbc_avx
-#define FLUSH_JOB_AES_XCBC    flush_job_aes_xcbc_avx
+#define SUBMIT_JOB_AES_XCBC   submit_job_aes_xcbc_avx2
+#define FLUSH_JOB_AES_XCBC    flush_job_aes_xcbc_avx2
 
 #define SUBMIT_JOB_AES128_DEC submit_job_aes128_dec_avx
 #define SUBMIT_JOB_AES192_DEC submit_job_aes192_dec_avx
@@ -158,6 +261,18 @@ IMB_JOB *flush_job_zuc_eia3_avx2(MB_MGR_ZUC_OOO *state);
 
 
 
+IMB_JOB *submit_job_hmac_ni_sse(MB_MGR_HMAC_SHA_1_OOO *state,
+                                IMB_JOB *job);
+IMB_JOB *flush_job_hmac_ni_sse(MB_MGR_HMAC_SHA_1_OOO *state);
+
+IMB_JOB *submit_job_hmac_sha_224_ni_sse(MB_MGR_HMAC_SHA_256_OOO *state,
+                                        IMB_JOB *job);
+IMB_JOB *flush_job_hmac_sha_224_ni_sse(MB_MGR_HMAC_SHA_256_OOO *state);
+
+IMB_JOB *submit_job_hmac_sha_256_ni_sse(MB_MGR_HMAC_SHA_256_OOO *state,
+                                        IMB_JOB *job);
+IMB_JOB *flush_job_hmac_sha_256_ni_sse(MB_MGR_HMAC_SHA_256_OOO *state);
+
 IMB_JOB *submit_job_hmac_avx2(MB_MGR_HMAC_SHA_1_OOO *state,
                                    IMB_JOB *job);
 IMB_JOB *flush_job_hmac_avx2(MB_MGR_HMAC_SHA_1_OOO *state);
@@ -182,10 +297,10 @@ IMB_JOB *submit_job_hmac_md5_avx2(MB_MGR_HMAC_MD5_OOO *state,
                                        IMB_JOB *job);
 IMB_JOB *flush_job_hmac_md5_avx2(MB_MGR_HMAC_MD5_OOO *state);
 
-IMB_JOB *submit_job_aes_cmac_auth_avx(MB_MGR_CMAC_OOO *state,
-                                           IMB_JOB *job);
+IMB_JOB *submit_job_aes_cmac_auth_avx2(MB_MGR_CMAC_OOO *state,
+                                       IMB_JOB *job);
 
-IMB_JOB *flush_job_aes_cmac_auth_avx(MB_MGR_CMAC_OOO *state);
+IMB_JOB *flush_job_aes_cmac_auth_avx2(MB_MGR_CMAC_OOO *state);
 
 IMB_JOB *submit_job_aes_ccm_auth_avx(MB_MGR_CCM_OOO *state,
                                            IMB_JOB *job);
@@ -194,6 +309,12 @@ IMB_JOB *flush_job_aes_ccm_auth_avx(MB_MGR_CCM_OOO *state);
 
 #define SUBMIT_JOB_HMAC               submit_job_hmac_avx2
 #define FLUSH_JOB_HMAC                flush_job_hmac_avx2
+#define SUBMIT_JOB_HMAC_NI            submit_job_hmac_ni_sse
+#define FLUSH_JOB_HMAC_NI             flush_job_hmac_ni_sse
+#define SUBMIT_JOB_HMAC_SHA_224_NI    submit_job_hmac_sha_224_ni_sse
+#define FLUSH_JOB_HMAC_SHA_224_NI     flush_job_hmac_sha_224_ni_sse
+#define SUBMIT_JOB_HMAC_SHA_256_NI    submit_job_hmac_sha_256_ni_sse
+#define FLUSH_JOB_HMAC_SHA_256_NI     flush_job_hmac_sha_256_ni_sse
 #define SUBMIT_JOB_HMAC_SHA_224       submit_job_hmac_sha_224_avx2
 #define FLUSH_JOB_HMAC_SHA_224        flush_job_hmac_sha_224_avx2
 #define SUBMIT_JOB_HMAC_SHA_256       submit_job_hmac_sha_256_avx2
@@ -213,6 +334,11 @@ IMB_JOB *flush_job_aes_ccm_auth_avx(MB_MGR_CCM_OOO *state);
 #define QUEUE_SIZE         queue_size_avx2
 #define GET_NEXT_JOB       get_next_job_avx2
 #define GET_COMPLETED_JOB  get_completed_job_avx2
+#define GET_NEXT_BURST       get_next_burst_avx2
+#define SUBMIT_BURST         submit_burst_avx2
+#define SUBMIT_BURST_NOCHECK submit_burst_nocheck_avx2
+#define GET_COMPLETED_BURST  get_completed_burst_avx2
+#define FLUSH_BURST          flush_burst_avx2
 
 /* ====================================================================== */
 
@@ -231,8 +357,17 @@ void aes128_cbc_mac_x8(AES_ARGS *args, uint64_t len);
 #define FLUSH_JOB_AES_CCM_AUTH     flush_job_aes_ccm_auth_avx
 #define SUBMIT_JOB_AES_CCM_AUTH    submit_job_aes_ccm_auth_avx
 
-#define FLUSH_JOB_AES_CMAC_AUTH    flush_job_aes_cmac_auth_avx
-#define SUBMIT_JOB_AES_CMAC_AUTH   submit_job_aes_cmac_auth_avx
+#define FLUSH_JOB_AES_CMAC_AUTH    flush_job_aes_cmac_auth_avx2
+#define SUBMIT_JOB_AES_CMAC_AUTH   submit_job_aes_cmac_auth_avx2
+
+/* ====================================================================== */
+
+/*
+ * Used to decide if SHA1/SHA256 SIMD or SHA1NI OOO scheduler should be
+ * called: SHA-NI lanes take jobs while fewer jobs than SIMD lanes are
+ * in flight and the SIMD scheduler is empty.
+ */
+#define HASH_USE_SHAEXT_ADAPTIVE AVX2_NUM_SHA1_LANES
 
 /* ====================================================================== */
 
@@ -242,6 +377,41 @@ uint32_t ethernet_fcs_avx(const void *msg, uint64_t len, const void *tag_ouput);
 
 /* ====================================================================== */
 
+/*
+ * DOCSIS SEC BPI: AES-CBC and CRC32 are done in one pass by 8 lane
+ * managers, encryption with CRC32 and all of decryption
+ * (see aes_docsis_crc32_avx2.c)
+ */
+IMB_JOB *
+submit_job_aes_docsis128_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state,
+                                        IMB_JOB *job);
+IMB_JOB *
+flush_job_aes_docsis128_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+IMB_JOB *
+submit_job_aes_docsis256_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state,
+                                        IMB_JOB *job);
+IMB_JOB *
+flush_job_aes_docsis256_enc_crc32_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+IMB_JOB *
+submit_job_aes_docsis128_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job);
+IMB_JOB *
+flush_job_aes_docsis128_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+IMB_JOB *
+submit_job_aes_docsis256_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job);
+IMB_JOB *
+flush_job_aes_docsis256_dec_avx2(MB_MGR_DOCSIS_AES_OOO *state);
+
+#define SUBMIT_JOB_DOCSIS128_SEC_CRC_ENC submit_job_aes_docsis128_enc_crc32_avx2
+#define SUBMIT_JOB_DOCSIS256_SEC_CRC_ENC submit_job_aes_docsis256_enc_crc32_avx2
+#define FLUSH_JOB_DOCSIS128_SEC_CRC_ENC  flush_job_aes_docsis128_enc_crc32_avx2
+#define FLUSH_JOB_DOCSIS256_SEC_CRC_ENC  flush_job_aes_docsis256_enc_crc32_avx2
+#define SUBMIT_JOB_DOCSIS128_SEC_DEC_OOO submit_job_aes_docsis128_dec_avx2
+#define SUBMIT_JOB_DOCSIS256_SEC_DEC_OOO submit_job_aes_docsis256_dec_avx2
+#define FLUSH_JOB_DOCSIS128_SEC_DEC_OOO  flush_job_aes_docsis128_dec_avx2
+#define FLUSH_JOB_DOCSIS256_SEC_DEC_OOO  flush_job_aes_docsis256_dec_avx2
+
+/* ====================================================================== */
+
 /*
  * GCM submit / flush API for AVX2 arch
  */
@@ -368,9 +538,16 @@ init_mb_mgr_avx2(IMB_MGR *state)
         MB_MGR_DOCSIS_AES_OOO *docsis256_sec_ooo = state->docsis256_sec_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis256_crc32_sec_ooo =
                                                 state->docsis256_crc32_sec_ooo;
+        MB_MGR_DOCSIS_AES_OOO *docsis128_dec_ooo = state->docsis128_dec_ooo;
+        MB_MGR_DOCSIS_AES_OOO *docsis256_dec_ooo = state->docsis256_dec_ooo;
         MB_MGR_HMAC_SHA_1_OOO *hmac_sha_1_ooo = state->hmac_sha_1_ooo;
         MB_MGR_HMAC_SHA_256_OOO *hmac_sha_224_ooo = state->hmac_sha_224_ooo;
         MB_MGR_HMAC_SHA_256_OOO *hmac_sha_256_ooo = state->hmac_sha_256_ooo;
+        MB_MGR_HMAC_SHA_1_OOO *hmac_sha_1_ni_ooo = state->hmac_sha_1_ni_ooo;
+        MB_MGR_HMAC_SHA_256_OOO *hmac_sha_224_ni_ooo =
+                state->hmac_sha_224_ni_ooo;
+        MB_MGR_HMAC_SHA_256_OOO *hmac_sha_256_ni_ooo =
+                state->hmac_sha_256_ni_ooo;
         MB_MGR_HMAC_SHA_512_OOO *hmac_sha_384_ooo = state->hmac_sha_384_ooo;
         MB_MGR_HMAC_SHA_512_OOO *hmac_sha_512_ooo = state->hmac_sha_512_ooo;
         MB_MGR_HMAC_MD5_OOO *hmac_md5_ooo = state->hmac_md5_ooo;
@@ -379,6 +556,27 @@ init_mb_mgr_avx2(IMB_MGR *state)
         MB_MGR_CMAC_OOO *aes_cmac_ooo = state->aes_cmac_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
+        MB_MGR_AES_OOO *aes128_cntr_ooo = state->aes128_cntr_ooo;
+        MB_MGR_AES_OOO *aes192_cntr_ooo = state->aes192_cntr_ooo;
+        MB_MGR_AES_OOO *aes256_cntr_ooo = state->aes256_cntr_ooo;
+        MB_MGR_GCM_OOO *aes128_gcm_ooo = state->aes128_gcm_ooo;
+        MB_MGR_GCM_OOO *aes192_gcm_ooo = state->aes192_gcm_ooo;
+        MB_MGR_GCM_OOO *aes256_gcm_ooo = state->aes256_gcm_ooo;
+        MB_MGR_SNOW3G_OOO *snow3g_uea2_ooo = state->snow3g_uea2_ooo;
+        MB_MGR_SNOW3G_OOO *snow3g_uia2_ooo = state->snow3g_uia2_ooo;
+        MB_MGR_KASUMI_OOO *kasumi_uea1_ooo = state->kasumi_uea1_ooo;
+        MB_MGR_KASUMI_OOO *kasumi_uia1_ooo = state->kasumi_uia1_ooo;
+        MB_MGR_DES_OOO *des_enc_ooo = state->des_enc_ooo;
+        MB_MGR_DES_OOO *des_dec_ooo = state->des_dec_ooo;
+        MB_MGR_DES_OOO *des3_enc_ooo = state->des3_enc_ooo;
+        MB_MGR_DES_OOO *des3_dec_ooo = state->des3_dec_ooo;
+        MB_MGR_DES_OOO *docsis_des_enc_ooo = state->docsis_des_enc_ooo;
+        MB_MGR_DES_OOO *docsis_des_dec_ooo = state->docsis_des_dec_ooo;
+        MB_MGR_SHA_OOO *sha_1_ooo = state->sha_1_ooo;
+        MB_MGR_SHA_OOO *sha_224_ooo = state->sha_224_ooo;
+        MB_MGR_SHA_OOO *sha_256_ooo = state->sha_256_ooo;
+        MB_MGR_SHA_OOO *sha_384_ooo = state->sha_384_ooo;
+        MB_MGR_SHA_OOO *sha_512_ooo = state->sha_512_ooo;
 
 
         state->features = cpu_feature_adjust(state->flags,
@@ -390,312 +588,524 @@ init_mb_mgr_avx2(IMB_MGR *state)
         }
 
         /* Init AES out-of-order fields */
-        memset(aes128_ooo->lens, 0xFF,
-               sizeof(aes128_ooo->lens));
-        memset(&aes128_ooo->lens[0], 0,
-               sizeof(aes128_ooo->lens[0]) * 8);
-        memset(aes128_ooo->job_in_lane, 0,
-               sizeof(aes128_ooo->job_in_lane));
-        aes128_ooo->unused_lanes = 0xF76543210;
-        aes128_ooo->num_lanes_inuse = 0;
-
-        memset(aes192_ooo->lens, 0xFF,
-               sizeof(aes192_ooo->lens));
-        memset(&aes192_ooo->lens[0], 0,
-               sizeof(aes192_ooo->lens[0]) * 8);
-        memset(aes192_ooo->job_in_lane, 0,
-               sizeof(aes192_ooo->job_in_lane));
-        aes192_ooo->unused_lanes = 0xF76543210;
-        aes192_ooo->num_lanes_inuse = 0;
-
-        memset(&aes256_ooo->lens, 0xFF,
-               sizeof(aes256_ooo->lens));
-        memset(&aes256_ooo->lens[0], 0,
-               sizeof(aes256_ooo->lens[0]) * 8);
-        memset(aes256_ooo->job_in_lane, 0,
-               sizeof(aes256_ooo->job_in_lane));
-        aes256_ooo->unused_lanes = 0xF76543210;
-        aes256_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_AES_CBC) {
+                memset(aes128_ooo->lens, 0xFF,
+                       sizeof(aes128_ooo->lens));
+                memset(aes128_ooo->job_in_lane, 0,
+                       sizeof(aes128_ooo->job_in_lane));
+                aes128_ooo->unused_lanes = 0xF76543210;
+                aes128_ooo->num_lanes_inuse = 0;
+
+                memset(aes192_ooo->lens, 0xFF,
+                       sizeof(aes192_ooo->lens));
+                memset(aes192_ooo->job_in_lane, 0,
+                       sizeof(aes192_ooo->job_in_lane));
+                aes192_ooo->unused_lanes = 0xF76543210;
+                aes192_ooo->num_lanes_inuse = 0;
+
+                memset(&aes256_ooo->lens, 0xFF,
+                       sizeof(aes256_ooo->lens));
+                memset(aes256_ooo->job_in_lane, 0,
+                       sizeof(aes256_ooo->job_in_lane));
+                aes256_ooo->unused_lanes = 0xF76543210;
+                aes256_ooo->num_lanes_inuse = 0;
+        }
 
         /* DOCSIS SEC BPI (AES CBC + AES CFB for partial block)
          * uses same settings as AES CBC.
          */
-        memset(docsis128_sec_ooo->lens, 0xFF,
-               sizeof(docsis128_sec_ooo->lens));
-        memset(&docsis128_sec_ooo->lens[0], 0,
-               sizeof(docsis128_sec_ooo->lens[0]) * 8);
-        memset(docsis128_sec_ooo->job_in_lane, 0,
-               sizeof(docsis128_sec_ooo->job_in_lane));
-        docsis128_sec_ooo->unused_lanes = 0xF76543210;
-        docsis128_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis128_crc32_sec_ooo->lens, 0xFF,
-               sizeof(docsis128_crc32_sec_ooo->lens));
-        memset(&docsis128_crc32_sec_ooo->lens[0], 0,
-               sizeof(docsis128_crc32_sec_ooo->lens[0]) * 8);
-        memset(docsis128_crc32_sec_ooo->job_in_lane, 0,
-               sizeof(docsis128_crc32_sec_ooo->job_in_lane));
-        docsis128_crc32_sec_ooo->unused_lanes = 0xF76543210;
-        docsis128_crc32_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis256_sec_ooo->lens, 0xFF,
-               sizeof(docsis256_sec_ooo->lens));
-        memset(&docsis256_sec_ooo->lens[0], 0,
-               sizeof(docsis256_sec_ooo->lens[0]) * 8);
-        memset(docsis256_sec_ooo->job_in_lane, 0,
-               sizeof(docsis256_sec_ooo->job_in_lane));
-        docsis256_sec_ooo->unused_lanes = 0xF76543210;
-        docsis256_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis256_crc32_sec_ooo->lens, 0xFF,
-               sizeof(docsis256_crc32_sec_ooo->lens));
-        memset(&docsis256_crc32_sec_ooo->lens[0], 0,
-               sizeof(docsis256_crc32_sec_ooo->lens[0]) * 8);
-        memset(docsis256_crc32_sec_ooo->job_in_lane, 0,
-               sizeof(docsis256_crc32_sec_ooo->job_in_lane));
-        docsis256_crc32_sec_ooo->unused_lanes = 0xF76543210;
-        docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_DOCSIS) {
+                memset(docsis128_sec_ooo->lens, 0xFF,
+                       sizeof(docsis128_sec_ooo->lens));
+                memset(docsis128_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_sec_ooo->job_in_lane));
+                docsis128_sec_ooo->unused_lanes = 0xF76543210;
+                docsis128_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis128_crc32_sec_ooo->lens, 0xFF,
+                       sizeof(docsis128_crc32_sec_ooo->lens));
+                memset(&docsis128_crc32_sec_ooo->lens[0], 0,
+                       sizeof(docsis128_crc32_sec_ooo->lens[0]) * 8);
+                memset(docsis128_crc32_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_crc32_sec_ooo->job_in_lane));
+                memset(docsis128_crc32_sec_ooo->crc_done, 0,
+                       sizeof(docsis128_crc32_sec_ooo->crc_done));
+                docsis128_crc32_sec_ooo->unused_lanes = 0xF76543210;
+                docsis128_crc32_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_sec_ooo->lens, 0xFF,
+                       sizeof(docsis256_sec_ooo->lens));
+                memset(docsis256_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_sec_ooo->job_in_lane));
+                docsis256_sec_ooo->unused_lanes = 0xF76543210;
+                docsis256_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_crc32_sec_ooo->lens, 0xFF,
+                       sizeof(docsis256_crc32_sec_ooo->lens));
+                memset(&docsis256_crc32_sec_ooo->lens[0], 0,
+                       sizeof(docsis256_crc32_sec_ooo->lens[0]) * 8);
+                memset(docsis256_crc32_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_crc32_sec_ooo->job_in_lane));
+                memset(docsis256_crc32_sec_ooo->crc_done, 0,
+                       sizeof(docsis256_crc32_sec_ooo->crc_done));
+                docsis256_crc32_sec_ooo->unused_lanes = 0xF76543210;
+                docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis128_dec_ooo->lens, 0xFF,
+                       sizeof(docsis128_dec_ooo->lens));
+                memset(&docsis128_dec_ooo->lens[0], 0,
+                       sizeof(docsis128_dec_ooo->lens[0]) * 8);
+                memset(docsis128_dec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_dec_ooo->job_in_lane));
+                memset(docsis128_dec_ooo->crc_done, 0,
+                       sizeof(docsis128_dec_ooo->crc_done));
+                docsis128_dec_ooo->unused_lanes = 0xF76543210;
+                docsis128_dec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_dec_ooo->lens, 0xFF,
+                       sizeof(docsis256_dec_ooo->lens));
+                memset(&docsis256_dec_ooo->lens[0], 0,
+                       sizeof(docsis256_dec_ooo->lens[0]) * 8);
+                memset(docsis256_dec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_dec_ooo->job_in_lane));
+                memset(docsis256_dec_ooo->crc_done, 0,
+                       sizeof(docsis256_dec_ooo->crc_done));
+                docsis256_dec_ooo->unused_lanes = 0xF76543210;
+                docsis256_dec_ooo->num_lanes_inuse = 0;
+        }
 
         /* Init ZUC out-of-order fields */
-        memset(zuc_eea3_ooo->lens, 0xFF,
-               sizeof(zuc_eea3_ooo->lens));
-        memset(zuc_eea3_ooo->job_in_lane, 0,
-               sizeof(zuc_eea3_ooo->job_in_lane));
-        zuc_eea3_ooo->unused_lanes = 0xF76543210;
-        zuc_eea3_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_ZUC) {
+                memset(zuc_eea3_ooo->lens, 0xFF,
+                       sizeof(zuc_eea3_ooo->lens));
+                memset(zuc_eea3_ooo->job_in_lane, 0,
+                       sizeof(zuc_eea3_ooo->job_in_lane));
+                zuc_eea3_ooo->unused_lanes = 0xF76543210;
+                zuc_eea3_ooo->num_lanes_inuse = 0;
+
+                memset(zuc_eia3_ooo->lens, 0xFF,
+                       sizeof(zuc_eia3_ooo->lens));
+                memset(zuc_eia3_ooo->job_in_lane, 0,
+                       sizeof(zuc_eia3_ooo->job_in_lane));
+                zuc_eia3_ooo->unused_lanes = 0xF76543210;
+                zuc_eia3_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init AES-CTR out-of-order fields */
+        if (state->algos & IMB_ALGO_AES_CTR) {
+                memset(aes128_cntr_ooo->lens, 0xFF,
+                       sizeof(aes128_cntr_ooo->lens));
+                memset(aes128_cntr_ooo->job_in_lane, 0,
+                       sizeof(aes128_cntr_ooo->job_in_lane));
+                aes128_cntr_ooo->unused_lanes = 0xF76543210;
+                aes128_cntr_ooo->num_lanes_inuse = 0;
+
+                memset(aes192_cntr_ooo->lens, 0xFF,
+                       sizeof(aes192_cntr_ooo->lens));
+                memset(aes192_cntr_ooo->job_in_lane, 0,
+                       sizeof(aes192_cntr_ooo->job_in_lane));
+                aes192_cntr_ooo->unused_lanes = 0xF76543210;
+                aes192_cntr_ooo->num_lanes_inuse = 0;
+
+                memset(aes256_cntr_ooo->lens, 0xFF,
+                       sizeof(aes256_cntr_ooo->lens));
+                memset(aes256_cntr_ooo->job_in_lane, 0,
+                       sizeof(aes256_cntr_ooo->job_in_lane));
+                aes256_cntr_ooo->unused_lanes = 0xF76543210;
+                aes256_cntr_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init AES-GCM out-of-order fields */
+        if (state->algos & IMB_ALGO_AES_GCM) {
+                memset(aes128_gcm_ooo->lens, 0xFF,
+                       sizeof(aes128_gcm_ooo->lens));
+                memset(aes128_gcm_ooo->job_in_lane, 0,
+                       sizeof(aes128_gcm_ooo->job_in_lane));
+                aes128_gcm_ooo->unused_lanes = 0xF76543210;
+                aes128_gcm_ooo->num_lanes_inuse = 0;
+
+                memset(aes192_gcm_ooo->lens, 0xFF,
+                       sizeof(aes192_gcm_ooo->lens));
+                memset(aes192_gcm_ooo->job_in_lane, 0,
+                       sizeof(aes192_gcm_ooo->job_in_lane));
+                aes192_gcm_ooo->unused_lanes = 0xF76543210;
+                aes192_gcm_ooo->num_lanes_inuse = 0;
+
+                memset(aes256_gcm_ooo->lens, 0xFF,
+                       sizeof(aes256_gcm_ooo->lens));
+                memset(aes256_gcm_ooo->job_in_lane, 0,
+                       sizeof(aes256_gcm_ooo->job_in_lane));
+                aes256_gcm_ooo->unused_lanes = 0xF76543210;
+                aes256_gcm_ooo->num_lanes_inuse = 0;
+        }
+
+        /* Init SNOW3G-UEA2 out-of-order fields */
+        if (state->algos & IMB_ALGO_SNOW3G) {
+                memset(snow3g_uea2_ooo->job_in_lane, 0,
+                       sizeof(snow3g_uea2_ooo->job_in_lane));
+                snow3g_uea2_ooo->unused_lanes = 0xF76543210;
+                snow3g_uea2_ooo->num_lanes_inuse = 0;
+                snow3g_uea2_ooo->done_lanes = 0;
+        }
+
+        /* Init SNOW3G-UIA2 out-of-order fields */
+        if (state->algos & IMB_ALGO_SNOW3G) {
+                memset(snow3g_uia2_ooo->job_in_lane, 0,
+                       sizeof(snow3g_uia2_ooo->job_in_lane));
+                snow3g_uia2_ooo->unused_lanes = 0xF76543210;
+                snow3g_uia2_ooo->num_lanes_inuse = 0;
+                snow3g_uia2_ooo->done_lanes = 0;
+        }
+
+        /* Init KASUMI-UEA1 out-of-order fields */
+        if (state->algos & IMB_ALGO_KASUMI) {
+                memset(kasumi_uea1_ooo->job_in_lane, 0,
+                       sizeof(kasumi_uea1_ooo->job_in_lane));
+                kasumi_uea1_ooo->unused_lanes = 0xFEDCBA9876543210;
+                kasumi_uea1_ooo->num_lanes_inuse = 0;
+                memset(kasumi_uea1_ooo->args.sk16, 0,
+                       sizeof(kasumi_uea1_ooo->args.sk16));
+        }
+
+        /* Init KASUMI-UIA1 out-of-order fields */
+        if (state->algos & IMB_ALGO_KASUMI) {
+                memset(kasumi_uia1_ooo->job_in_lane, 0,
+                       sizeof(kasumi_uia1_ooo->job_in_lane));
+                kasumi_uia1_ooo->unused_lanes = 0xFEDCBA9876543210;
+                kasumi_uia1_ooo->num_lanes_inuse = 0;
+                memset(kasumi_uia1_ooo->args.sk16, 0,
+                       sizeof(kasumi_uia1_ooo->args.sk16));
+        }
 
-        memset(zuc_eia3_ooo->lens, 0xFF,
-               sizeof(zuc_eia3_ooo->lens));
-        memset(zuc_eia3_ooo->job_in_lane, 0,
-               sizeof(zuc_eia3_ooo->job_in_lane));
-        zuc_eia3_ooo->unused_lanes = 0xF76543210;
-        zuc_eia3_ooo->num_lanes_inuse = 0;
+        /* Init DES, 3DES and DOCSIS DES out-of-order fields */
+        if (state->algos & IMB_ALGO_DES) {
+                memset(des_enc_ooo, 0, sizeof(*des_enc_ooo));
+                des_enc_ooo->unused_lanes = 0xF76543210;
+                memset(des_dec_ooo, 0, sizeof(*des_dec_ooo));
+                des_dec_ooo->unused_lanes = 0xF76543210;
+                memset(des3_enc_ooo, 0, sizeof(*des3_enc_ooo));
+                des3_enc_ooo->unused_lanes = 0xF76543210;
+                memset(des3_dec_ooo, 0, sizeof(*des3_dec_ooo));
+                des3_dec_ooo->unused_lanes = 0xF76543210;
+        }
+
+        if (state->algos & IMB_ALGO_DOCSIS) {
+                memset(docsis_des_enc_ooo, 0, sizeof(*docsis_des_enc_ooo));
+                docsis_des_enc_ooo->unused_lanes = 0xF76543210;
+                memset(docsis_des_dec_ooo, 0, sizeof(*docsis_des_dec_ooo));
+                docsis_des_dec_ooo->unused_lanes = 0xF76543210;
+        }
 
+        /* Init SHA-1/224/256/384/512 out-of-order fields */
+        if (state->algos & IMB_ALGO_SHA) {
+                memset(sha_1_ooo, 0, sizeof(*sha_1_ooo));
+                memset(sha_1_ooo->lens, 0xFF, sizeof(sha_1_ooo->lens));
+                sha_1_ooo->unused_lanes = 0xF76543210;
+                memset(sha_224_ooo, 0, sizeof(*sha_224_ooo));
+                memset(sha_224_ooo->lens, 0xFF, sizeof(sha_224_ooo->lens));
+                sha_224_ooo->unused_lanes = 0xF76543210;
+                memset(sha_256_ooo, 0, sizeof(*sha_256_ooo));
+                memset(sha_256_ooo->lens, 0xFF, sizeof(sha_256_ooo->lens));
+                sha_256_ooo->unused_lanes = 0xF76543210;
+                memset(sha_384_ooo, 0, sizeof(*sha_384_ooo));
+                memset(sha_384_ooo->lens, 0xFF, sizeof(sha_384_ooo->lens));
+                sha_384_ooo->unused_lanes = 0xF3210;
+                memset(sha_512_ooo, 0, sizeof(*sha_512_ooo));
+                memset(sha_512_ooo->lens, 0xFF, sizeof(sha_512_ooo->lens));
+                sha_512_ooo->unused_lanes = 0xF3210;
+        }
 
         /* Init HMAC/SHA1 out-of-order fields */
-        hmac_sha_1_ooo->lens[0] = 0;
-        hmac_sha_1_ooo->lens[1] = 0;
-        hmac_sha_1_ooo->lens[2] = 0;
-        hmac_sha_1_ooo->lens[3] = 0;
-        hmac_sha_1_ooo->lens[4] = 0;
-        hmac_sha_1_ooo->lens[5] = 0;
-        hmac_sha_1_ooo->lens[6] = 0;
-        hmac_sha_1_ooo->lens[7] = 0;
-        hmac_sha_1_ooo->unused_lanes = 0xF76543210;
-        for (j = 0; j < AVX2_NUM_SHA1_LANES; j++) {
-                hmac_sha_1_ooo->ldata[j].job_in_lane = NULL;
-                hmac_sha_1_ooo->ldata[j].extra_block[64] = 0x80;
-                memset(hmac_sha_1_ooo->ldata[j].extra_block + 65,
-                       0x00,
-                       64 + 7);
-                p = hmac_sha_1_ooo->ldata[j].outer_block;
-                memset(p + 5*4 + 1,
-                       0x00,
-                       64 - 5*4 - 1 - 2);
-                p[5 * 4] = 0x80;
-                p[64 - 2] = 0x02;
-                p[64 - 1] = 0xA0;
+        if (state->algos & IMB_ALGO_HMAC_SHA1) {
+                hmac_sha_1_ooo->lens[0] = 0;
+                hmac_sha_1_ooo->lens[1] = 0;
+                hmac_sha_1_ooo->lens[2] = 0;
+                hmac_sha_1_ooo->lens[3] = 0;
+                hmac_sha_1_ooo->lens[4] = 0;
+                hmac_sha_1_ooo->lens[5] = 0;
+                hmac_sha_1_ooo->lens[6] = 0;
+                hmac_sha_1_ooo->lens[7] = 0;
+                hmac_sha_1_ooo->unused_lanes = 0xF76543210;
+                for (j = 0; j < AVX2_NUM_SHA1_LANES; j++) {
+                        hmac_sha_1_ooo->ldata[j].job_in_lane = NULL;
+                        hmac_sha_1_ooo->ldata[j].extra_block[64] = 0x80;
+                        memset(hmac_sha_1_ooo->ldata[j].extra_block + 65,
+                               0x00,
+                               64 + 7);
+                        p = hmac_sha_1_ooo->ldata[j].outer_block;
+                        memset(p + 5*4 + 1,
+                               0x00,
+                               64 - 5*4 - 1 - 2);
+                        p[5 * 4] = 0x80;
+                        p[64 - 2] = 0x02;
+                        p[64 - 1] = 0xA0;
+                }
         }
         /* Init HMAC/SHA224 out-of-order fields */
-        hmac_sha_224_ooo->lens[0] = 0;
-        hmac_sha_224_ooo->lens[1] = 0;
-        hmac_sha_224_ooo->lens[2] = 0;
-        hmac_sha_224_ooo->lens[3] = 0;
-        hmac_sha_224_ooo->lens[4] = 0;
-        hmac_sha_224_ooo->lens[5] = 0;
-        hmac_sha_224_ooo->lens[6] = 0;
-        hmac_sha_224_ooo->lens[7] = 0;
-        hmac_sha_224_ooo->unused_lanes = 0xF76543210;
-        /* sha256 and sha224 are very similar except for
-         * digest constants and output size
-         */
-        for (j = 0; j < AVX2_NUM_SHA256_LANES; j++) {
-                hmac_sha_224_ooo->ldata[j].job_in_lane = NULL;
-
-                p = hmac_sha_224_ooo->ldata[j].extra_block;
-                size = sizeof(hmac_sha_224_ooo->ldata[j].extra_block);
-                memset (p, 0x00, size);
-                p[64] = 0x80;
-
-                p = hmac_sha_224_ooo->ldata[j].outer_block;
-                size = sizeof(hmac_sha_224_ooo->ldata[j].outer_block);
-                memset(p, 0x00, size);
-                p[7 * 4] = 0x80;  /* digest 7 words long */
-                p[64 - 2] = 0x02; /* length in little endian = 0x02E0 */
-                p[64 - 1] = 0xE0;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_224_ooo->lens[0] = 0;
+                hmac_sha_224_ooo->lens[1] = 0;
+                hmac_sha_224_ooo->lens[2] = 0;
+                hmac_sha_224_ooo->lens[3] = 0;
+                hmac_sha_224_ooo->lens[4] = 0;
+                hmac_sha_224_ooo->lens[5] = 0;
+                hmac_sha_224_ooo->lens[6] = 0;
+                hmac_sha_224_ooo->lens[7] = 0;
+                hmac_sha_224_ooo->unused_lanes = 0xF76543210;
+                /* sha256 and sha224 are very similar except for
+                 * digest constants and output size
+                 */
+                for (j = 0; j < AVX2_NUM_SHA256_LANES; j++) {
+                        hmac_sha_224_ooo->ldata[j].job_in_lane = NULL;
+
+                        p = hmac_sha_224_ooo->ldata[j].extra_block;
+                        size = sizeof(hmac_sha_224_ooo->ldata[j].extra_block);
+                        memset (p, 0x00, size);
+                        p[64] = 0x80;
+
+                        p = hmac_sha_224_ooo->ldata[j].outer_block;
+                        size = sizeof(hmac_sha_224_ooo->ldata[j].outer_block);
+                        memset(p, 0x00, size);
+                        p[7 * 4] = 0x80;  /* digest 7 words long */
+                        p[64 - 2] = 0x02; /* length in little endian = 0x02E0 */
+                        p[64 - 1] = 0xE0;
+                }
         }
 
         /* Init HMAC/SHA256 out-of-order fields */
-        hmac_sha_256_ooo->lens[0] = 0;
-        hmac_sha_256_ooo->lens[1] = 0;
-        hmac_sha_256_ooo->lens[2] = 0;
-        hmac_sha_256_ooo->lens[3] = 0;
-        hmac_sha_256_ooo->lens[4] = 0;
-        hmac_sha_256_ooo->lens[5] = 0;
-        hmac_sha_256_ooo->lens[6] = 0;
-        hmac_sha_256_ooo->lens[7] = 0;
-        hmac_sha_256_ooo->unused_lanes = 0xF76543210;
-        for (j = 0; j < AVX2_NUM_SHA256_LANES; j++) {
-                hmac_sha_256_ooo->ldata[j].job_in_lane = NULL;
-                hmac_sha_256_ooo->ldata[j].extra_block[64] = 0x80;
-                memset(hmac_sha_256_ooo->ldata[j].extra_block + 65,
-                       0x00,
-                       64 + 7);
-                /* hmac related */
-                p = hmac_sha_256_ooo->ldata[j].outer_block;
-                memset(p + 8*4 + 1,
-                       0x00,
-                       64 - 8*4 - 1 - 2);
-                p[8 * 4] = 0x80;  /* 8 digest words */
-                p[64 - 2] = 0x03; /* length */
-                p[64 - 1] = 0x00;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_256_ooo->lens[0] = 0;
+                hmac_sha_256_ooo->lens[1] = 0;
+                hmac_sha_256_ooo->lens[2] = 0;
+                hmac_sha_256_ooo->lens[3] = 0;
+                hmac_sha_256_ooo->lens[4] = 0;
+                hmac_sha_256_ooo->lens[5] = 0;
+                hmac_sha_256_ooo->lens[6] = 0;
+                hmac_sha_256_ooo->lens[7] = 0;
+                hmac_sha_256_ooo->unused_lanes = 0xF76543210;
+                for (j = 0; j < AVX2_NUM_SHA256_LANES; j++) {
+                        hmac_sha_256_ooo->ldata[j].job_in_lane = NULL;
+                        hmac_sha_256_ooo->ldata[j].extra_block[64] = 0x80;
+                        memset(hmac_sha_256_ooo->ldata[j].extra_block + 65,
+                               0x00,
+                               64 + 7);
+                        /* hmac related */
+                        p = hmac_sha_256_ooo->ldata[j].outer_block;
+                        memset(p + 8*4 + 1,
+                               0x00,
+                               64 - 8*4 - 1 - 2);
+                        p[8 * 4] = 0x80;  /* 8 digest words */
+                        p[64 - 2] = 0x03; /* length */
+                        p[64 - 1] = 0x00;
+                }
+        }
+
+        /*
+         * Init HMAC/SHA1, SHA224 and SHA256 SHA-NI out-of-order fields
+         * (2 lanes), used at low queue depth
+         */
+        if (state->algos & IMB_ALGO_HMAC_SHA1) {
+                memset(hmac_sha_1_ni_ooo, 0, sizeof(*hmac_sha_1_ni_ooo));
+                memset(&hmac_sha_1_ni_ooo->lens[2], 0xFF,
+                       sizeof(hmac_sha_1_ni_ooo->lens) - 2 * sizeof(uint16_t));
+                hmac_sha_1_ni_ooo->unused_lanes = 0xFF0100;
+                for (j = 0; j < 2; j++) {
+                        hmac_sha_1_ni_ooo->ldata[j].extra_block[64] = 0x80;
+                        p = hmac_sha_1_ni_ooo->ldata[j].outer_block;
+                        p[5 * 4] = 0x80;
+                        p[64 - 2] = 0x02;
+                        p[64 - 1] = 0xA0;
+                }
+        }
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                memset(hmac_sha_224_ni_ooo, 0, sizeof(*hmac_sha_224_ni_ooo));
+                memset(hmac_sha_256_ni_ooo, 0, sizeof(*hmac_sha_256_ni_ooo));
+                memset(&hmac_sha_224_ni_ooo->lens[2], 0xFF,
+                       sizeof(hmac_sha_224_ni_ooo->lens) -
+                       2 * sizeof(uint16_t));
+                memset(&hmac_sha_256_ni_ooo->lens[2], 0xFF,
+                       sizeof(hmac_sha_256_ni_ooo->lens) -
+                       2 * sizeof(uint16_t));
+                hmac_sha_224_ni_ooo->unused_lanes = 0xFF0100;
+                hmac_sha_256_ni_ooo->unused_lanes = 0xFF0100;
+                for (j = 0; j < 2; j++) {
+                        hmac_sha_224_ni_ooo->ldata[j].extra_block[64] = 0x80;
+                        p = hmac_sha_224_ni_ooo->ldata[j].outer_block;
+                        p[7 * 4] = 0x80;
+                        p[64 - 2] = 0x02;
+                        p[64 - 1] = 0xE0;
+
+                        hmac_sha_256_ni_ooo->ldata[j].extra_block[64] = 0x80;
+                        p = hmac_sha_256_ni_ooo->ldata[j].outer_block;
+                        p[8 * 4] = 0x80;
+                        p[64 - 2] = 0x03;
+                        p[64 - 1] = 0x00;
+                }
         }
 
         /* Init HMAC/SHA384 out-of-order fields */
-        hmac_sha_384_ooo->lens[0] = 0;
-        hmac_sha_384_ooo->lens[1] = 0;
-        hmac_sha_384_ooo->lens[2] = 0;
-        hmac_sha_384_ooo->lens[3] = 0;
-        hmac_sha_384_ooo->lens[4] = 0xFFFF;
-        hmac_sha_384_ooo->lens[5] = 0xFFFF;
-        hmac_sha_384_ooo->lens[6] = 0xFFFF;
-        hmac_sha_384_ooo->lens[7] = 0xFFFF;
-        hmac_sha_384_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < AVX2_NUM_SHA512_LANES; j++) {
-                MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_384_ooo;
-
-                ctx->ldata[j].job_in_lane = NULL;
-                ctx->ldata[j].extra_block[SHA_384_BLOCK_SIZE] = 0x80;
-                memset(ctx->ldata[j].extra_block + (SHA_384_BLOCK_SIZE + 1),
-                       0x00, SHA_384_BLOCK_SIZE + 7);
-                p = ctx->ldata[j].outer_block;
-                /* special end point because this length is constant */
-                memset(p + SHA384_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
-                       SHA_384_BLOCK_SIZE -
-                       SHA384_DIGEST_SIZE_IN_BYTES  - 1 - 2);
-                /* mark the end */
-                p[SHA384_DIGEST_SIZE_IN_BYTES] = 0x80;
-                /* hmac outer block length always of fixed size,
-                 * it is OKey length, a whole message block length, 1024 bits,
-                 * with padding plus the length of the inner digest,
-                 * which is 384 bits, 1408 bits == 0x0580.
-                 * The input message block needs to be converted to big endian
-                 * within the sha implementation before use.
-                 */
-                p[SHA_384_BLOCK_SIZE - 2] = 0x05;
-                p[SHA_384_BLOCK_SIZE - 1] = 0x80;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_384_ooo->lens[0] = 0;
+                hmac_sha_384_ooo->lens[1] = 0;
+                hmac_sha_384_ooo->lens[2] = 0;
+                hmac_sha_384_ooo->lens[3] = 0;
+                hmac_sha_384_ooo->lens[4] = 0xFFFF;
+                hmac_sha_384_ooo->lens[5] = 0xFFFF;
+                hmac_sha_384_ooo->lens[6] = 0xFFFF;
+                hmac_sha_384_ooo->lens[7] = 0xFFFF;
+                hmac_sha_384_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < AVX2_NUM_SHA512_LANES; j++) {
+                        MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_384_ooo;
+
+                        ctx->ldata[j].job_in_lane = NULL;
+                        ctx->ldata[j].extra_block[SHA_384_BLOCK_SIZE] = 0x80;
+                        memset(ctx->ldata[j].extra_block +
+                               (SHA_384_BLOCK_SIZE + 1),
+                               0x00, SHA_384_BLOCK_SIZE + 7);
+                        p = ctx->ldata[j].outer_block;
+                        /* special end point because this length is constant */
+                        memset(p + SHA384_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
+                               SHA_384_BLOCK_SIZE -
+                               SHA384_DIGEST_SIZE_IN_BYTES  - 1 - 2);
+                        /* mark the end */
+                        p[SHA384_DIGEST_SIZE_IN_BYTES] = 0x80;
+                        /*
+                         * hmac outer block length always of fixed size, it is
+                         * OKey length, a whole message block length, 1024 bits,
+                         * with padding plus the length of the inner digest,
+                         * which is 384 bits, 1408 bits == 0x0580. The input
+                         * message block needs to be converted to big endian
+                         * within the sha implementation before use.
+                         */
+                        p[SHA_384_BLOCK_SIZE - 2] = 0x05;
+                        p[SHA_384_BLOCK_SIZE - 1] = 0x80;
+                }
         }
 
         /* Init HMAC/SHA512 out-of-order fields */
-        hmac_sha_512_ooo->lens[0] = 0;
-        hmac_sha_512_ooo->lens[1] = 0;
-        hmac_sha_512_ooo->lens[2] = 0;
-        hmac_sha_512_ooo->lens[3] = 0;
-        hmac_sha_512_ooo->lens[4] = 0xFFFF;
-        hmac_sha_512_ooo->lens[5] = 0xFFFF;
-        hmac_sha_512_ooo->lens[6] = 0xFFFF;
-        hmac_sha_512_ooo->lens[7] = 0xFFFF;
-        hmac_sha_512_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < AVX2_NUM_SHA512_LANES; j++) {
-                MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_512_ooo;
-
-                ctx->ldata[j].job_in_lane = NULL;
-                ctx->ldata[j].extra_block[SHA_512_BLOCK_SIZE] = 0x80;
-                memset(ctx->ldata[j].extra_block + (SHA_512_BLOCK_SIZE + 1),
-                       0x00, SHA_512_BLOCK_SIZE + 7);
-                p = ctx->ldata[j].outer_block;
-                /* special end point because this length is constant */
-                memset(p + SHA512_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
-                       SHA_512_BLOCK_SIZE -
-                       SHA512_DIGEST_SIZE_IN_BYTES  - 1 - 2);
-                /* mark the end */
-                p[SHA512_DIGEST_SIZE_IN_BYTES] = 0x80;
-                /* hmac outer block length always of fixed size,
-                 * it is OKey length, a whole message block length, 1024 bits,
-                 * with padding plus the length of the inner digest,
-                 * which is 512 bits, 1536 bits == 0x600.
-                 * The input message block needs to be converted to big endian
-                 * within the sha implementation before use.
-                 */
-                p[SHA_512_BLOCK_SIZE - 2] = 0x06;
-                p[SHA_512_BLOCK_SIZE - 1] = 0x00;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_512_ooo->lens[0] = 0;
+                hmac_sha_512_ooo->lens[1] = 0;
+                hmac_sha_512_ooo->lens[2] = 0;
+                hmac_sha_512_ooo->lens[3] = 0;
+                hmac_sha_512_ooo->lens[4] = 0xFFFF;
+                hmac_sha_512_ooo->lens[5] = 0xFFFF;
+                hmac_sha_512_ooo->lens[6] = 0xFFFF;
+                hmac_sha_512_ooo->lens[7] = 0xFFFF;
+                hmac_sha_512_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < AVX2_NUM_SHA512_LANES; j++) {
+                        MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_512_ooo;
+
+                        ctx->ldata[j].job_in_lane = NULL;
+                        ctx->ldata[j].extra_block[SHA_512_BLOCK_SIZE] = 0x80;
+                        memset(ctx->ldata[j].extra_block +
+                               (SHA_512_BLOCK_SIZE + 1),
+                               0x00, SHA_512_BLOCK_SIZE + 7);
+                        p = ctx->ldata[j].outer_block;
+                        /* special end point because this length is constant */
+                        memset(p + SHA512_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
+                               SHA_512_BLOCK_SIZE -
+                               SHA512_DIGEST_SIZE_IN_BYTES  - 1 - 2);
+                        /* mark the end */
+                        p[SHA512_DIGEST_SIZE_IN_BYTES] = 0x80;
+                        /*
+                         * hmac outer block length always of fixed size, it is
+                         * OKey length, a whole message block length, 1024 bits,
+                         * with padding plus the length of the inner digest,
+                         * which is 512 bits, 1536 bits == 0x600. The input
+                         * message block needs to be converted to big endian
+                         * within the sha implementation before use.
+                         */
+                        p[SHA_512_BLOCK_SIZE - 2] = 0x06;
+                        p[SHA_512_BLOCK_SIZE - 1] = 0x00;
+                }
         }
 
         /* Init HMAC/MD5 out-of-order fields */
-        hmac_md5_ooo->lens[0] = 0;
-        hmac_md5_ooo->lens[1] = 0;
-        hmac_md5_ooo->lens[2] = 0;
-        hmac_md5_ooo->lens[3] = 0;
-        hmac_md5_ooo->lens[4] = 0;
-        hmac_md5_ooo->lens[5] = 0;
-        hmac_md5_ooo->lens[6] = 0;
-        hmac_md5_ooo->lens[7] = 0;
-        hmac_md5_ooo->lens[8] = 0;
-        hmac_md5_ooo->lens[9] = 0;
-        hmac_md5_ooo->lens[10] = 0;
-        hmac_md5_ooo->lens[11] = 0;
-        hmac_md5_ooo->lens[12] = 0;
-        hmac_md5_ooo->lens[13] = 0;
-        hmac_md5_ooo->lens[14] = 0;
-        hmac_md5_ooo->lens[15] = 0;
-        hmac_md5_ooo->unused_lanes = 0xFEDCBA9876543210;
-        hmac_md5_ooo->num_lanes_inuse = 0;
-        for (j = 0; j < AVX2_NUM_MD5_LANES; j++) {
-                hmac_md5_ooo->ldata[j].job_in_lane = NULL;
-
-                p = hmac_md5_ooo->ldata[j].extra_block;
-                size = sizeof(hmac_md5_ooo->ldata[j].extra_block);
-                memset (p, 0x00, size);
-                p[64] = 0x80;
-
-                p = hmac_md5_ooo->ldata[j].outer_block;
-                size = sizeof(hmac_md5_ooo->ldata[j].outer_block);
-                memset(p, 0x00, size);
-                p[4 * 4] = 0x80;
-                p[64 - 7] = 0x02;
-                p[64 - 8] = 0x80;
+        if (state->algos & IMB_ALGO_HMAC_MD5) {
+                hmac_md5_ooo->lens[0] = 0;
+                hmac_md5_ooo->lens[1] = 0;
+                hmac_md5_ooo->lens[2] = 0;
+                hmac_md5_ooo->lens[3] = 0;
+                hmac_md5_ooo->lens[4] = 0;
+                hmac_md5_ooo->lens[5] = 0;
+                hmac_md5_ooo->lens[6] = 0;
+                hmac_md5_ooo->lens[7] = 0;
+                hmac_md5_ooo->lens[8] = 0;
+                hmac_md5_ooo->lens[9] = 0;
+                hmac_md5_ooo->lens[10] = 0;
+                hmac_md5_ooo->lens[11] = 0;
+                hmac_md5_ooo->lens[12] = 0;
+                hmac_md5_ooo->lens[13] = 0;
+                hmac_md5_ooo->lens[14] = 0;
+                hmac_md5_ooo->lens[15] = 0;
+                hmac_md5_ooo->unused_lanes = 0xFEDCBA9876543210;
+                hmac_md5_ooo->num_lanes_inuse = 0;
+                for (j = 0; j < AVX2_NUM_MD5_LANES; j++) {
+                        hmac_md5_ooo->ldata[j].job_in_lane = NULL;
+
+                        p = hmac_md5_ooo->ldata[j].extra_block;
+                        size = sizeof(hmac_md5_ooo->ldata[j].extra_block);
+                        memset (p, 0x00, size);
+                        p[64] = 0x80;
+
+                        p = hmac_md5_ooo->ldata[j].outer_block;
+                        size = sizeof(hmac_md5_ooo->ldata[j].outer_block);
+                        memset(p, 0x00, size);
+                        p[4 * 4] = 0x80;
+                        p[64 - 7] = 0x02;
+                        p[64 - 8] = 0x80;
+                }
         }
 
         /* Init AES/XCBC OOO fields */
-        aes_xcbc_ooo->lens[0] = 0;
-        aes_xcbc_ooo->lens[1] = 0;
-        aes_xcbc_ooo->lens[2] = 0;
-        aes_xcbc_ooo->lens[3] = 0;
-        aes_xcbc_ooo->lens[4] = 0;
-        aes_xcbc_ooo->lens[5] = 0;
-        aes_xcbc_ooo->lens[6] = 0;
-        aes_xcbc_ooo->lens[7] = 0;
-        aes_xcbc_ooo->unused_lanes = 0xF76543210;
-        for (j = 0; j < 8 ; j++) {
-                aes_xcbc_ooo->ldata[j].job_in_lane = NULL;
-                aes_xcbc_ooo->ldata[j].final_block[16] = 0x80;
-                memset(aes_xcbc_ooo->ldata[j].final_block + 17, 0x00, 15);
+        if (state->algos & IMB_ALGO_AES_XCBC) {
+                memset(aes_xcbc_ooo->lens, 0xFF,
+                       sizeof(aes_xcbc_ooo->lens));
+                aes_xcbc_ooo->unused_lanes = 0xF76543210;
+                for (j = 0; j < 8 ; j++) {
+                        aes_xcbc_ooo->ldata[j].job_in_lane = NULL;
+                        aes_xcbc_ooo->ldata[j].final_block[16] = 0x80;
+                        memset(aes_xcbc_ooo->ldata[j].final_block +
+                               17, 0x00, 15);
+                }
         }
 
         /* Init AES-CCM auth out-of-order fields */
-        for (j = 0; j < 8; j++) {
-                aes_ccm_ooo->init_done[j] = 0;
-                aes_ccm_ooo->lens[j] = 0;
-                aes_ccm_ooo->job_in_lane[j] = NULL;
+        if (state->algos & IMB_ALGO_AES_CCM) {
+                for (j = 0; j < 8; j++) {
+                        aes_ccm_ooo->init_done[j] = 0;
+                        aes_ccm_ooo->lens[j] = 0;
+                        aes_ccm_ooo->job_in_lane[j] = NULL;
+                }
+                for (; j < 16; j++)
+                        aes_ccm_ooo->lens[j] = 0xFFFF;
+
+                aes_ccm_ooo->unused_lanes = 0xF76543210;
+                aes_ccm_ooo->num_lanes_inuse = 0;
         }
-        for (; j < 16; j++)
-                aes_ccm_ooo->lens[j] = 0xFFFF;
-
-        aes_ccm_ooo->unused_lanes = 0xF76543210;
-        aes_ccm_ooo->num_lanes_inuse = 0;
 
         /* Init AES-CMAC auth out-of-order fields */
-        for (j = 0; j < 8; j++) {
-                aes_cmac_ooo->init_done[j] = 0;
-                aes_cmac_ooo->lens[j] = 0;
-                aes_cmac_ooo->job_in_lane[j] = NULL;
+        if (state->algos & IMB_ALGO_AES_CMAC) {
+                for (j = 0; j < 8; j++) {
+                        aes_cmac_ooo->init_done[j] = 0;
+                        aes_cmac_ooo->job_in_lane[j] = NULL;
+                }
+                memset(aes_cmac_ooo->lens, 0xFF,
+                       sizeof(aes_cmac_ooo->lens));
+                aes_cmac_ooo->unused_lanes = 0xF76543210;
+                aes_cmac_ooo->num_lanes_inuse = 0;
         }
-        aes_cmac_ooo->unused_lanes = 0xF76543210;
-        aes_cmac_ooo->num_lanes_inuse = 0;
 
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->flush_budget_jobs = 0;
+        state->flush_budget_cycles = 0;
+#ifdef MB_STATS
+        if (state->stats != NULL)
+                memset(state->stats, 0, sizeof(MB_MGR_STATS));
+#endif
 
         /* set handlers */
         state->get_next_job        = get_next_job_avx2;
@@ -704,6 +1114,11 @@ init_mb_mgr_avx2(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_avx2;
         state->flush_job           = flush_job_avx2;
         state->queue_size          = queue_size_avx2;
+        state->get_next_burst      = get_next_burst_avx2;
+        state->submit_burst        = submit_burst_avx2;
+        state->submit_burst_nocheck = submit_burst_nocheck_avx2;
+        state->get_completed_burst = get_completed_burst_avx2;
+        state->flush_burst         = flush_burst_avx2;
         state->keyexp_128          = aes_keyexp_128_avx2;
         state->keyexp_192          = aes_keyexp_192_avx2;
         state->keyexp_256          = aes_keyexp_256_avx2;
@@ -748,11 +1163,23 @@ init_mb_mgr_avx2(IMB_MGR *state)
         state->snow3g_f8_8_buffer  = snow3g_f8_8_buffer_avx2;
         state->snow3g_f8_n_buffer  = snow3g_f8_n_buffer_avx2;
         state->snow3g_f8_8_buffer_multikey = snow3g_f8_8_buffer_multikey_avx2;
+        state->snow3g_f8_16_buffer_multikey =
+                snow3g_f8_16_buffer_multikey_avx2;
         state->snow3g_f8_n_buffer_multikey = snow3g_f8_n_buffer_multikey_avx2;
         state->snow3g_f9_1_buffer = snow3g_f9_1_buffer_avx2;
+        state->snow3g_f9_n_buffer = snow3g_f9_n_buffer_avx2;
+        state->snow3g_f9_n_buffer_multikey = snow3g_f9_n_buffer_multikey_avx2;
         state->snow3g_init_key_sched = snow3g_init_key_sched_avx2;
         state->snow3g_key_sched_size = snow3g_key_sched_size_avx2;
 
+        state->crc32_ethernet_fcs  = crc32_ethernet_fcs_avx;
+        state->crc16_ccitt         = crc16_ccitt_avx;
+        state->crc24_a             = crc24_a_avx;
+        state->crc24_b             = crc24_b_avx;
+        state->crc11               = crc11_avx;
+        state->crc6                = crc6_avx;
+        state->crc_n_buffer        = crc_n_buffer_avx;
+
         state->gcm128_enc          = aes_gcm_enc_128_avx_gen4;
         state->gcm192_enc          = aes_gcm_enc_192_avx_gen4;
         state->gcm256_enc          = aes_gcm_enc_256_avx_gen4;
@@ -0,0 +1,53 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#define SUBMIT_JOB_SHA1   submit_job_sha1_avx2
+#define FLUSH_JOB_SHA1    flush_job_sha1_avx2
+#define SUBMIT_JOB_SHA224 submit_job_sha224_avx2
+#define FLUSH_JOB_SHA224  flush_job_sha224_avx2
+#define SUBMIT_JOB_SHA256 submit_job_sha256_avx2
+#define FLUSH_JOB_SHA256  flush_job_sha256_avx2
+#define SUBMIT_JOB_SHA384 submit_job_sha384_avx2
+#define FLUSH_JOB_SHA384  flush_job_sha384_avx2
+#define SUBMIT_JOB_SHA512 submit_job_sha512_avx2
+#define FLUSH_JOB_SHA512  flush_job_sha512_avx2
+
+#define SHA1_MB_KERNEL    call_sha1_x8_avx2_from_c
+#define SHA256_MB_KERNEL  call_sha256_oct_avx2_from_c
+#define SHA512_MB_KERNEL  call_sha512_x4_avx2_from_c
+
+#define SHA1_NUM_LANES    AVX2_NUM_SHA1_LANES
+#define SHA256_NUM_LANES  AVX2_NUM_SHA256_LANES
+#define SHA512_NUM_LANES  AVX2_NUM_SHA512_LANES
+
+#define SHA1_ONE_BUFFER   sha1_avx2
+#define SHA224_ONE_BUFFER sha224_avx2
+#define SHA256_ONE_BUFFER sha256_avx2
+#define SHA384_ONE_BUFFER sha384_avx2
+#define SHA512_ONE_BUFFER sha512_avx2
+
+#include "include/sha_ooo_common.h"
@@ -40,6 +40,7 @@
 %include "mb_mgr_datastruct.asm"
 %include "include/transpose_avx2.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 section .data
 default rel
@@ -462,6 +463,9 @@ lloop:
 
 	ret
 
+;; void call_sha1_x8_avx2_from_c(SHA1_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha1_x8_avx2_from_c, sha1_x8_avx2, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
@@ -46,6 +46,7 @@
 %include "mb_mgr_datastruct.asm"
 %include "include/transpose_avx2.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 section .data
 default rel
@@ -583,6 +584,9 @@ Lrounds_16_xx:
 	add rsp, FRAMESZ
 	ret
 
+;; void call_sha256_oct_avx2_from_c(SHA256_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha256_oct_avx2_from_c, sha256_oct_avx2, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
@@ -47,6 +47,7 @@
 %include "include/dbgprint.asm"
 %include "mb_mgr_datastruct.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 section .data
 default rel
@@ -448,6 +449,9 @@ Lrounds_16_xx:
 	; outer calling routine restores XMM and other GP registers
 	ret
 
+;; void call_sha512_x4_avx2_from_c(SHA512_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha512_x4_avx2_from_c, sha512_x4_avx2, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
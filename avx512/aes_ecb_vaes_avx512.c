@@ -0,0 +1,256 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * AES-ECB encrypt/decrypt with VAES, 16 blocks at a time.
+ *
+ * Round keys are broadcast to all 4 128-bit lanes of ZMM registers,
+ * so each VAESENC/VAESDEC processes 4 blocks. The main loop runs
+ * 4 ZMM registers (16 blocks), the remaining blocks are processed
+ * one ZMM register at a time, the last 1 to 3 blocks with masked
+ * loads and stores.
+ */
+
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "asm.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+
+#define AES_BLOCK_SIZE 16
+
+#ifndef _WIN32
+/**
+ * @brief Runs AES rounds on one ZMM register (4 blocks)
+ *
+ * @param [in] d        4 blocks of plain/cipher text
+ * @param [in] rk       Round keys broadcast to 4 lanes
+ * @param [in] nrounds  Number of rounds (10, 12 or 14)
+ * @param [in] enc      1 - encrypt, 0 - decrypt
+ *
+ * @return 4 blocks of cipher/plain text
+ */
+__forceinline __m512i
+aes_ecb_x4(__m512i d, const __m512i *rk, const unsigned nrounds,
+           const unsigned enc)
+{
+        unsigned r;
+
+        d = _mm512_xor_si512(d, rk[0]);
+        if (enc) {
+                for (r = 1; r < nrounds; r++)
+                        d = _mm512_aesenc_epi128(d, rk[r]);
+                d = _mm512_aesenclast_epi128(d, rk[nrounds]);
+        } else {
+                for (r = 1; r < nrounds; r++)
+                        d = _mm512_aesdec_epi128(d, rk[r]);
+                d = _mm512_aesdeclast_epi128(d, rk[nrounds]);
+        }
+        return d;
+}
+
+/**
+ * @brief AES-ECB encrypt/decrypt, 16 blocks at a time
+ *
+ * @param [in] in         Input buffer
+ * @param [in] keys       Expanded keys (encrypt or decrypt, as per enc)
+ * @param [out] out       Output buffer
+ * @param [in] len_bytes  Length in bytes (multiple of 16)
+ * @param [in] nrounds    Number of rounds (10, 12 or 14)
+ * @param [in] enc        1 - encrypt, 0 - decrypt
+ */
+__forceinline void
+aes_ecb_by16(const void *in, const void *keys, void *out,
+             const uint64_t len_bytes, const unsigned nrounds,
+             const unsigned enc)
+{
+        const __m128i *k = (const __m128i *) keys;
+        const uint8_t *pin = (const uint8_t *) in;
+        uint8_t *pout = (uint8_t *) out;
+        uint64_t nblocks = len_bytes / AES_BLOCK_SIZE;
+        __m512i rk[15];
+        unsigned r;
+
+        for (r = 0; r <= nrounds; r++)
+                rk[r] = _mm512_broadcast_i32x4(_mm_load_si128(&k[r]));
+
+        while (nblocks >= 16) {
+                __m512i d0 = _mm512_loadu_si512(&pin[0 * 64]);
+                __m512i d1 = _mm512_loadu_si512(&pin[1 * 64]);
+                __m512i d2 = _mm512_loadu_si512(&pin[2 * 64]);
+                __m512i d3 = _mm512_loadu_si512(&pin[3 * 64]);
+
+                /* interleave the 4 registers to hide AES latency */
+                d0 = _mm512_xor_si512(d0, rk[0]);
+                d1 = _mm512_xor_si512(d1, rk[0]);
+                d2 = _mm512_xor_si512(d2, rk[0]);
+                d3 = _mm512_xor_si512(d3, rk[0]);
+                if (enc) {
+                        for (r = 1; r < nrounds; r++) {
+                                d0 = _mm512_aesenc_epi128(d0, rk[r]);
+                                d1 = _mm512_aesenc_epi128(d1, rk[r]);
+                                d2 = _mm512_aesenc_epi128(d2, rk[r]);
+                                d3 = _mm512_aesenc_epi128(d3, rk[r]);
+                        }
+                        d0 = _mm512_aesenclast_epi128(d0, rk[nrounds]);
+                        d1 = _mm512_aesenclast_epi128(d1, rk[nrounds]);
+                        d2 = _mm512_aesenclast_epi128(d2, rk[nrounds]);
+                        d3 = _mm512_aesenclast_epi128(d3, rk[nrounds]);
+                } else {
+                        for (r = 1; r < nrounds; r++) {
+                                d0 = _mm512_aesdec_epi128(d0, rk[r]);
+                                d1 = _mm512_aesdec_epi128(d1, rk[r]);
+                                d2 = _mm512_aesdec_epi128(d2, rk[r]);
+                                d3 = _mm512_aesdec_epi128(d3, rk[r]);
+                        }
+                        d0 = _mm512_aesdeclast_epi128(d0, rk[nrounds]);
+                        d1 = _mm512_aesdeclast_epi128(d1, rk[nrounds]);
+                        d2 = _mm512_aesdeclast_epi128(d2, rk[nrounds]);
+                        d3 = _mm512_aesdeclast_epi128(d3, rk[nrounds]);
+                }
+
+                _mm512_storeu_si512(&pout[0 * 64], d0);
+                _mm512_storeu_si512(&pout[1 * 64], d1);
+                _mm512_storeu_si512(&pout[2 * 64], d2);
+                _mm512_storeu_si512(&pout[3 * 64], d3);
+
+                pin += 16 * AES_BLOCK_SIZE;
+                pout += 16 * AES_BLOCK_SIZE;
+                nblocks -= 16;
+        }
+
+        while (nblocks >= 4) {
+                __m512i d = _mm512_loadu_si512(pin);
+
+                d = aes_ecb_x4(d, rk, nrounds, enc);
+                _mm512_storeu_si512(pout, d);
+
+                pin += 4 * AES_BLOCK_SIZE;
+                pout += 4 * AES_BLOCK_SIZE;
+                nblocks -= 4;
+        }
+
+        if (nblocks != 0) {
+                /* 2 quad words per block */
+                const __mmask8 mask = (__mmask8) ((1 << (nblocks * 2)) - 1);
+                __m512i d = _mm512_maskz_loadu_epi64(mask, pin);
+
+                d = aes_ecb_x4(d, rk, nrounds, enc);
+                _mm512_mask_storeu_epi64(pout, mask, d);
+        }
+
+#ifdef SAFE_DATA
+        clear_scratch_zmms();
+#endif
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_enc_128_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_by16(in, keys, out, len_bytes, 10, 1);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_enc_192_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_by16(in, keys, out, len_bytes, 12, 1);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_enc_256_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_by16(in, keys, out, len_bytes, 14, 1);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_dec_128_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_by16(in, keys, out, len_bytes, 10, 0);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_dec_192_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_by16(in, keys, out, len_bytes, 12, 0);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_dec_256_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_by16(in, keys, out, len_bytes, 14, 0);
+}
+#else /* _WIN32 */
+/* use AVX implementation on Windows for now */
+IMB_DLL_LOCAL void
+aes_ecb_enc_128_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_enc_128_avx(in, keys, out, len_bytes);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_enc_192_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_enc_192_avx(in, keys, out, len_bytes);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_enc_256_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_enc_256_avx(in, keys, out, len_bytes);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_dec_128_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_dec_128_avx(in, keys, out, len_bytes);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_dec_192_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_dec_192_avx(in, keys, out, len_bytes);
+}
+
+IMB_DLL_LOCAL void
+aes_ecb_dec_256_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_dec_256_avx(in, keys, out, len_bytes);
+}
+#endif /* _WIN32 */
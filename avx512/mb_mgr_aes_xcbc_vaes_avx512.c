@@ -0,0 +1,318 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * AES-XCBC-MAC-96 out-of-order manager with 16 lanes (VAES).
+ *
+ * Round keys of all lanes are kept in args.key_tab[round][lane], so that
+ * one 512-bit load gets a round key for 4 lanes and each VAESENC runs
+ * 4 lanes. The final (padded and XOR'ed with K2/K3) block is prepared
+ * on submit, the lane input is switched to it when the message blocks
+ * are done. Unused lanes keep length 0xFFFF and follow the input of
+ * a valid lane on flush.
+ */
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+#include "include/ooo_idle_lanes.h"
+
+#define AES_XCBC_BLOCK_SIZE  16
+#define AES_XCBC_DIGEST_SIZE 12
+#define AES_XCBC_NUM_ROUNDS  10
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_xcbc_vaes_avx512(MB_MGR_AES_XCBC_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_xcbc_vaes_avx512(MB_MGR_AES_XCBC_OOO *state);
+
+#ifndef _WIN32
+/**
+ * @brief Runs AES-CBC-MAC on all 16 lanes
+ *
+ * @param [in/out] args   Lane arguments
+ * @param [in] num_blocks Number of blocks to process in each lane
+ */
+static void
+aes_xcbc_x16(AES_XCBC_ARGS_x16 *args, const uint64_t num_blocks)
+{
+        __m512i icv[AES_XCBC_VAES_NUM_LANES / 4];
+        uint64_t i, offset = 0;
+        unsigned g, r;
+
+        for (g = 0; g < AES_XCBC_VAES_NUM_LANES / 4; g++)
+                icv[g] = _mm512_loadu_si512(&args->ICV[g * 4]);
+
+        for (i = 0; i < num_blocks; i++) {
+                for (g = 0; g < AES_XCBC_VAES_NUM_LANES / 4; g++) {
+                        const uint8_t *const *in = &args->in[g * 4];
+                        __m512i d;
+
+                        d = _mm512_castsi128_si512
+                                (_mm_loadu_si128((const __m128i *)
+                                                 &in[0][offset]));
+                        d = _mm512_inserti32x4(d, _mm_loadu_si128
+                                               ((const __m128i *)
+                                                &in[1][offset]), 1);
+                        d = _mm512_inserti32x4(d, _mm_loadu_si128
+                                               ((const __m128i *)
+                                                &in[2][offset]), 2);
+                        d = _mm512_inserti32x4(d, _mm_loadu_si128
+                                               ((const __m128i *)
+                                                &in[3][offset]), 3);
+                        icv[g] = _mm512_xor_si512(icv[g], d);
+                        icv[g] = _mm512_xor_si512(icv[g],
+                                                  _mm512_load_si512
+                                                  (&args->key_tab[0][g * 4]));
+                }
+
+                for (r = 1; r < AES_XCBC_NUM_ROUNDS; r++)
+                        for (g = 0; g < AES_XCBC_VAES_NUM_LANES / 4; g++)
+                                icv[g] = _mm512_aesenc_epi128
+                                        (icv[g], _mm512_load_si512
+                                         (&args->key_tab[r][g * 4]));
+
+                for (g = 0; g < AES_XCBC_VAES_NUM_LANES / 4; g++)
+                        icv[g] = _mm512_aesenclast_epi128
+                                (icv[g], _mm512_load_si512
+                                 (&args->key_tab[AES_XCBC_NUM_ROUNDS][g * 4]));
+
+                offset += AES_XCBC_BLOCK_SIZE;
+        }
+
+        for (g = 0; g < AES_XCBC_VAES_NUM_LANES / 4; g++)
+                _mm512_storeu_si512(&args->ICV[g * 4], icv[g]);
+
+        for (g = 0; g < AES_XCBC_VAES_NUM_LANES; g++)
+                args->in[g] += offset;
+}
+#else /* _WIN32 */
+/* use AES-NI on Windows for now */
+static void
+aes_xcbc_x16(AES_XCBC_ARGS_x16 *args, const uint64_t num_blocks)
+{
+        __m128i icv[AES_XCBC_VAES_NUM_LANES];
+        uint64_t i, offset = 0;
+        unsigned lane, r;
+
+        for (lane = 0; lane < AES_XCBC_VAES_NUM_LANES; lane++)
+                icv[lane] = _mm_load_si128((const __m128i *)
+                                           &args->ICV[lane]);
+
+        for (i = 0; i < num_blocks; i++) {
+                for (lane = 0; lane < AES_XCBC_VAES_NUM_LANES; lane++) {
+                        icv[lane] = _mm_xor_si128(icv[lane], _mm_loadu_si128
+                                                  ((const __m128i *)
+                                                   &args->in[lane][offset]));
+                        icv[lane] = _mm_xor_si128(icv[lane], _mm_load_si128
+                                                  ((const __m128i *)
+                                                   &args->key_tab[0][lane]));
+                }
+
+                for (r = 1; r < AES_XCBC_NUM_ROUNDS; r++)
+                        for (lane = 0; lane < AES_XCBC_VAES_NUM_LANES; lane++)
+                                icv[lane] = _mm_aesenc_si128
+                                        (icv[lane], _mm_load_si128
+                                         ((const __m128i *)
+                                          &args->key_tab[r][lane]));
+
+                for (lane = 0; lane < AES_XCBC_VAES_NUM_LANES; lane++)
+                        icv[lane] = _mm_aesenclast_si128
+                                (icv[lane], _mm_load_si128
+                                 ((const __m128i *)
+                                  &args->key_tab[AES_XCBC_NUM_ROUNDS][lane]));
+
+                offset += AES_XCBC_BLOCK_SIZE;
+        }
+
+        for (lane = 0; lane < AES_XCBC_VAES_NUM_LANES; lane++) {
+                _mm_store_si128((__m128i *) &args->ICV[lane], icv[lane]);
+                args->in[lane] += offset;
+        }
+}
+#endif /* _WIN32 */
+
+/**
+ * @brief Runs all lanes up to the shortest one
+ *
+ * @param [in/out] state  XCBC OOO manager
+ *
+ * @return Index of the shortest lane (its length is now 0)
+ */
+static unsigned
+aes_xcbc_x16_run(MB_MGR_AES_XCBC_OOO *state)
+{
+        const __m128i all_ones = _mm_set1_epi16(-1);
+        __m128i lo = _mm_load_si128((const __m128i *) &state->lens[0]);
+        __m128i hi = _mm_load_si128((const __m128i *) &state->lens[8]);
+        const __m128i minpos = _mm_minpos_epu16(_mm_min_epu16(lo, hi));
+        const uint16_t min_len = (uint16_t) _mm_extract_epi16(minpos, 0);
+        unsigned lane = (unsigned) _mm_extract_epi16(minpos, 1);
+
+        if (state->lens[lane] != min_len)
+                lane += 8;
+
+        if (min_len != 0) {
+                const __m128i sub = _mm_set1_epi16((short) min_len);
+                const __m128i unused_lo = _mm_cmpeq_epi16(lo, all_ones);
+                const __m128i unused_hi = _mm_cmpeq_epi16(hi, all_ones);
+
+                aes_xcbc_x16(&state->args, min_len / AES_XCBC_BLOCK_SIZE);
+
+                lo = _mm_or_si128(_mm_sub_epi16(lo, sub), unused_lo);
+                hi = _mm_or_si128(_mm_sub_epi16(hi, sub), unused_hi);
+                _mm_store_si128((__m128i *) &state->lens[0], lo);
+                _mm_store_si128((__m128i *) &state->lens[8], hi);
+        }
+
+        return lane;
+}
+
+/**
+ * @brief Runs the lanes until one of the jobs is complete and returns it
+ *
+ * @param [in/out] state  XCBC OOO manager
+ *
+ * @return Completed job
+ */
+static IMB_JOB *
+aes_xcbc_x16_process(MB_MGR_AES_XCBC_OOO *state)
+{
+        XCBC_LANE_DATA *ld;
+        unsigned lane;
+        IMB_JOB *job;
+
+        while (1) {
+                lane = aes_xcbc_x16_run(state);
+                ld = &state->ldata[lane];
+                if (ld->final_done)
+                        break;
+
+                /* all message blocks done, process the final block */
+                ld->final_done = 1;
+                state->lens[lane] = AES_XCBC_BLOCK_SIZE;
+                state->args.in[lane] = ld->final_block;
+                ooo_idle_lanes_follow(state->args.in, state->lens,
+                                      AES_XCBC_VAES_NUM_LANES, lane);
+        }
+
+        job = ld->job_in_lane;
+        memcpy(job->auth_tag_output, &state->args.ICV[lane],
+               AES_XCBC_DIGEST_SIZE);
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        ld->job_in_lane = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        {
+                unsigned r;
+
+                for (r = 0; r <= AES_XCBC_NUM_ROUNDS; r++)
+                        memset(&state->args.key_tab[r][lane], 0,
+                               sizeof(state->args.key_tab[r][lane]));
+        }
+        memset(&state->args.ICV[lane], 0, sizeof(state->args.ICV[lane]));
+        memset(ld->final_block, 0, sizeof(ld->final_block));
+#endif
+
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_aes_xcbc_vaes_avx512(MB_MGR_AES_XCBC_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        XCBC_LANE_DATA *ld = &state->ldata[lane];
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t r = len % AES_XCBC_BLOCK_SIZE;
+        const __m128i *k1 = (const __m128i *) job->u.XCBC._k1_expanded;
+        uint64_t blocks_len;
+        __m128i last;
+        unsigned i;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        ld->job_in_lane = job;
+        ld->final_done = 0;
+        state->args.keys[lane] = job->u.XCBC._k1_expanded;
+        for (i = 0; i <= AES_XCBC_NUM_ROUNDS; i++)
+                _mm_store_si128((__m128i *) &state->args.key_tab[i][lane],
+                                _mm_load_si128(&k1[i]));
+        state->args.in[lane] = (len > AES_XCBC_BLOCK_SIZE) ?
+                p : ld->final_block;
+        memset(&state->args.ICV[lane], 0, sizeof(state->args.ICV[lane]));
+
+        if (len != 0 && r == 0) {
+                /* M[n] XOR K2 */
+                blocks_len = len - AES_XCBC_BLOCK_SIZE;
+                last = _mm_loadu_si128((const __m128i *) &p[blocks_len]);
+                last = _mm_xor_si128(last, _mm_loadu_si128((const __m128i *)
+                                                           job->u.XCBC._k2));
+        } else {
+                /* pad(M[n]) XOR K3 */
+                blocks_len = len - r;
+                memset(ld->final_block, 0, AES_XCBC_BLOCK_SIZE);
+                memcpy(ld->final_block, &p[blocks_len], r);
+                ld->final_block[r] = 0x80;
+                last = _mm_load_si128((const __m128i *) ld->final_block);
+                last = _mm_xor_si128(last, _mm_loadu_si128((const __m128i *)
+                                                           job->u.XCBC._k3));
+        }
+        _mm_store_si128((__m128i *) ld->final_block, last);
+        state->lens[lane] = (uint16_t) blocks_len;
+
+        if (state->num_lanes_inuse < AES_XCBC_VAES_NUM_LANES)
+                return NULL;
+
+        return aes_xcbc_x16_process(state);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_aes_xcbc_vaes_avx512(MB_MGR_AES_XCBC_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        /*
+         * Empty lanes read the input of a valid lane,
+         * their length stays 0xFFFF and ICV is not used.
+         */
+        ooo_idle_lanes_follow(state->args.in, state->lens,
+                              AES_XCBC_VAES_NUM_LANES,
+                              ooo_busy_lane(state->lens));
+
+        return aes_xcbc_x16_process(state);
+}
@@ -0,0 +1,468 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * HMAC-MD5 out-of-order manager with 32 lanes (AVX512).
+ *
+ * The 32 lanes are processed as two groups of 16 lanes, each group
+ * keeps MD5 state of its lanes in 4 ZMM registers (x16x2). Digests are
+ * stored transposed in args.digest[word * 32 + lane], so that one
+ * 512-bit load gets one digest word of a group.
+ *
+ * With 32 lanes, unused_lanes is a bit mask of free lanes (bit set means
+ * the lane is free) and num_lanes_inuse tells if the manager is full.
+ * Unused lanes keep length 0xFFFF. Lengths are in 64 byte blocks.
+ */
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+#include "include/ooo_idle_lanes.h"
+
+#define MD5_BLOCK_SIZE        64
+#define MD5_DIGEST_SIZE       16
+#define MD5_DIGEST_SIZE_96    12
+#define MD5_GROUP_NUM_LANES   16
+#define MD5_NUM_GROUPS        (AVX512_NUM_MD5_LANES / MD5_GROUP_NUM_LANES)
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_hmac_md5_avx512(MB_MGR_HMAC_MD5_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_hmac_md5_avx512(MB_MGR_HMAC_MD5_OOO *state);
+
+static const uint32_t md5_k[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+        0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+        0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+        0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+        0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+        0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+        0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+        0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+        0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+/*
+ * MD5 round functions, computed with a single VPTERNLOGD each
+ *   F = (b & c) | (~b & d)
+ *   G = (b & d) | (c & ~d)
+ *   H = b ^ c ^ d
+ *   I = c ^ (b | ~d)
+ */
+#define MD5_F(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0xCA)
+#define MD5_G(b, c, d) _mm512_ternarylogic_epi32(d, b, c, 0xCA)
+#define MD5_H(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0x96)
+#define MD5_I(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0x39)
+
+/*
+ * a = b + ((a + FN(b, c, d) + w[idx] + md5_k[i]) <<< rot)
+ * and rotate the working variables for the next step
+ */
+#define MD5_STEP(FN, i, idx, rot) do {                                  \
+        __m512i t_;                                                     \
+                                                                        \
+        t_ = _mm512_add_epi32(w[idx], _mm512_set1_epi32(md5_k[i]));     \
+        t_ = _mm512_add_epi32(t_, FN(b, c, d));                         \
+        t_ = _mm512_add_epi32(t_, a);                                   \
+        t_ = _mm512_add_epi32(b, _mm512_rol_epi32(t_, rot));            \
+        a = d;                                                          \
+        d = c;                                                          \
+        c = b;                                                          \
+        b = t_;                                                         \
+} while (0)
+
+#define MD5_STEP4(FN, i, idx0, idx1, idx2, idx3, r0, r1, r2, r3) do {   \
+        MD5_STEP(FN, (i) + 0, idx0, r0);                                \
+        MD5_STEP(FN, (i) + 1, idx1, r1);                                \
+        MD5_STEP(FN, (i) + 2, idx2, r2);                                \
+        MD5_STEP(FN, (i) + 3, idx3, r3);                                \
+} while (0)
+
+/**
+ * @brief Transposes 16 rows of 16 double words
+ *
+ * On input r[n] holds 16 message words of lane n,
+ * on output r[n] holds message word n of all 16 lanes.
+ *
+ * @param [in/out] r  16 ZMM registers to transpose
+ */
+__forceinline void
+transpose_16x16_epi32(__m512i r[16])
+{
+        __m512i t[16];
+        unsigned i;
+
+        /* t[2i]/t[2i+1]: interleaved double words of rows 2i and 2i+1 */
+        for (i = 0; i < 16; i += 2) {
+                t[i] = _mm512_unpacklo_epi32(r[i], r[i + 1]);
+                t[i + 1] = _mm512_unpackhi_epi32(r[i], r[i + 1]);
+        }
+
+        /*
+         * r[4i+k]: 128-bit chunk c holds word (4c + k)
+         * of rows 4i to 4i+3
+         */
+        for (i = 0; i < 16; i += 4) {
+                r[i + 0] = _mm512_unpacklo_epi64(t[i + 0], t[i + 2]);
+                r[i + 1] = _mm512_unpackhi_epi64(t[i + 0], t[i + 2]);
+                r[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+                r[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+
+        /* gather 128-bit chunks of the same word from the 4 row groups */
+        for (i = 0; i < 4; i++) {
+                const __m512i x0 =
+                        _mm512_shuffle_i32x4(r[i], r[i + 4], 0x88);
+                const __m512i x1 =
+                        _mm512_shuffle_i32x4(r[i], r[i + 4], 0xDD);
+                const __m512i y0 =
+                        _mm512_shuffle_i32x4(r[i + 8], r[i + 12], 0x88);
+                const __m512i y1 =
+                        _mm512_shuffle_i32x4(r[i + 8], r[i + 12], 0xDD);
+
+                t[i + 0] = _mm512_shuffle_i32x4(x0, y0, 0x88);
+                t[i + 4] = _mm512_shuffle_i32x4(x1, y1, 0x88);
+                t[i + 8] = _mm512_shuffle_i32x4(x0, y0, 0xDD);
+                t[i + 12] = _mm512_shuffle_i32x4(x1, y1, 0xDD);
+        }
+
+        for (i = 0; i < 16; i++)
+                r[i] = t[i];
+}
+
+/**
+ * @brief Runs MD5 on 2 groups of 16 lanes
+ *
+ * @param [in/out] args   Lane arguments (transposed digests, data pointers)
+ * @param [in] num_blocks Number of 64 byte blocks to process in each lane
+ */
+static void
+md5_x16x2_avx512(MD5_ARGS *args, const uint64_t num_blocks)
+{
+        const uint64_t len = num_blocks * MD5_BLOCK_SIZE;
+        unsigned g, lane;
+
+        for (g = 0; g < MD5_NUM_GROUPS; g++) {
+                uint32_t *digest = &args->digest[g * MD5_GROUP_NUM_LANES];
+                const uint8_t **data_ptr =
+                        &args->data_ptr[g * MD5_GROUP_NUM_LANES];
+                __m512i a0, b0, c0, d0;
+                uint64_t offset;
+
+                a0 = _mm512_load_si512(&digest[0 * AVX512_NUM_MD5_LANES]);
+                b0 = _mm512_load_si512(&digest[1 * AVX512_NUM_MD5_LANES]);
+                c0 = _mm512_load_si512(&digest[2 * AVX512_NUM_MD5_LANES]);
+                d0 = _mm512_load_si512(&digest[3 * AVX512_NUM_MD5_LANES]);
+
+                for (offset = 0; offset < len; offset += MD5_BLOCK_SIZE) {
+                        __m512i w[16];
+                        __m512i a = a0, b = b0, c = c0, d = d0;
+
+                        for (lane = 0; lane < MD5_GROUP_NUM_LANES; lane++)
+                                w[lane] = _mm512_loadu_si512
+                                        (&data_ptr[lane][offset]);
+                        transpose_16x16_epi32(w);
+
+                        MD5_STEP4(MD5_F,  0,  0,  1,  2,  3, 7, 12, 17, 22);
+                        MD5_STEP4(MD5_F,  4,  4,  5,  6,  7, 7, 12, 17, 22);
+                        MD5_STEP4(MD5_F,  8,  8,  9, 10, 11, 7, 12, 17, 22);
+                        MD5_STEP4(MD5_F, 12, 12, 13, 14, 15, 7, 12, 17, 22);
+
+                        MD5_STEP4(MD5_G, 16,  1,  6, 11,  0, 5,  9, 14, 20);
+                        MD5_STEP4(MD5_G, 20,  5, 10, 15,  4, 5,  9, 14, 20);
+                        MD5_STEP4(MD5_G, 24,  9, 14,  3,  8, 5,  9, 14, 20);
+                        MD5_STEP4(MD5_G, 28, 13,  2,  7, 12, 5,  9, 14, 20);
+
+                        MD5_STEP4(MD5_H, 32,  5,  8, 11, 14, 4, 11, 16, 23);
+                        MD5_STEP4(MD5_H, 36,  1,  4,  7, 10, 4, 11, 16, 23);
+                        MD5_STEP4(MD5_H, 40, 13,  0,  3,  6, 4, 11, 16, 23);
+                        MD5_STEP4(MD5_H, 44,  9, 12, 15,  2, 4, 11, 16, 23);
+
+                        MD5_STEP4(MD5_I, 48,  0,  7, 14,  5, 6, 10, 15, 21);
+                        MD5_STEP4(MD5_I, 52, 12,  3, 10,  1, 6, 10, 15, 21);
+                        MD5_STEP4(MD5_I, 56,  8, 15,  6, 13, 6, 10, 15, 21);
+                        MD5_STEP4(MD5_I, 60,  4, 11,  2,  9, 6, 10, 15, 21);
+
+                        a0 = _mm512_add_epi32(a0, a);
+                        b0 = _mm512_add_epi32(b0, b);
+                        c0 = _mm512_add_epi32(c0, c);
+                        d0 = _mm512_add_epi32(d0, d);
+                }
+
+                _mm512_store_si512(&digest[0 * AVX512_NUM_MD5_LANES], a0);
+                _mm512_store_si512(&digest[1 * AVX512_NUM_MD5_LANES], b0);
+                _mm512_store_si512(&digest[2 * AVX512_NUM_MD5_LANES], c0);
+                _mm512_store_si512(&digest[3 * AVX512_NUM_MD5_LANES], d0);
+
+                for (lane = 0; lane < MD5_GROUP_NUM_LANES; lane++)
+                        data_ptr[lane] += len;
+        }
+}
+
+/**
+ * @brief Finds index of the lowest bit set
+ *
+ * @param [in] val  Non-zero value
+ *
+ * @return Bit index
+ */
+__forceinline unsigned
+md5_bsf32(const uint32_t val)
+{
+#ifdef _WIN32
+        unsigned long idx;
+
+        _BitScanForward(&idx, val);
+        return (unsigned) idx;
+#else
+        return (unsigned) __builtin_ctz(val);
+#endif
+}
+
+/**
+ * @brief Runs all lanes up to the shortest one
+ *
+ * @param [in/out] state  HMAC-MD5 OOO manager
+ *
+ * @return Index of the shortest lane (its length is now 0)
+ */
+static unsigned
+md5_x32_run(MB_MGR_HMAC_MD5_OOO *state)
+{
+        const __m512i lens = _mm512_loadu_si512(state->lens);
+        const __m256i min256 =
+                _mm256_min_epu16(_mm512_castsi512_si256(lens),
+                                 _mm512_extracti64x4_epi64(lens, 1));
+        const __m128i min128 =
+                _mm_min_epu16(_mm256_castsi256_si128(min256),
+                              _mm256_extracti128_si256(min256, 1));
+        const uint16_t min_len =
+                (uint16_t) _mm_extract_epi16(_mm_minpos_epu16(min128), 0);
+        const __m512i min_vec = _mm512_set1_epi16((short) min_len);
+        const unsigned lane =
+                md5_bsf32(_mm512_cmpeq_epi16_mask(lens, min_vec));
+
+        if (min_len != 0) {
+                const __mmask32 used =
+                        _mm512_cmpneq_epi16_mask(lens,
+                                                 _mm512_set1_epi16(-1));
+
+                md5_x16x2_avx512(&state->args, min_len);
+
+                _mm512_storeu_si512(state->lens,
+                                    _mm512_mask_sub_epi16(lens, used,
+                                                          lens, min_vec));
+        }
+
+        return lane;
+}
+
+/**
+ * @brief Sets digest of a lane from a precomputed HMAC key pad digest
+ *
+ * @param [out] args    Lane arguments
+ * @param [in] lane     Lane index
+ * @param [in] digest   Digest of (key XOR ipad) or (key XOR opad)
+ */
+__forceinline void
+md5_x32_set_digest(MD5_ARGS *args, const unsigned lane,
+                   const uint8_t *digest)
+{
+        uint32_t w[NUM_MD5_DIGEST_WORDS];
+        unsigned i;
+
+        memcpy(w, digest, sizeof(w));
+        for (i = 0; i < NUM_MD5_DIGEST_WORDS; i++)
+                args->digest[i * AVX512_NUM_MD5_LANES + lane] = w[i];
+}
+
+/**
+ * @brief Gets digest of a lane
+ *
+ * @param [in] args     Lane arguments
+ * @param [in] lane     Lane index
+ * @param [out] digest  16 byte digest
+ */
+__forceinline void
+md5_x32_get_digest(const MD5_ARGS *args, const unsigned lane,
+                   uint8_t *digest)
+{
+        uint32_t w[NUM_MD5_DIGEST_WORDS];
+        unsigned i;
+
+        for (i = 0; i < NUM_MD5_DIGEST_WORDS; i++)
+                w[i] = args->digest[i * AVX512_NUM_MD5_LANES + lane];
+        memcpy(digest, w, sizeof(w));
+}
+
+/**
+ * @brief Runs the lanes until one of the jobs is complete and returns it
+ *
+ * @param [in/out] state  HMAC-MD5 OOO manager
+ *
+ * @return Completed job
+ */
+static IMB_JOB *
+md5_x32_process(MB_MGR_HMAC_MD5_OOO *state)
+{
+        HMAC_SHA1_LANE_DATA *ld;
+        unsigned lane;
+        IMB_JOB *job;
+        uint8_t digest[MD5_DIGEST_SIZE];
+
+        while (1) {
+                lane = md5_x32_run(state);
+                ld = &state->ldata[lane];
+
+                if (ld->extra_blocks != 0) {
+                        /* message blocks done, process the padded tail */
+                        state->args.data_ptr[lane] = ld->extra_block;
+                        state->lens[lane] = (uint16_t) ld->extra_blocks;
+                        ld->extra_blocks = 0;
+                        ooo_idle_lanes_follow(state->args.data_ptr,
+                                              state->lens,
+                                              AVX512_NUM_MD5_LANES, lane);
+                        continue;
+                }
+
+                if (ld->outer_done)
+                        break;
+
+                /*
+                 * Inner hash done, run the outer hash over its digest.
+                 * Padding and length of outer_block are set on init.
+                 */
+                ld->outer_done = 1;
+                md5_x32_get_digest(&state->args, lane, ld->outer_block);
+                md5_x32_set_digest(&state->args, lane,
+                                   ld->job_in_lane->u.HMAC.
+                                   _hashed_auth_key_xor_opad);
+                state->args.data_ptr[lane] = ld->outer_block;
+                state->lens[lane] = 1;
+                ooo_idle_lanes_follow(state->args.data_ptr, state->lens,
+                                      AVX512_NUM_MD5_LANES, lane);
+        }
+
+        job = ld->job_in_lane;
+        md5_x32_get_digest(&state->args, lane, digest);
+        memcpy(job->auth_tag_output, digest,
+               (job->auth_tag_output_len_in_bytes == MD5_DIGEST_SIZE_96) ?
+               MD5_DIGEST_SIZE_96 : MD5_DIGEST_SIZE);
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        ld->job_in_lane = NULL;
+        state->unused_lanes |= (1ULL << lane);
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        {
+                unsigned i;
+
+                for (i = 0; i < NUM_MD5_DIGEST_WORDS; i++)
+                        state->args.digest[i * AVX512_NUM_MD5_LANES + lane] =
+                                0;
+        }
+        clear_mem(digest, sizeof(digest));
+        clear_mem(ld->extra_block, sizeof(ld->extra_block));
+        clear_mem(ld->outer_block, MD5_DIGEST_SIZE);
+#endif
+
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_hmac_md5_avx512(MB_MGR_HMAC_MD5_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = md5_bsf32((uint32_t) state->unused_lanes);
+        HMAC_SHA1_LANE_DATA *ld = &state->ldata[lane];
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t num_blocks = len / MD5_BLOCK_SIZE;
+        const uint64_t last_len = len % MD5_BLOCK_SIZE;
+        /* inner hash covers the (key XOR ipad) block too */
+        const uint64_t bit_len = (MD5_BLOCK_SIZE + len) * 8;
+
+        state->unused_lanes &= ~(1ULL << lane);
+        state->num_lanes_inuse++;
+        ld->job_in_lane = job;
+        ld->outer_done = 0;
+
+        /* tail of the message, 0x80 and 64-bit little endian bit length */
+        ld->extra_blocks = (uint32_t) ((last_len + 9 + MD5_BLOCK_SIZE - 1) /
+                                       MD5_BLOCK_SIZE);
+        memset(ld->extra_block, 0, ld->extra_blocks * MD5_BLOCK_SIZE);
+        memcpy(ld->extra_block, &p[num_blocks * MD5_BLOCK_SIZE], last_len);
+        ld->extra_block[last_len] = 0x80;
+        memcpy(&ld->extra_block[ld->extra_blocks * MD5_BLOCK_SIZE - 8],
+               &bit_len, sizeof(bit_len));
+
+        md5_x32_set_digest(&state->args, lane,
+                           job->u.HMAC._hashed_auth_key_xor_ipad);
+
+        if (num_blocks != 0) {
+                state->args.data_ptr[lane] = p;
+                state->lens[lane] = (uint16_t) num_blocks;
+        } else {
+                state->args.data_ptr[lane] = ld->extra_block;
+                state->lens[lane] = (uint16_t) ld->extra_blocks;
+                ld->extra_blocks = 0;
+        }
+
+        if (state->num_lanes_inuse < AVX512_NUM_MD5_LANES)
+                return NULL;
+
+        return md5_x32_process(state);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_hmac_md5_avx512(MB_MGR_HMAC_MD5_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        /*
+         * Empty lanes read the input of a valid lane,
+         * their length stays 0xFFFF and digest is not used.
+         */
+        ooo_idle_lanes_follow(state->args.data_ptr, state->lens,
+                              AVX512_NUM_MD5_LANES,
+                              ooo_busy_lane(state->lens));
+
+        return md5_x32_process(state);
+}
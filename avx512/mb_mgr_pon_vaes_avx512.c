@@ -0,0 +1,697 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * PON (AES128-CTR + CRC32 + BIP) out-of-order manager with 16 lanes
+ * (VAES and VPCLMULQDQ).
+ *
+ * Each kernel step does one 16 byte block of all 16 frames: counter blocks
+ * of 4 lanes are encrypted with one VAESENC, CRC32 (Ethernet FCS) of the
+ * plain text is folded for 4 lanes with one VPCLMULQDQ and BIP is updated
+ * on the cipher text. Lanes run the full CRC blocks only, the rest of
+ * the frame (CRC tail, CRC field and padding) is done with AES-NI when
+ * the job completes. Semantics follow sse/pon_sse.asm:
+ * - encrypt: HEC update, CRC32, AES-CTR and BIP
+ * - decrypt: BIP, AES-CTR and CRC32
+ * Unused lanes keep length 0xFFFF. Empty lanes on flush read the input
+ * of a valid lane and their output is not stored.
+ */
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+#include "include/crc.h"
+
+#define PON_BLOCK_SIZE  16
+#define PON_HEADER_SIZE 8
+
+/* CRC32 folding constants (reflected Ethernet FCS, see sse/pon_sse.asm) */
+#define PON_CRC_K1 UINT64_C(0x00000000ccaa009e)
+#define PON_CRC_K2 UINT64_C(0x00000001751997d0)
+
+/*
+ * XGEM header HEC: BCH code of the top 51 bits with
+ * x^12 + x^10 + x^8 + x^5 + x^4 + x^3 + 1, followed by even parity bit
+ */
+#define PON_HEC_POLY    UINT64_C(0x1539)
+#define PON_HEC_BARRETT UINT64_C(0xa35c93f631679) /* x^63 / PON_HEC_POLY */
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_pon_enc_vaes_avx512(MB_MGR_PON_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_pon_enc_vaes_avx512(MB_MGR_PON_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_pon_dec_vaes_avx512(MB_MGR_PON_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_pon_dec_vaes_avx512(MB_MGR_PON_OOO *state);
+
+/**
+ * @brief Updates HEC field of XGEM header
+ *
+ * @param [in] hdr  XGEM header (little endian)
+ *
+ * @return XGEM header with new HEC (little endian)
+ */
+static uint64_t
+pon_hec_update(const uint64_t hdr)
+{
+        __m128i q;
+        uint64_t quot, h;
+
+        /* Barrett: quotient of (hdr >> 13) * x^12 by the polynomial */
+        q = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long) (hdr >> 13)),
+                                 _mm_cvtsi64_si128((long long)
+                                                   PON_HEC_BARRETT), 0x00);
+        quot = ((uint64_t) _mm_cvtsi128_si64(q) >> 51) |
+                ((uint64_t) _mm_extract_epi64(q, 1) << 13);
+
+        /* remainder is in low 12 bits of quotient * polynomial */
+        q = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long) quot),
+                                 _mm_cvtsi64_si128((long long) PON_HEC_POLY),
+                                 0x00);
+        h = (hdr & UINT64_C(0xffffffffffffe000)) |
+                (((uint64_t) _mm_cvtsi128_si64(q) & 0xfff) << 1);
+
+        return h | (_mm_popcnt_u64(h) & 1);
+}
+
+/**
+ * @brief Gets number of bytes to CRC and to cipher from PON job
+ *
+ * @param [in]  job         PON job
+ * @param [out] crc_len     Bytes to CRC (0 if frame doesn't carry CRC)
+ * @param [out] cipher_len  Bytes to cipher (or copy with no AES-CTR)
+ */
+__forceinline void
+pon_job_lens(const IMB_JOB *job, uint64_t *crc_len, uint64_t *cipher_len)
+{
+        uint64_t hdr, pli;
+
+        memcpy(&hdr, job->src + job->hash_start_src_offset_in_bytes,
+               sizeof(hdr));
+        pli = BSWAP64(hdr) >> (48 + 2);
+        *crc_len = (pli > 4) ? (pli - 4) : 0;
+
+        if (job->msg_len_to_cipher_in_bytes != 0)
+                *cipher_len = job->msg_len_to_cipher_in_bytes;
+        else
+                *cipher_len = job->msg_len_to_hash_in_bytes - PON_HEADER_SIZE;
+}
+
+__forceinline __m128i
+pon_bswap_x1(const __m128i v)
+{
+        return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8,
+                                                9, 10, 11, 12, 13, 14, 15));
+}
+
+/* Increments 128-bit little endian counter block */
+__forceinline __m128i
+pon_ctr_inc_x1(const __m128i ctr)
+{
+        const __m128i one = _mm_set_epi64x(0, 1);
+        const __m128i c = _mm_add_epi64(ctr, one);
+
+        if (_mm_cvtsi128_si64(c) == 0)
+                return _mm_add_epi64(c, _mm_slli_si128(one, 8));
+        return c;
+}
+
+/* Encrypts counter block with round keys of a lane */
+__forceinline __m128i
+pon_keystream_x1(const PON_ARGS_x16 *args, const unsigned lane,
+                 const __m128i ctr)
+{
+        __m128i ks = pon_bswap_x1(ctr);
+        unsigned r;
+
+        ks = _mm_xor_si128(ks, _mm_load_si128((const __m128i *)
+                                              &args->key_tab[0][lane]));
+        for (r = 1; r < PON_OOO_NUM_ROUNDS; r++)
+                ks = _mm_aesenc_si128(ks, _mm_load_si128((const __m128i *)
+                                                         &args->key_tab[r]
+                                                         [lane]));
+        return _mm_aesenclast_si128(ks, _mm_load_si128
+                                    ((const __m128i *)
+                                     &args->key_tab[PON_OOO_NUM_ROUNDS][lane]));
+}
+
+/* CRC32 of the bytes with byte lookup table (no final XOR) */
+__forceinline uint32_t
+pon_crc_lut(uint32_t crc, const uint8_t *p, const uint64_t len)
+{
+        uint64_t i;
+
+        for (i = 0; i < len; i++)
+                crc = ethernet_fcs_lut[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+
+        return crc;
+}
+
+/**
+ * @brief AES-CTR and BIP on the rest of the frame in a lane
+ *
+ * Partial block of cipher text is zero padded for BIP.
+ *
+ * @param [in/out] args  Lane arguments (counter block and BIP updated)
+ * @param [in] lane      Lane index
+ * @param [in] in        Input text
+ * @param [out] out      Output text
+ * @param [in] len       Number of bytes
+ * @param [in] enc       1 - encrypt, 0 - decrypt direction
+ */
+__forceinline void
+pon_cipher_bip_x1(PON_ARGS_x16 *args, const unsigned lane,
+                  const uint8_t *in, uint8_t *out, const uint64_t len,
+                  const int enc)
+{
+        const int cipher = (args->ctr_mask >> (2 * lane)) & 1;
+        __m128i ctr = _mm_load_si128((const __m128i *) &args->ctr[lane]);
+        __m128i bip = _mm_load_si128((const __m128i *) &args->bip[lane]);
+        __m128i d, o;
+        uint64_t i;
+
+        for (i = 0; (i + PON_BLOCK_SIZE) <= len; i += PON_BLOCK_SIZE) {
+                d = _mm_loadu_si128((const __m128i *) &in[i]);
+                o = d;
+                if (cipher) {
+                        o = _mm_xor_si128(d, pon_keystream_x1(args, lane,
+                                                              ctr));
+                        ctr = pon_ctr_inc_x1(ctr);
+                }
+                _mm_storeu_si128((__m128i *) &out[i], o);
+                bip = _mm_xor_si128(bip, enc ? o : d);
+        }
+
+        if (i < len) {
+                const uint64_t r = len - i;
+                DECLARE_ALIGNED(uint8_t blk[PON_BLOCK_SIZE], 16);
+
+                memset(blk, 0, sizeof(blk));
+                memcpy(blk, &in[i], r);
+                d = _mm_load_si128((const __m128i *) blk);
+                o = d;
+                if (cipher)
+                        o = _mm_xor_si128(d, pon_keystream_x1(args, lane,
+                                                              ctr));
+                _mm_store_si128((__m128i *) blk, o);
+                memcpy(&out[i], blk, r);
+                memset(&blk[r], 0, sizeof(blk) - r);
+                o = _mm_load_si128((const __m128i *) blk);
+                bip = _mm_xor_si128(bip, enc ? o : d);
+#ifdef SAFE_DATA
+                clear_mem(blk, sizeof(blk));
+#endif
+        }
+
+        _mm_store_si128((__m128i *) &args->ctr[lane], ctr);
+        _mm_store_si128((__m128i *) &args->bip[lane], bip);
+}
+
+/**
+ * @brief Completes PON job in a lane
+ *
+ * Computes CRC of the bytes left after the lane blocks, writes back CRC
+ * (encrypt), ciphers the rest of the frame and writes authentication tag
+ * (BIP and CRC).
+ *
+ * @param [in/out] args  Lane arguments
+ * @param [in] lane      Lane index
+ * @param [in] job       Job in the lane
+ * @param [in] enc       1 - encrypt, 0 - decrypt direction
+ */
+__forceinline void
+pon_job_complete(PON_ARGS_x16 *args, const unsigned lane, IMB_JOB *job,
+                 const int enc)
+{
+        const uint8_t *in = args->in[lane];
+        uint8_t *out = args->out[lane];
+        uint64_t crc_len, cipher_len, done;
+        uint32_t crc = 0xffffffff, fcs = 0, bip;
+        __m128i b;
+
+        pon_job_lens(job, &crc_len, &cipher_len);
+        done = ((crc_len < cipher_len) ? crc_len : cipher_len) &
+                ~(uint64_t) (PON_BLOCK_SIZE - 1);
+
+        if (done != 0) {
+                /* CRC of the folded blocks */
+                DECLARE_ALIGNED(uint8_t blk[PON_BLOCK_SIZE], 16);
+
+                _mm_store_si128((__m128i *) blk, _mm_load_si128
+                                ((const __m128i *) &args->crc[lane]));
+                crc = pon_crc_lut(0, blk, sizeof(blk));
+        }
+
+        if (enc) {
+                if (crc_len != 0) {
+                        /* CRC field gets written into the source buffer */
+                        uint8_t *crc_field = (uint8_t *) (uintptr_t)
+                                &in[crc_len - done];
+
+                        fcs = ~pon_crc_lut(crc, in, crc_len - done);
+                        memcpy(crc_field, &fcs, sizeof(fcs));
+                }
+                pon_cipher_bip_x1(args, lane, in, out, cipher_len - done, 1);
+        } else {
+                pon_cipher_bip_x1(args, lane, in, out, cipher_len - done, 0);
+                if (crc_len != 0)
+                        fcs = ~pon_crc_lut(crc, out, crc_len - done);
+        }
+
+        /* fold BIP to 32 bits */
+        b = _mm_load_si128((const __m128i *) &args->bip[lane]);
+        b = _mm_xor_si128(b, _mm_srli_si128(b, 8));
+        b = _mm_xor_si128(b, _mm_srli_si128(b, 4));
+        bip = (uint32_t) _mm_cvtsi128_si32(b);
+
+        memcpy(&job->auth_tag_output[0], &bip, sizeof(bip));
+        memcpy(&job->auth_tag_output[4], &fcs, sizeof(fcs));
+
+        job->status |= STS_COMPLETED_AES;
+}
+
+#ifndef _WIN32
+/* Loads 16 bytes from 4 lanes */
+__forceinline __m512i
+pon_load_x4(const uint8_t *const *in, const uint64_t offset)
+{
+        __m512i d;
+
+        d = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)
+                                                   &in[0][offset]));
+        d = _mm512_inserti32x4(d, _mm_loadu_si128((const __m128i *)
+                                                  &in[1][offset]), 1);
+        d = _mm512_inserti32x4(d, _mm_loadu_si128((const __m128i *)
+                                                  &in[2][offset]), 2);
+        d = _mm512_inserti32x4(d, _mm_loadu_si128((const __m128i *)
+                                                  &in[3][offset]), 3);
+        return d;
+}
+
+/* Stores 16 bytes into 4 lanes, lanes not set in the mask are skipped */
+__forceinline void
+pon_store_x4(uint8_t *const *out, const uint64_t offset, const __m512i d,
+             const unsigned mask)
+{
+        if (mask & 1)
+                _mm_storeu_si128((__m128i *) &out[0][offset],
+                                 _mm512_castsi512_si128(d));
+        if (mask & 2)
+                _mm_storeu_si128((__m128i *) &out[1][offset],
+                                 _mm512_extracti32x4_epi32(d, 1));
+        if (mask & 4)
+                _mm_storeu_si128((__m128i *) &out[2][offset],
+                                 _mm512_extracti32x4_epi32(d, 2));
+        if (mask & 8)
+                _mm_storeu_si128((__m128i *) &out[3][offset],
+                                 _mm512_extracti32x4_epi32(d, 3));
+}
+
+/**
+ * @brief Runs AES-CTR, CRC32 and BIP on all 16 lanes
+ *
+ * @param [in/out] args   Lane arguments
+ * @param [in] num_blocks Number of blocks to process in each lane
+ * @param [in] enc        1 - encrypt, 0 - decrypt direction
+ */
+__forceinline void
+pon_x16(PON_ARGS_x16 *args, const uint64_t num_blocks, const int enc)
+{
+        const __m512i bswap =
+                _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                                    8, 9, 10, 11, 12, 13,
+                                                    14, 15));
+        const __m512i one_lo = _mm512_broadcast_i32x4(_mm_set_epi64x(0, 1));
+        const __m512i one_hi = _mm512_broadcast_i32x4(_mm_set_epi64x(1, 0));
+        const __m512i crc_k =
+                _mm512_broadcast_i32x4(_mm_set_epi64x((long long) PON_CRC_K2,
+                                                      (long long)
+                                                      PON_CRC_K1));
+        __m512i ctr[PON_OOO_NUM_LANES / 4];
+        __m512i crc[PON_OOO_NUM_LANES / 4];
+        __m512i bip[PON_OOO_NUM_LANES / 4];
+        uint32_t crc_first = args->crc_first_mask;
+        uint64_t i, offset = 0;
+        unsigned g, r;
+
+        for (g = 0; g < PON_OOO_NUM_LANES / 4; g++) {
+                ctr[g] = _mm512_load_si512(&args->ctr[g * 4]);
+                crc[g] = _mm512_load_si512(&args->crc[g * 4]);
+                bip[g] = _mm512_load_si512(&args->bip[g * 4]);
+        }
+
+        for (i = 0; i < num_blocks; i++) {
+                __m512i d[PON_OOO_NUM_LANES / 4];
+                __m512i ks[PON_OOO_NUM_LANES / 4];
+
+                for (g = 0; g < PON_OOO_NUM_LANES / 4; g++) {
+                        __mmask8 carry;
+
+                        d[g] = pon_load_x4(&args->in[g * 4], offset);
+
+                        ks[g] = _mm512_shuffle_epi8(ctr[g], bswap);
+                        ks[g] = _mm512_xor_si512(ks[g], _mm512_load_si512
+                                                 (&args->key_tab[0][g * 4]));
+
+                        /* increment on 128 bits, carry to high 64 bits */
+                        ctr[g] = _mm512_add_epi64(ctr[g], one_lo);
+                        carry = _mm512_mask_cmpeq_epi64_mask
+                                (0x55, ctr[g], _mm512_setzero_si512());
+                        ctr[g] = _mm512_mask_add_epi64(ctr[g],
+                                                       (__mmask8) (carry << 1),
+                                                       ctr[g], one_hi);
+                }
+
+                for (r = 1; r < PON_OOO_NUM_ROUNDS; r++)
+                        for (g = 0; g < PON_OOO_NUM_LANES / 4; g++)
+                                ks[g] = _mm512_aesenc_epi128
+                                        (ks[g], _mm512_load_si512
+                                         (&args->key_tab[r][g * 4]));
+
+                for (g = 0; g < PON_OOO_NUM_LANES / 4; g++) {
+                        const __mmask8 ctr_mask =
+                                (__mmask8) (args->ctr_mask >> (g * 8));
+                        const __mmask8 first_mask =
+                                (__mmask8) (crc_first >> (g * 8));
+                        __m512i o, fold;
+
+                        ks[g] = _mm512_aesenclast_epi128
+                                (ks[g], _mm512_load_si512
+                                 (&args->key_tab[PON_OOO_NUM_ROUNDS][g * 4]));
+
+                        /* lanes with no AES-CTR copy the input */
+                        o = _mm512_mask_xor_epi64(d[g], ctr_mask, d[g], ks[g]);
+
+                        /* CRC on plain text, first block XOR'ed with init */
+                        fold = _mm512_xor_si512
+                                (_mm512_clmulepi64_epi128(crc[g], crc_k, 0x01),
+                                 _mm512_clmulepi64_epi128(crc[g], crc_k, 0x10));
+                        crc[g] = _mm512_mask_mov_epi64(fold, first_mask,
+                                                       crc[g]);
+                        crc[g] = _mm512_xor_si512(crc[g], enc ? d[g] : o);
+
+                        /* BIP on cipher text */
+                        bip[g] = _mm512_xor_si512(bip[g], enc ? o : d[g]);
+
+                        pon_store_x4(&args->out[g * 4], offset, o,
+                                     (args->store_mask >> (g * 4)) & 0xf);
+                }
+
+                crc_first = 0;
+                offset += PON_BLOCK_SIZE;
+        }
+
+        for (g = 0; g < PON_OOO_NUM_LANES / 4; g++) {
+                _mm512_store_si512(&args->ctr[g * 4], ctr[g]);
+                _mm512_store_si512(&args->crc[g * 4], crc[g]);
+                _mm512_store_si512(&args->bip[g * 4], bip[g]);
+        }
+
+        for (g = 0; g < PON_OOO_NUM_LANES; g++) {
+                args->in[g] += offset;
+                args->out[g] += offset;
+        }
+        args->crc_first_mask = crc_first;
+}
+#else /* _WIN32 */
+/* use AES-NI and PCLMULQDQ on Windows for now */
+__forceinline void
+pon_x16(PON_ARGS_x16 *args, const uint64_t num_blocks, const int enc)
+{
+        const __m128i crc_k = _mm_set_epi64x((long long) PON_CRC_K2,
+                                             (long long) PON_CRC_K1);
+        const uint64_t len = num_blocks * PON_BLOCK_SIZE;
+        unsigned lane;
+
+        for (lane = 0; lane < PON_OOO_NUM_LANES; lane++) {
+                const int first = (args->crc_first_mask >> (2 * lane)) & 1;
+                const int cipher = (args->ctr_mask >> (2 * lane)) & 1;
+                const int store = (args->store_mask >> lane) & 1;
+                __m128i ctr = _mm_load_si128((const __m128i *)
+                                             &args->ctr[lane]);
+                __m128i crc = _mm_load_si128((const __m128i *)
+                                             &args->crc[lane]);
+                __m128i bip = _mm_load_si128((const __m128i *)
+                                             &args->bip[lane]);
+                uint64_t i;
+
+                for (i = 0; i < len; i += PON_BLOCK_SIZE) {
+                        const __m128i d = _mm_loadu_si128((const __m128i *)
+                                                          &args->in[lane][i]);
+                        __m128i o = d;
+
+                        if (cipher) {
+                                o = _mm_xor_si128(d, pon_keystream_x1(args,
+                                                                      lane,
+                                                                      ctr));
+                                ctr = pon_ctr_inc_x1(ctr);
+                        }
+
+                        if (i != 0 || !first)
+                                crc = _mm_xor_si128
+                                        (_mm_clmulepi64_si128(crc, crc_k,
+                                                              0x01),
+                                         _mm_clmulepi64_si128(crc, crc_k,
+                                                              0x10));
+                        crc = _mm_xor_si128(crc, enc ? d : o);
+                        bip = _mm_xor_si128(bip, enc ? o : d);
+
+                        if (store)
+                                _mm_storeu_si128((__m128i *)
+                                                 &args->out[lane][i], o);
+                }
+
+                _mm_store_si128((__m128i *) &args->ctr[lane], ctr);
+                _mm_store_si128((__m128i *) &args->crc[lane], crc);
+                _mm_store_si128((__m128i *) &args->bip[lane], bip);
+                args->in[lane] += len;
+                args->out[lane] += len;
+        }
+        args->crc_first_mask = 0;
+}
+#endif /* _WIN32 */
+
+/**
+ * @brief Runs all lanes up to the shortest one
+ *
+ * @param [in/out] state  PON OOO manager
+ * @param [in] enc        1 - encrypt, 0 - decrypt direction
+ *
+ * @return Index of the shortest lane (its length is now 0)
+ */
+__forceinline unsigned
+pon_x16_run(MB_MGR_PON_OOO *state, const int enc)
+{
+        const __m128i all_ones = _mm_set1_epi16(-1);
+        __m128i lo = _mm_load_si128((const __m128i *) &state->lens[0]);
+        __m128i hi = _mm_load_si128((const __m128i *) &state->lens[8]);
+        const __m128i minpos = _mm_minpos_epu16(_mm_min_epu16(lo, hi));
+        const uint16_t min_len = (uint16_t) _mm_extract_epi16(minpos, 0);
+        unsigned lane = (unsigned) _mm_extract_epi16(minpos, 1);
+
+        if (state->lens[lane] != min_len)
+                lane += 8;
+
+        if (min_len != 0) {
+                const __m128i sub = _mm_set1_epi16((short) min_len);
+                const __m128i unused_lo = _mm_cmpeq_epi16(lo, all_ones);
+                const __m128i unused_hi = _mm_cmpeq_epi16(hi, all_ones);
+
+                pon_x16(&state->args, min_len, enc);
+
+                lo = _mm_or_si128(_mm_sub_epi16(lo, sub), unused_lo);
+                hi = _mm_or_si128(_mm_sub_epi16(hi, sub), unused_hi);
+                _mm_store_si128((__m128i *) &state->lens[0], lo);
+                _mm_store_si128((__m128i *) &state->lens[8], hi);
+        }
+
+        return lane;
+}
+
+#ifdef SAFE_DATA
+__forceinline void
+pon_lane_clear(PON_ARGS_x16 *args, const unsigned lane)
+{
+        unsigned r;
+
+        for (r = 0; r <= PON_OOO_NUM_ROUNDS; r++)
+                memset(&args->key_tab[r][lane], 0,
+                       sizeof(args->key_tab[r][lane]));
+        memset(&args->ctr[lane], 0, sizeof(args->ctr[lane]));
+        memset(&args->crc[lane], 0, sizeof(args->crc[lane]));
+        memset(&args->bip[lane], 0, sizeof(args->bip[lane]));
+}
+#endif
+
+/**
+ * @brief Runs the lanes until one of the jobs is complete and returns it
+ *
+ * @param [in/out] state  PON OOO manager
+ * @param [in] enc        1 - encrypt, 0 - decrypt direction
+ *
+ * @return Completed job
+ */
+__forceinline IMB_JOB *
+pon_x16_process(MB_MGR_PON_OOO *state, const int enc)
+{
+        const unsigned lane = pon_x16_run(state, enc);
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        pon_job_complete(&state->args, lane, job, enc);
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+        state->args.store_mask &= ~(1U << lane);
+#ifdef SAFE_DATA
+        pon_lane_clear(&state->args, lane);
+#endif
+
+        return job;
+}
+
+__forceinline IMB_JOB *
+pon_submit(MB_MGR_PON_OOO *state, IMB_JOB *job, const int enc)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        const uint32_t lane_bits = 3U << (2 * lane);
+        PON_ARGS_x16 *args = &state->args;
+        /* XGEM header gets HEC updated in the source buffer (encrypt) */
+        uint8_t *hdr_ptr = (uint8_t *) (uintptr_t)
+                (job->src + job->hash_start_src_offset_in_bytes);
+        uint64_t hdr, crc_len, cipher_len, blocks_len;
+
+        memcpy(&hdr, hdr_ptr, sizeof(hdr));
+        if (enc) {
+                hdr = BSWAP64(pon_hec_update(BSWAP64(hdr)));
+                memcpy(hdr_ptr, &hdr, sizeof(hdr));
+        }
+
+        /* BIP starts with XGEM header, CRC with initial value */
+        _mm_store_si128((__m128i *) &args->bip[lane],
+                        _mm_cvtsi64_si128((long long) hdr));
+        _mm_store_si128((__m128i *) &args->crc[lane], _mm_cvtsi32_si128(-1));
+        args->crc_first_mask |= lane_bits;
+        args->in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        args->out[lane] = job->dst;
+
+        if (job->msg_len_to_cipher_in_bytes != 0) {
+                const __m128i *k = (const __m128i *) job->enc_keys;
+                unsigned i;
+
+                for (i = 0; i <= PON_OOO_NUM_ROUNDS; i++)
+                        _mm_store_si128((__m128i *) &args->key_tab[i][lane],
+                                        _mm_loadu_si128(&k[i]));
+                _mm_store_si128((__m128i *) &args->ctr[lane],
+                                pon_bswap_x1(_mm_loadu_si128
+                                             ((const __m128i *) job->iv)));
+                args->ctr_mask |= lane_bits;
+        } else {
+                args->ctr_mask &= ~lane_bits;
+        }
+
+        pon_job_lens(job, &crc_len, &cipher_len);
+        blocks_len = ((crc_len < cipher_len) ? crc_len : cipher_len) &
+                ~(uint64_t) (PON_BLOCK_SIZE - 1);
+
+        if (blocks_len == 0) {
+                /* nothing for the lanes, the job is done on the spot */
+                args->crc_first_mask &= ~lane_bits;
+                pon_job_complete(args, lane, job, enc);
+#ifdef SAFE_DATA
+                pon_lane_clear(args, lane);
+#endif
+                return job;
+        }
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = (uint16_t) (blocks_len / PON_BLOCK_SIZE);
+        args->store_mask |= 1U << lane;
+
+        if (state->num_lanes_inuse < PON_OOO_NUM_LANES)
+                return NULL;
+
+        return pon_x16_process(state, enc);
+}
+
+__forceinline IMB_JOB *
+pon_flush(MB_MGR_PON_OOO *state, const int enc)
+{
+        unsigned lane, good_lane = 0;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        while (state->job_in_lane[good_lane] == NULL)
+                good_lane++;
+
+        /*
+         * Empty lanes read the input of a valid lane,
+         * their length stays 0xFFFF and output is not stored.
+         */
+        for (lane = 0; lane < PON_OOO_NUM_LANES; lane++)
+                if (state->job_in_lane[lane] == NULL) {
+                        state->args.in[lane] = state->args.in[good_lane];
+                        state->args.out[lane] = state->args.out[good_lane];
+                }
+
+        return pon_x16_process(state, enc);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_pon_enc_vaes_avx512(MB_MGR_PON_OOO *state, IMB_JOB *job)
+{
+        return pon_submit(state, job, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_pon_enc_vaes_avx512(MB_MGR_PON_OOO *state)
+{
+        return pon_flush(state, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+submit_job_pon_dec_vaes_avx512(MB_MGR_PON_OOO *state, IMB_JOB *job)
+{
+        return pon_submit(state, job, 0);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+flush_job_pon_dec_vaes_avx512(MB_MGR_PON_OOO *state)
+{
+        return pon_flush(state, 0);
+}
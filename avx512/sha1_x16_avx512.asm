@@ -44,6 +44,7 @@
 %include "include/transpose_avx512.asm"
 %include "include/reg_sizes.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 section .data
 default rel
@@ -441,6 +442,9 @@ lastLoop:
 
 	ret
 
+;; void call_sha1_x16_avx512_from_c(SHA1_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha1_x16_avx512_from_c, sha1_x16_avx512, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
@@ -44,6 +44,7 @@
 %include "include/transpose_avx512.asm"
 %include "include/reg_sizes.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 ; re-use K256 from sha256_oct_avx2.asm
 extern K256
@@ -756,6 +757,9 @@ lastLoop:
         mov     rsp, [rsp + _rsp]
         ret
 
+;; void call_sha256_x16_avx512_from_c(SHA256_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha256_x16_avx512_from_c, sha256_x16_avx512, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
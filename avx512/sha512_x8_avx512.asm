@@ -45,6 +45,7 @@
 %include "mb_mgr_datastruct.asm"
 %include "include/transpose_avx512.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 %define APPEND(a,b) a %+ b
 
@@ -591,6 +592,9 @@ lastLoop:
 ;hash_done:
         ret
 
+;; void call_sha512_x8_avx512_from_c(SHA512_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha512_x8_avx512_from_c, sha512_x8_avx512, avx
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
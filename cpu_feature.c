@@ -221,6 +221,9 @@ uint64_t cpu_feature_detect(void)
 #ifdef SAFE_PARAM
         features |= IMB_FEATURE_SAFE_PARAM;
 #endif
+#ifdef MB_STATS
+        features |= IMB_FEATURE_STATS;
+#endif
 
         return features;
 }
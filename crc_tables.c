@@ -0,0 +1,429 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "include/crc.h"
+
+/*
+ * Constants for the PCLMULQDQ folded, non-reflected CRCs
+ * defined in 3GPP TS 38.212 (section 5.1), see include/crc_common.h
+ */
+
+/*
+ * CRC16 CCITT: x^16 + x^12 + x^5 + 1
+ * (polynomial shifted to 32 bits: 0x10210000)
+ */
+IMB_DLL_LOCAL
+DECLARE_ALIGNED(const struct crc_msb_consts crc16_ccitt_consts, 16) = {
+        /* fold by 4: x^576 mod P, x^512 mod P */
+        { 0x60190000, 0x59b00000 },
+        /* fold by 1: x^192 mod P, x^128 mod P */
+        { 0xd5f60000, 0x45630000 },
+        /* byte lookup table */
+        {
+                0x00000000, 0x10210000, 0x20420000, 0x30630000, 0x40840000,
+                0x50a50000, 0x60c60000, 0x70e70000, 0x81080000, 0x91290000,
+                0xa14a0000, 0xb16b0000, 0xc18c0000, 0xd1ad0000, 0xe1ce0000,
+                0xf1ef0000, 0x12310000, 0x02100000, 0x32730000, 0x22520000,
+                0x52b50000, 0x42940000, 0x72f70000, 0x62d60000, 0x93390000,
+                0x83180000, 0xb37b0000, 0xa35a0000, 0xd3bd0000, 0xc39c0000,
+                0xf3ff0000, 0xe3de0000, 0x24620000, 0x34430000, 0x04200000,
+                0x14010000, 0x64e60000, 0x74c70000, 0x44a40000, 0x54850000,
+                0xa56a0000, 0xb54b0000, 0x85280000, 0x95090000, 0xe5ee0000,
+                0xf5cf0000, 0xc5ac0000, 0xd58d0000, 0x36530000, 0x26720000,
+                0x16110000, 0x06300000, 0x76d70000, 0x66f60000, 0x56950000,
+                0x46b40000, 0xb75b0000, 0xa77a0000, 0x97190000, 0x87380000,
+                0xf7df0000, 0xe7fe0000, 0xd79d0000, 0xc7bc0000, 0x48c40000,
+                0x58e50000, 0x68860000, 0x78a70000, 0x08400000, 0x18610000,
+                0x28020000, 0x38230000, 0xc9cc0000, 0xd9ed0000, 0xe98e0000,
+                0xf9af0000, 0x89480000, 0x99690000, 0xa90a0000, 0xb92b0000,
+                0x5af50000, 0x4ad40000, 0x7ab70000, 0x6a960000, 0x1a710000,
+                0x0a500000, 0x3a330000, 0x2a120000, 0xdbfd0000, 0xcbdc0000,
+                0xfbbf0000, 0xeb9e0000, 0x9b790000, 0x8b580000, 0xbb3b0000,
+                0xab1a0000, 0x6ca60000, 0x7c870000, 0x4ce40000, 0x5cc50000,
+                0x2c220000, 0x3c030000, 0x0c600000, 0x1c410000, 0xedae0000,
+                0xfd8f0000, 0xcdec0000, 0xddcd0000, 0xad2a0000, 0xbd0b0000,
+                0x8d680000, 0x9d490000, 0x7e970000, 0x6eb60000, 0x5ed50000,
+                0x4ef40000, 0x3e130000, 0x2e320000, 0x1e510000, 0x0e700000,
+                0xff9f0000, 0xefbe0000, 0xdfdd0000, 0xcffc0000, 0xbf1b0000,
+                0xaf3a0000, 0x9f590000, 0x8f780000, 0x91880000, 0x81a90000,
+                0xb1ca0000, 0xa1eb0000, 0xd10c0000, 0xc12d0000, 0xf14e0000,
+                0xe16f0000, 0x10800000, 0x00a10000, 0x30c20000, 0x20e30000,
+                0x50040000, 0x40250000, 0x70460000, 0x60670000, 0x83b90000,
+                0x93980000, 0xa3fb0000, 0xb3da0000, 0xc33d0000, 0xd31c0000,
+                0xe37f0000, 0xf35e0000, 0x02b10000, 0x12900000, 0x22f30000,
+                0x32d20000, 0x42350000, 0x52140000, 0x62770000, 0x72560000,
+                0xb5ea0000, 0xa5cb0000, 0x95a80000, 0x85890000, 0xf56e0000,
+                0xe54f0000, 0xd52c0000, 0xc50d0000, 0x34e20000, 0x24c30000,
+                0x14a00000, 0x04810000, 0x74660000, 0x64470000, 0x54240000,
+                0x44050000, 0xa7db0000, 0xb7fa0000, 0x87990000, 0x97b80000,
+                0xe75f0000, 0xf77e0000, 0xc71d0000, 0xd73c0000, 0x26d30000,
+                0x36f20000, 0x06910000, 0x16b00000, 0x66570000, 0x76760000,
+                0x46150000, 0x56340000, 0xd94c0000, 0xc96d0000, 0xf90e0000,
+                0xe92f0000, 0x99c80000, 0x89e90000, 0xb98a0000, 0xa9ab0000,
+                0x58440000, 0x48650000, 0x78060000, 0x68270000, 0x18c00000,
+                0x08e10000, 0x38820000, 0x28a30000, 0xcb7d0000, 0xdb5c0000,
+                0xeb3f0000, 0xfb1e0000, 0x8bf90000, 0x9bd80000, 0xabbb0000,
+                0xbb9a0000, 0x4a750000, 0x5a540000, 0x6a370000, 0x7a160000,
+                0x0af10000, 0x1ad00000, 0x2ab30000, 0x3a920000, 0xfd2e0000,
+                0xed0f0000, 0xdd6c0000, 0xcd4d0000, 0xbdaa0000, 0xad8b0000,
+                0x9de80000, 0x8dc90000, 0x7c260000, 0x6c070000, 0x5c640000,
+                0x4c450000, 0x3ca20000, 0x2c830000, 0x1ce00000, 0x0cc10000,
+                0xef1f0000, 0xff3e0000, 0xcf5d0000, 0xdf7c0000, 0xaf9b0000,
+                0xbfba0000, 0x8fd90000, 0x9ff80000, 0x6e170000, 0x7e360000,
+                0x4e550000, 0x5e740000, 0x2e930000, 0x3eb20000, 0x0ed10000,
+                0x1ef00000
+        }
+};
+
+/*
+ * CRC24A: x^24 + x^23 + x^18 + x^17 + x^14 + x^11 + x^10 + x^7 +
+ *         x^6 + x^5 + x^4 + x^3 + x + 1
+ * (polynomial shifted to 32 bits: 0x864cfb00)
+ */
+IMB_DLL_LOCAL
+DECLARE_ALIGNED(const struct crc_msb_consts crc24_a_consts, 16) = {
+        /* fold by 4: x^576 mod P, x^512 mod P */
+        { 0x1f428700, 0x467d2400 },
+        /* fold by 1: x^192 mod P, x^128 mod P */
+        { 0x2c8c9d00, 0x64e4d700 },
+        /* byte lookup table */
+        {
+                0x00000000, 0x864cfb00, 0x8ad50d00, 0x0c99f600, 0x93e6e100,
+                0x15aa1a00, 0x1933ec00, 0x9f7f1700, 0xa1813900, 0x27cdc200,
+                0x2b543400, 0xad18cf00, 0x3267d800, 0xb42b2300, 0xb8b2d500,
+                0x3efe2e00, 0xc54e8900, 0x43027200, 0x4f9b8400, 0xc9d77f00,
+                0x56a86800, 0xd0e49300, 0xdc7d6500, 0x5a319e00, 0x64cfb000,
+                0xe2834b00, 0xee1abd00, 0x68564600, 0xf7295100, 0x7165aa00,
+                0x7dfc5c00, 0xfbb0a700, 0x0cd1e900, 0x8a9d1200, 0x8604e400,
+                0x00481f00, 0x9f370800, 0x197bf300, 0x15e20500, 0x93aefe00,
+                0xad50d000, 0x2b1c2b00, 0x2785dd00, 0xa1c92600, 0x3eb63100,
+                0xb8faca00, 0xb4633c00, 0x322fc700, 0xc99f6000, 0x4fd39b00,
+                0x434a6d00, 0xc5069600, 0x5a798100, 0xdc357a00, 0xd0ac8c00,
+                0x56e07700, 0x681e5900, 0xee52a200, 0xe2cb5400, 0x6487af00,
+                0xfbf8b800, 0x7db44300, 0x712db500, 0xf7614e00, 0x19a3d200,
+                0x9fef2900, 0x9376df00, 0x153a2400, 0x8a453300, 0x0c09c800,
+                0x00903e00, 0x86dcc500, 0xb822eb00, 0x3e6e1000, 0x32f7e600,
+                0xb4bb1d00, 0x2bc40a00, 0xad88f100, 0xa1110700, 0x275dfc00,
+                0xdced5b00, 0x5aa1a000, 0x56385600, 0xd074ad00, 0x4f0bba00,
+                0xc9474100, 0xc5deb700, 0x43924c00, 0x7d6c6200, 0xfb209900,
+                0xf7b96f00, 0x71f59400, 0xee8a8300, 0x68c67800, 0x645f8e00,
+                0xe2137500, 0x15723b00, 0x933ec000, 0x9fa73600, 0x19ebcd00,
+                0x8694da00, 0x00d82100, 0x0c41d700, 0x8a0d2c00, 0xb4f30200,
+                0x32bff900, 0x3e260f00, 0xb86af400, 0x2715e300, 0xa1591800,
+                0xadc0ee00, 0x2b8c1500, 0xd03cb200, 0x56704900, 0x5ae9bf00,
+                0xdca54400, 0x43da5300, 0xc596a800, 0xc90f5e00, 0x4f43a500,
+                0x71bd8b00, 0xf7f17000, 0xfb688600, 0x7d247d00, 0xe25b6a00,
+                0x64179100, 0x688e6700, 0xeec29c00, 0x3347a400, 0xb50b5f00,
+                0xb992a900, 0x3fde5200, 0xa0a14500, 0x26edbe00, 0x2a744800,
+                0xac38b300, 0x92c69d00, 0x148a6600, 0x18139000, 0x9e5f6b00,
+                0x01207c00, 0x876c8700, 0x8bf57100, 0x0db98a00, 0xf6092d00,
+                0x7045d600, 0x7cdc2000, 0xfa90db00, 0x65efcc00, 0xe3a33700,
+                0xef3ac100, 0x69763a00, 0x57881400, 0xd1c4ef00, 0xdd5d1900,
+                0x5b11e200, 0xc46ef500, 0x42220e00, 0x4ebbf800, 0xc8f70300,
+                0x3f964d00, 0xb9dab600, 0xb5434000, 0x330fbb00, 0xac70ac00,
+                0x2a3c5700, 0x26a5a100, 0xa0e95a00, 0x9e177400, 0x185b8f00,
+                0x14c27900, 0x928e8200, 0x0df19500, 0x8bbd6e00, 0x87249800,
+                0x01686300, 0xfad8c400, 0x7c943f00, 0x700dc900, 0xf6413200,
+                0x693e2500, 0xef72de00, 0xe3eb2800, 0x65a7d300, 0x5b59fd00,
+                0xdd150600, 0xd18cf000, 0x57c00b00, 0xc8bf1c00, 0x4ef3e700,
+                0x426a1100, 0xc426ea00, 0x2ae47600, 0xaca88d00, 0xa0317b00,
+                0x267d8000, 0xb9029700, 0x3f4e6c00, 0x33d79a00, 0xb59b6100,
+                0x8b654f00, 0x0d29b400, 0x01b04200, 0x87fcb900, 0x1883ae00,
+                0x9ecf5500, 0x9256a300, 0x141a5800, 0xefaaff00, 0x69e60400,
+                0x657ff200, 0xe3330900, 0x7c4c1e00, 0xfa00e500, 0xf6991300,
+                0x70d5e800, 0x4e2bc600, 0xc8673d00, 0xc4fecb00, 0x42b23000,
+                0xddcd2700, 0x5b81dc00, 0x57182a00, 0xd154d100, 0x26359f00,
+                0xa0796400, 0xace09200, 0x2aac6900, 0xb5d37e00, 0x339f8500,
+                0x3f067300, 0xb94a8800, 0x87b4a600, 0x01f85d00, 0x0d61ab00,
+                0x8b2d5000, 0x14524700, 0x921ebc00, 0x9e874a00, 0x18cbb100,
+                0xe37b1600, 0x6537ed00, 0x69ae1b00, 0xefe2e000, 0x709df700,
+                0xf6d10c00, 0xfa48fa00, 0x7c040100, 0x42fa2f00, 0xc4b6d400,
+                0xc82f2200, 0x4e63d900, 0xd11cce00, 0x57503500, 0x5bc9c300,
+                0xdd853800
+        }
+};
+
+/*
+ * CRC24B: x^24 + x^23 + x^6 + x^5 + x + 1
+ * (polynomial shifted to 32 bits: 0x80006300)
+ */
+IMB_DLL_LOCAL
+DECLARE_ALIGNED(const struct crc_msb_consts crc24_b_consts, 16) = {
+        /* fold by 4: x^576 mod P, x^512 mod P */
+        { 0xb5015b00, 0xa0660100 },
+        /* fold by 1: x^192 mod P, x^128 mod P */
+        { 0x42000100, 0x80140500 },
+        /* byte lookup table */
+        {
+                0x00000000, 0x80006300, 0x8000a500, 0x0000c600, 0x80012900,
+                0x00014a00, 0x00018c00, 0x8001ef00, 0x80023100, 0x00025200,
+                0x00029400, 0x8002f700, 0x00031800, 0x80037b00, 0x8003bd00,
+                0x0003de00, 0x80040100, 0x00046200, 0x0004a400, 0x8004c700,
+                0x00052800, 0x80054b00, 0x80058d00, 0x0005ee00, 0x00063000,
+                0x80065300, 0x80069500, 0x0006f600, 0x80071900, 0x00077a00,
+                0x0007bc00, 0x8007df00, 0x80086100, 0x00080200, 0x0008c400,
+                0x8008a700, 0x00094800, 0x80092b00, 0x8009ed00, 0x00098e00,
+                0x000a5000, 0x800a3300, 0x800af500, 0x000a9600, 0x800b7900,
+                0x000b1a00, 0x000bdc00, 0x800bbf00, 0x000c6000, 0x800c0300,
+                0x800cc500, 0x000ca600, 0x800d4900, 0x000d2a00, 0x000dec00,
+                0x800d8f00, 0x800e5100, 0x000e3200, 0x000ef400, 0x800e9700,
+                0x000f7800, 0x800f1b00, 0x800fdd00, 0x000fbe00, 0x8010a100,
+                0x0010c200, 0x00100400, 0x80106700, 0x00118800, 0x8011eb00,
+                0x80112d00, 0x00114e00, 0x00129000, 0x8012f300, 0x80123500,
+                0x00125600, 0x8013b900, 0x0013da00, 0x00131c00, 0x80137f00,
+                0x0014a000, 0x8014c300, 0x80140500, 0x00146600, 0x80158900,
+                0x0015ea00, 0x00152c00, 0x80154f00, 0x80169100, 0x0016f200,
+                0x00163400, 0x80165700, 0x0017b800, 0x8017db00, 0x80171d00,
+                0x00177e00, 0x0018c000, 0x8018a300, 0x80186500, 0x00180600,
+                0x8019e900, 0x00198a00, 0x00194c00, 0x80192f00, 0x801af100,
+                0x001a9200, 0x001a5400, 0x801a3700, 0x001bd800, 0x801bbb00,
+                0x801b7d00, 0x001b1e00, 0x801cc100, 0x001ca200, 0x001c6400,
+                0x801c0700, 0x001de800, 0x801d8b00, 0x801d4d00, 0x001d2e00,
+                0x001ef000, 0x801e9300, 0x801e5500, 0x001e3600, 0x801fd900,
+                0x001fba00, 0x001f7c00, 0x801f1f00, 0x80212100, 0x00214200,
+                0x00218400, 0x8021e700, 0x00200800, 0x80206b00, 0x8020ad00,
+                0x0020ce00, 0x00231000, 0x80237300, 0x8023b500, 0x0023d600,
+                0x80223900, 0x00225a00, 0x00229c00, 0x8022ff00, 0x00252000,
+                0x80254300, 0x80258500, 0x0025e600, 0x80240900, 0x00246a00,
+                0x0024ac00, 0x8024cf00, 0x80271100, 0x00277200, 0x0027b400,
+                0x8027d700, 0x00263800, 0x80265b00, 0x80269d00, 0x0026fe00,
+                0x00294000, 0x80292300, 0x8029e500, 0x00298600, 0x80286900,
+                0x00280a00, 0x0028cc00, 0x8028af00, 0x802b7100, 0x002b1200,
+                0x002bd400, 0x802bb700, 0x002a5800, 0x802a3b00, 0x802afd00,
+                0x002a9e00, 0x802d4100, 0x002d2200, 0x002de400, 0x802d8700,
+                0x002c6800, 0x802c0b00, 0x802ccd00, 0x002cae00, 0x002f7000,
+                0x802f1300, 0x802fd500, 0x002fb600, 0x802e5900, 0x002e3a00,
+                0x002efc00, 0x802e9f00, 0x00318000, 0x8031e300, 0x80312500,
+                0x00314600, 0x8030a900, 0x0030ca00, 0x00300c00, 0x80306f00,
+                0x8033b100, 0x0033d200, 0x00331400, 0x80337700, 0x00329800,
+                0x8032fb00, 0x80323d00, 0x00325e00, 0x80358100, 0x0035e200,
+                0x00352400, 0x80354700, 0x0034a800, 0x8034cb00, 0x80340d00,
+                0x00346e00, 0x0037b000, 0x8037d300, 0x80371500, 0x00377600,
+                0x80369900, 0x0036fa00, 0x00363c00, 0x80365f00, 0x8039e100,
+                0x00398200, 0x00394400, 0x80392700, 0x0038c800, 0x8038ab00,
+                0x80386d00, 0x00380e00, 0x003bd000, 0x803bb300, 0x803b7500,
+                0x003b1600, 0x803af900, 0x003a9a00, 0x003a5c00, 0x803a3f00,
+                0x003de000, 0x803d8300, 0x803d4500, 0x003d2600, 0x803cc900,
+                0x003caa00, 0x003c6c00, 0x803c0f00, 0x803fd100, 0x003fb200,
+                0x003f7400, 0x803f1700, 0x003ef800, 0x803e9b00, 0x803e5d00,
+                0x003e3e00
+        }
+};
+
+/*
+ * CRC11: x^11 + x^10 + x^9 + x^5 + 1
+ * (polynomial shifted to 32 bits: 0xc4200000)
+ */
+IMB_DLL_LOCAL
+DECLARE_ALIGNED(const struct crc_msb_consts crc11_consts, 16) = {
+        /* fold by 4: x^576 mod P, x^512 mod P */
+        { 0x9b800000, 0x9d000000 },
+        /* fold by 1: x^192 mod P, x^128 mod P */
+        { 0x8ea00000, 0x47600000 },
+        /* byte lookup table */
+        {
+                0x00000000, 0xc4200000, 0x4c600000, 0x88400000, 0x98c00000,
+                0x5ce00000, 0xd4a00000, 0x10800000, 0xf5a00000, 0x31800000,
+                0xb9c00000, 0x7de00000, 0x6d600000, 0xa9400000, 0x21000000,
+                0xe5200000, 0x2f600000, 0xeb400000, 0x63000000, 0xa7200000,
+                0xb7a00000, 0x73800000, 0xfbc00000, 0x3fe00000, 0xdac00000,
+                0x1ee00000, 0x96a00000, 0x52800000, 0x42000000, 0x86200000,
+                0x0e600000, 0xca400000, 0x5ec00000, 0x9ae00000, 0x12a00000,
+                0xd6800000, 0xc6000000, 0x02200000, 0x8a600000, 0x4e400000,
+                0xab600000, 0x6f400000, 0xe7000000, 0x23200000, 0x33a00000,
+                0xf7800000, 0x7fc00000, 0xbbe00000, 0x71a00000, 0xb5800000,
+                0x3dc00000, 0xf9e00000, 0xe9600000, 0x2d400000, 0xa5000000,
+                0x61200000, 0x84000000, 0x40200000, 0xc8600000, 0x0c400000,
+                0x1cc00000, 0xd8e00000, 0x50a00000, 0x94800000, 0xbd800000,
+                0x79a00000, 0xf1e00000, 0x35c00000, 0x25400000, 0xe1600000,
+                0x69200000, 0xad000000, 0x48200000, 0x8c000000, 0x04400000,
+                0xc0600000, 0xd0e00000, 0x14c00000, 0x9c800000, 0x58a00000,
+                0x92e00000, 0x56c00000, 0xde800000, 0x1aa00000, 0x0a200000,
+                0xce000000, 0x46400000, 0x82600000, 0x67400000, 0xa3600000,
+                0x2b200000, 0xef000000, 0xff800000, 0x3ba00000, 0xb3e00000,
+                0x77c00000, 0xe3400000, 0x27600000, 0xaf200000, 0x6b000000,
+                0x7b800000, 0xbfa00000, 0x37e00000, 0xf3c00000, 0x16e00000,
+                0xd2c00000, 0x5a800000, 0x9ea00000, 0x8e200000, 0x4a000000,
+                0xc2400000, 0x06600000, 0xcc200000, 0x08000000, 0x80400000,
+                0x44600000, 0x54e00000, 0x90c00000, 0x18800000, 0xdca00000,
+                0x39800000, 0xfda00000, 0x75e00000, 0xb1c00000, 0xa1400000,
+                0x65600000, 0xed200000, 0x29000000, 0xbf200000, 0x7b000000,
+                0xf3400000, 0x37600000, 0x27e00000, 0xe3c00000, 0x6b800000,
+                0xafa00000, 0x4a800000, 0x8ea00000, 0x06e00000, 0xc2c00000,
+                0xd2400000, 0x16600000, 0x9e200000, 0x5a000000, 0x90400000,
+                0x54600000, 0xdc200000, 0x18000000, 0x08800000, 0xcca00000,
+                0x44e00000, 0x80c00000, 0x65e00000, 0xa1c00000, 0x29800000,
+                0xeda00000, 0xfd200000, 0x39000000, 0xb1400000, 0x75600000,
+                0xe1e00000, 0x25c00000, 0xad800000, 0x69a00000, 0x79200000,
+                0xbd000000, 0x35400000, 0xf1600000, 0x14400000, 0xd0600000,
+                0x58200000, 0x9c000000, 0x8c800000, 0x48a00000, 0xc0e00000,
+                0x04c00000, 0xce800000, 0x0aa00000, 0x82e00000, 0x46c00000,
+                0x56400000, 0x92600000, 0x1a200000, 0xde000000, 0x3b200000,
+                0xff000000, 0x77400000, 0xb3600000, 0xa3e00000, 0x67c00000,
+                0xef800000, 0x2ba00000, 0x02a00000, 0xc6800000, 0x4ec00000,
+                0x8ae00000, 0x9a600000, 0x5e400000, 0xd6000000, 0x12200000,
+                0xf7000000, 0x33200000, 0xbb600000, 0x7f400000, 0x6fc00000,
+                0xabe00000, 0x23a00000, 0xe7800000, 0x2dc00000, 0xe9e00000,
+                0x61a00000, 0xa5800000, 0xb5000000, 0x71200000, 0xf9600000,
+                0x3d400000, 0xd8600000, 0x1c400000, 0x94000000, 0x50200000,
+                0x40a00000, 0x84800000, 0x0cc00000, 0xc8e00000, 0x5c600000,
+                0x98400000, 0x10000000, 0xd4200000, 0xc4a00000, 0x00800000,
+                0x88c00000, 0x4ce00000, 0xa9c00000, 0x6de00000, 0xe5a00000,
+                0x21800000, 0x31000000, 0xf5200000, 0x7d600000, 0xb9400000,
+                0x73000000, 0xb7200000, 0x3f600000, 0xfb400000, 0xebc00000,
+                0x2fe00000, 0xa7a00000, 0x63800000, 0x86a00000, 0x42800000,
+                0xcac00000, 0x0ee00000, 0x1e600000, 0xda400000, 0x52000000,
+                0x96200000
+        }
+};
+
+/*
+ * CRC6: x^6 + x^5 + 1
+ * (polynomial shifted to 32 bits: 0x84000000)
+ */
+IMB_DLL_LOCAL
+DECLARE_ALIGNED(const struct crc_msb_consts crc6_consts, 16) = {
+        /* fold by 4: x^576 mod P, x^512 mod P */
+        { 0xac000000, 0x94000000 },
+        /* fold by 1: x^192 mod P, x^128 mod P */
+        { 0x38000000, 0x1c000000 },
+        /* byte lookup table */
+        {
+                0x00000000, 0x84000000, 0x8c000000, 0x08000000, 0x9c000000,
+                0x18000000, 0x10000000, 0x94000000, 0xbc000000, 0x38000000,
+                0x30000000, 0xb4000000, 0x20000000, 0xa4000000, 0xac000000,
+                0x28000000, 0xfc000000, 0x78000000, 0x70000000, 0xf4000000,
+                0x60000000, 0xe4000000, 0xec000000, 0x68000000, 0x40000000,
+                0xc4000000, 0xcc000000, 0x48000000, 0xdc000000, 0x58000000,
+                0x50000000, 0xd4000000, 0x7c000000, 0xf8000000, 0xf0000000,
+                0x74000000, 0xe0000000, 0x64000000, 0x6c000000, 0xe8000000,
+                0xc0000000, 0x44000000, 0x4c000000, 0xc8000000, 0x5c000000,
+                0xd8000000, 0xd0000000, 0x54000000, 0x80000000, 0x04000000,
+                0x0c000000, 0x88000000, 0x1c000000, 0x98000000, 0x90000000,
+                0x14000000, 0x3c000000, 0xb8000000, 0xb0000000, 0x34000000,
+                0xa0000000, 0x24000000, 0x2c000000, 0xa8000000, 0xf8000000,
+                0x7c000000, 0x74000000, 0xf0000000, 0x64000000, 0xe0000000,
+                0xe8000000, 0x6c000000, 0x44000000, 0xc0000000, 0xc8000000,
+                0x4c000000, 0xd8000000, 0x5c000000, 0x54000000, 0xd0000000,
+                0x04000000, 0x80000000, 0x88000000, 0x0c000000, 0x98000000,
+                0x1c000000, 0x14000000, 0x90000000, 0xb8000000, 0x3c000000,
+                0x34000000, 0xb0000000, 0x24000000, 0xa0000000, 0xa8000000,
+                0x2c000000, 0x84000000, 0x00000000, 0x08000000, 0x8c000000,
+                0x18000000, 0x9c000000, 0x94000000, 0x10000000, 0x38000000,
+                0xbc000000, 0xb4000000, 0x30000000, 0xa4000000, 0x20000000,
+                0x28000000, 0xac000000, 0x78000000, 0xfc000000, 0xf4000000,
+                0x70000000, 0xe4000000, 0x60000000, 0x68000000, 0xec000000,
+                0xc4000000, 0x40000000, 0x48000000, 0xcc000000, 0x58000000,
+                0xdc000000, 0xd4000000, 0x50000000, 0x74000000, 0xf0000000,
+                0xf8000000, 0x7c000000, 0xe8000000, 0x6c000000, 0x64000000,
+                0xe0000000, 0xc8000000, 0x4c000000, 0x44000000, 0xc0000000,
+                0x54000000, 0xd0000000, 0xd8000000, 0x5c000000, 0x88000000,
+                0x0c000000, 0x04000000, 0x80000000, 0x14000000, 0x90000000,
+                0x98000000, 0x1c000000, 0x34000000, 0xb0000000, 0xb8000000,
+                0x3c000000, 0xa8000000, 0x2c000000, 0x24000000, 0xa0000000,
+                0x08000000, 0x8c000000, 0x84000000, 0x00000000, 0x94000000,
+                0x10000000, 0x18000000, 0x9c000000, 0xb4000000, 0x30000000,
+                0x38000000, 0xbc000000, 0x28000000, 0xac000000, 0xa4000000,
+                0x20000000, 0xf4000000, 0x70000000, 0x78000000, 0xfc000000,
+                0x68000000, 0xec000000, 0xe4000000, 0x60000000, 0x48000000,
+                0xcc000000, 0xc4000000, 0x40000000, 0xd4000000, 0x50000000,
+                0x58000000, 0xdc000000, 0x8c000000, 0x08000000, 0x00000000,
+                0x84000000, 0x10000000, 0x94000000, 0x9c000000, 0x18000000,
+                0x30000000, 0xb4000000, 0xbc000000, 0x38000000, 0xac000000,
+                0x28000000, 0x20000000, 0xa4000000, 0x70000000, 0xf4000000,
+                0xfc000000, 0x78000000, 0xec000000, 0x68000000, 0x60000000,
+                0xe4000000, 0xcc000000, 0x48000000, 0x40000000, 0xc4000000,
+                0x50000000, 0xd4000000, 0xdc000000, 0x58000000, 0xf0000000,
+                0x74000000, 0x7c000000, 0xf8000000, 0x6c000000, 0xe8000000,
+                0xe0000000, 0x64000000, 0x4c000000, 0xc8000000, 0xc0000000,
+                0x44000000, 0xd0000000, 0x54000000, 0x5c000000, 0xd8000000,
+                0x0c000000, 0x88000000, 0x80000000, 0x04000000, 0x90000000,
+                0x14000000, 0x1c000000, 0x98000000, 0xb0000000, 0x34000000,
+                0x3c000000, 0xb8000000, 0x2c000000, 0xa8000000, 0xa0000000,
+                0x24000000
+        }
+};
+
+/*
+ * Ethernet FCS (reflected 0x04C11DB7) byte lookup table,
+ * used to finish the CRC of PON frames (see mb_mgr_pon_vaes_avx512.c)
+ */
+IMB_DLL_LOCAL
+DECLARE_ALIGNED(const uint32_t ethernet_fcs_lut[256], 16) = {
+        0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419,
+        0x706af48f, 0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4,
+        0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07,
+        0x90bf1d91, 0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de,
+        0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7, 0x136c9856,
+        0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
+        0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4,
+        0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+        0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3,
+        0x45df5c75, 0xdcd60dcf, 0xabd13d59, 0x26d930ac, 0x51de003a,
+        0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599,
+        0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
+        0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190,
+        0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f,
+        0x9fbfe4a5, 0xe8b8d433, 0x7807c9a2, 0x0f00f934, 0x9609a88e,
+        0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+        0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed,
+        0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
+        0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3,
+        0xfbd44c65, 0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2,
+        0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a,
+        0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5,
+        0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa, 0xbe0b1010,
+        0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+        0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17,
+        0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6,
+        0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615,
+        0x73dc1683, 0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8,
+        0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1, 0xf00f9344,
+        0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
+        0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a,
+        0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+        0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1,
+        0xa6bc5767, 0x3fb506dd, 0x48b2364b, 0xd80d2bda, 0xaf0a1b4c,
+        0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef,
+        0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
+        0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe,
+        0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31,
+        0x2cd99e8b, 0x5bdeae1d, 0x9b64c2b0, 0xec63f226, 0x756aa39c,
+        0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+        0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b,
+        0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
+        0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1,
+        0x18b74777, 0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c,
+        0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45, 0xa00ae278,
+        0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7,
+        0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc, 0x40df0b66,
+        0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+        0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605,
+        0xcdd70693, 0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8,
+        0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b,
+        0x2d02ef8d
+};
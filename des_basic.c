@@ -98,7 +98,7 @@ uint64_t e_phase(const uint64_t R)
                 ((R & UINT64_C(1)) << 61);
 }
 
-static const uint32_t sbox0p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox0p[64] = {
         UINT32_C(0x00410100), UINT32_C(0x00010000),
         UINT32_C(0x40400000), UINT32_C(0x40410100),
         UINT32_C(0x00400000), UINT32_C(0x40010100),
@@ -133,7 +133,7 @@ static const uint32_t sbox0p[64] = {
         UINT32_C(0x00000100), UINT32_C(0x40010100)
 };
 
-static const uint32_t sbox1p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox1p[64] = {
         UINT32_C(0x08021002), UINT32_C(0x00000000),
         UINT32_C(0x00021000), UINT32_C(0x08020000),
         UINT32_C(0x08000002), UINT32_C(0x00001002),
@@ -168,7 +168,7 @@ static const uint32_t sbox1p[64] = {
         UINT32_C(0x08020000), UINT32_C(0x00021000)
 };
 
-static const uint32_t sbox2p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox2p[64] = {
         UINT32_C(0x20800000), UINT32_C(0x00808020),
         UINT32_C(0x00000020), UINT32_C(0x20800020),
         UINT32_C(0x20008000), UINT32_C(0x00800000),
@@ -203,7 +203,7 @@ static const uint32_t sbox2p[64] = {
         UINT32_C(0x00000020), UINT32_C(0x00808000)
 };
 
-static const uint32_t sbox3p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox3p[64] = {
         UINT32_C(0x00080201), UINT32_C(0x02000200),
         UINT32_C(0x00000001), UINT32_C(0x02080201),
         UINT32_C(0x00000000), UINT32_C(0x02080000),
@@ -238,7 +238,7 @@ static const uint32_t sbox3p[64] = {
         UINT32_C(0x02000001), UINT32_C(0x02080200)
 };
 
-static const uint32_t sbox4p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox4p[64] = {
         UINT32_C(0x01000000), UINT32_C(0x00002000),
         UINT32_C(0x00000080), UINT32_C(0x01002084),
         UINT32_C(0x01002004), UINT32_C(0x01000080),
@@ -273,7 +273,7 @@ static const uint32_t sbox4p[64] = {
         UINT32_C(0x01002000), UINT32_C(0x01000004)
 };
 
-const uint32_t sbox5p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox5p[64] = {
         UINT32_C(0x10000008), UINT32_C(0x00040008),
         UINT32_C(0x00000000), UINT32_C(0x10040400),
         UINT32_C(0x00040008), UINT32_C(0x00000400),
@@ -308,7 +308,7 @@ const uint32_t sbox5p[64] = {
         UINT32_C(0x00000008), UINT32_C(0x10040008)
 };
 
-static const uint32_t sbox6p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox6p[64] = {
         UINT32_C(0x00000800), UINT32_C(0x00000040),
         UINT32_C(0x00200040), UINT32_C(0x80200000),
         UINT32_C(0x80200840), UINT32_C(0x80000800),
@@ -343,7 +343,7 @@ static const uint32_t sbox6p[64] = {
         UINT32_C(0x00200800), UINT32_C(0x80000800)
 };
 
-static const uint32_t sbox7p[64] = {
+IMB_DLL_LOCAL const uint32_t des_sbox7p[64] = {
         UINT32_C(0x04100010), UINT32_C(0x04104000),
         UINT32_C(0x00004010), UINT32_C(0x00000000),
         UINT32_C(0x04004000), UINT32_C(0x00100010),
@@ -392,22 +392,22 @@ uint32_t fRK(const uint32_t R, const uint64_t K)
          *   s-box: 48 bits -> 32 bits
          *   p-phase: 32 bits -> 32 bites permutation
          */
-        return ((LOOKUP32_SSE(sbox0p, ((x >> (8 * 0)) & 0x3f),
-                              sizeof(sbox0p))) |
-                (LOOKUP32_SSE(sbox1p, ((x >> (8 * 1)) & 0x3f),
-                              sizeof(sbox1p))) |
-                (LOOKUP32_SSE(sbox2p, ((x >> (8 * 2)) & 0x3f),
-                              sizeof(sbox2p))) |
-                (LOOKUP32_SSE(sbox3p, ((x >> (8 * 3)) & 0x3f),
-                              sizeof(sbox3p))) |
-                (LOOKUP32_SSE(sbox4p, ((x >> (8 * 4)) & 0x3f),
-                              sizeof(sbox4p))) |
-                (LOOKUP32_SSE(sbox5p, ((x >> (8 * 5)) & 0x3f),
-                              sizeof(sbox5p))) |
-                (LOOKUP32_SSE(sbox6p, ((x >> (8 * 6)) & 0x3f),
-                              sizeof(sbox6p))) |
-                (LOOKUP32_SSE(sbox7p, ((x >> (8 * 7)) & 0x3f),
-                              sizeof(sbox7p))));
+        return ((LOOKUP32_SSE(des_sbox0p, ((x >> (8 * 0)) & 0x3f),
+                              sizeof(des_sbox0p))) |
+                (LOOKUP32_SSE(des_sbox1p, ((x >> (8 * 1)) & 0x3f),
+                              sizeof(des_sbox1p))) |
+                (LOOKUP32_SSE(des_sbox2p, ((x >> (8 * 2)) & 0x3f),
+                              sizeof(des_sbox2p))) |
+                (LOOKUP32_SSE(des_sbox3p, ((x >> (8 * 3)) & 0x3f),
+                              sizeof(des_sbox3p))) |
+                (LOOKUP32_SSE(des_sbox4p, ((x >> (8 * 4)) & 0x3f),
+                              sizeof(des_sbox4p))) |
+                (LOOKUP32_SSE(des_sbox5p, ((x >> (8 * 5)) & 0x3f),
+                              sizeof(des_sbox5p))) |
+                (LOOKUP32_SSE(des_sbox6p, ((x >> (8 * 6)) & 0x3f),
+                              sizeof(des_sbox6p))) |
+                (LOOKUP32_SSE(des_sbox7p, ((x >> (8 * 7)) & 0x3f),
+                              sizeof(des_sbox7p))));
 }
 
 __forceinline
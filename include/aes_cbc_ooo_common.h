@@ -0,0 +1,679 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer AES-CBC encryption, AES-XCBC-MAC-96 and AES-CMAC
+ * out-of-order managers (AVX2).
+ *
+ * All three modes run the same AES-CBC chain on AES_CBC_OOO_NUM_LANES
+ * independent buffers, one block per lane in each iteration.
+ * MAC modes don't write the output and keep the digest in the IV/ICV.
+ *
+ * Lane length tracking:
+ * - lens - number of bytes left to process, unused lanes hold 0xFFFF
+ *   so that they are never selected as the shortest lane
+ * - on flush, arguments of a valid lane are copied into empty lanes
+ *   with YMM blends instead of testing lanes one by one
+ *
+ * XCBC and CMAC prepare the final (padded and XOR'ed with the subkey)
+ * block on submit. When a lane runs out of data, its input is switched
+ * to the final block and the lane gets 16 more bytes to process.
+ * Empty lanes are pointed at the same final block, so that on flush
+ * they don't read past the end of the message.
+ *
+ * The including file has to define:
+ * - SUBMIT_JOB_AES128_ENC, SUBMIT_JOB_AES192_ENC, SUBMIT_JOB_AES256_ENC
+ * - FLUSH_JOB_AES128_ENC, FLUSH_JOB_AES192_ENC, FLUSH_JOB_AES256_ENC
+ * - SUBMIT_JOB_AES_XCBC, FLUSH_JOB_AES_XCBC
+ * - SUBMIT_JOB_AES_CMAC_AUTH, FLUSH_JOB_AES_CMAC_AUTH
+ */
+
+#ifndef AES_CBC_OOO_COMMON_H
+#define AES_CBC_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+#include "include/aes_x8_common.h"
+#include "include/ooo_idle_lanes.h"
+
+#define AES_CBC_BLOCK_SIZE 16
+#define AES_XCBC_DIGEST_SIZE 12
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES192_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_ENC(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES192_ENC(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_ENC(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES_XCBC(MB_MGR_AES_XCBC_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES_XCBC(MB_MGR_AES_XCBC_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES_CMAC_AUTH(MB_MGR_CMAC_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES_CMAC_AUTH(MB_MGR_CMAC_OOO *state);
+
+/**
+ * @brief Runs AES-CBC on all lanes
+ *
+ * All lanes are processed, unused lanes have to point to
+ * valid buffers (see flush).
+ *
+ * @param [in/out] in     Input pointers (advanced)
+ * @param [in/out] out    Output pointers (advanced), NULL for CBC-MAC
+ * @param [in] keys       Expanded encryption keys
+ * @param [in/out] iv     IV / chaining values
+ * @param [in] num_blocks Number of blocks to process in each lane
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ */
+__forceinline
+void
+aes_cbc_x8(const uint8_t **in, uint8_t **out, const uint32_t *const *keys,
+           imb_uint128_t *iv, const uint64_t num_blocks,
+           const unsigned nrounds)
+{
+        __m128i blk[AES_CBC_OOO_NUM_LANES];
+        __m128i d[AES_CBC_OOO_NUM_LANES];
+        uint64_t i, offset = 0;
+        unsigned lane;
+
+        for (lane = 0; lane < AES_CBC_OOO_NUM_LANES; lane++)
+                blk[lane] = _mm_load_si128((const __m128i *) &iv[lane]);
+
+        for (i = 0; i < num_blocks; i++) {
+                aes_x8_load_block(d, in, offset);
+                for (lane = 0; lane < AES_CBC_OOO_NUM_LANES; lane++)
+                        blk[lane] = _mm_xor_si128(blk[lane], d[lane]);
+
+                aes_x8_enc_block(blk, keys, nrounds);
+
+                if (out != NULL)
+                        for (lane = 0; lane < AES_CBC_OOO_NUM_LANES; lane++)
+                                _mm_storeu_si128((__m128i *)
+                                                 &out[lane][offset],
+                                                 blk[lane]);
+
+                offset += AES_CBC_BLOCK_SIZE;
+        }
+
+        for (lane = 0; lane < AES_CBC_OOO_NUM_LANES; lane++) {
+                _mm_store_si128((__m128i *) &iv[lane], blk[lane]);
+                in[lane] += offset;
+                if (out != NULL)
+                        out[lane] += offset;
+        }
+}
+
+/**
+ * @brief Runs all lanes up to the shortest one
+ *
+ * @param [in/out] lens   Lane lengths (0xFFFF for unused lanes)
+ * @param [in/out] in     Input pointers
+ * @param [in/out] out    Output pointers, NULL for CBC-MAC
+ * @param [in] keys       Expanded encryption keys
+ * @param [in/out] iv     IV / chaining values
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Index of the shortest lane (its length is now 0)
+ */
+__forceinline
+unsigned
+aes_cbc_ooo_run(uint16_t *lens, const uint8_t **in, uint8_t **out,
+                const uint32_t *const *keys, imb_uint128_t *iv,
+                const unsigned nrounds)
+{
+        __m128i l = _mm_load_si128((const __m128i *) lens);
+        const __m128i minpos = _mm_minpos_epu16(l);
+        const unsigned min_len = (unsigned) _mm_extract_epi16(minpos, 0);
+
+        if (min_len != 0) {
+                const __m128i unused = _mm_cmpeq_epi16(l,
+                                                       _mm_set1_epi16(-1));
+
+                aes_cbc_x8(in, out, keys, iv,
+                           min_len / AES_CBC_BLOCK_SIZE, nrounds);
+
+                l = _mm_sub_epi16(l, _mm_set1_epi16((short) min_len));
+                l = _mm_or_si128(l, unused);
+                _mm_store_si128((__m128i *) lens, l);
+        }
+
+        return (unsigned) _mm_extract_epi16(minpos, 1);
+}
+
+/**
+ * @brief Finds empty lanes of the manager
+ *
+ * @param [in] jobs       Jobs in lanes
+ * @param [out] null_lo   Lanes 0 to 3, all bits set for empty lanes
+ * @param [out] null_hi   Lanes 4 to 7, all bits set for empty lanes
+ *
+ * @return Index of a lane with a job
+ */
+__forceinline
+unsigned
+aes_cbc_ooo_null_lanes(IMB_JOB *const *jobs, __m256i *null_lo,
+                       __m256i *null_hi)
+{
+        const __m256i zero = _mm256_setzero_si256();
+        unsigned mask, good_lane = 0;
+
+        *null_lo = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)
+                                                         &jobs[0]), zero);
+        *null_hi = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)
+                                                         &jobs[4]), zero);
+
+        mask = (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(*null_lo)) |
+                ((unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(*null_hi))
+                 << 4);
+
+        while (mask & (1 << good_lane))
+                good_lane++;
+
+        return good_lane;
+}
+
+/**
+ * @brief Copies a pointer of the good lane into empty lanes
+ *
+ * @param [in/out] ptrs   Array of AES_CBC_OOO_NUM_LANES pointers
+ * @param [in] null_lo    Empty lanes 0 to 3
+ * @param [in] null_hi    Empty lanes 4 to 7
+ * @param [in] good_lane  Lane to copy from
+ */
+__forceinline
+void
+aes_cbc_ooo_fill_ptrs(void *ptrs, const __m256i null_lo,
+                      const __m256i null_hi, const unsigned good_lane)
+{
+        __m256i *p = (__m256i *) ptrs;
+        const __m256i good =
+                _mm256_set1_epi64x((long long)
+                                   ((const uint64_t *) ptrs)[good_lane]);
+
+        _mm256_storeu_si256(&p[0],
+                            _mm256_blendv_epi8(_mm256_loadu_si256(&p[0]),
+                                               good, null_lo));
+        _mm256_storeu_si256(&p[1],
+                            _mm256_blendv_epi8(_mm256_loadu_si256(&p[1]),
+                                               good, null_hi));
+}
+
+/**
+ * @brief Copies IV of the good lane into empty lanes
+ *
+ * With clear set, IVs of empty lanes are zeroed instead.
+ *
+ * @param [in/out] iv     Array of AES_CBC_OOO_NUM_LANES IVs
+ * @param [in] null_lo    Empty lanes 0 to 3
+ * @param [in] null_hi    Empty lanes 4 to 7
+ * @param [in] good_lane  Lane to copy from
+ * @param [in] clear      Zero IVs of empty lanes
+ */
+__forceinline
+void
+aes_cbc_ooo_fill_iv(imb_uint128_t *iv, const __m256i null_lo,
+                    const __m256i null_hi, const unsigned good_lane,
+                    const int clear)
+{
+        __m256i *p = (__m256i *) iv;
+        const __m256i good = clear ? _mm256_setzero_si256() :
+                _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)
+                                                           &iv[good_lane]));
+        /* 64-bit lane masks expanded to pairs of 128-bit IVs */
+        const __m256i m[4] = {
+                _mm256_permute4x64_epi64(null_lo, 0x50),
+                _mm256_permute4x64_epi64(null_lo, 0xFA),
+                _mm256_permute4x64_epi64(null_hi, 0x50),
+                _mm256_permute4x64_epi64(null_hi, 0xFA)
+        };
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                _mm256_store_si256(&p[i],
+                                   _mm256_blendv_epi8(_mm256_load_si256(&p[i]),
+                                                      good, m[i]));
+}
+
+/* ========================================================================= */
+/* AES-CBC encryption */
+/* ========================================================================= */
+
+/**
+ * @brief Runs all lanes up to the shortest one and returns its job
+ *
+ * @param [in/out] state  AES OOO manager
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+aes_cbc_enc_ooo_process(MB_MGR_AES_OOO *state, const unsigned nrounds)
+{
+        const unsigned lane = aes_cbc_ooo_run(state->lens, state->args.in,
+                                              state->args.out,
+                                              state->args.keys,
+                                              state->args.IV, nrounds);
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+        state->args.keys[lane] = NULL;
+#endif
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+/**
+ * @brief Puts a job into a free lane and processes the lanes if all are used
+ *
+ * @param [in/out] state  AES OOO manager
+ * @param [in] job        Job to submit
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+__forceinline
+IMB_JOB *
+submit_job_aes_cbc_enc_ooo(MB_MGR_AES_OOO *state, IMB_JOB *job,
+                           const unsigned nrounds)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        /* DOCSIS may pass size unaligned to block size */
+        state->lens[lane] = (uint16_t) (job->msg_len_to_cipher_in_bytes &
+                                        (~(uint64_t) (AES_CBC_BLOCK_SIZE - 1)));
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = job->enc_keys;
+        _mm_store_si128((__m128i *) &state->args.IV[lane],
+                        _mm_loadu_si128((const __m128i *) job->iv));
+
+        if (state->num_lanes_inuse < AES_CBC_OOO_NUM_LANES)
+                return NULL;
+
+        return aes_cbc_enc_ooo_process(state, nrounds);
+}
+
+/**
+ * @brief Completes the shortest job in the manager
+ *
+ * @param [in/out] state  AES OOO manager
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+__forceinline
+IMB_JOB *
+flush_job_aes_cbc_enc_ooo(MB_MGR_AES_OOO *state, const unsigned nrounds)
+{
+        __m256i null_lo, null_hi;
+        unsigned good_lane;
+        IMB_JOB *job;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        /* copy valid lane arguments into empty lanes */
+        good_lane = aes_cbc_ooo_null_lanes(state->job_in_lane,
+                                           &null_lo, &null_hi);
+        aes_cbc_ooo_fill_ptrs(state->args.in, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_ptrs(state->args.out, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_ptrs(state->args.keys, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_iv(state->args.IV, null_lo, null_hi, good_lane, 0);
+
+        job = aes_cbc_enc_ooo_process(state, nrounds);
+#ifdef SAFE_DATA
+        /* clear IVs of empty lanes */
+        aes_cbc_ooo_fill_iv(state->args.IV, null_lo, null_hi, good_lane, 1);
+#endif
+        return job;
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cbc_enc_ooo(state, job, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES192_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cbc_enc_ooo(state, job, 12);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cbc_enc_ooo(state, job, 14);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_ENC(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cbc_enc_ooo(state, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES192_ENC(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cbc_enc_ooo(state, 12);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_ENC(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cbc_enc_ooo(state, 14);
+}
+
+/* ========================================================================= */
+/* AES-XCBC-MAC-96 */
+/* ========================================================================= */
+
+/**
+ * @brief Runs the lanes until one of the jobs is complete and returns it
+ *
+ * @param [in/out] state  XCBC OOO manager
+ *
+ * @return Completed job
+ */
+static IMB_JOB *
+aes_xcbc_ooo_process(MB_MGR_AES_XCBC_OOO *state)
+{
+        XCBC_LANE_DATA *ld;
+        unsigned lane;
+        IMB_JOB *job;
+
+        while (1) {
+                lane = aes_cbc_ooo_run(state->lens, state->args.in, NULL,
+                                       state->args.keys, state->args.ICV, 10);
+                ld = &state->ldata[lane];
+                if (ld->final_done)
+                        break;
+
+                /* all message blocks done, process the final block */
+                ld->final_done = 1;
+                state->lens[lane] = AES_CBC_BLOCK_SIZE;
+                state->args.in[lane] = ld->final_block;
+                ooo_idle_lanes_follow(state->args.in, state->lens,
+                                      AES_CBC_OOO_NUM_LANES, lane);
+        }
+
+        job = ld->job_in_lane;
+        memcpy(job->auth_tag_output, &state->args.ICV[lane],
+               AES_XCBC_DIGEST_SIZE);
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        ld->job_in_lane = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+#ifdef SAFE_DATA
+        memset(&state->args.ICV[lane], 0, sizeof(state->args.ICV[lane]));
+        memset(ld->final_block, 0, sizeof(ld->final_block));
+#endif
+
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES_XCBC(MB_MGR_AES_XCBC_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        XCBC_LANE_DATA *ld = &state->ldata[lane];
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t r = len % AES_CBC_BLOCK_SIZE;
+        uint64_t blocks_len;
+        __m128i last;
+
+        state->unused_lanes >>= 4;
+        ld->job_in_lane = job;
+        ld->final_done = 0;
+        state->args.keys[lane] = job->u.XCBC._k1_expanded;
+        state->args.in[lane] = (len > AES_CBC_BLOCK_SIZE) ? p : ld->final_block;
+        memset(&state->args.ICV[lane], 0, sizeof(state->args.ICV[lane]));
+
+        if (len != 0 && r == 0) {
+                /* M[n] XOR K2 */
+                blocks_len = len - AES_CBC_BLOCK_SIZE;
+                last = _mm_loadu_si128((const __m128i *) &p[blocks_len]);
+                last = _mm_xor_si128(last, _mm_loadu_si128((const __m128i *)
+                                                           job->u.XCBC._k2));
+        } else {
+                /* pad(M[n]) XOR K3 */
+                blocks_len = len - r;
+                memset(ld->final_block, 0, AES_CBC_BLOCK_SIZE);
+                memcpy(ld->final_block, &p[blocks_len], r);
+                ld->final_block[r] = 0x80;
+                last = _mm_load_si128((const __m128i *) ld->final_block);
+                last = _mm_xor_si128(last, _mm_loadu_si128((const __m128i *)
+                                                           job->u.XCBC._k3));
+        }
+        _mm_store_si128((__m128i *) ld->final_block, last);
+        state->lens[lane] = (uint16_t) blocks_len;
+
+        if (state->unused_lanes != 0xF)
+                return NULL;
+
+        return aes_xcbc_ooo_process(state);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES_XCBC(MB_MGR_AES_XCBC_OOO *state)
+{
+        IMB_JOB *jobs[AES_CBC_OOO_NUM_LANES];
+        __m256i null_lo, null_hi;
+        unsigned lane, good_lane;
+        IMB_JOB *job;
+
+        /* check for empty */
+        if ((state->unused_lanes >> (AES_CBC_OOO_NUM_LANES * 4)) == 0xF)
+                return NULL;
+
+        for (lane = 0; lane < AES_CBC_OOO_NUM_LANES; lane++)
+                jobs[lane] = state->ldata[lane].job_in_lane;
+
+        /* copy valid lane arguments into empty lanes */
+        good_lane = aes_cbc_ooo_null_lanes(jobs, &null_lo, &null_hi);
+        aes_cbc_ooo_fill_ptrs(state->args.in, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_ptrs(state->args.keys, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_iv(state->args.ICV, null_lo, null_hi, good_lane, 0);
+
+        job = aes_xcbc_ooo_process(state);
+#ifdef SAFE_DATA
+        /* clear ICVs of empty lanes */
+        aes_cbc_ooo_fill_iv(state->args.ICV, null_lo, null_hi, good_lane, 1);
+#endif
+        return job;
+}
+
+/* ========================================================================= */
+/* AES-CMAC */
+/* ========================================================================= */
+
+/**
+ * @brief Runs the lanes until one of the jobs is complete and returns it
+ *
+ * @param [in/out] state  CMAC OOO manager
+ *
+ * @return Completed job
+ */
+static IMB_JOB *
+aes_cmac_ooo_process(MB_MGR_CMAC_OOO *state)
+{
+        unsigned lane;
+        IMB_JOB *job;
+
+        while (1) {
+                lane = aes_cbc_ooo_run(state->lens, state->args.in, NULL,
+                                       state->args.keys, state->args.IV, 10);
+                if (state->init_done[lane])
+                        break;
+
+                /* all message blocks done, process M_last */
+                state->init_done[lane] = 1;
+                state->lens[lane] = AES_CBC_BLOCK_SIZE;
+                state->args.in[lane] = &state->scratch[lane *
+                                                       AES_CBC_BLOCK_SIZE];
+                ooo_idle_lanes_follow(state->args.in, state->lens,
+                                      AES_CBC_OOO_NUM_LANES, lane);
+        }
+
+        job = state->job_in_lane[lane];
+        memcpy(job->auth_tag_output, &state->args.IV[lane],
+               job->auth_tag_output_len_in_bytes);
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+        memset(&state->scratch[lane * AES_CBC_BLOCK_SIZE], 0,
+               AES_CBC_BLOCK_SIZE);
+#endif
+
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES_CMAC_AUTH(MB_MGR_CMAC_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        uint8_t *m_last = &state->scratch[lane * AES_CBC_BLOCK_SIZE];
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        /* message length is in bits */
+        const uint64_t len = (job->msg_len_to_hash_in_bits + 7) >> 3;
+        const unsigned rbits = (unsigned) (job->msg_len_to_hash_in_bits & 7);
+        const uint64_t r = len % AES_CBC_BLOCK_SIZE;
+        const uint64_t n = (len + AES_CBC_BLOCK_SIZE - 1) / AES_CBC_BLOCK_SIZE;
+        __m128i last;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->args.keys[lane] = job->u.CMAC._key_expanded;
+        memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+
+        if (n == 0) {
+                /* empty message, M_last only */
+                state->init_done[lane] = 1;
+                state->lens[lane] = AES_CBC_BLOCK_SIZE;
+                state->args.in[lane] = m_last;
+        } else {
+                state->init_done[lane] = 0;
+                state->lens[lane] = (uint16_t) ((n - 1) * AES_CBC_BLOCK_SIZE);
+                state->args.in[lane] = p;
+                p += (n - 1) * AES_CBC_BLOCK_SIZE;
+        }
+
+        if (n != 0 && r == 0 && rbits == 0) {
+                /* complete block: M_last = M_n XOR K1 */
+                last = _mm_loadu_si128((const __m128i *) p);
+                last = _mm_xor_si128(last, _mm_loadu_si128((const __m128i *)
+                                                           job->u.CMAC._skey1));
+        } else {
+                /* M_last = padding(M_n) XOR K2 */
+                const uint64_t nbytes = (r == 0 && n != 0) ?
+                        AES_CBC_BLOCK_SIZE : r;
+
+                memset(m_last, 0, AES_CBC_BLOCK_SIZE);
+                memcpy(m_last, p, nbytes);
+                if (rbits == 0) {
+                        m_last[nbytes] = 0x80;
+                } else {
+                        /* 3GPP: bit padding within the last byte */
+                        const uint8_t pad = (uint8_t) (0x80 >> rbits);
+
+                        m_last[nbytes - 1] &= (uint8_t) ~(pad - 1);
+                        m_last[nbytes - 1] |= pad;
+                }
+                last = _mm_load_si128((const __m128i *) m_last);
+                last = _mm_xor_si128(last, _mm_loadu_si128((const __m128i *)
+                                                           job->u.CMAC._skey2));
+        }
+        _mm_store_si128((__m128i *) m_last, last);
+
+        if (state->num_lanes_inuse < AES_CBC_OOO_NUM_LANES)
+                return NULL;
+
+        return aes_cmac_ooo_process(state);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES_CMAC_AUTH(MB_MGR_CMAC_OOO *state)
+{
+        __m256i null_lo, null_hi;
+        unsigned good_lane;
+        IMB_JOB *job;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        /* copy valid lane arguments into empty lanes */
+        good_lane = aes_cbc_ooo_null_lanes(state->job_in_lane,
+                                           &null_lo, &null_hi);
+        aes_cbc_ooo_fill_ptrs(state->args.in, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_ptrs(state->args.keys, null_lo, null_hi, good_lane);
+        aes_cbc_ooo_fill_iv(state->args.IV, null_lo, null_hi, good_lane, 0);
+
+        job = aes_cmac_ooo_process(state);
+#ifdef SAFE_DATA
+        /* clear digests of empty lanes */
+        aes_cbc_ooo_fill_iv(state->args.IV, null_lo, null_hi, good_lane, 1);
+#endif
+        return job;
+}
+
+#endif /* AES_CBC_OOO_COMMON_H */
@@ -0,0 +1,316 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer AES-CTR out-of-order manager.
+ *
+ * Each lane holds one job and encrypts one counter block per iteration,
+ * so that AES rounds of AES_CNTR_OOO_NUM_LANES independent buffers
+ * are interleaved. Suited for short buffers, which don't fill
+ * the pipeline of the single buffer "by8" implementation.
+ *
+ * Per lane state is kept in MB_MGR_AES_OOO:
+ * - args.in/out/keys - source, destination and expanded keys
+ * - args.IV - byte reflected counter block (32-bit counter in dword 0)
+ * - lens - number of bytes left to process
+ *
+ * The including file has to define:
+ * - SUBMIT_JOB_AES128_CNTR, SUBMIT_JOB_AES192_CNTR, SUBMIT_JOB_AES256_CNTR
+ * - FLUSH_JOB_AES128_CNTR, FLUSH_JOB_AES192_CNTR, FLUSH_JOB_AES256_CNTR
+ */
+
+#ifndef AES_CNTR_OOO_COMMON_H
+#define AES_CNTR_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+#include "include/aes_x8_common.h"
+
+#define AES_CNTR_BLOCK_SIZE 16
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_CNTR(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES192_CNTR(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_CNTR(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_CNTR(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES192_CNTR(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_CNTR(MB_MGR_AES_OOO *state);
+
+/**
+ * @brief Processes full blocks of all lanes
+ *
+ * All lanes are processed, unused lanes have to point to
+ * valid buffers (see flush).
+ *
+ * @param [in/out] args   Lane arguments
+ * @param [in] num_blocks Number of blocks to process in each lane
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ */
+__forceinline
+void
+aes_cntr_x8(AES_ARGS *args, const uint64_t num_blocks,
+            const unsigned nrounds)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+        __m128i ctr[AES_CNTR_OOO_NUM_LANES];
+        uint64_t i, offset = 0;
+        unsigned lane;
+
+        for (lane = 0; lane < AES_CNTR_OOO_NUM_LANES; lane++)
+                ctr[lane] = _mm_load_si128((const __m128i *)
+                                           &args->IV[lane]);
+
+        for (i = 0; i < num_blocks; i++) {
+                __m128i ks[AES_CNTR_OOO_NUM_LANES];
+                __m128i in[AES_CNTR_OOO_NUM_LANES];
+
+                for (lane = 0; lane < AES_CNTR_OOO_NUM_LANES; lane++) {
+                        ks[lane] = _mm_shuffle_epi8(ctr[lane], bswap);
+                        ctr[lane] = _mm_add_epi32(ctr[lane], one);
+                }
+
+                aes_x8_enc_block(ks, args->keys, nrounds);
+                aes_x8_load_block(in, args->in, offset);
+
+                for (lane = 0; lane < AES_CNTR_OOO_NUM_LANES; lane++)
+                        _mm_storeu_si128((__m128i *) &args->out[lane][offset],
+                                         _mm_xor_si128(in[lane], ks[lane]));
+
+                offset += AES_CNTR_BLOCK_SIZE;
+        }
+
+        for (lane = 0; lane < AES_CNTR_OOO_NUM_LANES; lane++) {
+                _mm_store_si128((__m128i *) &args->IV[lane], ctr[lane]);
+                args->in[lane] += offset;
+                args->out[lane] += offset;
+        }
+}
+
+/**
+ * @brief Runs all lanes up to the shortest one and returns its job
+ *
+ * @param [in/out] state  CNTR OOO manager
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+aes_cntr_ooo_process(MB_MGR_AES_OOO *state, const unsigned nrounds)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        __m128i lens = _mm_load_si128((const __m128i *) state->lens);
+        __m128i minpos = _mm_minpos_epu16(lens);
+        const unsigned min_len = (unsigned) _mm_extract_epi16(minpos, 0);
+        const unsigned lane = (unsigned) _mm_extract_epi16(minpos, 1);
+        const unsigned num_blocks = min_len / AES_CNTR_BLOCK_SIZE;
+        IMB_JOB *job = state->job_in_lane[lane];
+        unsigned tail;
+
+        if (num_blocks != 0) {
+                const uint16_t sub = (uint16_t)
+                        (num_blocks * AES_CNTR_BLOCK_SIZE);
+
+                /* unused lanes keep length 0xFFFF */
+                const __m128i unused = _mm_cmpeq_epi16(lens,
+                                                       _mm_set1_epi16(-1));
+
+                aes_cntr_x8(&state->args, num_blocks, nrounds);
+
+                lens = _mm_sub_epi16(lens, _mm_set1_epi16((short) sub));
+                lens = _mm_or_si128(lens, unused);
+                _mm_store_si128((__m128i *) state->lens, lens);
+        }
+
+        /* last partial block of the completed job */
+        tail = state->lens[lane];
+        if (tail != 0) {
+                uint8_t buf[AES_CNTR_BLOCK_SIZE];
+                __m128i ks, ctr;
+                unsigned i;
+
+                ctr = _mm_load_si128((const __m128i *) &state->args.IV[lane]);
+                ks = aes_x1_enc_block(_mm_shuffle_epi8(ctr, bswap),
+                                      state->args.keys[lane], nrounds);
+                _mm_storeu_si128((__m128i *) buf, ks);
+                for (i = 0; i < tail; i++)
+                        state->args.out[lane][i] =
+                                state->args.in[lane][i] ^ buf[i];
+#ifdef SAFE_DATA
+                clear_mem(buf, sizeof(buf));
+#endif
+        }
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+#endif
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+/**
+ * @brief Puts a job into a free lane and processes the lanes if all are used
+ *
+ * @param [in/out] state  CNTR OOO manager
+ * @param [in] job        Job to submit
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+__forceinline
+IMB_JOB *
+submit_job_aes_cntr_ooo(MB_MGR_AES_OOO *state, IMB_JOB *job,
+                        const unsigned nrounds)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        __m128i ctr;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = (uint16_t) job->msg_len_to_cipher_in_bytes;
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = job->enc_keys;
+
+        if (job->iv_len_in_bytes == 16) {
+                ctr = _mm_loadu_si128((const __m128i *) job->iv);
+        } else {
+                /* 12 bytes: Nonce + ESP IV, block counter set to 1 */
+                const uint8_t *iv = (const uint8_t *) job->iv;
+                uint32_t nonce;
+
+                memcpy(&nonce, &iv[8], sizeof(nonce));
+                ctr = _mm_loadl_epi64((const __m128i *) iv);
+                ctr = _mm_insert_epi32(ctr, (int) nonce, 2);
+                ctr = _mm_insert_epi32(ctr, (int) 0x01000000, 3);
+        }
+        _mm_store_si128((__m128i *) &state->args.IV[lane],
+                        _mm_shuffle_epi8(ctr, bswap));
+
+        if (state->num_lanes_inuse < AES_CNTR_OOO_NUM_LANES)
+                return NULL;
+
+        return aes_cntr_ooo_process(state, nrounds);
+}
+
+/**
+ * @brief Completes the shortest job in the manager
+ *
+ * @param [in/out] state  CNTR OOO manager
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+__forceinline
+IMB_JOB *
+flush_job_aes_cntr_ooo(MB_MGR_AES_OOO *state, const unsigned nrounds)
+{
+        unsigned lane, good_lane = 0;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        for (lane = 0; lane < AES_CNTR_OOO_NUM_LANES; lane++)
+                if (state->job_in_lane[lane] != NULL) {
+                        good_lane = lane;
+                        break;
+                }
+
+        /* copy valid lane arguments into empty lanes */
+        for (lane = 0; lane < AES_CNTR_OOO_NUM_LANES; lane++) {
+                if (state->job_in_lane[lane] != NULL)
+                        continue;
+                state->args.in[lane] = state->args.in[good_lane];
+                state->args.out[lane] = state->args.out[good_lane];
+                state->args.keys[lane] = state->args.keys[good_lane];
+                state->args.IV[lane] = state->args.IV[good_lane];
+        }
+
+        return aes_cntr_ooo_process(state, nrounds);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_CNTR(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cntr_ooo(state, job, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES192_CNTR(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cntr_ooo(state, job, 12);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_CNTR(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cntr_ooo(state, job, 14);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_CNTR(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cntr_ooo(state, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES192_CNTR(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cntr_ooo(state, 12);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_CNTR(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cntr_ooo(state, 14);
+}
+
+#endif /* AES_CNTR_OOO_COMMON_H */
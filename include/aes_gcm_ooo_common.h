@@ -0,0 +1,523 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer AES-GCM out-of-order manager.
+ *
+ * Each lane holds one job (encrypt or decrypt) with its own
+ * struct gcm_key_data. Every iteration encrypts one counter block and
+ * runs one GHASH multiply per lane, so that AES rounds and carry-less
+ * multiplies of AES_GCM_OOO_NUM_LANES independent buffers are interleaved.
+ *
+ * Per lane state is kept in MB_MGR_GCM_OOO:
+ * - args.in/out/keys - source, destination and GCM key data
+ * - args.IV - byte reflected counter block (32-bit counter in dword 0)
+ * - ghash - byte reflected GHASH accumulator
+ * - decrypt - set for decrypt jobs (GHASH is computed on the input)
+ * - lens - number of message bytes left to process
+ *
+ * AAD is hashed on submit, the last partial block, the length block and
+ * the tag are done when the job completes.
+ * Only 12 byte IVs are supported.
+ *
+ * The including file has to define:
+ * - SUBMIT_JOB_AES128_GCM, SUBMIT_JOB_AES192_GCM, SUBMIT_JOB_AES256_GCM
+ * - FLUSH_JOB_AES128_GCM, FLUSH_JOB_AES192_GCM, FLUSH_JOB_AES256_GCM
+ */
+
+#ifndef AES_GCM_OOO_COMMON_H
+#define AES_GCM_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+#include "include/aes_x8_common.h"
+
+#define AES_GCM_BLOCK_SIZE 16
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_GCM(MB_MGR_GCM_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES192_GCM(MB_MGR_GCM_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_GCM(MB_MGR_GCM_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_GCM(MB_MGR_GCM_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES192_GCM(MB_MGR_GCM_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_GCM(MB_MGR_GCM_OOO *state);
+
+/**
+ * @brief GHASH multiply, GH = GH * HashKey mod poly
+ *
+ * Same algorithm as GHASH_MUL macro of gcm_sse.asm
+ * (Karatsuba multiply followed by two phase reduction).
+ *
+ * @param [in] gh  Byte reflected GHASH value
+ * @param [in] hk  HashKey<<1 mod poly, as stored in struct gcm_key_data
+ *
+ * @return Byte reflected product
+ */
+__forceinline
+__m128i
+aes_gcm_ghash_mul(__m128i gh, const __m128i hk)
+{
+        __m128i t1, t2, t3, t4, t5;
+
+        /* Karatsuba method */
+        t2 = _mm_xor_si128(_mm_shuffle_epi32(gh, 0x4e), gh);
+        t3 = _mm_xor_si128(_mm_shuffle_epi32(hk, 0x4e), hk);
+        t1 = _mm_clmulepi64_si128(gh, hk, 0x11);
+        gh = _mm_clmulepi64_si128(gh, hk, 0x00);
+        t2 = _mm_clmulepi64_si128(t2, t3, 0x00);
+        t2 = _mm_xor_si128(t2, gh);
+        t2 = _mm_xor_si128(t2, t1);
+        gh = _mm_xor_si128(gh, _mm_slli_si128(t2, 8));
+        t1 = _mm_xor_si128(t1, _mm_srli_si128(t2, 8));
+
+        /* first phase of the reduction */
+        t2 = _mm_slli_epi32(gh, 31);
+        t3 = _mm_slli_epi32(gh, 30);
+        t4 = _mm_slli_epi32(gh, 25);
+        t2 = _mm_xor_si128(t2, t3);
+        t2 = _mm_xor_si128(t2, t4);
+        t5 = _mm_srli_si128(t2, 4);
+        gh = _mm_xor_si128(gh, _mm_slli_si128(t2, 12));
+
+        /* second phase of the reduction */
+        t2 = _mm_srli_epi32(gh, 1);
+        t3 = _mm_srli_epi32(gh, 2);
+        t4 = _mm_srli_epi32(gh, 7);
+        t2 = _mm_xor_si128(t2, t3);
+        t2 = _mm_xor_si128(t2, t4);
+        t2 = _mm_xor_si128(t2, t5);
+        gh = _mm_xor_si128(gh, t2);
+
+        return _mm_xor_si128(gh, t1);
+}
+
+/**
+ * @brief Returns hash key of a lane
+ *
+ * @param [in] state  GCM OOO manager
+ * @param [in] lane   Lane index
+ *
+ * @return HashKey<<1 mod poly
+ */
+__forceinline
+__m128i
+aes_gcm_lane_hkey(const MB_MGR_GCM_OOO *state, const unsigned lane)
+{
+        const uint8_t *key = (const uint8_t *) state->args.keys[lane];
+
+        return _mm_loadu_si128((const __m128i *)
+                               &key[AES_GCM_OOO_HKEY_OFFSET]);
+}
+
+/**
+ * @brief Hashes a buffer, last partial block is padded with zeros
+ *
+ * @param [in] gh   Byte reflected GHASH value
+ * @param [in] hk   HashKey<<1 mod poly
+ * @param [in] buf  Buffer to hash
+ * @param [in] len  Length of the buffer in bytes
+ *
+ * @return Updated GHASH value
+ */
+__forceinline
+__m128i
+aes_gcm_ghash(__m128i gh, const __m128i hk, const uint8_t *buf,
+              const uint64_t len)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        uint64_t i;
+
+        for (i = 0; (i + AES_GCM_BLOCK_SIZE) <= len; i += AES_GCM_BLOCK_SIZE) {
+                const __m128i b = _mm_loadu_si128((const __m128i *) &buf[i]);
+
+                gh = _mm_xor_si128(gh, _mm_shuffle_epi8(b, bswap));
+                gh = aes_gcm_ghash_mul(gh, hk);
+        }
+
+        if (i < len) {
+                uint8_t last[AES_GCM_BLOCK_SIZE];
+                __m128i b;
+
+                memset(last, 0, sizeof(last));
+                memcpy(last, &buf[i], (size_t) (len - i));
+                b = _mm_loadu_si128((const __m128i *) last);
+                gh = _mm_xor_si128(gh, _mm_shuffle_epi8(b, bswap));
+                gh = aes_gcm_ghash_mul(gh, hk);
+#ifdef SAFE_DATA
+                clear_mem(last, sizeof(last));
+#endif
+        }
+
+        return gh;
+}
+
+/**
+ * @brief Returns J0 = IV || 0^31 || 1 for a 12 byte IV
+ *
+ * @param [in] iv  12 byte IV
+ *
+ * @return J0 block (not reflected)
+ */
+__forceinline
+__m128i
+aes_gcm_j0(const void *iv)
+{
+        const uint8_t *iv8 = (const uint8_t *) iv;
+        uint32_t iv_hi;
+        __m128i j0;
+
+        memcpy(&iv_hi, &iv8[8], sizeof(iv_hi));
+        j0 = _mm_loadl_epi64((const __m128i *) iv8);
+        j0 = _mm_insert_epi32(j0, (int) iv_hi, 2);
+        return _mm_insert_epi32(j0, (int) 0x01000000, 3);
+}
+
+/**
+ * @brief Processes full blocks of all lanes
+ *
+ * All lanes are processed, unused lanes have to point to
+ * valid buffers and keys (see flush).
+ *
+ * @param [in/out] state  GCM OOO manager
+ * @param [in] num_blocks Number of blocks to process in each lane
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ */
+__forceinline
+void
+aes_gcm_x8(MB_MGR_GCM_OOO *state, const uint64_t num_blocks,
+           const unsigned nrounds)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+        AES_ARGS *args = &state->args;
+        __m128i ctr[AES_GCM_OOO_NUM_LANES];
+        __m128i gh[AES_GCM_OOO_NUM_LANES];
+        __m128i hk[AES_GCM_OOO_NUM_LANES];
+        __m128i dec[AES_GCM_OOO_NUM_LANES];
+        uint64_t i, offset = 0;
+        unsigned lane;
+
+        for (lane = 0; lane < AES_GCM_OOO_NUM_LANES; lane++) {
+                ctr[lane] = _mm_load_si128((const __m128i *)
+                                           &args->IV[lane]);
+                gh[lane] = _mm_load_si128((const __m128i *)
+                                          &state->ghash[lane]);
+                hk[lane] = aes_gcm_lane_hkey(state, lane);
+                dec[lane] = _mm_set1_epi8((char) -state->decrypt[lane]);
+        }
+
+        for (i = 0; i < num_blocks; i++) {
+                __m128i ks[AES_GCM_OOO_NUM_LANES];
+                __m128i in[AES_GCM_OOO_NUM_LANES];
+
+                for (lane = 0; lane < AES_GCM_OOO_NUM_LANES; lane++) {
+                        ks[lane] = _mm_shuffle_epi8(ctr[lane], bswap);
+                        ctr[lane] = _mm_add_epi32(ctr[lane], one);
+                }
+
+                aes_x8_enc_block(ks, args->keys, nrounds);
+                aes_x8_load_block(in, args->in, offset);
+
+                for (lane = 0; lane < AES_GCM_OOO_NUM_LANES; lane++) {
+                        const __m128i out = _mm_xor_si128(in[lane], ks[lane]);
+                        /* GHASH is always computed on the ciphertext */
+                        const __m128i ct = _mm_blendv_epi8(out, in[lane],
+                                                           dec[lane]);
+
+                        _mm_storeu_si128((__m128i *) &args->out[lane][offset],
+                                         out);
+                        gh[lane] = _mm_xor_si128(gh[lane],
+                                                 _mm_shuffle_epi8(ct, bswap));
+                        gh[lane] = aes_gcm_ghash_mul(gh[lane], hk[lane]);
+                }
+
+                offset += AES_GCM_BLOCK_SIZE;
+        }
+
+        for (lane = 0; lane < AES_GCM_OOO_NUM_LANES; lane++) {
+                _mm_store_si128((__m128i *) &args->IV[lane], ctr[lane]);
+                _mm_store_si128((__m128i *) &state->ghash[lane], gh[lane]);
+                args->in[lane] += offset;
+                args->out[lane] += offset;
+        }
+}
+
+/**
+ * @brief Completes a job: last partial block, length block and tag
+ *
+ * @param [in/out] state  GCM OOO manager
+ * @param [in] lane       Lane of the job
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ */
+__forceinline
+void
+aes_gcm_lane_finalize(MB_MGR_GCM_OOO *state, const unsigned lane,
+                      const unsigned nrounds)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        const IMB_JOB *job = state->job_in_lane[lane];
+        const uint8_t *keys = (const uint8_t *) state->args.keys[lane];
+        const __m128i hk = aes_gcm_lane_hkey(state, lane);
+        const unsigned tail = state->lens[lane];
+        __m128i gh = _mm_load_si128((const __m128i *) &state->ghash[lane]);
+        __m128i t;
+        uint8_t buf[AES_GCM_BLOCK_SIZE];
+
+        if (tail != 0) {
+                uint8_t ks[AES_GCM_BLOCK_SIZE];
+                unsigned i;
+
+                t = _mm_load_si128((const __m128i *) &state->args.IV[lane]);
+                t = aes_x1_enc_block(_mm_shuffle_epi8(t, bswap), keys,
+                                      nrounds);
+                _mm_storeu_si128((__m128i *) ks, t);
+
+                memset(buf, 0, sizeof(buf));
+                for (i = 0; i < tail; i++) {
+                        const uint8_t in = state->args.in[lane][i];
+                        const uint8_t out = in ^ ks[i];
+
+                        state->args.out[lane][i] = out;
+                        buf[i] = state->decrypt[lane] ? in : out;
+                }
+
+                t = _mm_loadu_si128((const __m128i *) buf);
+                gh = _mm_xor_si128(gh, _mm_shuffle_epi8(t, bswap));
+                gh = aes_gcm_ghash_mul(gh, hk);
+#ifdef SAFE_DATA
+                clear_mem(ks, sizeof(ks));
+#endif
+        }
+
+        /* len(A) || len(C) in bits */
+        t = _mm_set_epi64x((long long) (job->u.GCM.aad_len_in_bytes << 3),
+                           (long long) (job->msg_len_to_cipher_in_bytes << 3));
+        gh = _mm_xor_si128(gh, t);
+        gh = aes_gcm_ghash_mul(gh, hk);
+
+        /* T = E(K, J0) xor GHASH */
+        t = aes_x1_enc_block(aes_gcm_j0(job->iv), keys, nrounds);
+        t = _mm_xor_si128(t, _mm_shuffle_epi8(gh, bswap));
+        _mm_storeu_si128((__m128i *) buf, t);
+        memcpy(job->auth_tag_output, buf,
+               (size_t) job->auth_tag_output_len_in_bytes);
+#ifdef SAFE_DATA
+        clear_mem(buf, sizeof(buf));
+#endif
+}
+
+/**
+ * @brief Runs all lanes up to the shortest one and returns its job
+ *
+ * @param [in/out] state  GCM OOO manager
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+aes_gcm_ooo_process(MB_MGR_GCM_OOO *state, const unsigned nrounds)
+{
+        __m128i lens = _mm_load_si128((const __m128i *) state->lens);
+        __m128i minpos = _mm_minpos_epu16(lens);
+        const unsigned min_len = (unsigned) _mm_extract_epi16(minpos, 0);
+        const unsigned lane = (unsigned) _mm_extract_epi16(minpos, 1);
+        const unsigned num_blocks = min_len / AES_GCM_BLOCK_SIZE;
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        if (num_blocks != 0) {
+                const uint16_t sub = (uint16_t)
+                        (num_blocks * AES_GCM_BLOCK_SIZE);
+
+                /* unused lanes keep length 0xFFFF */
+                const __m128i unused = _mm_cmpeq_epi16(lens,
+                                                       _mm_set1_epi16(-1));
+
+                aes_gcm_x8(state, num_blocks, nrounds);
+
+                lens = _mm_sub_epi16(lens, _mm_set1_epi16((short) sub));
+                lens = _mm_or_si128(lens, unused);
+                _mm_store_si128((__m128i *) state->lens, lens);
+        }
+
+        aes_gcm_lane_finalize(state, lane, nrounds);
+
+        /* release the lane */
+        state->lens[lane] = 0xFFFF;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+        memset(&state->ghash[lane], 0, sizeof(state->ghash[lane]));
+#endif
+
+        job->status |= STS_COMPLETED;
+        return job;
+}
+
+/**
+ * @brief Puts a job into a free lane and processes the lanes if all are used
+ *
+ * @param [in/out] state  GCM OOO manager
+ * @param [in] job        Job to submit (12 byte IV)
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+__forceinline
+IMB_JOB *
+submit_job_aes_gcm_ooo(MB_MGR_GCM_OOO *state, IMB_JOB *job,
+                       const unsigned nrounds)
+{
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                           8, 9, 10, 11, 12, 13, 14, 15);
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        __m128i ctr, gh;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = (uint16_t) job->msg_len_to_cipher_in_bytes;
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        /* same key structure is used for encrypt and decrypt */
+        if (job->cipher_direction == IMB_DIR_ENCRYPT) {
+                state->args.keys[lane] = job->enc_keys;
+                state->decrypt[lane] = 0;
+        } else {
+                state->args.keys[lane] = job->dec_keys;
+                state->decrypt[lane] = 1;
+        }
+
+        /* first block of the message is encrypted with J0 + 1 */
+        ctr = _mm_shuffle_epi8(aes_gcm_j0(job->iv), bswap);
+        ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, 1));
+        _mm_store_si128((__m128i *) &state->args.IV[lane], ctr);
+
+        gh = aes_gcm_ghash(_mm_setzero_si128(),
+                           aes_gcm_lane_hkey(state, lane),
+                           (const uint8_t *) job->u.GCM.aad,
+                           job->u.GCM.aad_len_in_bytes);
+        _mm_store_si128((__m128i *) &state->ghash[lane], gh);
+
+        if (state->num_lanes_inuse < AES_GCM_OOO_NUM_LANES)
+                return NULL;
+
+        return aes_gcm_ooo_process(state, nrounds);
+}
+
+/**
+ * @brief Completes the shortest job in the manager
+ *
+ * @param [in/out] state  GCM OOO manager
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+__forceinline
+IMB_JOB *
+flush_job_aes_gcm_ooo(MB_MGR_GCM_OOO *state, const unsigned nrounds)
+{
+        unsigned lane, good_lane = 0;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        for (lane = 0; lane < AES_GCM_OOO_NUM_LANES; lane++)
+                if (state->job_in_lane[lane] != NULL) {
+                        good_lane = lane;
+                        break;
+                }
+
+        /* copy valid lane arguments into empty lanes */
+        for (lane = 0; lane < AES_GCM_OOO_NUM_LANES; lane++) {
+                if (state->job_in_lane[lane] != NULL)
+                        continue;
+                state->args.in[lane] = state->args.in[good_lane];
+                state->args.out[lane] = state->args.out[good_lane];
+                state->args.keys[lane] = state->args.keys[good_lane];
+                state->args.IV[lane] = state->args.IV[good_lane];
+                state->ghash[lane] = state->ghash[good_lane];
+                state->decrypt[lane] = state->decrypt[good_lane];
+        }
+
+        return aes_gcm_ooo_process(state, nrounds);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_GCM(MB_MGR_GCM_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_gcm_ooo(state, job, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES192_GCM(MB_MGR_GCM_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_gcm_ooo(state, job, 12);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_GCM(MB_MGR_GCM_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_gcm_ooo(state, job, 14);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_GCM(MB_MGR_GCM_OOO *state)
+{
+        return flush_job_aes_gcm_ooo(state, 10);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES192_GCM(MB_MGR_GCM_OOO *state)
+{
+        return flush_job_aes_gcm_ooo(state, 12);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_GCM(MB_MGR_GCM_OOO *state)
+{
+        return flush_job_aes_gcm_ooo(state, 14);
+}
+
+#endif /* AES_GCM_OOO_COMMON_H */
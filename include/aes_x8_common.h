@@ -0,0 +1,126 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * AES-NI building blocks of the x8 out-of-order managers written in C.
+ *
+ * AES rounds of AES_X8_NUM_LANES independent lanes are interleaved,
+ * so that the AESENC latency of one lane is hidden by the others.
+ * Each lane has its own expanded key.
+ */
+
+#ifndef AES_X8_COMMON_H
+#define AES_X8_COMMON_H
+
+#include <stdint.h>
+
+#include "include/wireless_common.h"
+
+#define AES_X8_NUM_LANES 8
+
+/**
+ * @brief Encrypts one 16 byte block with an expanded key
+ *
+ * @param [in] block  Input block
+ * @param [in] keys   Expanded encryption keys
+ * @param [in] nrounds Number of AES rounds (10, 12 or 14)
+ *
+ * @return Encrypted block
+ */
+__forceinline
+__m128i
+aes_x1_enc_block(__m128i block, const void *keys, const unsigned nrounds)
+{
+        const __m128i *k = (const __m128i *) keys;
+        unsigned r;
+
+        block = _mm_xor_si128(block, _mm_loadu_si128(&k[0]));
+        for (r = 1; r < nrounds; r++)
+                block = _mm_aesenc_si128(block, _mm_loadu_si128(&k[r]));
+        return _mm_aesenclast_si128(block, _mm_loadu_si128(&k[nrounds]));
+}
+
+/**
+ * @brief Encrypts one block in each lane
+ *
+ * @param [in/out] blk    Blocks of all lanes
+ * @param [in] keys       Expanded encryption keys of all lanes
+ * @param [in] nrounds    Number of AES rounds (10, 12 or 14)
+ */
+__forceinline
+void
+aes_x8_enc_block(__m128i *blk, const uint32_t *const *keys,
+                 const unsigned nrounds)
+{
+        unsigned lane, r;
+
+        for (lane = 0; lane < AES_X8_NUM_LANES; lane++)
+                blk[lane] = _mm_xor_si128(blk[lane],
+                                          _mm_loadu_si128((const __m128i *)
+                                                          keys[lane]));
+
+        for (r = 1; r < nrounds; r++)
+                for (lane = 0; lane < AES_X8_NUM_LANES; lane++) {
+                        const __m128i *k = (const __m128i *) keys[lane];
+
+                        blk[lane] = _mm_aesenc_si128(blk[lane],
+                                                     _mm_loadu_si128(&k[r]));
+                }
+
+        for (lane = 0; lane < AES_X8_NUM_LANES; lane++) {
+                const __m128i *k = (const __m128i *) keys[lane];
+
+                blk[lane] = _mm_aesenclast_si128(blk[lane],
+                                                 _mm_loadu_si128(&k[nrounds]));
+        }
+}
+
+/**
+ * @brief Loads one block of input in each lane
+ *
+ * Inputs of all lanes have to be loaded before any output is stored.
+ * Unused lanes duplicate a valid lane on flush and
+ * the buffers may be in-place.
+ *
+ * @param [out] blk       Blocks of all lanes
+ * @param [in] in         Input pointers of all lanes
+ * @param [in] offset     Offset of the block from the input pointers
+ */
+__forceinline
+void
+aes_x8_load_block(__m128i *blk, const uint8_t *const *in,
+                  const uint64_t offset)
+{
+        unsigned lane;
+
+        for (lane = 0; lane < AES_X8_NUM_LANES; lane++)
+                blk[lane] = _mm_loadu_si128((const __m128i *)
+                                            &in[lane][offset]);
+}
+
+#endif /* AES_X8_COMMON_H */
@@ -0,0 +1,107 @@
+;;
+;; Copyright (c) 2012-2020, Intel Corporation
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;     * Redistributions of source code must retain the above copyright notice,
+;;       this list of conditions and the following disclaimer.
+;;     * Redistributions in binary form must reproduce the above copyright
+;;       notice, this list of conditions and the following disclaimer in the
+;;       documentation and/or other materials provided with the distribution.
+;;     * Neither the name of Intel Corporation nor the names of its contributors
+;;       may be used to endorse or promote products derived from this software
+;;       without specific prior written permission.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+;; DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+;; FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+;; DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+;; SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+;; CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+;; OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+;; OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+;;
+
+;; Multi-buffer hash kernels (e.g. sha1_x8_avx2) use a custom calling
+;; convention: they clobber callee saved GP registers (and XMM6-XMM15
+;; on Windows) and expect the stack to be aligned to 32 bytes before
+;; the call. They are called directly by the assembly OOO managers.
+;;
+;; CALL_FROM_C creates an ABI compliant entry point for such a kernel,
+;; so that it can also be called from the C OOO managers:
+;;     void wrapper(void *args, uint64_t num_blocks)
+;; Arguments are passed to the kernel in the same registers.
+
+%ifndef CALL_FROM_C_ASM_INCLUDED
+%define CALL_FROM_C_ASM_INCLUDED
+
+%include "include/os.asm"
+
+%define _cfc_gpr_save	0
+%define _cfc_rsp_save	(8 * 8)
+%define _cfc_xmm_save	(8 * 8 + 16)
+%define _cfc_frame_size	(_cfc_xmm_save + 10 * 16)
+
+;; CALL_FROM_C wrapper, kernel, sse|avx
+%macro CALL_FROM_C 3
+MKGLOBAL(%1,function,internal)
+align 32
+%1:
+	mov	rax, rsp
+	sub	rsp, _cfc_frame_size
+	and	rsp, -32
+	mov	[rsp + _cfc_gpr_save + 8*0], rbx
+	mov	[rsp + _cfc_gpr_save + 8*1], rbp
+	mov	[rsp + _cfc_gpr_save + 8*2], r12
+	mov	[rsp + _cfc_gpr_save + 8*3], r13
+	mov	[rsp + _cfc_gpr_save + 8*4], r14
+	mov	[rsp + _cfc_gpr_save + 8*5], r15
+%ifndef LINUX
+	mov	[rsp + _cfc_gpr_save + 8*6], rsi
+	mov	[rsp + _cfc_gpr_save + 8*7], rdi
+%assign i 0
+%rep 10
+%assign j (i + 6)
+%ifidn %3, avx
+	vmovdqa	[rsp + _cfc_xmm_save + i*16], xmm %+ j
+%else
+	movdqa	[rsp + _cfc_xmm_save + i*16], xmm %+ j
+%endif
+%assign i (i+1)
+%endrep
+%endif
+	mov	[rsp + _cfc_rsp_save], rax
+
+	call	%2
+
+%ifndef LINUX
+%assign i 0
+%rep 10
+%assign j (i + 6)
+%ifidn %3, avx
+	vmovdqa	xmm %+ j, [rsp + _cfc_xmm_save + i*16]
+%else
+	movdqa	xmm %+ j, [rsp + _cfc_xmm_save + i*16]
+%endif
+%assign i (i+1)
+%endrep
+	mov	rsi, [rsp + _cfc_gpr_save + 8*6]
+	mov	rdi, [rsp + _cfc_gpr_save + 8*7]
+%endif
+	mov	rbx, [rsp + _cfc_gpr_save + 8*0]
+	mov	rbp, [rsp + _cfc_gpr_save + 8*1]
+	mov	r12, [rsp + _cfc_gpr_save + 8*2]
+	mov	r13, [rsp + _cfc_gpr_save + 8*3]
+	mov	r14, [rsp + _cfc_gpr_save + 8*4]
+	mov	r15, [rsp + _cfc_gpr_save + 8*5]
+	mov	rsp, [rsp + _cfc_rsp_save]
+%ifidn %3, avx
+	vzeroupper
+%endif
+	ret
+%endmacro
+
+%endif ; CALL_FROM_C_ASM_INCLUDED
@@ -0,0 +1,104 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _CRC_H_
+#define _CRC_H_
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+/*
+ * Folding constants and byte lookup table for a non-reflected CRC
+ * (most significant bit first, zero initial value, no final XOR).
+ *
+ * CRCs narrower than 32 bits are computed with the polynomial shifted
+ * left to bit 31, so that a single 32-bit engine serves all widths;
+ * the result is shifted back right by (32 - width).
+ */
+struct crc_msb_consts {
+        uint64_t fold_by4[2];   /* x^(128*4+64) mod P, x^(128*4) mod P */
+        uint64_t fold_by1[2];   /* x^(128+64) mod P, x^128 mod P */
+        uint32_t lut[256];      /* byte at a time lookup table */
+};
+
+extern const struct crc_msb_consts crc16_ccitt_consts;
+extern const struct crc_msb_consts crc24_a_consts;
+extern const struct crc_msb_consts crc24_b_consts;
+extern const struct crc_msb_consts crc11_consts;
+extern const struct crc_msb_consts crc6_consts;
+
+/* Ethernet FCS byte lookup table (reflected) */
+extern const uint32_t ethernet_fcs_lut[256];
+
+/* Ethernet FCS (DOCSIS and PON code paths) */
+uint32_t
+ethernet_fcs_sse(const void *msg, uint64_t len, const void *tag_ouput);
+uint32_t
+ethernet_fcs_avx(const void *msg, uint64_t len, const void *tag_ouput);
+uint32_t
+ethernet_fcs_avx512(const void *msg, uint64_t len, const void *tag_ouput);
+
+/*******************************************************************************
+ * SSE
+ ******************************************************************************/
+uint32_t crc32_ethernet_fcs_sse(const void *in, const uint64_t len);
+uint32_t crc16_ccitt_sse(const void *in, const uint64_t len);
+uint32_t crc24_a_sse(const void *in, const uint64_t len);
+uint32_t crc24_b_sse(const void *in, const uint64_t len);
+uint32_t crc11_sse(const void *in, const uint64_t len);
+uint32_t crc6_sse(const void *in, const uint64_t len);
+void crc_n_buffer_sse(const IMB_CRC_TYPE type,
+                      const void * const in[], const uint64_t len[],
+                      uint32_t out[], const uint32_t num);
+
+/*******************************************************************************
+ * AVX
+ ******************************************************************************/
+uint32_t crc32_ethernet_fcs_avx(const void *in, const uint64_t len);
+uint32_t crc16_ccitt_avx(const void *in, const uint64_t len);
+uint32_t crc24_a_avx(const void *in, const uint64_t len);
+uint32_t crc24_b_avx(const void *in, const uint64_t len);
+uint32_t crc11_avx(const void *in, const uint64_t len);
+uint32_t crc6_avx(const void *in, const uint64_t len);
+void crc_n_buffer_avx(const IMB_CRC_TYPE type,
+                      const void * const in[], const uint64_t len[],
+                      uint32_t out[], const uint32_t num);
+
+/*******************************************************************************
+ * AVX512
+ ******************************************************************************/
+uint32_t crc32_ethernet_fcs_avx512(const void *in, const uint64_t len);
+uint32_t crc16_ccitt_avx512(const void *in, const uint64_t len);
+uint32_t crc24_a_avx512(const void *in, const uint64_t len);
+uint32_t crc24_b_avx512(const void *in, const uint64_t len);
+uint32_t crc11_avx512(const void *in, const uint64_t len);
+uint32_t crc6_avx512(const void *in, const uint64_t len);
+void crc_n_buffer_avx512(const IMB_CRC_TYPE type,
+                         const void * const in[], const uint64_t len[],
+                         uint32_t out[], const uint32_t num);
+
+#endif /* _CRC_H_ */
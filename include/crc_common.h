@@ -0,0 +1,307 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ *
+ * CRC implementations for the public CRC API:
+ * - Ethernet FCS (CRC32, reflected) reuses the DOCSIS/PON assembly code
+ * - 3GPP CRCs (TS 38.212 section 5.1) are non-reflected, start from
+ *   a zero value and have no final XOR. They are computed by folding
+ *   128-bit blocks with PCLMULQDQ (4 blocks at a time on long buffers),
+ *   with the last block and the tail bytes finished through a byte
+ *   lookup table.
+ *
+ * The including module defines the names of the exported functions
+ * (CRC16_CCITT, CRC24_A, ...) and ETHERNET_FCS_FN.
+ *
+ *-----------------------------------------------------------------------*/
+
+#ifndef CRC_COMMON_H
+#define CRC_COMMON_H
+
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "include/wireless_common.h"
+#include "include/crc.h"
+
+#define CRC_BLOCK_SIZE (16)
+
+/**
+ * @brief Byte at a time CRC update using the lookup table
+ *
+ * @param [in] crc     current CRC value (aligned to bit 31)
+ * @param [in] in      pointer to the data
+ * @param [in] len     number of bytes to process
+ * @param [in] lut     byte lookup table
+ *
+ * @return updated CRC value
+ */
+__forceinline uint32_t
+crc32_msb_lut(uint32_t crc, const uint8_t *in, uint64_t len,
+              const uint32_t *lut)
+{
+        while (len--)
+                crc = (crc << 8) ^ lut[(crc >> 24) ^ *in++];
+
+        return crc;
+}
+
+/**
+ * @brief Folds 128-bit block \a x into \a next
+ *
+ * @param [in] x       block to be folded (byte reflected)
+ * @param [in] k       folding constants (high 64 bits multiplier in low
+ *                     64 bits, low 64 bits multiplier in high 64 bits)
+ * @param [in] next    block at the folding distance from \a x
+ *
+ * @return folded block
+ */
+__forceinline __m128i
+crc32_msb_fold(const __m128i x, const __m128i k, const __m128i next)
+{
+        const __m128i hi = _mm_clmulepi64_si128(x, k, 0x01);
+        const __m128i lo = _mm_clmulepi64_si128(x, k, 0x10);
+
+        return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+/**
+ * @brief Loads 16 bytes of data and byte reflects them, so that
+ *        the first byte of the block lands in the most significant byte
+ */
+__forceinline __m128i
+crc32_msb_load(const uint8_t *in)
+{
+        const __m128i bswap = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                            7, 6, 5, 4, 3, 2, 1, 0);
+
+        return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in), bswap);
+}
+
+/**
+ * @brief Computes non-reflected CRC with the polynomial aligned to bit 31
+ *
+ * @param [in] consts  folding constants and lookup table of the polynomial
+ * @param [in] data    pointer to the data
+ * @param [in] len     length of the data in bytes
+ *
+ * @return CRC value aligned to bit 31
+ */
+__forceinline uint32_t
+crc32_msb(const struct crc_msb_consts *consts, const void *data, uint64_t len)
+{
+        const uint8_t *in = (const uint8_t *) data;
+        DECLARE_ALIGNED(uint8_t last_block[CRC_BLOCK_SIZE], 16);
+        __m128i x0, k;
+
+        if (len < CRC_BLOCK_SIZE)
+                return crc32_msb_lut(0, in, len, consts->lut);
+
+        x0 = crc32_msb_load(in);
+        in += CRC_BLOCK_SIZE;
+        len -= CRC_BLOCK_SIZE;
+
+        if (len >= (3 * CRC_BLOCK_SIZE)) {
+                __m128i x1 = crc32_msb_load(&in[0]);
+                __m128i x2 = crc32_msb_load(&in[16]);
+                __m128i x3 = crc32_msb_load(&in[32]);
+
+                in += (3 * CRC_BLOCK_SIZE);
+                len -= (3 * CRC_BLOCK_SIZE);
+
+                k = _mm_load_si128((const __m128i *) consts->fold_by4);
+
+                while (len >= (4 * CRC_BLOCK_SIZE)) {
+                        x0 = crc32_msb_fold(x0, k, crc32_msb_load(&in[0]));
+                        x1 = crc32_msb_fold(x1, k, crc32_msb_load(&in[16]));
+                        x2 = crc32_msb_fold(x2, k, crc32_msb_load(&in[32]));
+                        x3 = crc32_msb_fold(x3, k, crc32_msb_load(&in[48]));
+                        in += (4 * CRC_BLOCK_SIZE);
+                        len -= (4 * CRC_BLOCK_SIZE);
+                }
+
+                /* reduce 4 blocks into 1 */
+                k = _mm_load_si128((const __m128i *) consts->fold_by1);
+                x0 = crc32_msb_fold(x0, k, x1);
+                x0 = crc32_msb_fold(x0, k, x2);
+                x0 = crc32_msb_fold(x0, k, x3);
+        } else {
+                k = _mm_load_si128((const __m128i *) consts->fold_by1);
+        }
+
+        while (len >= CRC_BLOCK_SIZE) {
+                x0 = crc32_msb_fold(x0, k, crc32_msb_load(in));
+                in += CRC_BLOCK_SIZE;
+                len -= CRC_BLOCK_SIZE;
+        }
+
+        /*
+         * Remaining 128-bit block gets processed as message bytes,
+         * followed by the tail bytes of the buffer
+         */
+        x0 = _mm_shuffle_epi8(x0, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                                7, 6, 5, 4, 3, 2, 1, 0));
+        _mm_store_si128((__m128i *) last_block, x0);
+
+        return crc32_msb_lut(crc32_msb_lut(0, last_block, CRC_BLOCK_SIZE,
+                                           consts->lut),
+                             in, len, consts->lut);
+}
+
+/**
+ * @brief Selects constants and width for the non-reflected CRC types
+ *
+ * @param [in]  type    CRC type
+ * @param [out] width   CRC width in bits
+ *
+ * @return pointer to the constants or NULL if type is not supported
+ */
+__forceinline const struct crc_msb_consts *
+crc_msb_type_consts(const IMB_CRC_TYPE type, unsigned *width)
+{
+        switch (type) {
+        case IMB_CRC_TYPE_CRC16_CCITT:
+                *width = 16;
+                return &crc16_ccitt_consts;
+        case IMB_CRC_TYPE_CRC24_A:
+                *width = 24;
+                return &crc24_a_consts;
+        case IMB_CRC_TYPE_CRC24_B:
+                *width = 24;
+                return &crc24_b_consts;
+        case IMB_CRC_TYPE_CRC11:
+                *width = 11;
+                return &crc11_consts;
+        case IMB_CRC_TYPE_CRC6:
+                *width = 6;
+                return &crc6_consts;
+        default:
+                break;
+        }
+        return NULL;
+}
+
+/* ========================================================================== */
+/* Public API */
+
+uint32_t
+CRC32_ETHERNET_FCS(const void *in, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (in == NULL && len != 0)
+                return 0;
+#endif
+        /* CRC of an empty buffer (assembly code expects at least 1 byte) */
+        if (len == 0)
+                return 0;
+
+        return ETHERNET_FCS_FN(in, len, NULL);
+}
+
+uint32_t
+CRC16_CCITT(const void *in, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (in == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_msb(&crc16_ccitt_consts, in, len) >> (32 - 16);
+}
+
+uint32_t
+CRC24_A(const void *in, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (in == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_msb(&crc24_a_consts, in, len) >> (32 - 24);
+}
+
+uint32_t
+CRC24_B(const void *in, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (in == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_msb(&crc24_b_consts, in, len) >> (32 - 24);
+}
+
+uint32_t
+CRC11(const void *in, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (in == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_msb(&crc11_consts, in, len) >> (32 - 11);
+}
+
+uint32_t
+CRC6(const void *in, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (in == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_msb(&crc6_consts, in, len) >> (32 - 6);
+}
+
+void
+CRC_N_BUFFER(const IMB_CRC_TYPE type,
+             const void * const in[], const uint64_t len[],
+             uint32_t out[], const uint32_t num)
+{
+        const struct crc_msb_consts *consts;
+        unsigned width = 32;
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (in == NULL || len == NULL || out == NULL)
+                return;
+        for (i = 0; i < num; i++)
+                if (in[i] == NULL && len[i] != 0)
+                        return;
+#endif
+        if (type == IMB_CRC_TYPE_CRC32_ETHERNET_FCS) {
+                for (i = 0; i < num; i++)
+                        out[i] = (len[i] == 0) ? 0 :
+                                ETHERNET_FCS_FN(in[i], len[i], NULL);
+                return;
+        }
+
+        consts = crc_msb_type_consts(type, &width);
+        if (consts == NULL)
+                return;
+
+        for (i = 0; i < num; i++)
+                out[i] = crc32_msb(consts, in[i], len[i]) >> (32 - width);
+}
+
+#endif /* CRC_COMMON_H */
@@ -0,0 +1,833 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * Multi-buffer DES, 3DES and DOCSIS DES out-of-order managers.
+ *
+ * DES_OOO_NUM_LANES independent buffers (4 with SSE and AVX, 8 with AVX2)
+ * are processed together, one 64-bit block per lane, with each SIMD
+ * register holding one 32-bit half of the blocks of all lanes.
+ *
+ * The round function uses the combined S-box and P tables of des_basic.c.
+ * With SAFE_LOOKUP, a table is looked up by permuting all of its entries
+ * in registers and blending on the upper index bits, so memory accesses
+ * don't depend on the data or the key. Otherwise, table entries are
+ * loaded directly (gathered with AVX2).
+ *
+ * Lane fields are used as in the AVX512 DES managers:
+ * - lens - number of bytes left to process (full blocks only)
+ * - args.IV - low halves of the IV's in IV[0-15], high halves in IV[16-31]
+ * - DOCSIS DES: partial block length and position are kept in
+ *   partial_len, last_in and last_out. The partial block (CFB) is
+ *   processed once all full blocks of the lane are done, together
+ *   with other lanes in the same state.
+ *
+ * Key schedules are transposed into lane order on each processing call.
+ * Buffers too long for lens are processed on submission (des_basic.c).
+ *
+ * The including file has to define:
+ * - CLEAR_SCRATCH_SIMD_REGS
+ * - AVX2 for 256-bit code or AVX for VEX encoded 128-bit code
+ * - SUBMIT_JOB_DES_CBC_ENC, FLUSH_JOB_DES_CBC_ENC
+ * - SUBMIT_JOB_DES_CBC_DEC, FLUSH_JOB_DES_CBC_DEC
+ * - SUBMIT_JOB_3DES_CBC_ENC, FLUSH_JOB_3DES_CBC_ENC
+ * - SUBMIT_JOB_3DES_CBC_DEC, FLUSH_JOB_3DES_CBC_DEC
+ * - SUBMIT_JOB_DOCSIS_DES_ENC, FLUSH_JOB_DOCSIS_DES_ENC
+ * - SUBMIT_JOB_DOCSIS_DES_DEC, FLUSH_JOB_DOCSIS_DES_DEC
+ */
+
+#ifndef DES_OOO_COMMON_H
+#define DES_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/des.h"
+#include "include/clear_regs_mem.h"
+
+/* cipher selection for the common functions */
+#define DES_OOO_DES    0
+#define DES_OOO_3DES   1
+#define DES_OOO_DOCSIS 2
+
+/* index of the high IV half of lane 0 in args.IV */
+#define DES_OOO_IV_HI AVX512_NUM_DES_LANES
+
+#ifdef AVX2
+#define DES_OOO_NUM_LANES AVX2_NUM_DES_LANES
+typedef __m256i des_vec_t;
+#define DES_VLOAD(p)     _mm256_loadu_si256((const __m256i *)(p))
+#define DES_VSTORE(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+#define DES_VXOR         _mm256_xor_si256
+#define DES_VAND         _mm256_and_si256
+#define DES_VOR          _mm256_or_si256
+#define DES_VSET1        _mm256_set1_epi32
+#define DES_VSRL         _mm256_srli_epi32
+#define DES_VSLL         _mm256_slli_epi32
+#else
+#ifdef AVX
+#define DES_OOO_NUM_LANES AVX_NUM_DES_LANES
+#else
+#define DES_OOO_NUM_LANES SSE_NUM_DES_LANES
+#endif
+typedef __m128i des_vec_t;
+#define DES_VLOAD(p)     _mm_loadu_si128((const __m128i *)(p))
+#define DES_VSTORE(p, v) _mm_storeu_si128((__m128i *)(p), v)
+#define DES_VXOR         _mm_xor_si128
+#define DES_VAND         _mm_and_si128
+#define DES_VOR          _mm_or_si128
+#define DES_VSET1        _mm_set1_epi32
+#define DES_VSRL         _mm_srli_epi32
+#define DES_VSLL         _mm_slli_epi32
+#endif
+
+/* transposed key schedules: [DES/3DES key][round][low/high half][lane] */
+typedef uint32_t des_ooo_ks_t[3][16][2][DES_OOO_NUM_LANES];
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state);
+
+/**
+ * @brief Looks up a DES S-box table for all lanes
+ *
+ * Constant time with SAFE_LOOKUP (see LOOKUP32_SSE in des_basic.c).
+ *
+ * @param [in] sbox  64 entry S-box table
+ * @param [in] idx   Table indexes in bits 0 to 5 (upper bits ignored)
+ *
+ * @return Table entries
+ */
+__forceinline
+des_vec_t
+des_ooo_sbox(const uint32_t *sbox, const des_vec_t idx)
+{
+#ifndef SAFE_LOOKUP
+        const des_vec_t i = DES_VAND(idx, DES_VSET1(0x3f));
+
+#ifdef AVX2
+        return _mm256_i32gather_epi32((const int *) sbox, i, 4);
+#else
+        return _mm_set_epi32(sbox[_mm_extract_epi32(i, 3)],
+                             sbox[_mm_extract_epi32(i, 2)],
+                             sbox[_mm_extract_epi32(i, 1)],
+                             sbox[_mm_cvtsi128_si32(i)]);
+#endif
+#elif defined(AVX2)
+        /* bits 0-2 select the entry of 8 entry slices, bits 3-5 the slice */
+        const __m256 m3 = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 28));
+        const __m256 m4 = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 27));
+        const __m256 m5 = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 26));
+        __m256 t0, t1, t2, t3;
+
+#define DES_OOO_SLICE(n) \
+        _mm256_castsi256_ps(_mm256_permutevar8x32_epi32( \
+                            DES_VLOAD(&sbox[(n) * 8]), idx))
+
+        t0 = _mm256_blendv_ps(DES_OOO_SLICE(0), DES_OOO_SLICE(1), m3);
+        t1 = _mm256_blendv_ps(DES_OOO_SLICE(2), DES_OOO_SLICE(3), m3);
+        t2 = _mm256_blendv_ps(DES_OOO_SLICE(4), DES_OOO_SLICE(5), m3);
+        t3 = _mm256_blendv_ps(DES_OOO_SLICE(6), DES_OOO_SLICE(7), m3);
+#undef DES_OOO_SLICE
+
+        t0 = _mm256_blendv_ps(t0, t1, m4);
+        t2 = _mm256_blendv_ps(t2, t3, m4);
+
+        return _mm256_castps_si256(_mm256_blendv_ps(t0, t2, m5));
+#else
+        /* bits 0-1 select the entry of 4 entry slices, bits 2-5 the slice */
+        const __m128 m2 = _mm_castsi128_ps(_mm_slli_epi32(idx, 29));
+        const __m128 m3 = _mm_castsi128_ps(_mm_slli_epi32(idx, 28));
+        const __m128 m4 = _mm_castsi128_ps(_mm_slli_epi32(idx, 27));
+        const __m128 m5 = _mm_castsi128_ps(_mm_slli_epi32(idx, 26));
+        __m128 t0, t1, t2, t3;
+
+#ifdef AVX
+#define DES_OOO_SLICE(n) \
+        _mm_permutevar_ps(_mm_castsi128_ps(DES_VLOAD(&sbox[(n) * 4])), idx)
+#else
+        /* byte shuffle control: 4 x (idx & 3) + (0, 1, 2, 3) */
+        const __m128i ctrl =
+                _mm_add_epi8(_mm_shuffle_epi8(
+                             _mm_slli_epi32(_mm_and_si128(idx,
+                                                          _mm_set1_epi32(3)),
+                                            2),
+                             _mm_set_epi8(12, 12, 12, 12, 8, 8, 8, 8,
+                                          4, 4, 4, 4, 0, 0, 0, 0)),
+                             _mm_set1_epi32(0x03020100));
+
+#define DES_OOO_SLICE(n) \
+        _mm_castsi128_ps(_mm_shuffle_epi8(DES_VLOAD(&sbox[(n) * 4]), ctrl))
+#endif
+
+#define DES_OOO_SLICE4(n) \
+        _mm_blendv_ps(_mm_blendv_ps(DES_OOO_SLICE(n), \
+                                    DES_OOO_SLICE((n) + 1), m2), \
+                      _mm_blendv_ps(DES_OOO_SLICE((n) + 2), \
+                                    DES_OOO_SLICE((n) + 3), m2), m3)
+
+        t0 = DES_OOO_SLICE4(0);
+        t1 = DES_OOO_SLICE4(4);
+        t2 = DES_OOO_SLICE4(8);
+        t3 = DES_OOO_SLICE4(12);
+#undef DES_OOO_SLICE4
+#undef DES_OOO_SLICE
+
+        t0 = _mm_blendv_ps(t0, t1, m4);
+        t2 = _mm_blendv_ps(t2, t3, m4);
+
+        return _mm_castps_si128(_mm_blendv_ps(t0, t2, m5));
+#endif
+}
+
+/**
+ * @brief DES round function (E phase, key mixing, S-boxes and P)
+ *
+ * @param [in] r   R halves of the blocks
+ * @param [in] k   Round key, low and high halves in lane order
+ *
+ * @return f(R, K)
+ */
+__forceinline
+des_vec_t
+des_ooo_frk(const des_vec_t r, const uint32_t (*k)[DES_OOO_NUM_LANES])
+{
+        des_vec_t lo, hi, x;
+
+        /* E phase as e_phase() in des_basic.c, split into 32-bit halves */
+        lo = DES_VOR(DES_VAND(DES_VSLL(r, 1), DES_VSET1(0x3e)),
+                     DES_VSRL(r, 31));
+        lo = DES_VOR(lo, DES_VAND(DES_VSLL(r, 5), DES_VSET1(0x3f00)));
+        lo = DES_VOR(lo, DES_VAND(DES_VSLL(r, 9), DES_VSET1(0x3f0000)));
+        lo = DES_VOR(lo, DES_VAND(DES_VSLL(r, 13), DES_VSET1(0x3f000000)));
+
+        hi = DES_VOR(DES_VAND(DES_VSRL(r, 15), DES_VSET1(0x3f)),
+                     DES_VAND(DES_VSRL(r, 11), DES_VSET1(0x3f00)));
+        hi = DES_VOR(hi, DES_VAND(DES_VSRL(r, 7), DES_VSET1(0x3f0000)));
+        hi = DES_VOR(hi, DES_VAND(DES_VSRL(r, 3), DES_VSET1(0x1f000000)));
+        hi = DES_VOR(hi, DES_VAND(DES_VSLL(r, 29), DES_VSET1(0x20000000)));
+
+        lo = DES_VXOR(lo, DES_VLOAD(k[0]));
+        hi = DES_VXOR(hi, DES_VLOAD(k[1]));
+
+        x = DES_VOR(des_ooo_sbox(des_sbox0p, lo),
+                    des_ooo_sbox(des_sbox1p, DES_VSRL(lo, 8)));
+        x = DES_VOR(x, des_ooo_sbox(des_sbox2p, DES_VSRL(lo, 16)));
+        x = DES_VOR(x, des_ooo_sbox(des_sbox3p, DES_VSRL(lo, 24)));
+        x = DES_VOR(x, des_ooo_sbox(des_sbox4p, hi));
+        x = DES_VOR(x, des_ooo_sbox(des_sbox5p, DES_VSRL(hi, 8)));
+        x = DES_VOR(x, des_ooo_sbox(des_sbox6p, DES_VSRL(hi, 16)));
+        return DES_VOR(x, des_ooo_sbox(des_sbox7p, DES_VSRL(hi, 24)));
+}
+
+/* see permute_operation() in des_basic.c */
+__forceinline
+void
+des_ooo_permute(des_vec_t *pa, des_vec_t *pb, const int n, const int m)
+{
+        const des_vec_t t = DES_VAND(DES_VXOR(*pb, DES_VSRL(*pa, n)),
+                                     DES_VSET1(m));
+
+        *pb = DES_VXOR(*pb, t);
+        *pa = DES_VXOR(*pa, DES_VSLL(t, n));
+}
+
+/**
+ * @brief Encrypts or decrypts one block in each lane
+ *
+ * @param [in/out] lo  Low halves of the blocks
+ * @param [in/out] hi  High halves of the blocks
+ * @param [in] ks      Transposed key schedule
+ * @param [in] enc     Encrypt (1) or decrypt (0)
+ */
+__forceinline
+void
+des_ooo_crypt(des_vec_t *lo, des_vec_t *hi,
+              const uint32_t (*ks)[2][DES_OOO_NUM_LANES], const int enc)
+{
+        des_vec_t r = *lo, l = *hi;
+        int i;
+
+        /* initial permutation, see ip_z() */
+        des_ooo_permute(&l, &r, 4, 0x0f0f0f0f);
+        des_ooo_permute(&r, &l, 16, 0x0000ffff);
+        des_ooo_permute(&l, &r, 2, 0x33333333);
+        des_ooo_permute(&r, &l, 8, 0x00ff00ff);
+        des_ooo_permute(&l, &r, 1, 0x55555555);
+
+        if (enc) {
+                for (i = 0; i < 16; i += 2) {
+                        l = DES_VXOR(l, des_ooo_frk(r, ks[i]));
+                        r = DES_VXOR(r, des_ooo_frk(l, ks[i + 1]));
+                }
+        } else {
+                for (i = 15; i > 0; i -= 2) {
+                        l = DES_VXOR(l, des_ooo_frk(r, ks[i]));
+                        r = DES_VXOR(r, des_ooo_frk(l, ks[i - 1]));
+                }
+        }
+
+        /* final permutation, see fp_z() */
+        des_ooo_permute(&r, &l, 1, 0x55555555);
+        des_ooo_permute(&l, &r, 8, 0x00ff00ff);
+        des_ooo_permute(&r, &l, 2, 0x33333333);
+        des_ooo_permute(&l, &r, 16, 0x0000ffff);
+        des_ooo_permute(&r, &l, 4, 0x0f0f0f0f);
+
+        *lo = l;
+        *hi = r;
+}
+
+/**
+ * @brief Runs the DES or 3DES cipher on one block in each lane
+ *
+ * @param [in/out] lo  Low halves of the blocks
+ * @param [in/out] hi  High halves of the blocks
+ * @param [in] ks      Transposed key schedules
+ * @param [in] cipher  DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ * @param [in] enc     Encrypt (1) or decrypt (0)
+ */
+__forceinline
+void
+des_ooo_cipher(des_vec_t *lo, des_vec_t *hi, des_ooo_ks_t ks,
+               const int cipher, const int enc)
+{
+        if (cipher != DES_OOO_3DES) {
+                des_ooo_crypt(lo, hi, ks[0], enc);
+        } else if (enc) {
+                des_ooo_crypt(lo, hi, ks[0], 1);
+                des_ooo_crypt(lo, hi, ks[1], 0);
+                des_ooo_crypt(lo, hi, ks[2], 1);
+        } else {
+                des_ooo_crypt(lo, hi, ks[2], 0);
+                des_ooo_crypt(lo, hi, ks[1], 1);
+                des_ooo_crypt(lo, hi, ks[0], 0);
+        }
+}
+
+/**
+ * @brief Collects the used lanes of the manager
+ *
+ * @param [in] state      DES OOO manager
+ * @param [out] lanes     Indexes of the used lanes
+ * @param [out] min_lane  Lane with the least bytes to process
+ *
+ * @return Number of used lanes
+ */
+__forceinline
+unsigned
+des_ooo_collect_lanes(const MB_MGR_DES_OOO *state, uint8_t *lanes,
+                      unsigned *min_lane)
+{
+        uint32_t min_len = UINT32_MAX;
+        unsigned lane, n = 0;
+
+        for (lane = 0; lane < DES_OOO_NUM_LANES; lane++) {
+                if (state->job_in_lane[lane] == NULL)
+                        continue;
+                if (state->lens[lane] < min_len) {
+                        min_len = state->lens[lane];
+                        *min_lane = lane;
+                }
+                lanes[n++] = (uint8_t) lane;
+        }
+
+        return n;
+}
+
+/**
+ * @brief Transposes key schedules of the used lanes into lane order
+ *
+ * @param [in] state   DES OOO manager
+ * @param [out] ks     Transposed key schedules (zero for unused lanes)
+ * @param [in] cipher  DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ */
+__forceinline
+void
+des_ooo_load_keys(const MB_MGR_DES_OOO *state, des_ooo_ks_t ks,
+                  const int cipher)
+{
+        const unsigned num_ks = (cipher == DES_OOO_3DES) ? 3 : 1;
+        unsigned lane, n, i;
+
+        for (lane = 0; lane < DES_OOO_NUM_LANES; lane++) {
+                for (n = 0; n < num_ks; n++) {
+                        const uint64_t *k;
+
+                        if (state->job_in_lane[lane] == NULL) {
+                                for (i = 0; i < 16; i++) {
+                                        ks[n][i][0][lane] = 0;
+                                        ks[n][i][1][lane] = 0;
+                                }
+                                continue;
+                        }
+
+                        if (cipher == DES_OOO_3DES)
+                                k = ((const uint64_t * const *)
+                                     state->args.keys[lane])[n];
+                        else
+                                k = (const uint64_t *) state->args.keys[lane];
+
+                        for (i = 0; i < 16; i++) {
+                                ks[n][i][0][lane] = (uint32_t) k[i];
+                                ks[n][i][1][lane] = (uint32_t) (k[i] >> 32);
+                        }
+                }
+        }
+}
+
+/**
+ * @brief Runs CBC on the used lanes
+ *
+ * @param [in/out] state  DES OOO manager
+ * @param [in] lanes      Indexes of the used lanes
+ * @param [in] n          Number of used lanes
+ * @param [in] ks         Transposed key schedules
+ * @param [in] len        Number of bytes to process in each lane
+ * @param [in] cipher     DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ * @param [in] enc        Encrypt (1) or decrypt (0)
+ */
+__forceinline
+void
+des_ooo_cbc(MB_MGR_DES_OOO *state, const uint8_t *lanes, const unsigned n,
+            des_ooo_ks_t ks, const uint32_t len, const int cipher,
+            const int enc)
+{
+        DECLARE_ALIGNED(uint32_t blk_lo[DES_OOO_NUM_LANES], 32);
+        DECLARE_ALIGNED(uint32_t blk_hi[DES_OOO_NUM_LANES], 32);
+        des_vec_t lo, hi, iv_lo, iv_hi;
+        uint32_t offset;
+        unsigned i;
+
+        memset(blk_lo, 0, sizeof(blk_lo));
+        memset(blk_hi, 0, sizeof(blk_hi));
+
+        iv_lo = DES_VLOAD(&state->args.IV[0]);
+        iv_hi = DES_VLOAD(&state->args.IV[DES_OOO_IV_HI]);
+
+        for (offset = 0; offset < len; offset += DES_BLOCK_SIZE) {
+                for (i = 0; i < n; i++) {
+                        const unsigned lane = lanes[i];
+                        const uint32_t *in = (const uint32_t *)
+                                &state->args.in[lane][offset];
+
+                        blk_lo[lane] = in[0];
+                        blk_hi[lane] = in[1];
+                }
+
+                lo = DES_VLOAD(blk_lo);
+                hi = DES_VLOAD(blk_hi);
+
+                if (enc) {
+                        lo = DES_VXOR(lo, iv_lo);
+                        hi = DES_VXOR(hi, iv_hi);
+                        des_ooo_cipher(&lo, &hi, ks, cipher, 1);
+                        iv_lo = lo;
+                        iv_hi = hi;
+                } else {
+                        const des_vec_t c_lo = lo, c_hi = hi;
+
+                        des_ooo_cipher(&lo, &hi, ks, cipher, 0);
+                        lo = DES_VXOR(lo, iv_lo);
+                        hi = DES_VXOR(hi, iv_hi);
+                        iv_lo = c_lo;
+                        iv_hi = c_hi;
+                }
+
+                DES_VSTORE(blk_lo, lo);
+                DES_VSTORE(blk_hi, hi);
+
+                for (i = 0; i < n; i++) {
+                        const unsigned lane = lanes[i];
+                        uint32_t *out = (uint32_t *)
+                                &state->args.out[lane][offset];
+
+                        out[0] = blk_lo[lane];
+                        out[1] = blk_hi[lane];
+                }
+        }
+
+        DES_VSTORE(blk_lo, iv_lo);
+        DES_VSTORE(blk_hi, iv_hi);
+
+        for (i = 0; i < n; i++) {
+                const unsigned lane = lanes[i];
+
+                state->args.IV[lane] = blk_lo[lane];
+                state->args.IV[lane + DES_OOO_IV_HI] = blk_hi[lane];
+                state->args.in[lane] += len;
+                state->args.out[lane] += len;
+                state->lens[lane] -= (uint16_t) len;
+        }
+
+#ifdef SAFE_DATA
+        clear_mem(blk_lo, sizeof(blk_lo));
+        clear_mem(blk_hi, sizeof(blk_hi));
+#endif
+}
+
+/**
+ * @brief Runs DOCSIS CFB on partial blocks of lanes with no full blocks left
+ *
+ * The IV of such a lane is the last cipher text block
+ * (or the job IV if the buffer has no full blocks).
+ *
+ * @param [in/out] state  DOCSIS DES OOO manager
+ * @param [in] lanes      Indexes of the used lanes
+ * @param [in] n          Number of used lanes
+ * @param [in] ks         Transposed key schedules
+ */
+__forceinline
+void
+des_ooo_docsis_cfb(MB_MGR_DES_OOO *state, const uint8_t *lanes,
+                   const unsigned n, des_ooo_ks_t ks)
+{
+        DECLARE_ALIGNED(uint32_t blk_lo[DES_OOO_NUM_LANES], 32);
+        DECLARE_ALIGNED(uint32_t blk_hi[DES_OOO_NUM_LANES], 32);
+        des_vec_t lo, hi;
+        unsigned i, num_cfb = 0;
+
+        for (i = 0; i < n; i++)
+                if (state->lens[lanes[i]] == 0 &&
+                    state->args.partial_len[lanes[i]] != 0)
+                        num_cfb++;
+
+        if (num_cfb == 0)
+                return;
+
+        lo = DES_VLOAD(&state->args.IV[0]);
+        hi = DES_VLOAD(&state->args.IV[DES_OOO_IV_HI]);
+        des_ooo_crypt(&lo, &hi, ks[0], 1 /* encrypt */);
+        DES_VSTORE(blk_lo, lo);
+        DES_VSTORE(blk_hi, hi);
+
+        for (i = 0; i < n; i++) {
+                const unsigned lane = lanes[i];
+                const uint32_t partial = state->args.partial_len[lane];
+                const uint8_t *in = state->args.last_in[lane];
+                uint8_t *out = state->args.last_out[lane];
+                uint64_t t;
+                uint32_t j;
+
+                if (state->lens[lane] != 0 || partial == 0)
+                        continue;
+
+                t = ((uint64_t) blk_hi[lane] << 32) | blk_lo[lane];
+                for (j = 0; j < partial; j++, t >>= 8)
+                        out[j] = in[j] ^ (uint8_t) t;
+
+                state->args.partial_len[lane] = 0;
+        }
+
+#ifdef SAFE_DATA
+        clear_mem(blk_lo, sizeof(blk_lo));
+        clear_mem(blk_hi, sizeof(blk_hi));
+#endif
+}
+
+/**
+ * @brief Frees a lane and returns its job
+ *
+ * @param [in/out] state  DES OOO manager
+ * @param [in] lane       Lane to free
+ *
+ * @return Job of the lane
+ */
+__forceinline
+IMB_JOB *
+des_ooo_release(MB_MGR_DES_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        state->args.IV[lane] = 0;
+        state->args.IV[lane + DES_OOO_IV_HI] = 0;
+#endif
+        return job;
+}
+
+/**
+ * @brief Runs all used lanes and completes the shortest job
+ *
+ * @param [in/out] state  DES OOO manager (can't be empty)
+ * @param [in] cipher     DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ * @param [in] enc        Encrypt (1) or decrypt (0)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+des_ooo_process(MB_MGR_DES_OOO *state, const int cipher, const int enc)
+{
+        DECLARE_ALIGNED(des_ooo_ks_t ks, 32);
+        uint8_t lanes[DES_OOO_NUM_LANES];
+        unsigned n, min_lane = 0;
+        uint32_t len;
+        IMB_JOB *job;
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+        n = des_ooo_collect_lanes(state, lanes, &min_lane);
+        len = state->lens[min_lane];
+
+        if (len != 0 || cipher == DES_OOO_DOCSIS) {
+                des_ooo_load_keys(state, ks, cipher);
+
+                /* all lanes run the full blocks of the shortest buffer */
+                if (len != 0)
+                        des_ooo_cbc(state, lanes, n, ks, len, cipher, enc);
+
+                if (cipher == DES_OOO_DOCSIS)
+                        des_ooo_docsis_cfb(state, lanes, n, ks);
+
+#ifdef SAFE_DATA
+                /* Clear sensitive data in stack */
+                clear_mem(ks, sizeof(ks));
+#endif
+        }
+
+        job = des_ooo_release(state, min_lane);
+        job->status |= STS_COMPLETED_AES;
+
+        return job;
+}
+
+/**
+ * @brief Processes a job on its own (lens can't hold its length)
+ *
+ * @param [in] job     Job to process
+ * @param [in] cipher  DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ * @param [in] enc     Encrypt (1) or decrypt (0)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+des_ooo_single(IMB_JOB *job, const int cipher, const int enc)
+{
+        if (cipher == DES_OOO_DES)
+                return enc ? DES_CBC_ENC(job) : DES_CBC_DEC(job);
+
+        if (cipher == DES_OOO_3DES)
+                return enc ? DES3_CBC_ENC(job) : DES3_CBC_DEC(job);
+
+        if (enc)
+                docsis_des_enc_basic(job->src +
+                                     job->cipher_start_src_offset_in_bytes,
+                                     job->dst,
+                                     (int) job->msg_len_to_cipher_in_bytes,
+                                     job->enc_keys,
+                                     (const uint64_t *) job->iv);
+        else
+                docsis_des_dec_basic(job->src +
+                                     job->cipher_start_src_offset_in_bytes,
+                                     job->dst,
+                                     (int) job->msg_len_to_cipher_in_bytes,
+                                     job->dec_keys,
+                                     (const uint64_t *) job->iv);
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+/**
+ * @brief Puts a job into a free lane and processes the lanes when full
+ *
+ * @param [in/out] state  DES OOO manager
+ * @param [in] job        Job to submit
+ * @param [in] cipher     DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ * @param [in] enc        Encrypt (1) or decrypt (0)
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+__forceinline
+IMB_JOB *
+des_ooo_submit(MB_MGR_DES_OOO *state, IMB_JOB *job, const int cipher,
+               const int enc)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        const uint64_t len = job->msg_len_to_cipher_in_bytes;
+        const uint16_t full_len = (uint16_t) (len & (~(DES_BLOCK_SIZE - 1)));
+        const uint8_t *in = job->src + job->cipher_start_src_offset_in_bytes;
+        const uint32_t *iv = (const uint32_t *) job->iv;
+
+        if (len > UINT16_MAX)
+                return des_ooo_single(job, cipher, enc);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = full_len;
+
+        state->args.keys[lane] = (const uint8_t *)
+                (enc ? job->enc_keys : job->dec_keys);
+        state->args.IV[lane] = iv[0];
+        state->args.IV[lane + DES_OOO_IV_HI] = iv[1];
+        state->args.in[lane] = in;
+        state->args.out[lane] = job->dst;
+
+        if (cipher == DES_OOO_DOCSIS) {
+                state->args.block_len[lane] = full_len;
+                state->args.last_in[lane] = in + full_len;
+                state->args.last_out[lane] = job->dst + full_len;
+                state->args.partial_len[lane] =
+                        (uint32_t) (len & (DES_BLOCK_SIZE - 1));
+        }
+
+        if (state->num_lanes_inuse < DES_OOO_NUM_LANES)
+                return NULL;
+
+        return des_ooo_process(state, cipher, enc);
+}
+
+/**
+ * @brief Completes the shortest job of the manager
+ *
+ * @param [in/out] state  DES OOO manager
+ * @param [in] cipher     DES_OOO_DES, DES_OOO_3DES or DES_OOO_DOCSIS
+ * @param [in] enc        Encrypt (1) or decrypt (0)
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+__forceinline
+IMB_JOB *
+des_ooo_flush(MB_MGR_DES_OOO *state, const int cipher, const int enc)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return des_ooo_process(state, cipher, enc);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_ooo_submit(state, job, DES_OOO_DES, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state)
+{
+        return des_ooo_flush(state, DES_OOO_DES, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_ooo_submit(state, job, DES_OOO_DES, 0);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state)
+{
+        return des_ooo_flush(state, DES_OOO_DES, 0);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_ooo_submit(state, job, DES_OOO_3DES, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state)
+{
+        return des_ooo_flush(state, DES_OOO_3DES, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_ooo_submit(state, job, DES_OOO_3DES, 0);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state)
+{
+        return des_ooo_flush(state, DES_OOO_3DES, 0);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_ooo_submit(state, job, DES_OOO_DOCSIS, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state)
+{
+        return des_ooo_flush(state, DES_OOO_DOCSIS, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_ooo_submit(state, job, DES_OOO_DOCSIS, 0);
+}
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state)
+{
+        return des_ooo_flush(state, DES_OOO_DOCSIS, 0);
+}
+
+#endif /* DES_OOO_COMMON_H */
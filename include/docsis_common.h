@@ -310,7 +310,7 @@ SUBMIT_JOB_DOCSIS_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
         return SUBMIT_JOB_DOCSIS_SEC_ENC(state, job, key_size);
 }
 
-#ifndef AVX512
+#if !defined(AVX512) && !defined(AVX2)
 __forceinline
 IMB_JOB *
 SUBMIT_JOB_DOCSIS128_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state,
@@ -340,7 +340,7 @@ FLUSH_JOB_DOCSIS_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state,
         return FLUSH_JOB_DOCSIS_SEC_ENC(state, key_size);
 }
 
-#ifndef AVX512
+#if !defined(AVX512) && !defined(AVX2)
 __forceinline
 IMB_JOB *
 FLUSH_JOB_DOCSIS128_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state)
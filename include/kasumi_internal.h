@@ -480,6 +480,86 @@ kasumi_8_blocks(const uint16_t *context, uint16_t **ppData)
     kasumi_4_blocks (context, &ppData[4]);
 }
 
+/**
+ ******************************************************************************
+ * @description
+ * This function performs the Kasumi operation on two blocks, each one
+ * using its own key schedule
+ *
+ * @param[in]       context1     Context of the first block
+ * @param[in]       context2     Context of the second block
+ * @param[in/out]   data1        First block to be enc/dec
+ * @param[in/out]   data2        Second block to be enc/dec
+ *
+ ******************************************************************************/
+static inline void
+kasumi_2_blocks_multikey(const uint16_t *context1, const uint16_t *context2,
+                         uint16_t *data1, uint16_t *data2)
+{
+        const uint16_t *end = context1 + KASUMI_KEY_SCHEDULE_SIZE;
+        uint16_t temp1_l, temp1_h;
+        uint16_t temp2_l, temp2_h;
+
+        /* 4 iterations odd/even, blocks are independent and interleave */
+        do {
+                /* even */
+                temp1_l = data1[3];
+                temp1_h = data1[2];
+                temp2_l = data2[3];
+                temp2_h = data2[2];
+                FLp1(context1, temp1_h, temp1_l);
+                FLp1(context2, temp2_h, temp2_l);
+                FOp1(context1, temp1_h, temp1_l);
+                FOp1(context2, temp2_h, temp2_l);
+                context1 += 8;
+                context2 += 8;
+                data1[1] ^= temp1_l;
+                data1[0] ^= temp1_h;
+                data2[1] ^= temp2_l;
+                data2[0] ^= temp2_h;
+
+                /* odd */
+                temp1_h = data1[1];
+                temp1_l = data1[0];
+                temp2_h = data2[1];
+                temp2_l = data2[0];
+                FOp1(context1, temp1_h, temp1_l);
+                FOp1(context2, temp2_h, temp2_l);
+                FLp1(context1, temp1_h, temp1_l);
+                FLp1(context2, temp2_h, temp2_l);
+                context1 += 8;
+                context2 += 8;
+                data1[3] ^= temp1_h;
+                data1[2] ^= temp1_l;
+                data2[3] ^= temp2_h;
+                data2[2] ^= temp2_l;
+        } while (context1 < end);
+}
+
+/**
+ ******************************************************************************
+ * @description
+ * This function performs the Kasumi operation on up to 16 blocks,
+ * each one using its own key schedule
+ *
+ * @param[in]       ppContext   Array of contexts, one per block
+ * @param[in/out]   ppData      Array of addresses of blocks
+ * @param[in]       num         Number of blocks
+ *
+ ******************************************************************************/
+static inline void
+kasumi_n_blocks_multikey(const uint16_t * const *ppContext, uint16_t **ppData,
+                         const unsigned num)
+{
+        unsigned i;
+
+        for (i = 0; (i + 1) < num; i += 2)
+                kasumi_2_blocks_multikey(ppContext[i], ppContext[i + 1],
+                                         ppData[i], ppData[i + 1]);
+        if (num & 1)
+                kasumi_1_block(ppContext[num - 1], ppData[num - 1]);
+}
+
 /******************************************************************************
 * @description
 *   Multiple wrappers for the Kasumi rounds on up to 16 blocks of 64 bits at a
@@ -0,0 +1,490 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer KASUMI-UEA1 (F8) and KASUMI-UIA1 (F9) out-of-order managers.
+ *
+ * Jobs with individual key schedules are collected in
+ * KASUMI_OOO_NUM_LANES lanes. Once all lanes are used (or on flush),
+ * the lanes run the KASUMI rounds together, block by block,
+ * up to the last block of the shortest buffer. The shortest job is
+ * then completed and returned, the other lanes keep their state
+ * (next key stream block or running MAC) for the next call.
+ *
+ * With AVX2 or AVX512 defined, the lanes use the 16 lane KASUMI code
+ * of kasumi_x16.h (key schedules kept in lane order in the args).
+ *
+ * The including file has to define:
+ * - CLEAR_SCRATCH_SIMD_REGS
+ * - SUBMIT_JOB_KASUMI_UEA1, FLUSH_JOB_KASUMI_UEA1
+ * - SUBMIT_JOB_KASUMI_UIA1, FLUSH_JOB_KASUMI_UIA1
+ */
+
+#ifndef KASUMI_OOO_COMMON_H
+#define KASUMI_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/kasumi_internal.h"
+#if defined(AVX512) || defined(AVX2)
+#include "include/kasumi_x16.h"
+#endif
+#include "include/clear_regs_mem.h"
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_KASUMI_UEA1(MB_MGR_KASUMI_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_KASUMI_UEA1(MB_MGR_KASUMI_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_KASUMI_UIA1(MB_MGR_KASUMI_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_KASUMI_UIA1(MB_MGR_KASUMI_OOO *state);
+
+/**
+ * @brief Puts a job into a free lane
+ *
+ * @param [in/out] state  KASUMI OOO manager (can't be full)
+ * @param [in] job        Job to put in the lane
+ * @param [in] len        Length of the job in bytes
+ *
+ * @return Lane index
+ */
+__forceinline
+unsigned
+kasumi_ooo_get_lane(MB_MGR_KASUMI_OOO *state, IMB_JOB *job,
+                    const uint32_t len)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = len;
+
+        return lane;
+}
+
+/**
+ * @brief Sets the key schedule of a lane
+ *
+ * @param [in/out] state  KASUMI OOO manager
+ * @param [in] lane       Lane of the job
+ * @param [in] keys       Key schedule of the job
+ */
+__forceinline
+void
+kasumi_ooo_set_keys(MB_MGR_KASUMI_OOO *state, const unsigned lane,
+                    const kasumi_key_sched_t *keys)
+{
+        state->args.keys[lane] = keys;
+#if defined(AVX512) || defined(AVX2)
+        {
+                unsigned i;
+
+                /* lane column of the 16 lane key schedules */
+                for (i = 0; i < KASUMI_KEY_SCHEDULE_SIZE; i++)
+                        state->args.sk16[i][lane] = keys->sk16[i];
+        }
+#endif
+}
+
+/**
+ * @brief Frees a lane and returns its job
+ *
+ * @param [in/out] state  KASUMI OOO manager
+ * @param [in] lane       Lane to free
+ *
+ * @return Job of the lane
+ */
+__forceinline
+IMB_JOB *
+kasumi_ooo_release(MB_MGR_KASUMI_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        /* clear key stream and modifier/MAC state of the lane */
+        state->args.blk[lane] = 0;
+        state->args.mod[lane] = 0;
+#if defined(AVX512) || defined(AVX2)
+        {
+                unsigned i;
+
+                for (i = 0; i < KASUMI_KEY_SCHEDULE_SIZE; i++)
+                        state->args.sk16[i][lane] = 0;
+        }
+#endif
+#endif
+        return job;
+}
+
+/**
+ * @brief Collects the used lanes of the manager
+ *
+ * @param [in] state      KASUMI OOO manager
+ * @param [out] lanes     Indexes of the used lanes
+ * @param [out] ctx       Key schedules (sk16) of the used lanes
+ * @param [out] blk       KASUMI input blocks, indexed by lane
+ *                        (zero for unused lanes)
+ * @param [out] data      Addresses of the blocks of the used lanes
+ * @param [out] min_idx   Position of the shortest lane in lanes
+ *
+ * @return Number of used lanes
+ */
+__forceinline
+unsigned
+kasumi_ooo_collect_lanes(const MB_MGR_KASUMI_OOO *state, uint8_t *lanes,
+                         const uint16_t **ctx, kasumi_union_t *blk,
+                         uint16_t **data, unsigned *min_idx)
+{
+        uint32_t min_len = UINT32_MAX;
+        unsigned lane, n = 0;
+
+        for (lane = 0; lane < KASUMI_OOO_NUM_LANES; lane++) {
+                if (state->job_in_lane[lane] == NULL) {
+                        blk[lane].b64[0] = 0;
+                        continue;
+                }
+                if (state->lens[lane] < min_len) {
+                        min_len = state->lens[lane];
+                        *min_idx = n;
+                }
+                lanes[n] = (uint8_t) lane;
+                ctx[n] = state->args.keys[lane]->sk16;
+                blk[lane].b64[0] = state->args.blk[lane];
+                data[n] = blk[lane].b16;
+                n++;
+        }
+
+        return n;
+}
+
+/**
+ * @brief Runs KASUMI on the blocks of the used lanes
+ *
+ * @param [in] state      KASUMI OOO manager
+ * @param [in] ctx        Key schedules (sk16) of the used lanes
+ * @param [in/out] blk    KASUMI blocks, indexed by lane
+ * @param [in] data       Addresses of the blocks of the used lanes
+ * @param [in] n          Number of used lanes
+ */
+__forceinline
+void
+kasumi_ooo_run_blocks(const MB_MGR_KASUMI_OOO *state,
+                      const uint16_t * const *ctx, kasumi_union_t *blk,
+                      uint16_t **data, const unsigned n)
+{
+#if defined(AVX512) || defined(AVX2)
+        if (n >= KASUMI_16_LANES_MIN) {
+                kasumi_16_blocks_multikey(state->args.sk16, blk);
+                return;
+        }
+#else
+        (void) state;
+        (void) blk;
+#endif
+        kasumi_n_blocks_multikey(ctx, data, n);
+}
+
+/**
+ * @brief Runs F8 on all used lanes and completes the shortest job
+ *
+ * @param [in/out] state  KASUMI-UEA1 OOO manager (can't be empty)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+kasumi_uea1_ooo_process(MB_MGR_KASUMI_OOO *state)
+{
+        const uint16_t *ctx[KASUMI_OOO_NUM_LANES];
+        uint16_t *data[KASUMI_OOO_NUM_LANES];
+        kasumi_union_t blk[KASUMI_OOO_NUM_LANES];
+        uint8_t lanes[KASUMI_OOO_NUM_LANES];
+        unsigned i, n, min_idx = 0, min_lane;
+        uint32_t num_blocks, len;
+        SafeBuf safeInBuf;
+        IMB_JOB *job;
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+        n = kasumi_ooo_collect_lanes(state, lanes, ctx, blk, data, &min_idx);
+        min_lane = lanes[min_idx];
+
+        /* all lanes run up to the last block of the shortest buffer */
+        num_blocks = (state->lens[min_lane] - 1) / KASUMI_BLOCK_SIZE;
+
+        while (num_blocks--) {
+                kasumi_ooo_run_blocks(state, ctx, blk, data, n);
+
+                for (i = 0; i < n; i++) {
+                        const unsigned lane = lanes[i];
+
+                        state->args.in[lane] =
+                                xor_keystrm_rev(state->args.out[lane],
+                                                state->args.in[lane],
+                                                blk[lane].b64[0]);
+                        state->args.out[lane] += KASUMI_BLOCK_SIZE;
+                        state->lens[lane] -= KASUMI_BLOCK_SIZE;
+
+                        /* apply the modifier and update the block count */
+                        blk[lane].b64[0] ^= state->args.mod[lane];
+                        blk[lane].b16[0] ^=
+                                (uint16_t)++state->args.blkcnt[lane];
+                }
+        }
+
+        for (i = 0; i < n; i++)
+                state->args.blk[lanes[i]] = blk[lanes[i]].b64[0];
+
+        /* last block (1 to 8 bytes) of the shortest buffer */
+        kasumi_1_block(ctx[min_idx], blk[min_lane].b16);
+        len = state->lens[min_lane];
+        if (len == KASUMI_BLOCK_SIZE) {
+                xor_keystrm_rev(state->args.out[min_lane],
+                                state->args.in[min_lane],
+                                blk[min_lane].b64[0]);
+        } else {
+                memcpy_keystrm(safeInBuf.b8, state->args.in[min_lane], len);
+                xor_keystrm_rev(blk[min_lane].b8, safeInBuf.b8,
+                                blk[min_lane].b64[0]);
+                memcpy_keystrm(state->args.out[min_lane], blk[min_lane].b8,
+                               len);
+        }
+        state->lens[min_lane] = 0;
+
+        job = kasumi_ooo_release(state, min_lane);
+        job->status |= STS_COMPLETED_AES;
+
+#ifdef SAFE_DATA
+        /* Clear sensitive data in stack */
+        clear_mem(blk, sizeof(blk));
+        clear_mem(&safeInBuf, sizeof(safeInBuf));
+#endif
+        return job;
+}
+
+/**
+ * @brief Runs F9 on all used lanes and completes the shortest job
+ *
+ * @param [in/out] state  KASUMI-UIA1 OOO manager (can't be empty)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+kasumi_uia1_ooo_process(MB_MGR_KASUMI_OOO *state)
+{
+        const uint16_t *ctx[KASUMI_OOO_NUM_LANES];
+        uint16_t *data[KASUMI_OOO_NUM_LANES];
+        kasumi_union_t blk[KASUMI_OOO_NUM_LANES];
+        uint8_t lanes[KASUMI_OOO_NUM_LANES];
+        unsigned i, n, min_idx = 0, min_lane;
+        uint32_t num_blocks, len;
+        kasumi_union_t b, mask;
+        SafeBuf safeBuf;
+        IMB_JOB *job;
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+        n = kasumi_ooo_collect_lanes(state, lanes, ctx, blk, data, &min_idx);
+        min_lane = lanes[min_idx];
+
+        /* all lanes run the full blocks of the shortest buffer */
+        num_blocks = state->lens[min_lane] / KASUMI_BLOCK_SIZE;
+
+        while (num_blocks--) {
+                for (i = 0; i < n; i++) {
+                        const unsigned lane = lanes[i];
+                        const uint64_t *pIn =
+                                (const uint64_t *) state->args.in[lane];
+
+                        blk[lane].b64[0] ^= BSWAP64(*pIn);
+                        state->args.in[lane] += KASUMI_BLOCK_SIZE;
+                        state->lens[lane] -= KASUMI_BLOCK_SIZE;
+                }
+
+                kasumi_ooo_run_blocks(state, ctx, blk, data, n);
+
+                for (i = 0; i < n; i++)
+                        state->args.mod[lanes[i]] ^= blk[lanes[i]].b64[0];
+        }
+
+        for (i = 0; i < n; i++)
+                state->args.blk[lanes[i]] = blk[lanes[i]].b64[0];
+
+        /* remaining bytes (0 to 7) of the shortest buffer */
+        b.b64[0] = state->args.mod[min_lane];
+        len = state->lens[min_lane];
+        if (len) {
+                mask.b64[0] = ~(UINT64_MAX >> (BYTESIZE * len));
+                safeBuf.b64 = 0;
+                memcpy(&safeBuf.b64, state->args.in[min_lane], len);
+                mask.b64[0] &= BSWAP64(safeBuf.b64);
+                blk[min_lane].b64[0] ^= mask.b64[0];
+
+                kasumi_1_block(ctx[min_idx], blk[min_lane].b16);
+
+                b.b64[0] ^= blk[min_lane].b64[0];
+        }
+        state->lens[min_lane] = 0;
+
+        /* Kasumi b */
+        kasumi_1_block(state->args.keys[min_lane]->msk16, b.b16);
+
+        job = kasumi_ooo_release(state, min_lane);
+
+        /* swap result */
+        *(uint32_t *)job->auth_tag_output = bswap4(b.b32[1]);
+        job->status |= STS_COMPLETED_HMAC;
+
+#ifdef SAFE_DATA
+        /* Clear sensitive data in stack */
+        clear_mem(blk, sizeof(blk));
+        clear_mem(&b, sizeof(b));
+        clear_mem(&mask, sizeof(mask));
+        clear_mem(&safeBuf, sizeof(safeBuf));
+#endif
+        return job;
+}
+
+/**
+ * @brief Submits a KASUMI-UEA1 job to the manager
+ *
+ * The modifier of the job is computed on submission.
+ *
+ * @param [in/out] state  KASUMI-UEA1 OOO manager
+ * @param [in] job        Job to submit (non-zero byte length, no bit offset)
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_KASUMI_UEA1(MB_MGR_KASUMI_OOO *state, IMB_JOB *job)
+{
+        const kasumi_key_sched_t *key = job->enc_keys;
+        const unsigned lane =
+                kasumi_ooo_get_lane(state, job, (uint32_t)
+                                    (job->msg_len_to_cipher_in_bits >> 3));
+        kasumi_union_t a;
+
+        kasumi_ooo_set_keys(state, lane, key);
+        state->args.in[lane] = job->src;
+        state->args.out[lane] = job->dst;
+
+        /* IV Endianity */
+        a.b64[0] = BSWAP64(*(const uint64_t *)job->iv);
+
+        /* First encryption to create modifier */
+        kasumi_1_block(key->msk16, a.b16);
+
+        state->args.mod[lane] = a.b64[0];
+        state->args.blk[lane] = a.b64[0];
+        state->args.blkcnt[lane] = 0;
+
+#ifdef SAFE_DATA
+        clear_mem(&a, sizeof(a));
+#endif
+        if (state->num_lanes_inuse < KASUMI_OOO_NUM_LANES)
+                return NULL;
+
+        return kasumi_uea1_ooo_process(state);
+}
+
+/**
+ * @brief Completes the shortest KASUMI-UEA1 job of the manager
+ *
+ * @param [in/out] state  KASUMI-UEA1 OOO manager
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_KASUMI_UEA1(MB_MGR_KASUMI_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return kasumi_uea1_ooo_process(state);
+}
+
+/**
+ * @brief Submits a KASUMI-UIA1 job to the manager
+ *
+ * @param [in/out] state  KASUMI-UIA1 OOO manager
+ * @param [in] job        Job to submit
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_KASUMI_UIA1(MB_MGR_KASUMI_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane =
+                kasumi_ooo_get_lane(state, job, (uint32_t)
+                                    job->msg_len_to_hash_in_bytes);
+
+        kasumi_ooo_set_keys(state, lane, (const kasumi_key_sched_t *)
+                            job->u.KASUMI_UIA1._key);
+        state->args.in[lane] = job->src + job->hash_start_src_offset_in_bytes;
+        state->args.blk[lane] = 0;
+        state->args.mod[lane] = 0;
+
+        if (state->num_lanes_inuse < KASUMI_OOO_NUM_LANES)
+                return NULL;
+
+        return kasumi_uia1_ooo_process(state);
+}
+
+/**
+ * @brief Completes the shortest KASUMI-UIA1 job of the manager
+ *
+ * @param [in/out] state  KASUMI-UIA1 OOO manager
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_KASUMI_UIA1(MB_MGR_KASUMI_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return kasumi_uia1_ooo_process(state);
+}
+
+#endif /* KASUMI_OOO_COMMON_H */
@@ -0,0 +1,676 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*---------------------------------------------------------------------
+* 16 lane KASUMI
+*
+* Up to 16 blocks, each one with its own key schedule, run the KASUMI
+* rounds together. A vector holds the same 16-bit word of all lanes
+* and the S7/S9 lookups are done for all lanes at once:
+* - AVX512: word permutes (vpermi2w) from the S-box tables in registers
+* - AVX2 and SAFE_LOOKUP: byte shuffles (vpshufb) from the S-box tables
+* - AVX2: gathers, 2 vectors of 8 lanes per word
+* The AVX512 and SAFE_LOOKUP versions don't use data dependent memory
+* accesses.
+*---------------------------------------------------------------------*/
+
+#ifndef _KASUMI_X16_H_
+#define _KASUMI_X16_H_
+
+#include "include/kasumi_internal.h"
+
+#if !defined(AVX512) && !defined(AVX2)
+#error "AVX512 or AVX2 has to be defined"
+#endif
+
+/* Minimum number of used lanes for the 16 lane code to be faster */
+#if defined(AVX512) || defined(SAFE_LOOKUP)
+#define KASUMI_16_LANES_MIN     1
+#else
+#define KASUMI_16_LANES_MIN     8
+#endif
+
+#ifdef AVX512
+
+typedef __m512i kasumi_16_lanes_t;
+
+typedef struct kasumi_16_lanes_sbox_s {
+        __m512i s7[4];
+        __m512i s9[16];
+} kasumi_16_lanes_sbox_t;
+
+__forceinline
+void
+kasumi_16_lanes_sbox_init(kasumi_16_lanes_sbox_t *sbox)
+{
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                sbox->s7[i] = _mm512_loadu_si512(&sso_kasumi_S7e[i * 32]);
+        for (i = 0; i < 16; i++)
+                sbox->s9[i] = _mm512_loadu_si512(&sso_kasumi_S9e[i * 32]);
+}
+
+__forceinline
+__m512i
+kasumi_16_lanes_xor(const __m512i a, const __m512i b)
+{
+        return _mm512_xor_si512(a, b);
+}
+
+__forceinline
+__m512i
+kasumi_16_lanes_key(const uint16_t sk16[][16], const unsigned i)
+{
+        return _mm512_castsi256_si512(_mm256_load_si256((const __m256i *)
+                                                        sk16[i]));
+}
+
+/* 16-bit left rotation by 1 */
+__forceinline
+__m512i
+kasumi_16_lanes_rol1(const __m512i a)
+{
+        return _mm512_or_si512(_mm512_slli_epi16(a, 1),
+                               _mm512_srli_epi16(a, 15));
+}
+
+/* S7e lookup, bits 0-6 of idx are used */
+__forceinline
+__m512i
+kasumi_16_lanes_s7(const kasumi_16_lanes_sbox_t *sbox, const __m512i idx)
+{
+        const __mmask32 k6 =
+                _mm512_test_epi16_mask(idx, _mm512_set1_epi16(0x40));
+
+        return _mm512_mask_blend_epi16(k6,
+                _mm512_permutex2var_epi16(sbox->s7[0], idx, sbox->s7[1]),
+                _mm512_permutex2var_epi16(sbox->s7[2], idx, sbox->s7[3]));
+}
+
+/* S9e lookup, bits 0-8 of idx are used */
+__forceinline
+__m512i
+kasumi_16_lanes_s9(const kasumi_16_lanes_sbox_t *sbox, const __m512i idx)
+{
+        const __mmask32 k6 =
+                _mm512_test_epi16_mask(idx, _mm512_set1_epi16(0x40));
+        const __mmask32 k7 =
+                _mm512_test_epi16_mask(idx, _mm512_set1_epi16(0x80));
+        const __mmask32 k8 =
+                _mm512_test_epi16_mask(idx, _mm512_set1_epi16(0x100));
+        __m512i t[8];
+        unsigned i;
+
+        /* 64 entries per permute, then select with bits 6, 7 and 8 */
+        for (i = 0; i < 8; i++)
+                t[i] = _mm512_permutex2var_epi16(sbox->s9[2 * i], idx,
+                                                 sbox->s9[2 * i + 1]);
+        for (i = 0; i < 8; i += 2)
+                t[i] = _mm512_mask_blend_epi16(k6, t[i], t[i + 1]);
+        for (i = 0; i < 8; i += 4)
+                t[i] = _mm512_mask_blend_epi16(k7, t[i], t[i + 2]);
+
+        return _mm512_mask_blend_epi16(k8, t[0], t[4]);
+}
+
+__forceinline
+__m512i
+kasumi_16_lanes_fi(const kasumi_16_lanes_sbox_t *sbox, __m512i data,
+                   const __m512i key1, const __m512i key2, const __m512i key3)
+{
+        data = _mm512_xor_si512(data, key1);
+        data = _mm512_ternarylogic_epi64(kasumi_16_lanes_s7(sbox, data),
+                                         kasumi_16_lanes_s9(sbox,
+                                                _mm512_srli_epi16(data, 7)),
+                                         key2, 0x96);
+        return _mm512_ternarylogic_epi64(kasumi_16_lanes_s7(sbox,
+                                                _mm512_srli_epi16(data, 9)),
+                                         kasumi_16_lanes_s9(sbox, data),
+                                         key3, 0x96);
+}
+
+__forceinline
+void
+kasumi_16_lanes_fl(__m512i *h, __m512i *l,
+                   const __m512i key1, const __m512i key2)
+{
+        __m512i r, t;
+
+        r = _mm512_and_si512(*l, key1);
+        r = _mm512_xor_si512(*h, kasumi_16_lanes_rol1(r));
+        t = _mm512_or_si512(r, key2);
+        *h = _mm512_xor_si512(*l, kasumi_16_lanes_rol1(t));
+        *l = r;
+}
+
+/* 16 blocks to 4 vectors, word i of all blocks in data[i] */
+__forceinline
+void
+kasumi_16_lanes_load(const kasumi_union_t *blocks, __m512i *data)
+{
+        const __m512i b0 = _mm512_loadu_si512(&blocks[0]);
+        const __m512i b1 = _mm512_loadu_si512(&blocks[8]);
+        const __m512i idx = _mm512_set_epi32(0, 0, 0, 0, 0, 0, 0, 0,
+                                             0x003c0038, 0x00340030,
+                                             0x002c0028, 0x00240020,
+                                             0x001c0018, 0x00140010,
+                                             0x000c0008, 0x00040000);
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                data[i] = _mm512_permutex2var_epi16(b0,
+                                _mm512_add_epi16(idx, _mm512_set1_epi16(i)),
+                                b1);
+}
+
+/* 4 vectors back to 16 blocks */
+__forceinline
+void
+kasumi_16_lanes_store(kasumi_union_t *blocks, const __m512i *data)
+{
+        /* words 0 and 1 of all blocks, then words 2 and 3 */
+        const __m512i d01 = _mm512_inserti64x4(data[0],
+                                               _mm512_castsi512_si256(data[1]),
+                                               1);
+        const __m512i d23 = _mm512_inserti64x4(data[2],
+                                               _mm512_castsi512_si256(data[3]),
+                                               1);
+        const __m512i idx = _mm512_set_epi32(0x00370027, 0x00170007,
+                                             0x00360026, 0x00160006,
+                                             0x00350025, 0x00150005,
+                                             0x00340024, 0x00140004,
+                                             0x00330023, 0x00130003,
+                                             0x00320022, 0x00120002,
+                                             0x00310021, 0x00110001,
+                                             0x00300020, 0x00100000);
+
+        _mm512_storeu_si512(&blocks[0],
+                            _mm512_permutex2var_epi16(d01, idx, d23));
+        _mm512_storeu_si512(&blocks[8],
+                            _mm512_permutex2var_epi16(d01,
+                                _mm512_add_epi16(idx, _mm512_set1_epi16(8)),
+                                d23));
+}
+
+#else /* AVX2 */
+
+/*
+ * 16 blocks to 4 vectors of 16-bit elements, word i of all blocks
+ * in data[i]
+ *
+ * in[j] holds blocks 2j, 2j + 1 (low 128 bits) and 8 + 2j, 9 + 2j,
+ * so that the unpacks keep the block order.
+ */
+__forceinline
+void
+kasumi_16_lanes_load_words(const kasumi_union_t *blocks, __m256i *data)
+{
+        /* dword i of each 128-bit lane: word i of the 2 blocks */
+        const __m256i shuf = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11,
+                                              4, 5, 12, 13, 6, 7, 14, 15,
+                                              0, 1, 8, 9, 2, 3, 10, 11,
+                                              4, 5, 12, 13, 6, 7, 14, 15);
+        __m256i in[4], lo01, hi01, lo23, hi23;
+        unsigned j;
+
+        for (j = 0; j < 4; j++) {
+                in[j] = _mm256_inserti128_si256(_mm256_castsi128_si256(
+                                _mm_loadu_si128((const __m128i *)
+                                                &blocks[2 * j])),
+                                _mm_loadu_si128((const __m128i *)
+                                                &blocks[8 + 2 * j]), 1);
+                in[j] = _mm256_shuffle_epi8(in[j], shuf);
+        }
+
+        lo01 = _mm256_unpacklo_epi32(in[0], in[1]);
+        hi01 = _mm256_unpackhi_epi32(in[0], in[1]);
+        lo23 = _mm256_unpacklo_epi32(in[2], in[3]);
+        hi23 = _mm256_unpackhi_epi32(in[2], in[3]);
+
+        data[0] = _mm256_unpacklo_epi64(lo01, lo23);
+        data[1] = _mm256_unpackhi_epi64(lo01, lo23);
+        data[2] = _mm256_unpacklo_epi64(hi01, hi23);
+        data[3] = _mm256_unpackhi_epi64(hi01, hi23);
+}
+
+/* 4 vectors of 16-bit elements back to 16 blocks */
+__forceinline
+void
+kasumi_16_lanes_store_words(kasumi_union_t *blocks, const __m256i *data)
+{
+        const __m256i shuf = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13,
+                                              2, 3, 6, 7, 10, 11, 14, 15,
+                                              0, 1, 4, 5, 8, 9, 12, 13,
+                                              2, 3, 6, 7, 10, 11, 14, 15);
+        __m256i lo[2], hi[2];
+        unsigned j;
+
+        /* reverse the 64-bit unpacks, swap the middle dwords */
+        for (j = 0; j < 2; j++) {
+                lo[j] = _mm256_shuffle_epi32(
+                        j ? _mm256_unpackhi_epi64(data[0], data[1]) :
+                        _mm256_unpacklo_epi64(data[0], data[1]), 0xD8);
+                hi[j] = _mm256_shuffle_epi32(
+                        j ? _mm256_unpackhi_epi64(data[2], data[3]) :
+                        _mm256_unpacklo_epi64(data[2], data[3]), 0xD8);
+        }
+
+        for (j = 0; j < 4; j++) {
+                __m256i out = (j & 1) ?
+                        _mm256_unpackhi_epi64(lo[j >> 1], hi[j >> 1]) :
+                        _mm256_unpacklo_epi64(lo[j >> 1], hi[j >> 1]);
+
+                out = _mm256_shuffle_epi8(out, shuf);
+                _mm_storeu_si128((__m128i *) &blocks[2 * j],
+                                 _mm256_castsi256_si128(out));
+                _mm_storeu_si128((__m128i *) &blocks[8 + 2 * j],
+                                 _mm256_extracti128_si256(out, 1));
+        }
+}
+
+#ifdef SAFE_LOOKUP
+
+typedef __m256i kasumi_16_lanes_t;
+
+/*
+ * S-box tables split in chunks of 16 entries, low and high bytes
+ * in separate vectors (same 16 bytes in both 128-bit lanes)
+ */
+typedef struct kasumi_16_lanes_sbox_s {
+        __m256i s7_lo[8];
+        __m256i s7_hi[8];
+        __m256i s9_lo[32];
+        __m256i s9_hi[32];
+} kasumi_16_lanes_sbox_t;
+
+__forceinline
+void
+kasumi_16_lanes_split_table(const uint16_t *table, const unsigned num_chunks,
+                            __m256i *lo, __m256i *hi)
+{
+        const __m256i shuf = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                              1, 3, 5, 7, 9, 11, 13, 15,
+                                              0, 2, 4, 6, 8, 10, 12, 14,
+                                              1, 3, 5, 7, 9, 11, 13, 15);
+        unsigned i;
+
+        for (i = 0; i < num_chunks; i++) {
+                __m256i t = _mm256_loadu_si256((const __m256i *)
+                                               &table[i * 16]);
+
+                /* low bytes to qwords 0 and 2, high bytes to 1 and 3 */
+                t = _mm256_shuffle_epi8(t, shuf);
+                t = _mm256_permute4x64_epi64(t, 0xD8);
+                lo[i] = _mm256_permute2x128_si256(t, t, 0x00);
+                hi[i] = _mm256_permute2x128_si256(t, t, 0x11);
+        }
+}
+
+__forceinline
+void
+kasumi_16_lanes_sbox_init(kasumi_16_lanes_sbox_t *sbox)
+{
+        kasumi_16_lanes_split_table(sso_kasumi_S7e, 8,
+                                    sbox->s7_lo, sbox->s7_hi);
+        kasumi_16_lanes_split_table(sso_kasumi_S9e, 32,
+                                    sbox->s9_lo, sbox->s9_hi);
+}
+
+__forceinline
+__m256i
+kasumi_16_lanes_xor(const __m256i a, const __m256i b)
+{
+        return _mm256_xor_si256(a, b);
+}
+
+__forceinline
+__m256i
+kasumi_16_lanes_key(const uint16_t sk16[][16], const unsigned i)
+{
+        return _mm256_load_si256((const __m256i *) sk16[i]);
+}
+
+/* 16-bit left rotation by 1 */
+__forceinline
+__m256i
+kasumi_16_lanes_rol1(const __m256i a)
+{
+        return _mm256_or_si256(_mm256_slli_epi16(a, 1),
+                               _mm256_srli_epi16(a, 15));
+}
+
+/*
+ * Table lookup going through all chunks of the table,
+ * idx can't have bits set above the table size
+ */
+__forceinline
+__m256i
+kasumi_16_lanes_lookup(const __m256i *lo, const __m256i *hi,
+                       const unsigned num_chunks, const __m256i idx)
+{
+        const __m256i low4 = _mm256_and_si256(idx, _mm256_set1_epi16(0xf));
+        /* 0x80 in the other byte zeroes it in the shuffle result */
+        const __m256i idx_lo =
+                _mm256_or_si256(low4, _mm256_set1_epi16((short) 0x8000));
+        const __m256i idx_hi =
+                _mm256_or_si256(_mm256_slli_epi16(low4, 8),
+                                _mm256_set1_epi16(0x0080));
+        const __m256i chunk = _mm256_srli_epi16(idx, 4);
+        __m256i i_vec = _mm256_setzero_si256();
+        __m256i res = _mm256_setzero_si256();
+        unsigned i;
+
+        for (i = 0; i < num_chunks; i++) {
+                const __m256i t =
+                        _mm256_or_si256(_mm256_shuffle_epi8(lo[i], idx_lo),
+                                        _mm256_shuffle_epi8(hi[i], idx_hi));
+
+                res = _mm256_or_si256(res,
+                                      _mm256_and_si256(t,
+                                        _mm256_cmpeq_epi16(chunk, i_vec)));
+                i_vec = _mm256_add_epi16(i_vec, _mm256_set1_epi16(1));
+        }
+
+        return res;
+}
+
+__forceinline
+__m256i
+kasumi_16_lanes_fi(const kasumi_16_lanes_sbox_t *sbox, __m256i data,
+                   const __m256i key1, const __m256i key2, const __m256i key3)
+{
+        const __m256i mask7 = _mm256_set1_epi16(0x7f);
+        const __m256i mask9 = _mm256_set1_epi16(0x1ff);
+        __m256i s7, s9;
+
+        data = _mm256_xor_si256(data, key1);
+        s7 = kasumi_16_lanes_lookup(sbox->s7_lo, sbox->s7_hi, 8,
+                                    _mm256_and_si256(data, mask7));
+        s9 = kasumi_16_lanes_lookup(sbox->s9_lo, sbox->s9_hi, 32,
+                                    _mm256_srli_epi16(data, 7));
+        data = _mm256_xor_si256(_mm256_xor_si256(s7, s9), key2);
+        s7 = kasumi_16_lanes_lookup(sbox->s7_lo, sbox->s7_hi, 8,
+                                    _mm256_srli_epi16(data, 9));
+        s9 = kasumi_16_lanes_lookup(sbox->s9_lo, sbox->s9_hi, 32,
+                                    _mm256_and_si256(data, mask9));
+        return _mm256_xor_si256(_mm256_xor_si256(s7, s9), key3);
+}
+
+__forceinline
+void
+kasumi_16_lanes_fl(__m256i *h, __m256i *l,
+                   const __m256i key1, const __m256i key2)
+{
+        __m256i r, t;
+
+        r = _mm256_and_si256(*l, key1);
+        r = _mm256_xor_si256(*h, kasumi_16_lanes_rol1(r));
+        t = _mm256_or_si256(r, key2);
+        *h = _mm256_xor_si256(*l, kasumi_16_lanes_rol1(t));
+        *l = r;
+}
+
+__forceinline
+void
+kasumi_16_lanes_load(const kasumi_union_t *blocks, __m256i *data)
+{
+        kasumi_16_lanes_load_words(blocks, data);
+}
+
+__forceinline
+void
+kasumi_16_lanes_store(kasumi_union_t *blocks, const __m256i *data)
+{
+        kasumi_16_lanes_store_words(blocks, data);
+}
+
+#else /* SAFE_LOOKUP */
+
+/* lanes 0-7 and 8-15 in 32-bit elements */
+typedef struct kasumi_16_lanes_s {
+        __m256i v[2];
+} kasumi_16_lanes_t;
+
+/* gathers read the tables directly */
+typedef struct kasumi_16_lanes_sbox_s {
+        const uint16_t *s7;
+        const uint16_t *s9;
+} kasumi_16_lanes_sbox_t;
+
+__forceinline
+void
+kasumi_16_lanes_sbox_init(kasumi_16_lanes_sbox_t *sbox)
+{
+        sbox->s7 = sso_kasumi_S7e;
+        sbox->s9 = sso_kasumi_S9e;
+}
+
+__forceinline
+kasumi_16_lanes_t
+kasumi_16_lanes_xor(const kasumi_16_lanes_t a, const kasumi_16_lanes_t b)
+{
+        kasumi_16_lanes_t r;
+
+        r.v[0] = _mm256_xor_si256(a.v[0], b.v[0]);
+        r.v[1] = _mm256_xor_si256(a.v[1], b.v[1]);
+        return r;
+}
+
+__forceinline
+kasumi_16_lanes_t
+kasumi_16_lanes_key(const uint16_t sk16[][16], const unsigned i)
+{
+        kasumi_16_lanes_t r;
+
+        r.v[0] = _mm256_cvtepu16_epi32(_mm_load_si128((const __m128i *)
+                                                      &sk16[i][0]));
+        r.v[1] = _mm256_cvtepu16_epi32(_mm_load_si128((const __m128i *)
+                                                      &sk16[i][8]));
+        return r;
+}
+
+/* 16-bit left rotation by 1 */
+__forceinline
+__m256i
+kasumi_16_lanes_rol1(const __m256i a)
+{
+        return _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi32(a, 1),
+                                                _mm256_srli_epi32(a, 15)),
+                                _mm256_set1_epi32(0xffff));
+}
+
+/*
+ * Table lookup, gathers the dword with the entry
+ * (not beyond the end of the table) and shifts the entry down.
+ * Bits 16-31 of the result are not cleared.
+ */
+__forceinline
+__m256i
+kasumi_16_lanes_lookup(const uint16_t *table, const __m256i idx)
+{
+        const __m256i t = _mm256_i32gather_epi32((const int *) table,
+                                                 _mm256_srli_epi32(idx, 1), 4);
+
+        return _mm256_srlv_epi32(t, _mm256_and_si256(_mm256_slli_epi32(idx, 4),
+                                                     _mm256_set1_epi32(16)));
+}
+
+__forceinline
+kasumi_16_lanes_t
+kasumi_16_lanes_fi(const kasumi_16_lanes_sbox_t *sbox, kasumi_16_lanes_t data,
+                   const kasumi_16_lanes_t key1, const kasumi_16_lanes_t key2,
+                   const kasumi_16_lanes_t key3)
+{
+        const __m256i mask7 = _mm256_set1_epi32(0x7f);
+        const __m256i mask9 = _mm256_set1_epi32(0x1ff);
+        const __m256i mask16 = _mm256_set1_epi32(0xffff);
+        unsigned i;
+
+        for (i = 0; i < 2; i++) {
+                __m256i d = _mm256_xor_si256(data.v[i], key1.v[i]);
+                __m256i s7, s9;
+
+                s7 = kasumi_16_lanes_lookup(sbox->s7,
+                                            _mm256_and_si256(d, mask7));
+                s9 = kasumi_16_lanes_lookup(sbox->s9,
+                                            _mm256_srli_epi32(d, 7));
+                d = _mm256_xor_si256(_mm256_xor_si256(s7, s9), key2.v[i]);
+                d = _mm256_and_si256(d, mask16);
+                s7 = kasumi_16_lanes_lookup(sbox->s7,
+                                            _mm256_srli_epi32(d, 9));
+                s9 = kasumi_16_lanes_lookup(sbox->s9,
+                                            _mm256_and_si256(d, mask9));
+                d = _mm256_xor_si256(_mm256_xor_si256(s7, s9), key3.v[i]);
+                data.v[i] = _mm256_and_si256(d, mask16);
+        }
+
+        return data;
+}
+
+__forceinline
+void
+kasumi_16_lanes_fl(kasumi_16_lanes_t *h, kasumi_16_lanes_t *l,
+                   const kasumi_16_lanes_t key1, const kasumi_16_lanes_t key2)
+{
+        unsigned i;
+
+        for (i = 0; i < 2; i++) {
+                __m256i r, t;
+
+                r = _mm256_and_si256(l->v[i], key1.v[i]);
+                r = _mm256_xor_si256(h->v[i], kasumi_16_lanes_rol1(r));
+                t = _mm256_or_si256(r, key2.v[i]);
+                h->v[i] = _mm256_xor_si256(l->v[i], kasumi_16_lanes_rol1(t));
+                l->v[i] = r;
+        }
+}
+
+/* 16 blocks to 4 vectors, word i of all blocks in data[i] */
+__forceinline
+void
+kasumi_16_lanes_load(const kasumi_union_t *blocks, kasumi_16_lanes_t *data)
+{
+        __m256i words[4];
+        unsigned i;
+
+        kasumi_16_lanes_load_words(blocks, words);
+        for (i = 0; i < 4; i++) {
+                data[i].v[0] = _mm256_cvtepu16_epi32(
+                                        _mm256_castsi256_si128(words[i]));
+                data[i].v[1] = _mm256_cvtepu16_epi32(
+                                        _mm256_extracti128_si256(words[i], 1));
+        }
+}
+
+/* 4 vectors back to 16 blocks */
+__forceinline
+void
+kasumi_16_lanes_store(kasumi_union_t *blocks, const kasumi_16_lanes_t *data)
+{
+        __m256i words[4];
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                words[i] = _mm256_permute4x64_epi64(
+                                _mm256_packus_epi32(data[i].v[0],
+                                                    data[i].v[1]), 0xD8);
+        kasumi_16_lanes_store_words(blocks, words);
+}
+
+#endif /* SAFE_LOOKUP */
+#endif /* AVX512 */
+
+/**
+ ******************************************************************************
+ * @description
+ * This function performs the Kasumi operation on 16 blocks,
+ * block i using the key schedule of lane i
+ *
+ * @param[in]       sk16        Key schedules, sk16[n][i] is the n-th
+ *                              subkey of lane i
+ * @param[in/out]   blocks      Array of 16 blocks to be enc/dec
+ *
+ ******************************************************************************/
+static inline void
+kasumi_16_blocks_multikey(const uint16_t sk16[][16], kasumi_union_t *blocks)
+{
+        kasumi_16_lanes_sbox_t sbox;
+        kasumi_16_lanes_t data[4];
+        kasumi_16_lanes_t temp_l, temp_h;
+        unsigned i;
+
+        kasumi_16_lanes_sbox_init(&sbox);
+        kasumi_16_lanes_load(blocks, data);
+
+        /* 4 iterations odd/even, as in kasumi_1_block() */
+        for (i = 0; i < KASUMI_KEY_SCHEDULE_SIZE; i += 16) {
+                temp_l = data[3];
+                temp_h = data[2];
+                kasumi_16_lanes_fl(&temp_h, &temp_l,
+                                   kasumi_16_lanes_key(sk16, i + 0),
+                                   kasumi_16_lanes_key(sk16, i + 1));
+                temp_h = kasumi_16_lanes_fi(&sbox, temp_h,
+                                            kasumi_16_lanes_key(sk16, i + 2),
+                                            kasumi_16_lanes_key(sk16, i + 3),
+                                            temp_l);
+                temp_l = kasumi_16_lanes_fi(&sbox, temp_l,
+                                            kasumi_16_lanes_key(sk16, i + 4),
+                                            kasumi_16_lanes_key(sk16, i + 5),
+                                            temp_h);
+                temp_h = kasumi_16_lanes_fi(&sbox, temp_h,
+                                            kasumi_16_lanes_key(sk16, i + 6),
+                                            kasumi_16_lanes_key(sk16, i + 7),
+                                            temp_l);
+                data[1] = kasumi_16_lanes_xor(data[1], temp_l);
+                data[0] = kasumi_16_lanes_xor(data[0], temp_h);
+
+                temp_h = data[1];
+                temp_l = data[0];
+                temp_h = kasumi_16_lanes_fi(&sbox, temp_h,
+                                            kasumi_16_lanes_key(sk16, i + 10),
+                                            kasumi_16_lanes_key(sk16, i + 11),
+                                            temp_l);
+                temp_l = kasumi_16_lanes_fi(&sbox, temp_l,
+                                            kasumi_16_lanes_key(sk16, i + 12),
+                                            kasumi_16_lanes_key(sk16, i + 13),
+                                            temp_h);
+                temp_h = kasumi_16_lanes_fi(&sbox, temp_h,
+                                            kasumi_16_lanes_key(sk16, i + 14),
+                                            kasumi_16_lanes_key(sk16, i + 15),
+                                            temp_l);
+                kasumi_16_lanes_fl(&temp_h, &temp_l,
+                                   kasumi_16_lanes_key(sk16, i + 8),
+                                   kasumi_16_lanes_key(sk16, i + 9));
+                data[3] = kasumi_16_lanes_xor(data[3], temp_h);
+                data[2] = kasumi_16_lanes_xor(data[2], temp_l);
+        }
+
+        kasumi_16_lanes_store(blocks, data);
+}
+
+#endif /* _KASUMI_X16_H_ */
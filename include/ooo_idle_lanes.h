@@ -0,0 +1,90 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * Idle lanes of the out-of-order managers written in C.
+ *
+ * Idle lanes have length OOO_IDLE_LANE_LEN, so they are never
+ * selected as the shortest lane. On flush, they are pointed at the data
+ * of a busy lane and run along with it, their results are not used.
+ * Whenever that lane switches to another buffer (final, extra or
+ * outer block), idle lanes have to follow it, otherwise they keep
+ * reading past the end of the message they were pointed at.
+ */
+
+#ifndef OOO_IDLE_LANES_H
+#define OOO_IDLE_LANES_H
+
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+
+#define OOO_IDLE_LANE_LEN 0xFFFF
+
+/**
+ * @brief Finds the first busy lane
+ *
+ * The manager must not be empty.
+ *
+ * @param [in] lens       Lane lengths
+ *
+ * @return Index of the first lane with a job
+ */
+__forceinline
+unsigned
+ooo_busy_lane(const uint16_t *lens)
+{
+        unsigned lane = 0;
+
+        while (lens[lane] == OOO_IDLE_LANE_LEN)
+                lane++;
+
+        return lane;
+}
+
+/**
+ * @brief Points idle lanes at the data of \a lane
+ *
+ * @param [in/out] ptrs   Data pointers of all lanes
+ * @param [in] lens       Lane lengths
+ * @param [in] num_lanes  Number of lanes
+ * @param [in] lane       Busy lane to copy from
+ */
+__forceinline
+void
+ooo_idle_lanes_follow(const uint8_t **ptrs, const uint16_t *lens,
+                      const unsigned num_lanes, const unsigned lane)
+{
+        unsigned i;
+
+        for (i = 0; i < num_lanes; i++)
+                if (lens[i] == OOO_IDLE_LANE_LEN)
+                        ptrs[i] = ptrs[lane];
+}
+
+#endif /* OOO_IDLE_LANES_H */
@@ -0,0 +1,424 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * Multi-buffer SHA-1/224/256/384/512 (plain digest) out-of-order managers.
+ *
+ * Jobs are put in the lanes of the multi-buffer SHA kernels used by
+ * the HMAC managers (e.g. sha1_x8_avx2), called through their ABI
+ * compliant call_*_from_c entry points. Message blocks are read in place
+ * and the padded last block(s) are prepared in the lane extra_block.
+ * Once all lanes are used (or on flush), the kernel runs all lanes up to
+ * the shortest one, which is then either switched to its extra blocks
+ * or completed. Unlike HMAC, there is no outer hash pass.
+ *
+ * Lane lengths are 16-bit block counts, longer messages are hashed
+ * with the single buffer code on submit.
+ *
+ * The including file has to define:
+ * - SUBMIT_JOB_SHA1, FLUSH_JOB_SHA1 ... SUBMIT_JOB_SHA512, FLUSH_JOB_SHA512
+ * - SHA1_MB_KERNEL, SHA256_MB_KERNEL, SHA512_MB_KERNEL
+ * - SHA1_NUM_LANES, SHA256_NUM_LANES, SHA512_NUM_LANES
+ * - SHA1_ONE_BUFFER ... SHA512_ONE_BUFFER
+ */
+
+#ifndef SHA_OOO_COMMON_H
+#define SHA_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "constants.h"
+#include "include/wireless_common.h"
+#include "include/ooo_idle_lanes.h"
+
+/* lens value of a lane without a job */
+#define SHA_OOO_UNUSED_LEN OOO_IDLE_LANE_LEN
+
+void SHA1_MB_KERNEL(SHA1_ARGS *args, uint64_t num_blocks);
+void SHA256_MB_KERNEL(SHA256_ARGS *args, uint64_t num_blocks);
+void SHA512_MB_KERNEL(SHA512_ARGS *args, uint64_t num_blocks);
+
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA1(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA1(MB_MGR_SHA_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA224(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA224(MB_MGR_SHA_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA256(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA256(MB_MGR_SHA_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA384(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA384(MB_MGR_SHA_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA512(MB_MGR_SHA_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA512(MB_MGR_SHA_OOO *state);
+
+static const uint32_t sha1_ooo_iv[NUM_SHA_DIGEST_WORDS] = {
+        H0, H1, H2, H3, H4
+};
+
+static const uint32_t sha224_ooo_iv[NUM_SHA_256_DIGEST_WORDS] = {
+        SHA224_H0, SHA224_H1, SHA224_H2, SHA224_H3,
+        SHA224_H4, SHA224_H5, SHA224_H6, SHA224_H7
+};
+
+static const uint32_t sha256_ooo_iv[NUM_SHA_256_DIGEST_WORDS] = {
+        SHA256_H0, SHA256_H1, SHA256_H2, SHA256_H3,
+        SHA256_H4, SHA256_H5, SHA256_H6, SHA256_H7
+};
+
+static const uint64_t sha384_ooo_iv[NUM_SHA_512_DIGEST_WORDS] = {
+        SHA384_H0, SHA384_H1, SHA384_H2, SHA384_H3,
+        SHA384_H4, SHA384_H5, SHA384_H6, SHA384_H7
+};
+
+static const uint64_t sha512_ooo_iv[NUM_SHA_512_DIGEST_WORDS] = {
+        SHA512_H0, SHA512_H1, SHA512_H2, SHA512_H3,
+        SHA512_H4, SHA512_H5, SHA512_H6, SHA512_H7
+};
+
+__forceinline
+unsigned sha_ooo_num_lanes(const int sha_type)
+{
+        if (sha_type == 1)
+                return SHA1_NUM_LANES;
+        if (sha_type == 224 || sha_type == 256)
+                return SHA256_NUM_LANES;
+        return SHA512_NUM_LANES;
+}
+
+__forceinline
+uint64_t sha_ooo_block_size(const int sha_type)
+{
+        return (sha_type == 384 || sha_type == 512) ?
+                SHA_512_BLOCK_SIZE : SHA1_BLOCK_SIZE;
+}
+
+__forceinline
+const uint8_t **sha_ooo_data_ptr(MB_MGR_SHA_OOO *state, const int sha_type)
+{
+        if (sha_type == 1)
+                return state->args.sha1.data_ptr;
+        if (sha_type == 224 || sha_type == 256)
+                return state->args.sha256.data_ptr;
+        return state->args.sha512.data_ptr;
+}
+
+/**
+ * @brief Sets the initial digest of a lane
+ *
+ * Digest words are kept transposed (word row, lane column).
+ */
+__forceinline
+void sha_ooo_init_digest(MB_MGR_SHA_OOO *state, const unsigned lane,
+                         const int sha_type)
+{
+        unsigned i;
+
+        if (sha_type == 1) {
+                for (i = 0; i < NUM_SHA_DIGEST_WORDS; i++)
+                        state->args.sha1.digest[i * AVX512_NUM_SHA1_LANES +
+                                                lane] = sha1_ooo_iv[i];
+        } else if (sha_type == 224 || sha_type == 256) {
+                const uint32_t *iv = (sha_type == 224) ?
+                        sha224_ooo_iv : sha256_ooo_iv;
+
+                for (i = 0; i < NUM_SHA_256_DIGEST_WORDS; i++)
+                        state->args.sha256.digest[i * AVX512_NUM_SHA256_LANES +
+                                                  lane] = iv[i];
+        } else {
+                const uint64_t *iv = (sha_type == 384) ?
+                        sha384_ooo_iv : sha512_ooo_iv;
+
+                for (i = 0; i < NUM_SHA_512_DIGEST_WORDS; i++)
+                        state->args.sha512.digest[i * AVX512_NUM_SHA512_LANES +
+                                                  lane] = iv[i];
+        }
+}
+
+/**
+ * @brief Writes the digest of a lane out (big endian)
+ */
+__forceinline
+void sha_ooo_write_digest(MB_MGR_SHA_OOO *state, const unsigned lane,
+                          void *out, const int sha_type)
+{
+        unsigned i;
+
+        if (sha_type == 1) {
+                uint32_t *d = &state->args.sha1.digest[lane];
+                uint32_t *o = (uint32_t *) out;
+
+                for (i = 0; i < NUM_SHA_DIGEST_WORDS; i++) {
+                        o[i] = BSWAP32(d[i * AVX512_NUM_SHA1_LANES]);
+#ifdef SAFE_DATA
+                        d[i * AVX512_NUM_SHA1_LANES] = 0;
+#endif
+                }
+        } else if (sha_type == 224 || sha_type == 256) {
+                const unsigned n = (sha_type == 224) ?
+                        NUM_SHA_224_DIGEST_WORDS : NUM_SHA_256_DIGEST_WORDS;
+                uint32_t *d = &state->args.sha256.digest[lane];
+                uint32_t *o = (uint32_t *) out;
+
+                for (i = 0; i < n; i++)
+                        o[i] = BSWAP32(d[i * AVX512_NUM_SHA256_LANES]);
+#ifdef SAFE_DATA
+                for (i = 0; i < NUM_SHA_256_DIGEST_WORDS; i++)
+                        d[i * AVX512_NUM_SHA256_LANES] = 0;
+#endif
+        } else {
+                const unsigned n = (sha_type == 384) ?
+                        NUM_SHA_384_DIGEST_WORDS : NUM_SHA_512_DIGEST_WORDS;
+                uint64_t *d = &state->args.sha512.digest[lane];
+                uint64_t *o = (uint64_t *) out;
+
+                for (i = 0; i < n; i++)
+                        o[i] = BSWAP64(d[i * AVX512_NUM_SHA512_LANES]);
+#ifdef SAFE_DATA
+                for (i = 0; i < NUM_SHA_512_DIGEST_WORDS; i++)
+                        d[i * AVX512_NUM_SHA512_LANES] = 0;
+#endif
+        }
+}
+
+/**
+ * @brief Runs all lanes up to the shortest one
+ *
+ * @return Index of the shortest lane (its length is now 0)
+ */
+__forceinline
+unsigned sha_ooo_run(MB_MGR_SHA_OOO *state, const int sha_type)
+{
+        const unsigned num_lanes = sha_ooo_num_lanes(sha_type);
+        uint16_t min_len = SHA_OOO_UNUSED_LEN;
+        unsigned i, lane = 0;
+
+        for (i = 0; i < num_lanes; i++)
+                if (state->lens[i] < min_len) {
+                        min_len = state->lens[i];
+                        lane = i;
+                }
+
+        if (min_len == 0)
+                return lane;
+
+        if (sha_type == 1)
+                SHA1_MB_KERNEL(&state->args.sha1, min_len);
+        else if (sha_type == 224 || sha_type == 256)
+                SHA256_MB_KERNEL(&state->args.sha256, min_len);
+        else
+                SHA512_MB_KERNEL(&state->args.sha512, min_len);
+
+        for (i = 0; i < num_lanes; i++)
+                if (state->lens[i] != SHA_OOO_UNUSED_LEN)
+                        state->lens[i] -= min_len;
+
+        return lane;
+}
+
+/**
+ * @brief Runs the lanes until one of the jobs is complete and returns it
+ */
+__forceinline
+IMB_JOB *sha_ooo_process(MB_MGR_SHA_OOO *state, const int sha_type)
+{
+        const uint8_t **data_ptr = sha_ooo_data_ptr(state, sha_type);
+        SHA_LANE_DATA *ld;
+        unsigned lane;
+        IMB_JOB *job;
+
+        while (1) {
+                lane = sha_ooo_run(state, sha_type);
+                ld = &state->ldata[lane];
+                if (ld->extra_blocks == 0)
+                        break;
+
+                /* message blocks done, hash the padded last block(s) */
+                state->lens[lane] = (uint16_t) ld->extra_blocks;
+                data_ptr[lane] = ld->extra_block;
+                ld->extra_blocks = 0;
+                ooo_idle_lanes_follow(data_ptr, state->lens,
+                                      sha_ooo_num_lanes(sha_type), lane);
+        }
+
+        job = ld->job_in_lane;
+        sha_ooo_write_digest(state, lane, job->auth_tag_output, sha_type);
+
+        /* release the lane */
+        state->lens[lane] = SHA_OOO_UNUSED_LEN;
+        ld->job_in_lane = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+#ifdef SAFE_DATA
+        memset(ld->extra_block, 0, sizeof(ld->extra_block));
+#endif
+
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+__forceinline
+void sha_ooo_one_buffer(IMB_JOB *job, const int sha_type)
+{
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+
+        if (sha_type == 1)
+                SHA1_ONE_BUFFER(p, len, job->auth_tag_output);
+        else if (sha_type == 224)
+                SHA224_ONE_BUFFER(p, len, job->auth_tag_output);
+        else if (sha_type == 256)
+                SHA256_ONE_BUFFER(p, len, job->auth_tag_output);
+        else if (sha_type == 384)
+                SHA384_ONE_BUFFER(p, len, job->auth_tag_output);
+        else
+                SHA512_ONE_BUFFER(p, len, job->auth_tag_output);
+}
+
+__forceinline
+IMB_JOB *sha_ooo_submit(MB_MGR_SHA_OOO *state, IMB_JOB *job,
+                        const int sha_type)
+{
+        const uint64_t blk_size = sha_ooo_block_size(sha_type);
+        const uint64_t pad_size = (blk_size == SHA_512_BLOCK_SIZE) ?
+                SHA512_PAD_SIZE : SHA1_PAD_SIZE;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint64_t num_blocks = len / blk_size;
+        const uint64_t r = len % blk_size;
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        const uint8_t **data_ptr = sha_ooo_data_ptr(state, sha_type);
+        uint32_t extra_blocks;
+        uint64_t bit_len;
+        SHA_LANE_DATA *ld;
+        unsigned lane;
+
+        if (num_blocks >= SHA_OOO_UNUSED_LEN) {
+                /* too long for a lane */
+                sha_ooo_one_buffer(job, sha_type);
+                job->status |= STS_COMPLETED_HMAC;
+                return job;
+        }
+
+        lane = (unsigned) (state->unused_lanes & 0xF);
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        ld = &state->ldata[lane];
+        ld->job_in_lane = job;
+        sha_ooo_init_digest(state, lane, sha_type);
+
+        /* padding: 0x80, zeros and message length in bits (big endian) */
+        extra_blocks = (r + 1 + pad_size > blk_size) ? 2 : 1;
+        memset(ld->extra_block, 0, extra_blocks * blk_size);
+        memcpy(ld->extra_block, &p[len - r], r);
+        ld->extra_block[r] = 0x80;
+        bit_len = BSWAP64(len * 8);
+        memcpy(&ld->extra_block[extra_blocks * blk_size - 8], &bit_len, 8);
+
+        if (num_blocks != 0) {
+                data_ptr[lane] = p;
+                state->lens[lane] = (uint16_t) num_blocks;
+                ld->extra_blocks = extra_blocks;
+        } else {
+                data_ptr[lane] = ld->extra_block;
+                state->lens[lane] = (uint16_t) extra_blocks;
+                ld->extra_blocks = 0;
+        }
+
+        if (state->num_lanes_inuse < sha_ooo_num_lanes(sha_type))
+                return NULL;
+
+        return sha_ooo_process(state, sha_type);
+}
+
+__forceinline
+IMB_JOB *sha_ooo_flush(MB_MGR_SHA_OOO *state, const int sha_type)
+{
+        const uint8_t **data_ptr = sha_ooo_data_ptr(state, sha_type);
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        /* empty lanes hash the data of a valid lane, their result is unused */
+        ooo_idle_lanes_follow(data_ptr, state->lens,
+                              sha_ooo_num_lanes(sha_type),
+                              ooo_busy_lane(state->lens));
+
+        return sha_ooo_process(state, sha_type);
+}
+
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA1(MB_MGR_SHA_OOO *state, IMB_JOB *job)
+{
+        return sha_ooo_submit(state, job, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA1(MB_MGR_SHA_OOO *state)
+{
+        return sha_ooo_flush(state, 1);
+}
+
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA224(MB_MGR_SHA_OOO *state, IMB_JOB *job)
+{
+        return sha_ooo_submit(state, job, 224);
+}
+
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA224(MB_MGR_SHA_OOO *state)
+{
+        return sha_ooo_flush(state, 224);
+}
+
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA256(MB_MGR_SHA_OOO *state, IMB_JOB *job)
+{
+        return sha_ooo_submit(state, job, 256);
+}
+
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA256(MB_MGR_SHA_OOO *state)
+{
+        return sha_ooo_flush(state, 256);
+}
+
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA384(MB_MGR_SHA_OOO *state, IMB_JOB *job)
+{
+        return sha_ooo_submit(state, job, 384);
+}
+
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA384(MB_MGR_SHA_OOO *state)
+{
+        return sha_ooo_flush(state, 384);
+}
+
+IMB_DLL_LOCAL IMB_JOB *SUBMIT_JOB_SHA512(MB_MGR_SHA_OOO *state, IMB_JOB *job)
+{
+        return sha_ooo_submit(state, job, 512);
+}
+
+IMB_DLL_LOCAL IMB_JOB *FLUSH_JOB_SHA512(MB_MGR_SHA_OOO *state)
+{
+        return sha_ooo_flush(state, 512);
+}
+
+#endif /* SHA_OOO_COMMON_H */
@@ -62,6 +62,19 @@
 
 #define SNOW3G_BLOCK_SIZE (8)
 
+/*
+ * Minimum number of lanes with data left to keep running
+ * the 16 lane F8 loop (below it, lanes are finished one at a time)
+ */
+#define SNOW3G_16_MIN_ACTIVE_LANES (4)
+
+/* Maximum number of buffers F9 generates key stream for in parallel */
+#ifdef AVX512
+#define SNOW3G_F9_MAX_LANES (16)
+#else
+#define SNOW3G_F9_MAX_LANES (8)
+#endif
+
 #define SNOW3G_KEY_LEN_IN_BYTES (16) /* 128b */
 #define SNOW3G_IV_LEN_IN_BYTES (16)  /* 128b */
 
@@ -105,6 +118,16 @@ typedef struct snow3gKeyState8_s {
 } snow3gKeyState8_t;
 #endif /* AVX2 */
 
+#ifdef AVX512
+typedef struct snow3gKeyState16_s {
+        /* 16 LFSR stages */
+        __m512i LFSR_X[16];
+        /* 3 FSM states */
+        __m512i FSM_X[3];
+        uint32_t iLFSR_X;
+} snow3gKeyState16_t;
+#endif /* AVX512 */
+
 /**
  * @brief Finds minimum 32-bit value in an array
  * @return Min 32-bit value
@@ -627,6 +650,31 @@ static inline __m256i S1_box_8(const __m256i x)
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Sbox S1 maps a 16x32bit input to a 16x32bit output
+ *
+ * Bytes of each 128-bit lane are put through inverse ShiftRows first,
+ * so that ShiftRows of 'vaesenc' restores the columns and each
+ * 32-bit word gets its own SubBytes and MixColumns transformation.
+ *
+ * @param[in] x  vector of 16 32-bit words to be passed through S1 box
+ *
+ * @return 16x32-bits from \a x transformed through S1 box
+ */
+static inline __m512i S1_box_16(const __m512i x)
+{
+        const __m512i inv_shift_rows =
+                _mm512_broadcast_i32x4(_mm_setr_epi8(0, 13, 10, 7,
+                                                     4, 1, 14, 11,
+                                                     8, 5, 2, 15,
+                                                     12, 9, 6, 3));
+
+        return _mm512_aesenc_epi128(_mm512_shuffle_epi8(x, inv_shift_rows),
+                                    _mm512_setzero_si512());
+}
+#endif /* AVX512 */
+
 /**
  * @brief Sbox S2 maps a 32-bit input to a 32-bit output
  *
@@ -1053,6 +1101,75 @@ static inline __m256i S2_box_8(const __m256i x)
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Sbox S2 maps a 16x32bit input to a 16x32bit output
+ *
+ * SQ is the Dickson polynomial g49(x) ^ 0x25 over GF(2^8) with
+ * x^8 + x^6 + x^5 + x^3 + 1 polynomial. The field is isomorphic to the
+ * AES field, so bytes are mapped into the AES field with 'gf2p8affineqb'
+ * and g49 is computed with 'gf2p8mulb'. Squaring is linear, so all
+ * x^(2^k) powers are folded into the mapping matrices.
+ * The result is mapped back (and multiplied by x for MixColumn)
+ * with another affine transformation.
+ *
+ * @param[in] x  vector of 16 32-bit words to be passed through S2 box
+ *
+ * @return 16x32-bits from \a x transformed through S2 box
+ */
+static inline __m512i S2_box_16(const __m512i x)
+{
+        /* x -> x^(2^k) mapped into the AES field, k = 0 to 5 */
+        const __m512i pow1 = _mm512_set1_epi64(0xcdd61cd46ec09888LL);
+        const __m512i pow2 = _mm512_set1_epi64(0x3b7e16befa581410LL);
+        const __m512i pow4 = _mm512_set1_epi64(0xd5fe26a6fc4ce604LL);
+        const __m512i pow8 = _mm512_set1_epi64(0xcf1eb252deaaeae2LL);
+        const __m512i pow16 = _mm512_set1_epi64(0xfbd6b47c8e40f808LL);
+        const __m512i pow32 = _mm512_set1_epi64(0x8d7e963e32b83cf0LL);
+        /* AES field -> SNOW3G field, without and with MULx */
+        const __m512i inv_map = _mm512_set1_epi64(0xe50ae82cc0528cacLL);
+        const __m512i inv_map_mulx = _mm512_set1_epi64(0xace50a442c6cfe8cLL);
+        __m512i x1, x2, x4, x8, x16, x32;
+        __m512i x9, x13, x15, x33, x41, x45, x47, x49;
+        __m512i g, sq, sq_mulx, t;
+
+        x1 = _mm512_gf2p8affine_epi64_epi8(x, pow1, 0);
+        x2 = _mm512_gf2p8affine_epi64_epi8(x, pow2, 0);
+        x4 = _mm512_gf2p8affine_epi64_epi8(x, pow4, 0);
+        x8 = _mm512_gf2p8affine_epi64_epi8(x, pow8, 0);
+        x16 = _mm512_gf2p8affine_epi64_epi8(x, pow16, 0);
+        x32 = _mm512_gf2p8affine_epi64_epi8(x, pow32, 0);
+
+        x9 = _mm512_gf2p8mul_epi8(x1, x8);
+        x13 = _mm512_gf2p8mul_epi8(x9, x4);
+        x15 = _mm512_gf2p8mul_epi8(x13, x2);
+        x33 = _mm512_gf2p8mul_epi8(x1, x32);
+        x41 = _mm512_gf2p8mul_epi8(x33, x8);
+        x45 = _mm512_gf2p8mul_epi8(x41, x4);
+        x47 = _mm512_gf2p8mul_epi8(x45, x2);
+        x49 = _mm512_gf2p8mul_epi8(x33, x16);
+
+        /* g49 = x + x^9 + x^13 + x^15 + x^33 + x^41 + x^45 + x^47 + x^49 */
+        g = _mm512_ternarylogic_epi64(x1, x9, x13, 0x96);
+        g = _mm512_ternarylogic_epi64(g, x15, x33, 0x96);
+        g = _mm512_ternarylogic_epi64(g, x41, x45, 0x96);
+        g = _mm512_ternarylogic_epi64(g, x47, x49, 0x96);
+
+        /* SQ(x) = g49 ^ 0x25 and MULx(SQ(x), 0x69) = MULx(g49) ^ 0x4a */
+        sq = _mm512_gf2p8affine_epi64_epi8(g, inv_map, 0x25);
+        sq_mulx = _mm512_gf2p8affine_epi64_epi8(g, inv_map_mulx, 0x4a);
+
+        /*
+         * MixColumn, byte 3 of the word is w0:
+         * r = MULx(sq) ^ ror8(MULx(sq) ^ sq) ^ rol8(sq) ^ rol16(sq)
+         */
+        t = _mm512_xor_si512(sq_mulx, sq);
+        t = _mm512_ternarylogic_epi32(sq_mulx, _mm512_ror_epi32(t, 8),
+                                      _mm512_rol_epi32(sq, 8), 0x96);
+        return _mm512_xor_si512(t, _mm512_rol_epi32(sq, 16));
+}
+#endif /* AVX512 */
+
 /**
  * @brief MULalpha SNOW3G operation on 4 8-bit values at the same time
  *
@@ -1455,6 +1572,81 @@ __m256i DIVa_8(const __m256i L11)
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Looks up 16 x 32-bit MULalpha/DIValpha values
+ *
+ * Each byte of MULalpha/DIValpha result is a linear function of the
+ * 8-bit input. The input byte is broadcast across its 32-bit word and
+ * each of the 4 result bytes is computed by 'gf2p8affineqb'
+ * with its own matrix, no table lookups are needed.
+ *
+ * @param [in] x        16 x 32-bit words with the input byte broadcast
+ * @param [in] m0       matrix for the result byte 0
+ * @param [in] m1       matrix for the result byte 1
+ * @param [in] m2       matrix for the result byte 2
+ * @param [in] m3       matrix for the result byte 3
+ * @return 16 x 32-bit results
+ */
+static inline __m512i
+alpha_16(const __m512i x, const __m512i m0, const __m512i m1,
+         const __m512i m2, const __m512i m3)
+{
+        __m512i r;
+
+        r = _mm512_maskz_gf2p8affine_epi64_epi8(0x1111111111111111ULL,
+                                                x, m0, 0);
+        r = _mm512_mask_gf2p8affine_epi64_epi8(r, 0x2222222222222222ULL,
+                                               x, m1, 0);
+        r = _mm512_mask_gf2p8affine_epi64_epi8(r, 0x4444444444444444ULL,
+                                               x, m2, 0);
+        return _mm512_mask_gf2p8affine_epi64_epi8(r, 0x8888888888888888ULL,
+                                                  x, m3, 0);
+}
+
+/**
+ * @brief MULalpha SNOW3G operation on 16 8-bit values at the same time
+ *
+ * @param [in] L0       16 x 32-bit LFSR[0]
+ * @return 16 x 32-bit MULalpha(L0 >> 24)
+ */
+static inline __m512i MULa_16(const __m512i L0)
+{
+        const __m512i bcast_byte3 =
+                _mm512_broadcast_i32x4(_mm_setr_epi8(3, 3, 3, 3,
+                                                     7, 7, 7, 7,
+                                                     11, 11, 11, 11,
+                                                     15, 15, 15, 15));
+
+        return alpha_16(_mm512_shuffle_epi8(L0, bcast_byte3),
+                        _mm512_set1_epi64(0xf1e3c67cf90204f8LL),
+                        _mm512_set1_epi64(0x13274f8d1a264d89LL),
+                        _mm512_set1_epi64(0xbf7fff4183b8705fLL),
+                        _mm512_set1_epi64(0x0b162c52a4438705LL));
+}
+
+/**
+ * @brief DIValpha SNOW3G operation on 16 8-bit values at the same time
+ *
+ * @param [in] L11      16 x 32-bit LFSR[11]
+ * @return 16 x 32-bit DIValpha(L11 & 0xff)
+ */
+static inline __m512i DIVa_16(const __m512i L11)
+{
+        const __m512i bcast_byte0 =
+                _mm512_broadcast_i32x4(_mm_setr_epi8(0, 0, 0, 0,
+                                                     4, 4, 4, 4,
+                                                     8, 8, 8, 8,
+                                                     12, 12, 12, 12));
+
+        return alpha_16(_mm512_shuffle_epi8(L11, bcast_byte0),
+                        _mm512_set1_epi64(0x93264d0912b66d49LL),
+                        _mm512_set1_epi64(0xdcb8703c782c596eLL),
+                        _mm512_set1_epi64(0xa14387af5e1c38d0LL),
+                        _mm512_set1_epi64(0x9020401123d6acc8LL));
+}
+#endif /* AVX512 */
+
 /**
  * @brief ClockFSM function as defined in SNOW3G standard
  *
@@ -1628,6 +1820,17 @@ static inline void ShiftLFSR_8(snow3gKeyState8_t *pCtx)
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief LFSR array shift by one (16 lanes)
+ * @param[in]     pCtx       Context where the scheduled keys are stored
+ */
+static inline void ShiftLFSR_16(snow3gKeyState16_t *pCtx)
+{
+        pCtx->iLFSR_X = (pCtx->iLFSR_X + 1) & 15;
+}
+#endif /* AVX512 */
+
 /**
  * @brief LFSR array shift by one (4 lanes)
  * @param[in]     pCtx       Context where the scheduled keys are stored
@@ -1664,6 +1867,38 @@ static inline uint64_t multiply_and_reduce64(uint64_t a, uint64_t b)
         return res;
 }
 
+#ifndef NO_AESNI
+/**
+ * @brief GF2 modular multiplication/reduction using carry-less multiply
+ *
+ * Same result as multiply_and_reduce64().
+ * The upper 64 bits of the product are folded twice
+ * with the SNOW3GCONSTANT/0x1b reduction polynomial.
+ *
+ * @param[in] a   64-bit input
+ * @param[in] b   64-bit input
+ * @return 64-bit output
+ */
+static inline uint64_t multiply_and_reduce64_clmul(const uint64_t a,
+                                                   const uint64_t b)
+{
+        const __m128i poly = _mm_cvtsi64_si128(SNOW3GCONSTANT);
+        const __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(a),
+                                                  _mm_cvtsi64_si128(b), 0x00);
+        /* fold the upper 64 bits (68 bits result) */
+        const __m128i fold1 = _mm_clmulepi64_si128(prod, poly, 0x01);
+        /* fold the upper 4 bits of the first fold */
+        const __m128i fold2 = _mm_clmulepi64_si128(fold1, poly, 0x01);
+
+        return (uint64_t) _mm_cvtsi128_si64(_mm_xor_si128(prod,
+                                            _mm_xor_si128(fold1, fold2)));
+}
+
+#define F9_MUL64 multiply_and_reduce64_clmul
+#else
+#define F9_MUL64 multiply_and_reduce64
+#endif /* NO_AESNI */
+
 #ifdef AVX2
 /**
  * @brief ClockLFSR sub-function as defined in SNOW3G standard (8 lanes)
@@ -1787,6 +2022,64 @@ static inline __m256i ClockFSM_8(snow3gKeyState8_t *pCtx)
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief ClockLFSR function as defined in SNOW3G standard (16 lanes)
+ *
+ * S =  table_Alpha_div[LFSR[11] & 0xff]
+ *       ^ table_Alpha_mul[LFSR[0] >> 24]
+ *       ^ LFSR[2] ^ LFSR[0] << 8 ^ LFSR[11] >> 8
+ *
+ * @param[in]     pCtx       Context where the scheduled keys are stored
+ */
+static inline void ClockLFSR_16(snow3gKeyState16_t *pCtx)
+{
+        const __m512i U = pCtx->LFSR_X[pCtx->iLFSR_X];
+        const __m512i S = pCtx->LFSR_X[(pCtx->iLFSR_X + 11) & 15];
+        const __m512i X2 = _mm512_xor_si512(DIVa_16(S), MULa_16(U));
+        const __m512i T =
+                _mm512_ternarylogic_epi32(_mm512_slli_epi32(U, 8),
+                                          _mm512_srli_epi32(S, 8),
+                                          pCtx->LFSR_X[(pCtx->iLFSR_X + 2) &
+                                                       15],
+                                          0x96);
+
+        ShiftLFSR_16(pCtx);
+
+        pCtx->LFSR_X[(pCtx->iLFSR_X + 15) & 15] = _mm512_xor_si512(T, X2);
+}
+
+/**
+ * @brief ClockFSM function as defined in SNOW3G standard
+ *
+ * It operates on 16 packets/lanes at a time
+ *
+ * @param[in]     pCtx       Context where the scheduled keys are stored
+ * @return 16 x 4bytes of key stream
+ */
+static inline __m512i ClockFSM_16(snow3gKeyState16_t *pCtx)
+{
+        const uint32_t iLFSR_X_5 = (pCtx->iLFSR_X + 5) & 15;
+        const uint32_t iLFSR_X_15 = (pCtx->iLFSR_X + 15) & 15;
+
+        const __m512i F =
+                _mm512_add_epi32(pCtx->LFSR_X[iLFSR_X_15], pCtx->FSM_X[0]);
+
+        const __m512i ret = _mm512_xor_si512(F, pCtx->FSM_X[1]);
+
+        const __m512i R =
+                _mm512_add_epi32(_mm512_xor_si512(pCtx->LFSR_X[iLFSR_X_5],
+                                                  pCtx->FSM_X[2]),
+                                 pCtx->FSM_X[1]);
+
+        pCtx->FSM_X[2] = S2_box_16(pCtx->FSM_X[1]);
+        pCtx->FSM_X[1] = S1_box_16(pCtx->FSM_X[0]);
+        pCtx->FSM_X[0] = R;
+
+        return ret;
+}
+#endif /* AVX512 */
+
 /**
  * @brief ClockFSM function as defined in SNOW3G standard
  *
@@ -1962,25 +2255,25 @@ static inline void snow3g_keystream_8_32(snow3gKeyState8_t *pCtx,
         /** produces the next 4 bytes for each buffer */
         int i;
 
-        /** Byte reversal on each KS */
+        /** Byte swap of each 32-bit KS word */
         static const __m256i mask1 = {
-                0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL,
-                0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL
+                0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL,
+                0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL
         };
-        /** Reversal, shifted 4 bytes right */
+        /** Byte swap, rotated 4 bytes right */
         static const __m256i mask2 = {
-                0x0405060708090a0bULL, 0x0c0d0e0f00010203ULL,
-                0x0405060708090a0bULL, 0x0c0d0e0f00010203ULL
+                0x000102030c0d0e0fULL, 0x08090a0b04050607ULL,
+                0x000102030c0d0e0fULL, 0x08090a0b04050607ULL
         };
-        /** Reversal, shifted 8 bytes right */
+        /** Byte swap, rotated 8 bytes right */
         static const __m256i mask3 = {
-                0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
-                0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL
+                0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL
         };
-        /** Reversal, shifted 12 bytes right */
+        /** Byte swap, rotated 12 bytes right */
         static const __m256i mask4 = {
-                0x0c0d0e0f00010203ULL, 0x0405060708090a0bULL,
-                0x0c0d0e0f00010203ULL, 0x0405060708090a0bULL
+                0x08090a0b04050607ULL, 0x000102030c0d0e0fULL,
+                0x08090a0b04050607ULL, 0x000102030c0d0e0fULL
         };
 
         temp[0] = _mm256_shuffle_epi8(snow3g_keystream_8_4(pCtx), mask1);
@@ -2032,8 +2325,127 @@ static inline void snow3g_keystream_8_32(snow3gKeyState8_t *pCtx,
                                                    blended[i + 4], 0x31);
         }
 }
+
+/**
+ * @brief Generates 5 words of key stream used in F9, 8 buffers at a time
+ *
+ * @param[in]     pCtx        Context where the scheduled keys are stored
+ * @param[out]    pKeyStream  5 vectors of key stream words (one per buffer)
+ */
+static inline void snow3g_f9_8_keystream_words(snow3gKeyState8_t *pCtx,
+                                               __m256i *pKeyStream)
+{
+        int i;
+
+        (void) ClockFSM_8(pCtx);
+        ClockLFSR_8(pCtx);
+
+        for (i = 0; i < 5; i++)
+                pKeyStream[i] = snow3g_keystream_8_4(pCtx);
+}
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Generates 4 bytes of key stream 16 buffers at a time
+ *
+ * @param[in]      pCtx         Context where the scheduled keys are stored
+ * @return 16 x 4 bytes vector with key stream data
+ */
+static inline __m512i snow3g_keystream_16_4(snow3gKeyState16_t *pCtx)
+{
+        const __m512i keyStream = _mm512_xor_si512(ClockFSM_16(pCtx),
+                                                   pCtx->LFSR_X[pCtx->iLFSR_X]);
+
+        ClockLFSR_16(pCtx);
+        return keyStream;
+}
+
+/**
+ * @brief Generates 64 bytes of key stream 16 buffers at a time
+ *
+ * 16 key stream words of 16 lanes are transposed, so that
+ * each vector holds 64 bytes of key stream for one buffer.
+ *
+ * @param[in]     pCtx         Context where the scheduled keys are stored
+ * @param[in/out] pKeyStream   Array of generated key streams (one per buffer)
+ */
+static inline void snow3g_keystream_16_64(snow3gKeyState16_t *pCtx,
+                                          __m512i *pKeyStream)
+{
+        const __m512i swap_mask =
+                _mm512_broadcast_i32x4(_mm_setr_epi8(3, 2, 1, 0,
+                                                     7, 6, 5, 4,
+                                                     11, 10, 9, 8,
+                                                     15, 14, 13, 12));
+        __m512i ks[16], t[16];
+        int i;
+
+        for (i = 0; i < 16; i++)
+                ks[i] = snow3g_keystream_16_4(pCtx);
+
+        /* 32-bit and 64-bit word interleave inside 128-bit lanes */
+        for (i = 0; i < 16; i += 2) {
+                t[i] = _mm512_unpacklo_epi32(ks[i], ks[i + 1]);
+                t[i + 1] = _mm512_unpackhi_epi32(ks[i], ks[i + 1]);
+        }
+
+        for (i = 0; i < 16; i += 4) {
+                ks[i] = _mm512_unpacklo_epi64(t[i], t[i + 2]);
+                ks[i + 1] = _mm512_unpackhi_epi64(t[i], t[i + 2]);
+                ks[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+                ks[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+
+        /*
+         * 128-bit lane L of ks[4 * j + k] holds words 4 * j to 4 * j + 3
+         * of buffer 4 * L + k, put 128-bit lanes together
+         */
+        for (i = 0; i < 4; i++) {
+                const __m512i lo1 = _mm512_shuffle_i32x4(ks[i], ks[i + 4],
+                                                         0x44);
+                const __m512i hi1 = _mm512_shuffle_i32x4(ks[i], ks[i + 4],
+                                                         0xee);
+                const __m512i lo2 = _mm512_shuffle_i32x4(ks[i + 8],
+                                                         ks[i + 12], 0x44);
+                const __m512i hi2 = _mm512_shuffle_i32x4(ks[i + 8],
+                                                         ks[i + 12], 0xee);
+
+                t[i] = _mm512_shuffle_i32x4(lo1, lo2, 0x88);
+                t[i + 4] = _mm512_shuffle_i32x4(lo1, lo2, 0xdd);
+                t[i + 8] = _mm512_shuffle_i32x4(hi1, hi2, 0x88);
+                t[i + 12] = _mm512_shuffle_i32x4(hi1, hi2, 0xdd);
+        }
+
+        /* key stream words are stored in big endian */
+        for (i = 0; i < 16; i++)
+                pKeyStream[i] = _mm512_shuffle_epi8(t[i], swap_mask);
+
+#ifdef SAFE_DATA
+        CLEAR_MEM(ks, sizeof(ks));
+        CLEAR_MEM(t, sizeof(t));
+#endif /* SAFE_DATA */
+}
+
+/**
+ * @brief Generates 5 words of key stream used in F9, 16 buffers at a time
+ *
+ * @param[in]     pCtx        Context where the scheduled keys are stored
+ * @param[out]    pKeyStream  5 vectors of key stream words (one per buffer)
+ */
+static inline void snow3g_f9_16_keystream_words(snow3gKeyState16_t *pCtx,
+                                                __m512i *pKeyStream)
+{
+        int i;
+
+        (void) ClockFSM_16(pCtx);
+        ClockLFSR_16(pCtx);
+
+        for (i = 0; i < 5; i++)
+                pKeyStream[i] = snow3g_keystream_16_4(pCtx);
+}
+#endif /* AVX512 */
+
 /**
  * @brief Generates 4 bytes of key stream 4 buffers at a time
  *
@@ -2162,6 +2574,24 @@ static inline void snow3g_keystream_4_16(snow3gKeyState4_t *pCtx,
                                          swapMask);
 }
 
+/**
+ * @brief Generates 5 words of key stream used in F9, 4 buffers at a time
+ *
+ * @param[in]     pCtx        Context where the scheduled keys are stored
+ * @param[out]    pKeyStream  5 vectors of key stream words (one per buffer)
+ */
+static inline void snow3g_f9_4_keystream_words(snow3gKeyState4_t *pCtx,
+                                               __m128i *pKeyStream)
+{
+        int i;
+
+        (void) ClockFSM_4(pCtx);
+        ClockLFSR_4(pCtx);
+
+        for (i = 0; i < 5; i++)
+                pKeyStream[i] = snow3g_keystream_4_4(pCtx);
+}
+
 /**
  * @brief Initializes the key schedule for 4 buffers for SNOW3G f8/f9.
  *
@@ -2251,6 +2681,94 @@ snow3gStateInitialize_4(snow3gKeyState4_t *pCtx,
         }
 }
 
+/**
+ * @brief Initializes the key schedule for 4 buffers with individual keys
+ *
+ * It can be used for SNOW3G F8/F9
+ *
+ * @param[in/out] pCtx      pointer to a 4 buffer key stream state
+ * @param[in]     KeySched  pointer to an array with 4 key schedules
+ * @param[in]     pIV       pointer to an array with 4 IV's
+ */
+static inline void
+snow3gStateInitialize_4_multiKey(snow3gKeyState4_t *pCtx,
+                                 const snow3g_key_schedule_t * const KeySched[],
+                                 const void * const pIV[])
+{
+        __m128i R, S, T, U;
+        __m128i T0, T1;
+        int i;
+
+        /* Initialize the LFSR table from constants, Keys, and IV */
+
+        /* Load complete 128b IV into register (SSE2)*/
+        static const uint64_t sm[2] = {
+                0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL
+        };
+
+        R = _mm_loadu_si128((const __m128i *)pIV[0]);
+        S = _mm_loadu_si128((const __m128i *)pIV[1]);
+        T = _mm_loadu_si128((const __m128i *)pIV[2]);
+        U = _mm_loadu_si128((const __m128i *)pIV[3]);
+
+        /* initialize the array block (SSE4) */
+        for (i = 0; i < 4; i++) {
+                const __m128i VK = _mm_set_epi32(KeySched[3]->k[i],
+                                                 KeySched[2]->k[i],
+                                                 KeySched[1]->k[i],
+                                                 KeySched[0]->k[i]);
+                const __m128i VL = _mm_xor_si128(VK, _mm_set1_epi32(-1));
+
+                pCtx->LFSR_X[i + 4] =
+                        pCtx->LFSR_X[i + 12] = VK;
+                pCtx->LFSR_X[i + 0] =
+                        pCtx->LFSR_X[i + 8] = VL;
+        }
+        /* Update the schedule structure with IVs */
+        /* Store the 4 IVs in LFSR by a column/row matrix swap
+         * after endianness correction */
+
+        /* endianness swap (SSSE3) */
+        const __m128i swapMask = _mm_loadu_si128((const __m128i *) sm);
+
+        R = _mm_shuffle_epi8(R, swapMask);
+        S = _mm_shuffle_epi8(S, swapMask);
+        T = _mm_shuffle_epi8(T, swapMask);
+        U = _mm_shuffle_epi8(U, swapMask);
+
+        /* row/column dword inversion (SSE2) */
+        T0 = _mm_unpacklo_epi32(R, S);
+        R = _mm_unpackhi_epi32(R, S);
+        T1 = _mm_unpacklo_epi32(T, U);
+        T = _mm_unpackhi_epi32(T, U);
+
+        /* row/column qword inversion (SSE2) */
+        U = _mm_unpackhi_epi64(R, T);
+        T = _mm_unpacklo_epi64(R, T);
+        S = _mm_unpackhi_epi64(T0, T1);
+        R = _mm_unpacklo_epi64(T0, T1);
+
+        /* IV ^ LFSR (SSE2) */
+        pCtx->LFSR_X[15] = _mm_xor_si128(pCtx->LFSR_X[15], U);
+        pCtx->LFSR_X[12] = _mm_xor_si128(pCtx->LFSR_X[12], T);
+        pCtx->LFSR_X[10] = _mm_xor_si128(pCtx->LFSR_X[10], S);
+        pCtx->LFSR_X[9] = _mm_xor_si128(pCtx->LFSR_X[9], R);
+        pCtx->iLFSR_X = 0;
+
+        /* FSM initialization (SSE2) */
+        pCtx->FSM_X[0] = pCtx->FSM_X[1] =
+                pCtx->FSM_X[2] = _mm_setzero_si128();
+
+        /* Initialisation rounds */
+        for (i = 0; i < 32; i++) {
+                T1 = ClockFSM_4(pCtx);
+                ClockLFSR_4(pCtx);
+                pCtx->LFSR_X[(pCtx->iLFSR_X + 15) & 15] =
+                        _mm_xor_si128(pCtx->LFSR_X[(pCtx->iLFSR_X + 15) & 15],
+                                      T1);
+        }
+}
+
 #ifdef AVX2
 /**
  * @brief Initializes the key schedule for 8 buffers with individual keys
@@ -2441,19 +2959,97 @@ snow3gStateInitialize_8(snow3gKeyState8_t *pCtx,
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Initializes the key schedule for 16 buffers with individual keys
+ *
+ * It can be used for SNOW3G F8/F9
+ *
+ * @param[in/out] pCtx      pointer to 16 lane key stream state
+ * @param[in]     pKeySched pointer to an array with 16 key schedules
+ * @param[in]     pIV       pointer to an array with 16 IV's
+ */
 static inline void
-preserve_bits(uint64_t *KS,
-              const uint8_t *pcBufferOut, const uint8_t *pcBufferIn,
-              SafeBuf *safeOutBuf, SafeBuf *safeInBuf,
-              const uint8_t bit_len, const uint8_t byte_len)
+snow3gStateInitialize_16_multiKey(snow3gKeyState16_t *pCtx,
+                                  const snow3g_key_schedule_t * const
+                                  KeySched[],
+                                  const void * const pIV[])
 {
-        const uint64_t mask = UINT64_MAX << (SNOW3G_BLOCK_SIZE * 8 - bit_len);
-
-        /* Clear the last bits of the key stream and the input
-         * (input only in out-of-place case) */
-        *KS &= mask;
-        if (pcBufferIn != pcBufferOut) {
-                const uint64_t swapMask = BSWAP64(mask);
+        DECLARE_ALIGNED(uint32_t k[16], 64);
+        DECLARE_ALIGNED(uint32_t iv[4][16], 64);
+        __m512i mS;
+        int i, j;
+
+        /* Initialize the LFSR table from constants, Keys, and IV */
+        for (i = 0; i < 4; i++) {
+                __m512i K, L;
+
+                for (j = 0; j < 16; j++)
+                        k[j] = KeySched[j]->k[i];
+
+                K = _mm512_load_si512((const void *)k);
+                L = _mm512_ternarylogic_epi32(K, K, K, 0x55); /* ~K */
+
+                pCtx->LFSR_X[i + 4] = K;
+                pCtx->LFSR_X[i + 12] = K;
+                pCtx->LFSR_X[i + 0] = L;
+                pCtx->LFSR_X[i + 8] = L;
+        }
+
+        /* IV words in big endian, one vector per word */
+        for (j = 0; j < 16; j++) {
+                const uint32_t *pIV32 = (const uint32_t *) pIV[j];
+
+                for (i = 0; i < 4; i++)
+                        iv[i][j] = BSWAP32(pIV32[i]);
+        }
+
+        /* IV ^ LFSR */
+        pCtx->LFSR_X[15] = _mm512_xor_si512(pCtx->LFSR_X[15],
+                                            _mm512_load_si512(iv[3]));
+        pCtx->LFSR_X[12] = _mm512_xor_si512(pCtx->LFSR_X[12],
+                                            _mm512_load_si512(iv[2]));
+        pCtx->LFSR_X[10] = _mm512_xor_si512(pCtx->LFSR_X[10],
+                                            _mm512_load_si512(iv[1]));
+        pCtx->LFSR_X[9] = _mm512_xor_si512(pCtx->LFSR_X[9],
+                                           _mm512_load_si512(iv[0]));
+        pCtx->iLFSR_X = 0;
+
+        /* FSM initialization */
+        pCtx->FSM_X[0] =
+                pCtx->FSM_X[1] =
+                pCtx->FSM_X[2] = _mm512_setzero_si512();
+
+        /* Initialisation rounds */
+        for (i = 0; i < 32; i++) {
+                mS = ClockFSM_16(pCtx);
+                ClockLFSR_16(pCtx);
+
+                const uint32_t idx = (pCtx->iLFSR_X + 15) & 15;
+
+                pCtx->LFSR_X[idx] = _mm512_xor_si512(pCtx->LFSR_X[idx], mS);
+        }
+
+#ifdef SAFE_DATA
+        CLEAR_MEM(k, sizeof(k));
+        CLEAR_MEM(iv, sizeof(iv));
+#endif /* SAFE_DATA */
+}
+#endif /* AVX512 */
+
+static inline void
+preserve_bits(uint64_t *KS,
+              const uint8_t *pcBufferOut, const uint8_t *pcBufferIn,
+              SafeBuf *safeOutBuf, SafeBuf *safeInBuf,
+              const uint8_t bit_len, const uint8_t byte_len)
+{
+        const uint64_t mask = UINT64_MAX << (SNOW3G_BLOCK_SIZE * 8 - bit_len);
+
+        /* Clear the last bits of the key stream and the input
+         * (input only in out-of-place case) */
+        *KS &= mask;
+        if (pcBufferIn != pcBufferOut) {
+                const uint64_t swapMask = BSWAP64(mask);
 
                 safeInBuf->b64 &= swapMask;
 
@@ -2700,6 +3296,39 @@ static inline void snow3gStateConvert_8(const snow3gKeyState8_t *pSrcState,
 }
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Extracts one state from a 16 buffer state structure.
+ *
+ * @param[in]  pSrcState   Pointer to the source state
+ * @param[in]  pDstState   Pointer to the destination state
+ * @param[in]  NumBuffer   Buffer number
+ */
+static inline void snow3gStateConvert_16(const snow3gKeyState16_t *pSrcState,
+                                         snow3gKeyState1_t *pDstState,
+                                         const uint32_t NumBuffer)
+{
+        const uint32_t iLFSR_X = pSrcState->iLFSR_X;
+        const __m512i *LFSR_X = pSrcState->LFSR_X;
+        uint32_t i;
+
+        for (i = 0; i < 16; i++) {
+                const uint32_t *pLFSR_X =
+                        (const uint32_t *) &LFSR_X[(i + iLFSR_X) & 15];
+
+                pDstState->LFSR_S[i] = pLFSR_X[NumBuffer];
+        }
+
+        const uint32_t *pFSM_X0 = (const uint32_t *)&pSrcState->FSM_X[0];
+        const uint32_t *pFSM_X1 = (const uint32_t *)&pSrcState->FSM_X[1];
+        const uint32_t *pFSM_X2 = (const uint32_t *)&pSrcState->FSM_X[2];
+
+        pDstState->FSM_R1 = pFSM_X0[NumBuffer];
+        pDstState->FSM_R2 = pFSM_X1[NumBuffer];
+        pDstState->FSM_R3 = pFSM_X2[NumBuffer];
+}
+#endif /* AVX512 */
+
 /**
  * @brief Extracts one state from a 4 buffer state structure.
  *
@@ -3066,6 +3695,112 @@ void SNOW3G_F8_4_BUFFER(const snow3g_key_schedule_t *pHandle,
 #endif /* SAFE_DATA */
 }
 
+/**
+ * @brief Multiple-key 4 buffer F8 key stream generation
+ *
+ * Processes 4 packets 16 or 8 bytes at a time.
+ * Use different key schedule for each buffer.
+ *
+ * @param[in] pKey          pointer to an array of key schedules
+ * @param[in] IV            pointer to an array of IV's
+ * @param[in] pBufferIn     pointer to an array of input buffers
+ * @param[out] pBufferOut   pointer to an array of output buffers
+ * @param[in] lengthInBytes pointer to an array of message lengths in bytes
+ */
+static inline void
+snow3g_4_buffer_ks_16_8_multi(const snow3g_key_schedule_t * const pKey[],
+                              const void * const IV[],
+                              const void * const pBufferIn[],
+                              void *pBufferOut[],
+                              const uint32_t *lengthInBytes)
+{
+        const size_t num_lanes = 4;
+        snow3gKeyState4_t ctx;
+        uint32_t tLenInBytes[4];
+        uint8_t *tBufferOut[4];
+        const uint8_t *tBufferIn[4];
+        uint32_t bytes, qwords, i;
+
+        memcpy((void *)tBufferIn, (const void *)pBufferIn,
+               sizeof(tBufferIn));
+        memcpy((void *)tBufferOut, (const void *)pBufferOut,
+               sizeof(tBufferOut));
+        memcpy((void *)tLenInBytes, (const void *)lengthInBytes,
+               sizeof(tLenInBytes));
+
+        /* find min common length */
+        bytes = length_find_min(tLenInBytes, num_lanes);
+        qwords = bytes / SNOW3G_8_BYTES;
+
+        /* subtract min common length from all buffers */
+        length_sub(tLenInBytes, num_lanes, qwords * SNOW3G_8_BYTES);
+
+        /* Initialize the schedule from the IV */
+        snow3gStateInitialize_4_multiKey(&ctx, pKey, IV);
+
+        /* Clock FSM and LFSR once, ignore the key stream */
+        (void) snow3g_keystream_4_4(&ctx);
+
+        /* generates 16 bytes at a time on all streams */
+        while (qwords >= 2) {
+                __m128i ks[4];
+
+                snow3g_keystream_4_16(&ctx, ks);
+
+                for (i = 0; i < num_lanes; i++) {
+                        const __m128i in =
+                                _mm_loadu_si128((const __m128i *)tBufferIn[i]);
+
+                        _mm_storeu_si128((__m128i *)tBufferOut[i],
+                                         _mm_xor_si128(in, ks[i]));
+
+                        tBufferOut[i] += (2 * SNOW3G_8_BYTES);
+                        tBufferIn[i] += (2 * SNOW3G_8_BYTES);
+                }
+
+                qwords = qwords - 2;
+#ifdef SAFE_DATA
+                CLEAR_MEM(ks, sizeof(ks));
+#endif /* SAFE_DATA */
+        }
+
+        while (qwords--) {
+                __m128i H, L; /* 4 bytes of key stream */
+
+                snow3g_keystream_4_8(&ctx, &L, &H);
+
+                tBufferIn[0] = xor_keystrm_rev(tBufferOut[0], tBufferIn[0],
+                                               _mm_extract_epi64(L, 0));
+                tBufferIn[1] = xor_keystrm_rev(tBufferOut[1], tBufferIn[1],
+                                               _mm_extract_epi64(L, 1));
+                tBufferIn[2] = xor_keystrm_rev(tBufferOut[2], tBufferIn[2],
+                                               _mm_extract_epi64(H, 0));
+                tBufferIn[3] = xor_keystrm_rev(tBufferOut[3], tBufferIn[3],
+                                               _mm_extract_epi64(H, 1));
+
+                for (i = 0; i < num_lanes; i++)
+                        tBufferOut[i] += SNOW3G_8_BYTES;
+        }
+
+        /* process the remaining of each buffer
+         *  - extract the LFSR and FSM structures
+         *  - Continue process 1 buffer
+         */
+        for (i = 0; i < num_lanes; i++) {
+                snow3gKeyState1_t t_ctx;
+
+                if (tLenInBytes[i] == 0)
+                        continue;
+
+                snow3gStateConvert_4(&ctx, &t_ctx, i);
+                f8_snow3g(&t_ctx, tBufferIn[i], tBufferOut[i], tLenInBytes[i]);
+        }
+
+#ifdef SAFE_DATA
+        CLEAR_MEM(&ctx, sizeof(ctx));
+#endif /* SAFE_DATA */
+}
+
 #ifdef AVX2
 /**
  * @brief Multiple-key 8 buffer F8/F9 key stream generation
@@ -3342,6 +4077,151 @@ snow3g_8_buffer_ks_32_8(const snow3g_key_schedule_t *pKey,
 
 #endif /* AVX2 */
 
+#ifdef AVX512
+/**
+ * @brief Multiple-key 16 buffer F8 key stream generation
+ *
+ * Processes 16 packets 64 bytes at a time.
+ * Message tails are handled with masked loads and stores, so lanes
+ * don't have to be of the same length. The 16 lane loop runs for as long
+ * as at least SNOW3G_16_MIN_ACTIVE_LANES lanes have data left,
+ * the remaining lanes are finished one at a time.
+ * Lanes with zero length are skipped.
+ * Use different key schedule for each buffer.
+ *
+ * @param[in] pKey          pointer to an array of key schedules
+ * @param[in] IV            pointer to an array of IV's
+ * @param[in] pBufferIn     pointer to an array of input buffers
+ * @param[out] pBufferOut   pointer to an array of output buffers
+ * @param[in] lengthInBytes pointer to an array of message lengths in bytes
+ */
+static inline void
+snow3g_16_buffer_ks_64_multi(const snow3g_key_schedule_t * const pKey[],
+                             const void * const IV[],
+                             const void * const pBufferIn[],
+                             void *pBufferOut[],
+                             const uint32_t *lengthInBytes)
+{
+        const size_t num_lanes = 16;
+        const uint32_t block_size = 64;
+        const uint8_t *tBufferIn[16];
+        uint8_t *tBufferOut[16];
+        uint32_t tLenInBytes[16];
+        snow3gKeyState16_t ctx;
+        __m512i ks[16];
+        size_t i, active_lanes = 0;
+
+        memcpy((void *)tBufferIn, (const void *)pBufferIn,
+               sizeof(tBufferIn));
+        memcpy((void *)tBufferOut, (const void *)pBufferOut,
+               sizeof(tBufferOut));
+        memcpy((void *)tLenInBytes, (const void *)lengthInBytes,
+               sizeof(tLenInBytes));
+
+        for (i = 0; i < num_lanes; i++)
+                if (tLenInBytes[i] != 0)
+                        active_lanes++;
+
+        /* Initialize the schedule from the IV */
+        snow3gStateInitialize_16_multiKey(&ctx, pKey, IV);
+
+        /* Clock FSM and LFSR once, ignore the key stream */
+        (void) snow3g_keystream_16_4(&ctx);
+
+        while (active_lanes >= SNOW3G_16_MIN_ACTIVE_LANES) {
+                snow3g_keystream_16_64(&ctx, ks);
+
+                for (i = 0; i < num_lanes; i++) {
+                        const uint32_t len = tLenInBytes[i];
+                        __mmask64 mask;
+                        __m512i in_val;
+
+                        if (len == 0)
+                                continue;
+
+                        if (len >= block_size) {
+                                mask = (__mmask64) -1;
+                                tLenInBytes[i] = len - block_size;
+                        } else {
+                                mask = (((__mmask64) 1) << len) - 1;
+                                tLenInBytes[i] = 0;
+                        }
+
+                        in_val = _mm512_maskz_loadu_epi8(mask, tBufferIn[i]);
+                        _mm512_mask_storeu_epi8(tBufferOut[i], mask,
+                                                _mm512_xor_si512(in_val,
+                                                                 ks[i]));
+
+                        tBufferIn[i] += block_size;
+                        tBufferOut[i] += block_size;
+
+                        if (tLenInBytes[i] == 0)
+                                active_lanes--;
+                }
+        }
+
+        /* process the remaining of each buffer
+         *  - extract the LFSR and FSM structures
+         *  - Continue process 1 buffer
+         */
+        for (i = 0; i < num_lanes; i++) {
+                snow3gKeyState1_t t_ctx;
+
+                if (tLenInBytes[i] == 0)
+                        continue;
+
+                snow3gStateConvert_16(&ctx, &t_ctx, (uint32_t) i);
+                f8_snow3g(&t_ctx, tBufferIn[i], tBufferOut[i], tLenInBytes[i]);
+        }
+
+#ifdef SAFE_DATA
+        CLEAR_MEM(&ctx, sizeof(ctx));
+        CLEAR_MEM(ks, sizeof(ks));
+#endif /* SAFE_DATA */
+}
+
+/**
+ * @brief Multiple-key F8 key stream generation for up to 16 buffers
+ *
+ * Unused lanes are filled with parameters of the first buffer
+ * and zero length, so they are skipped.
+ *
+ * @param[in] pKey          pointer to an array of key schedules
+ * @param[in] IV            pointer to an array of IV's
+ * @param[in] pBufferIn     pointer to an array of input buffers
+ * @param[out] pBufferOut   pointer to an array of output buffers
+ * @param[in] lengthInBytes pointer to an array of message lengths in bytes
+ * @param[in] num           number of buffers (1 to 16)
+ */
+static inline void
+snow3g_16_buffer_ks_64_multi_n(const snow3g_key_schedule_t * const pKey[],
+                               const void * const IV[],
+                               const void * const pBufferIn[],
+                               void *pBufferOut[],
+                               const uint32_t *lengthInBytes,
+                               const uint32_t num)
+{
+        const snow3g_key_schedule_t *keys[16];
+        const void *ivs[16];
+        const void *ins[16];
+        void *outs[16];
+        uint32_t lens[16];
+        uint32_t i;
+
+        for (i = 0; i < 16; i++) {
+                const uint32_t j = (i < num) ? i : 0;
+
+                keys[i] = pKey[j];
+                ivs[i] = IV[j];
+                ins[i] = pBufferIn[j];
+                outs[i] = pBufferOut[j];
+                lens[i] = (i < num) ? lengthInBytes[i] : 0;
+        }
+
+        snow3g_16_buffer_ks_64_multi(keys, ivs, ins, outs, lens);
+}
+#endif /* AVX512 */
+
 /**
  * @brief Multiple-key 8 buffer F8 encrypt/decrypt
  *
@@ -3375,29 +4255,93 @@ void SNOW3G_F8_8_BUFFER_MULTIKEY(const snow3g_key_schedule_t * const pKey[],
                 return;
 #endif
 
-#ifndef AVX2
-        /* Basic C workaround for lack of non AVX2 implementation */
-        size_t i;
-
-        for (i = 0; i < num_lanes; i++)
-                SNOW3G_F8_1_BUFFER(pKey[i], IV[i], BufferIn[i], BufferOut[i],
-                                   lengthInBytes[i]);
-#else
-
 #ifdef SAFE_DATA
         CLEAR_SCRATCH_SIMD_REGS();
 #endif /* SAFE_DATA */
 
         (void) num_lanes; /* avoid compiler warning */
+#ifndef AVX2
+        /* process 8 buffers as two groups of 4 lanes */
+        snow3g_4_buffer_ks_16_8_multi(&pKey[0], &IV[0], &BufferIn[0],
+                                      &BufferOut[0], &lengthInBytes[0]);
+        snow3g_4_buffer_ks_16_8_multi(&pKey[4], &IV[4], &BufferIn[4],
+                                      &BufferOut[4], &lengthInBytes[4]);
+#else
         snow3g_8_buffer_ks_32_8_multi(pKey, IV, BufferIn,
                                       BufferOut, lengthInBytes);
+#endif /* AVX2 */
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+}
+
+#ifdef SNOW3G_F8_16_BUFFER_MULTIKEY
+/**
+ * @brief Multiple-key 16 buffer F8 encrypt/decrypt
+ *
+ * Sixteen packets enc/dec with sixteen respective key schedules.
+ * The 16 IVs are independent and are passed as an array of pointers.
+ * Each buffer and data length are separate.
+ *
+ * @param[in] pKey          pointer to an array of key schedules
+ * @param[in] IV            pointer to an array of IV's
+ * @param[in] pBufferIn     pointer to an array of input buffers
+ * @param[out] pBufferOut   pointer to an array of output buffers
+ * @param[in] lengthInBytes pointer to an array of message lengths in bytes
+ */
+void SNOW3G_F8_16_BUFFER_MULTIKEY(const snow3g_key_schedule_t * const pKey[],
+                                  const void * const IV[],
+                                  const void * const BufferIn[],
+                                  void *BufferOut[],
+                                  const uint32_t lengthInBytes[])
+{
+#ifdef SAFE_PARAM
+        const size_t num_lanes = 16;
+
+        if ((pKey == NULL) || (IV == NULL) || (BufferIn == NULL) ||
+            (BufferOut == NULL) || (lengthInBytes == NULL))
+                return;
+
+        if (!ptr_check(BufferOut, num_lanes) || !cptr_check(IV, num_lanes) ||
+            !cptr_check((const void * const *)pKey, num_lanes) ||
+            !cptr_check(BufferIn, num_lanes) ||
+            !length_check(lengthInBytes, num_lanes))
+                return;
+#endif
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+#if defined(AVX512)
+        snow3g_16_buffer_ks_64_multi(pKey, IV, BufferIn,
+                                     BufferOut, lengthInBytes);
+#elif defined(AVX2)
+        snow3g_8_buffer_ks_32_8_multi(&pKey[0], &IV[0], &BufferIn[0],
+                                      &BufferOut[0], &lengthInBytes[0]);
+        snow3g_8_buffer_ks_32_8_multi(&pKey[8], &IV[8], &BufferIn[8],
+                                      &BufferOut[8], &lengthInBytes[8]);
+#else
+        {
+                size_t i;
+
+                /* process 16 buffers as four groups of 4 lanes */
+                for (i = 0; i < 16; i += 4)
+                        snow3g_4_buffer_ks_16_8_multi(&pKey[i], &IV[i],
+                                                      &BufferIn[i],
+                                                      &BufferOut[i],
+                                                      &lengthInBytes[i]);
+        }
+#endif
 
 #ifdef SAFE_DATA
         CLEAR_SCRATCH_GPS();
         CLEAR_SCRATCH_SIMD_REGS();
 #endif
-#endif /* AVX2 */
 }
+#endif /* SNOW3G_F8_16_BUFFER_MULTIKEY */
 
 /**
  * @brief 8 buffer F8 encrypt/decrypt with the same key schedule
@@ -3650,6 +4594,21 @@ void SNOW3G_F8_N_BUFFER(const snow3g_key_schedule_t *pCtx,
         }                 /* if sortNeeded */
 
         packet_index = 0;
+#ifdef AVX512
+        /* process 9 to 16 buffers at-a-time */
+        if (pktCnt > 8) {
+                const snow3g_key_schedule_t *keys[NUM_PACKETS_16];
+
+                for (inner_index = 0; inner_index < pktCnt; inner_index++)
+                        keys[inner_index] = pCtx;
+
+                snow3g_16_buffer_ks_64_multi_n(
+                        keys, (const void * const *)pIV,
+                        (const void * const *)pSrcBuf,
+                        (void **)pDstBuf, lensBuf, pktCnt);
+                pktCnt = 0;
+        }
+#endif
         /* process 8 buffers at-a-time */
 #ifdef AVX2
         while (pktCnt >= 8) {
@@ -3733,6 +4692,11 @@ void SNOW3G_F8_N_BUFFER(const snow3g_key_schedule_t *pCtx,
                                    lensBuf[packet_index + 0]);
                 packet_index++;
         }
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
 }
 
 /**
@@ -3854,6 +4818,17 @@ void SNOW3G_F8_N_BUFFER_MULTIKEY(const snow3g_key_schedule_t * const pCtx[],
         }                 /* if sortNeeded */
 
         packet_index = 0;
+#ifdef AVX512
+        /* process 9 to 16 buffers at-a-time */
+        if (pktCnt > 8) {
+                snow3g_16_buffer_ks_64_multi_n(
+                        (const snow3g_key_schedule_t * const *)pCtxBuf,
+                        (const void * const *)pIV,
+                        (const void * const *)pSrcBuf,
+                        (void **)pDstBuf, lensBuf, pktCnt);
+                pktCnt = 0;
+        }
+#endif
         /* process 8 buffers at-a-time */
 #ifdef AVX2
         while (pktCnt >= 8) {
@@ -3868,7 +4843,18 @@ void SNOW3G_F8_N_BUFFER_MULTIKEY(const snow3g_key_schedule_t * const pCtx[],
                 packet_index += 8;
         }
 #endif
-        /* @todo process 4 buffers at-a-time */
+        /* process 4 buffers at-a-time */
+        while (pktCnt >= 4) {
+                pktCnt -= 4;
+                snow3g_4_buffer_ks_16_8_multi(
+                        (const snow3g_key_schedule_t * const *)
+                        &pCtxBuf[packet_index],
+                        (const void * const *)&pIV[packet_index],
+                        (const void * const *)&pSrcBuf[packet_index],
+                        (void **)&pDstBuf[packet_index],
+                        &lensBuf[packet_index]);
+                packet_index += 4;
+        }
         /* @todo process 2 packets at-a-time */
         /* remaining packets are processed 1 at a time */
         while (pktCnt--) {
@@ -3961,4 +4947,440 @@ void SNOW3G_F9_1_BUFFER(const snow3g_key_schedule_t *pHandle,
 #endif /* SAFE_DATA */
 }
 
+/**
+ * @brief F9 hash (EVAL_MUL) and final MAC of up to 16 buffers
+ *
+ * Blocks common to all buffers are processed buffer by buffer
+ * in the same loop, so multiplications of different buffers overlap.
+ *
+ * @param[in]  z             5 key stream words of each buffer
+ * @param[in]  pBufferIn     array of input buffers
+ * @param[in]  lengthInBits  array of message lengths in bits
+ * @param[out] pDigest       array of pointers to store the F9 digests
+ * @param[in]  num           number of buffers
+ */
+static inline void
+snow3g_f9_n_eval(const uint32_t z[5][SNOW3G_F9_MAX_LANES],
+                 const void * const pBufferIn[],
+                 const uint64_t lengthInBits[],
+                 void *pDigest[],
+                 const uint32_t num)
+{
+        uint64_t E[SNOW3G_F9_MAX_LANES], P[SNOW3G_F9_MAX_LANES];
+        uint64_t minQwords = UINT64_MAX;
+        uint64_t i, V = 0;
+        uint32_t j;
+
+        for (j = 0; j < num; j++) {
+                P[j] = ((uint64_t)z[0][j] << 32) | ((uint64_t)z[1][j]);
+                E[j] = 0;
+                if ((lengthInBits[j] / 64) < minQwords)
+                        minQwords = lengthInBits[j] / 64;
+        }
+
+        /* blocks common to all buffers */
+        for (i = 0; i < minQwords; i++)
+                for (j = 0; j < num; j++) {
+                        const uint64_t *inputBuffer =
+                                (const uint64_t *)pBufferIn[j];
+
+                        V = BSWAP64(inputBuffer[i]);
+                        E[j] = F9_MUL64(E[j] ^ V, P[j]);
+                }
+
+        for (j = 0; j < num; j++) {
+                const uint64_t *inputBuffer = (const uint64_t *)pBufferIn[j];
+                const uint64_t lengthInQwords = lengthInBits[j] / 64;
+                const uint64_t rem_bits = lengthInBits[j] % 64;
+
+                /* rest of the blocks except the last one */
+                for (i = minQwords; i < lengthInQwords; i++) {
+                        V = BSWAP64(inputBuffer[i]);
+                        E[j] = F9_MUL64(E[j] ^ V, P[j]);
+                }
+
+                /* last bits of last block if any left */
+                if (rem_bits) {
+                        /* last bytes, do not go past end of buffer */
+                        memcpy(&V, &inputBuffer[i], (rem_bits + 7) / 8);
+                        V = BSWAP64(V);
+                        /* mask extra bits */
+                        V &= (((uint64_t)-1) << (64 - rem_bits));
+                        E[j] = F9_MUL64(E[j] ^ V, P[j]);
+                }
+
+                /* Multiply by Q */
+                E[j] = F9_MUL64(E[j] ^ lengthInBits[j],
+                                (((uint64_t)z[2][j] << 32) |
+                                 ((uint64_t)z[3][j])));
+
+                /* Final MAC */
+                *(uint32_t *)pDigest[j] =
+                        (uint32_t)BSWAP64(E[j] ^ ((uint64_t)z[4][j] << 32));
+        }
+#ifdef SAFE_DATA
+        CLEAR_MEM(E, sizeof(E));
+        CLEAR_MEM(P, sizeof(P));
+        CLEAR_VAR(&V, sizeof(V));
+#endif /* SAFE_DATA */
+}
+
+/**
+ * @brief F9 of 4 buffers with individual keys
+ *
+ * Key stream of the 4 buffers is generated in parallel.
+ *
+ * @param[in]  pKey          array of 4 key schedules
+ * @param[in]  pIV           array of 4 IV's
+ * @param[in]  pBufferIn     array of 4 input buffers
+ * @param[in]  lengthInBits  array of 4 message lengths in bits
+ * @param[out] pDigest       array of 4 pointers to store the F9 digests
+ * @param[in]  num           number of buffers to compute digests for (2 - 4)
+ */
+static inline void
+snow3g_f9_4_buffer_multikey(const snow3g_key_schedule_t * const pKey[],
+                            const void * const pIV[],
+                            const void * const pBufferIn[],
+                            const uint64_t lengthInBits[],
+                            void *pDigest[],
+                            const uint32_t num)
+{
+        snow3gKeyState4_t ctx;
+        __m128i ks[5];
+        DECLARE_ALIGNED(uint32_t z[5][SNOW3G_F9_MAX_LANES], 16);
+        int i;
+
+        snow3gStateInitialize_4_multiKey(&ctx, pKey, pIV);
+        snow3g_f9_4_keystream_words(&ctx, ks);
+
+        for (i = 0; i < 5; i++)
+                _mm_store_si128((__m128i *)z[i], ks[i]);
+
+        snow3g_f9_n_eval((const uint32_t (*)[SNOW3G_F9_MAX_LANES]) z,
+                         pBufferIn, lengthInBits, pDigest, num);
+#ifdef SAFE_DATA
+        CLEAR_MEM(&ctx, sizeof(ctx));
+        CLEAR_MEM(ks, sizeof(ks));
+        CLEAR_MEM(z, sizeof(z));
+#endif /* SAFE_DATA */
+}
+
+#ifdef AVX2
+/**
+ * @brief F9 of 8 buffers with individual keys
+ *
+ * Key stream of the 8 buffers is generated in parallel.
+ *
+ * @param[in]  pKey          array of 8 key schedules
+ * @param[in]  pIV           array of 8 IV's
+ * @param[in]  pBufferIn     array of 8 input buffers
+ * @param[in]  lengthInBits  array of 8 message lengths in bits
+ * @param[out] pDigest       array of 8 pointers to store the F9 digests
+ */
+static inline void
+snow3g_f9_8_buffer_multikey(const snow3g_key_schedule_t * const pKey[],
+                            const void * const pIV[],
+                            const void * const pBufferIn[],
+                            const uint64_t lengthInBits[],
+                            void *pDigest[])
+{
+        snow3gKeyState8_t ctx;
+        __m256i ks[5];
+        DECLARE_ALIGNED(uint32_t z[5][SNOW3G_F9_MAX_LANES], 32);
+        int i;
+
+        snow3gStateInitialize_8_multiKey(&ctx, pKey, pIV);
+        snow3g_f9_8_keystream_words(&ctx, ks);
+
+        for (i = 0; i < 5; i++)
+                _mm256_store_si256((__m256i *)z[i], ks[i]);
+
+        snow3g_f9_n_eval((const uint32_t (*)[SNOW3G_F9_MAX_LANES]) z,
+                         pBufferIn, lengthInBits, pDigest, 8);
+#ifdef SAFE_DATA
+        CLEAR_MEM(&ctx, sizeof(ctx));
+        CLEAR_MEM(ks, sizeof(ks));
+        CLEAR_MEM(z, sizeof(z));
+#endif /* SAFE_DATA */
+}
+#endif /* AVX2 */
+
+/**
+ * @brief Multi-key N buffer F9 processing up to 8 buffers at a time
+ *
+ * @param[in]  pKey          array of key schedules
+ * @param[in]  pIV           array of IV's
+ * @param[in]  pBufferIn     array of input buffers
+ * @param[in]  lengthInBits  array of message lengths in bits
+ * @param[out] pDigest       array of pointers to store the F9 digests
+ * @param[in]  bufferCount   number of buffers (up to 8)
+ */
+static inline void
+snow3g_f9_8_n_buffer_multikey(const snow3g_key_schedule_t * const pKey[],
+                              const void * const pIV[],
+                              const void * const pBufferIn[],
+                              const uint64_t lengthInBits[],
+                              void *pDigest[],
+                              const uint32_t bufferCount)
+{
+        uint32_t idx = 0, left = bufferCount;
+
+#ifdef AVX2
+        if (left == 8) {
+                snow3g_f9_8_buffer_multikey(pKey, pIV, pBufferIn,
+                                            lengthInBits, pDigest);
+                return;
+        }
+#endif
+        if (left > 4) {
+                snow3g_f9_4_buffer_multikey(pKey, pIV, pBufferIn,
+                                            lengthInBits, pDigest, 4);
+                idx = 4;
+                left -= 4;
+        }
+
+        if (left == 1) {
+                SNOW3G_F9_1_BUFFER(pKey[idx], pIV[idx], pBufferIn[idx],
+                                   lengthInBits[idx], pDigest[idx]);
+        } else if (left != 0) {
+                /*
+                 * Unused lanes repeat the first buffer of the group,
+                 * as F9 only reads the buffers. Their digests are not used.
+                 */
+                const snow3g_key_schedule_t *keys[4];
+                const void *ivs[4];
+                const void *ins[4];
+                void *digests[4];
+                uint64_t lens[4];
+                uint32_t i;
+
+                for (i = 0; i < 4; i++) {
+                        const uint32_t j = idx + ((i < left) ? i : 0);
+
+                        keys[i] = pKey[j];
+                        ivs[i] = pIV[j];
+                        ins[i] = pBufferIn[j];
+                        digests[i] = pDigest[j];
+                        lens[i] = lengthInBits[j];
+                }
+
+                snow3g_f9_4_buffer_multikey(keys, ivs, ins, lens,
+                                            digests, left);
+        }
+}
+
+#ifdef AVX512
+/**
+ * @brief F9 of up to 16 buffers with individual keys
+ *
+ * Key stream of the 16 buffers is generated in parallel.
+ *
+ * @param[in]  pKey          array of 16 key schedules
+ * @param[in]  pIV           array of 16 IV's
+ * @param[in]  pBufferIn     array of 16 input buffers
+ * @param[in]  lengthInBits  array of 16 message lengths in bits
+ * @param[out] pDigest       array of 16 pointers to store the F9 digests
+ * @param[in]  num           number of buffers to compute digests for (9 - 16)
+ */
+static inline void
+snow3g_f9_16_buffer_multikey(const snow3g_key_schedule_t * const pKey[],
+                             const void * const pIV[],
+                             const void * const pBufferIn[],
+                             const uint64_t lengthInBits[],
+                             void *pDigest[],
+                             const uint32_t num)
+{
+        snow3gKeyState16_t ctx;
+        __m512i ks[5];
+        DECLARE_ALIGNED(uint32_t z[5][SNOW3G_F9_MAX_LANES], 64);
+        int i;
+
+        snow3gStateInitialize_16_multiKey(&ctx, pKey, pIV);
+        snow3g_f9_16_keystream_words(&ctx, ks);
+
+        for (i = 0; i < 5; i++)
+                _mm512_store_si512((__m512i *)z[i], ks[i]);
+
+        snow3g_f9_n_eval((const uint32_t (*)[SNOW3G_F9_MAX_LANES]) z,
+                         pBufferIn, lengthInBits, pDigest, num);
+#ifdef SAFE_DATA
+        CLEAR_MEM(&ctx, sizeof(ctx));
+        CLEAR_MEM(ks, sizeof(ks));
+        CLEAR_MEM(z, sizeof(z));
+#endif /* SAFE_DATA */
+}
+
+/**
+ * @brief Multi-key N buffer F9 processing up to 16 buffers at a time
+ *
+ * @param[in]  pKey          array of key schedules
+ * @param[in]  pIV           array of IV's
+ * @param[in]  pBufferIn     array of input buffers
+ * @param[in]  lengthInBits  array of message lengths in bits
+ * @param[out] pDigest       array of pointers to store the F9 digests
+ * @param[in]  bufferCount   number of buffers (up to 16)
+ */
+static inline void
+snow3g_f9_16_n_buffer_multikey(const snow3g_key_schedule_t * const pKey[],
+                               const void * const pIV[],
+                               const void * const pBufferIn[],
+                               const uint64_t lengthInBits[],
+                               void *pDigest[],
+                               const uint32_t bufferCount)
+{
+        const snow3g_key_schedule_t *keys[16];
+        const void *ivs[16];
+        const void *ins[16];
+        void *digests[16];
+        uint64_t lens[16];
+        uint32_t i;
+
+        if (bufferCount <= 8) {
+                snow3g_f9_8_n_buffer_multikey(pKey, pIV, pBufferIn,
+                                              lengthInBits, pDigest,
+                                              bufferCount);
+                return;
+        }
+
+        /* Unused lanes repeat the first buffer, their digests are not used */
+        for (i = 0; i < 16; i++) {
+                const uint32_t j = (i < bufferCount) ? i : 0;
+
+                keys[i] = pKey[j];
+                ivs[i] = pIV[j];
+                ins[i] = pBufferIn[j];
+                digests[i] = pDigest[j];
+                lens[i] = lengthInBits[j];
+        }
+
+        snow3g_f9_16_buffer_multikey(keys, ivs, ins, lens, digests,
+                                     bufferCount);
+}
+#endif /* AVX512 */
+
+/**
+ * @brief N buffer F9 function
+ *
+ * Digests of N buffers with individual IV's and the same key,
+ * key stream is generated 4 (SSE/AVX), 8 (AVX2) or 16 (AVX512) buffers
+ * at a time.
+ *
+ * @param[in]  pHandle       pointer to precomputed key schedule
+ * @param[in]  pIV           array of IV's
+ * @param[in]  pBufferIn     array of input buffers
+ * @param[in]  lengthInBits  array of message lengths in bits
+ * @param[out] pDigest       array of pointers to store the F9 digests
+ * @param[in]  bufferCount   number of buffers
+ */
+void SNOW3G_F9_N_BUFFER(const snow3g_key_schedule_t *pHandle,
+                        const void * const pIV[],
+                        const void * const pBufferIn[],
+                        const uint64_t lengthInBits[],
+                        void *pDigest[],
+                        const uint32_t bufferCount)
+{
+        const snow3g_key_schedule_t *keys[SNOW3G_F9_MAX_LANES];
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if ((pHandle == NULL) || (pIV == NULL) || (pBufferIn == NULL) ||
+            (lengthInBits == NULL) || (pDigest == NULL))
+                return;
+
+        for (i = 0; i < bufferCount; i++)
+                if ((pIV[i] == NULL) || (pBufferIn[i] == NULL) ||
+                    (pDigest[i] == NULL) || (lengthInBits[i] == 0) ||
+                    (lengthInBits[i] > SNOW3G_MAX_BITLEN))
+                        return;
+#endif
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+        for (i = 0; i < SNOW3G_F9_MAX_LANES; i++)
+                keys[i] = pHandle;
+
+        for (i = 0; i < bufferCount; i += SNOW3G_F9_MAX_LANES) {
+                const uint32_t left = bufferCount - i;
+                const uint32_t num = (left > SNOW3G_F9_MAX_LANES) ?
+                        SNOW3G_F9_MAX_LANES : left;
+
+#ifdef AVX512
+                snow3g_f9_16_n_buffer_multikey(keys, &pIV[i], &pBufferIn[i],
+                                               &lengthInBits[i], &pDigest[i],
+                                               num);
+#else
+                snow3g_f9_8_n_buffer_multikey(keys, &pIV[i], &pBufferIn[i],
+                                              &lengthInBits[i], &pDigest[i],
+                                              num);
+#endif
+        }
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+}
+
+/**
+ * @brief Multi-key N buffer F9 function
+ *
+ * Digests of N buffers with individual keys and IV's,
+ * key stream is generated 4 (SSE/AVX), 8 (AVX2) or 16 (AVX512) buffers
+ * at a time.
+ *
+ * @param[in]  pKey          array of key schedules
+ * @param[in]  pIV           array of IV's
+ * @param[in]  pBufferIn     array of input buffers
+ * @param[in]  lengthInBits  array of message lengths in bits
+ * @param[out] pDigest       array of pointers to store the F9 digests
+ * @param[in]  bufferCount   number of buffers
+ */
+void SNOW3G_F9_N_BUFFER_MULTIKEY(const snow3g_key_schedule_t * const pKey[],
+                                 const void * const pIV[],
+                                 const void * const pBufferIn[],
+                                 const uint64_t lengthInBits[],
+                                 void *pDigest[],
+                                 const uint32_t bufferCount)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if ((pKey == NULL) || (pIV == NULL) || (pBufferIn == NULL) ||
+            (lengthInBits == NULL) || (pDigest == NULL))
+                return;
+
+        for (i = 0; i < bufferCount; i++)
+                if ((pKey[i] == NULL) || (pIV[i] == NULL) ||
+                    (pBufferIn[i] == NULL) || (pDigest[i] == NULL) ||
+                    (lengthInBits[i] == 0) ||
+                    (lengthInBits[i] > SNOW3G_MAX_BITLEN))
+                        return;
+#endif
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+        for (i = 0; i < bufferCount; i += SNOW3G_F9_MAX_LANES) {
+                const uint32_t left = bufferCount - i;
+                const uint32_t num = (left > SNOW3G_F9_MAX_LANES) ?
+                        SNOW3G_F9_MAX_LANES : left;
+
+#ifdef AVX512
+                snow3g_f9_16_n_buffer_multikey(&pKey[i], &pIV[i],
+                                               &pBufferIn[i],
+                                               &lengthInBits[i], &pDigest[i],
+                                               num);
+#else
+                snow3g_f9_8_n_buffer_multikey(&pKey[i], &pIV[i],
+                                              &pBufferIn[i],
+                                              &lengthInBits[i], &pDigest[i],
+                                              num);
+#endif
+        }
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+}
+
 #endif /* SNOW3G_COMMON_H */
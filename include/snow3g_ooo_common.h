@@ -0,0 +1,341 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer SNOW3G-UEA2 and SNOW3G-UIA2 out-of-order managers.
+ *
+ * Jobs with individual keys and IV's are collected in
+ * SNOW3G_OOO_LANES (8, or 16 for AVX512) lanes and passed to the multi-key
+ * F8/F9 function once all lanes are used (or on flush).
+ *
+ * UEA2: key stream generation of all lanes runs in parallel up to
+ * the shortest buffer, the rest of each buffer is processed by
+ * the single buffer code.
+ * UIA2: key stream words of 4 (SSE/AVX), 8 (AVX2) or 16 (AVX512) lanes
+ * are generated in parallel, the EVAL_MUL hash of all lanes runs
+ * in the same loop.
+ *
+ * All lanes complete in one call, so the processed jobs are kept
+ * in their lanes (done_lanes) and returned one per submit/flush call.
+ * This way each job still goes through the rest of the manager
+ * (cipher job through the hash stage and vice versa).
+ *
+ * The including file defines the manager(s) to build:
+ * - SUBMIT_JOB_SNOW3G_UEA2, FLUSH_JOB_SNOW3G_UEA2 and
+ *   SNOW3G_F8_8_BUFFER_MULTIKEY (SNOW3G_F8_16_BUFFER_MULTIKEY for 16 lanes)
+ * - SUBMIT_JOB_SNOW3G_UIA2, FLUSH_JOB_SNOW3G_UIA2 and
+ *   SNOW3G_F9_N_BUFFER_MULTIKEY
+ * and optionally SNOW3G_OOO_LANES (8 by default).
+ */
+
+#ifndef SNOW3G_OOO_COMMON_H
+#define SNOW3G_OOO_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "ipsec_ooo_mgr.h"
+#include "include/snow3g.h"
+#include "include/clear_regs_mem.h"
+
+#ifndef SNOW3G_OOO_LANES
+#define SNOW3G_OOO_LANES 8
+#endif
+
+/**
+ * @brief Releases the lowest processed lane and returns its job
+ *
+ * @param [in/out] state  SNOW3G OOO manager (done_lanes can't be 0)
+ * @param [in] status     Status bit to set in the job
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+snow3g_ooo_release(MB_MGR_SNOW3G_OOO *state, const int status)
+{
+        unsigned lane;
+        IMB_JOB *job;
+
+        for (lane = 0; lane < SNOW3G_OOO_LANES; lane++)
+                if (state->done_lanes & (UINT64_C(1) << lane))
+                        break;
+
+        job = state->job_in_lane[lane];
+        state->done_lanes &= ~(UINT64_C(1) << lane);
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+
+        job->status |= status;
+        return job;
+}
+
+/**
+ * @brief Marks all used lanes as processed and returns one of the jobs
+ *
+ * @param [in/out] state  SNOW3G OOO manager
+ * @param [in] status     Status bit to set in the job
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+snow3g_ooo_complete(MB_MGR_SNOW3G_OOO *state, const int status)
+{
+        unsigned lane;
+
+        for (lane = 0; lane < SNOW3G_OOO_LANES; lane++)
+                if (state->job_in_lane[lane] != NULL)
+                        state->done_lanes |= (UINT64_C(1) << lane);
+
+        return snow3g_ooo_release(state, status);
+}
+
+#ifdef SUBMIT_JOB_SNOW3G_UEA2
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_SNOW3G_UEA2(MB_MGR_SNOW3G_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_SNOW3G_UEA2(MB_MGR_SNOW3G_OOO *state);
+
+/**
+ * @brief Processes all lanes and returns one of the jobs
+ *
+ * All lanes are processed, unused lanes have to point to
+ * valid buffers (see flush).
+ *
+ * @param [in/out] state  SNOW3G OOO manager
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+snow3g_uea2_ooo_process(MB_MGR_SNOW3G_OOO *state)
+{
+#if SNOW3G_OOO_LANES == 16
+        SNOW3G_F8_16_BUFFER_MULTIKEY(state->args.keys, state->args.iv,
+                                     state->args.in, state->args.out,
+                                     state->lens);
+#else
+        SNOW3G_F8_8_BUFFER_MULTIKEY(state->args.keys, state->args.iv,
+                                    state->args.in, state->args.out,
+                                    state->lens);
+#endif
+
+        return snow3g_ooo_complete(state, STS_COMPLETED_AES);
+}
+
+/**
+ * @brief Puts a job into a free lane and processes the lanes if all are used
+ *
+ * @param [in/out] state  SNOW3G OOO manager
+ * @param [in] job        Job to submit (byte length, no bit offset)
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_SNOW3G_UEA2(MB_MGR_SNOW3G_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        state->lens[lane] = (uint32_t) (job->msg_len_to_cipher_in_bits >> 3);
+        state->args.keys[lane] = job->enc_keys;
+        state->args.iv[lane] = job->iv;
+        state->args.in[lane] = job->src;
+        state->args.out[lane] = job->dst;
+
+        /* jobs from the last run are returned first */
+        if (state->done_lanes != 0)
+                return snow3g_ooo_release(state, STS_COMPLETED_AES);
+
+        if (state->num_lanes_inuse < SNOW3G_OOO_LANES)
+                return NULL;
+
+        return snow3g_uea2_ooo_process(state);
+}
+
+/**
+ * @brief Completes one job of the manager
+ *
+ * Empty lanes get the key and IV of a valid lane and
+ * process the scratch buffer of the manager.
+ *
+ * @param [in/out] state  SNOW3G OOO manager
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_SNOW3G_UEA2(MB_MGR_SNOW3G_OOO *state)
+{
+        uint32_t scratch_len = SNOW3G_OOO_SCRATCH_SIZE;
+        unsigned lane, good_lane = 0;
+        IMB_JOB *job;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        if (state->done_lanes != 0)
+                return snow3g_ooo_release(state, STS_COMPLETED_AES);
+
+        for (lane = 0; lane < SNOW3G_OOO_LANES; lane++) {
+                if (state->job_in_lane[lane] == NULL)
+                        continue;
+                good_lane = lane;
+                if (state->lens[lane] < scratch_len)
+                        scratch_len = state->lens[lane];
+        }
+
+        /*
+         * Empty lanes don't extend the common length
+         * processed in parallel by the valid lanes.
+         */
+        for (lane = 0; lane < SNOW3G_OOO_LANES; lane++) {
+                if (state->job_in_lane[lane] != NULL)
+                        continue;
+                state->args.keys[lane] = state->args.keys[good_lane];
+                state->args.iv[lane] = state->args.iv[good_lane];
+                state->args.in[lane] = state->scratch;
+                state->args.out[lane] = state->scratch;
+                state->lens[lane] = scratch_len;
+        }
+
+        job = snow3g_uea2_ooo_process(state);
+
+#ifdef SAFE_DATA
+        /* scratch buffer holds key stream now */
+        clear_mem(state->scratch, sizeof(state->scratch));
+#endif
+        return job;
+}
+#endif /* SUBMIT_JOB_SNOW3G_UEA2 */
+
+#ifdef SUBMIT_JOB_SNOW3G_UIA2
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_SNOW3G_UIA2(MB_MGR_SNOW3G_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_SNOW3G_UIA2(MB_MGR_SNOW3G_OOO *state);
+
+/**
+ * @brief Computes the digests of all used lanes and returns one of the jobs
+ *
+ * Used lanes are passed to the multi-key F9 function,
+ * so empty lanes don't need to be filled on flush.
+ *
+ * @param [in/out] state  SNOW3G OOO manager (can't be empty)
+ *
+ * @return Completed job
+ */
+__forceinline
+IMB_JOB *
+snow3g_uia2_ooo_process(MB_MGR_SNOW3G_OOO *state)
+{
+        const snow3g_key_schedule_t *keys[SNOW3G_OOO_LANES];
+        const void *iv[SNOW3G_OOO_LANES];
+        const void *in[SNOW3G_OOO_LANES];
+        void *digest[SNOW3G_OOO_LANES];
+        uint64_t lens[SNOW3G_OOO_LANES];
+        unsigned lane, num = 0;
+
+        for (lane = 0; lane < SNOW3G_OOO_LANES; lane++) {
+                if (state->job_in_lane[lane] == NULL)
+                        continue;
+                keys[num] = state->args.keys[lane];
+                iv[num] = state->args.iv[lane];
+                in[num] = state->args.in[lane];
+                digest[num] = state->args.out[lane];
+                lens[num] = state->lens[lane];
+                num++;
+        }
+
+        SNOW3G_F9_N_BUFFER_MULTIKEY(keys, iv, in, lens, digest, num);
+
+        return snow3g_ooo_complete(state, STS_COMPLETED_HMAC);
+}
+
+/**
+ * @brief Puts a job into a free lane and processes the lanes if all are used
+ *
+ * @param [in/out] state  SNOW3G-UIA2 OOO manager
+ * @param [in] job        Job to submit
+ *
+ * @return Completed job
+ * @retval NULL if no job completed
+ */
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_SNOW3G_UIA2(MB_MGR_SNOW3G_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+        /* bit length, up to SNOW3G_MAX_BITLEN */
+        state->lens[lane] = (uint32_t) job->msg_len_to_hash_in_bits;
+        state->args.keys[lane] = (const snow3g_key_schedule_t *)
+                job->u.SNOW3G_UIA2._key;
+        state->args.iv[lane] = job->u.SNOW3G_UIA2._iv;
+        state->args.in[lane] = job->src + job->hash_start_src_offset_in_bytes;
+        state->args.out[lane] = job->auth_tag_output;
+
+        /* jobs from the last run are returned first */
+        if (state->done_lanes != 0)
+                return snow3g_ooo_release(state, STS_COMPLETED_HMAC);
+
+        if (state->num_lanes_inuse < SNOW3G_OOO_LANES)
+                return NULL;
+
+        return snow3g_uia2_ooo_process(state);
+}
+
+/**
+ * @brief Completes one job of the manager
+ *
+ * @param [in/out] state  SNOW3G-UIA2 OOO manager
+ *
+ * @return Completed job
+ * @retval NULL if the manager is empty
+ */
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_SNOW3G_UIA2(MB_MGR_SNOW3G_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        if (state->done_lanes != 0)
+                return snow3g_ooo_release(state, STS_COMPLETED_HMAC);
+
+        return snow3g_uia2_ooo_process(state);
+}
+#endif /* SUBMIT_JOB_SNOW3G_UIA2 */
+
+#endif /* SNOW3G_OOO_COMMON_H */
@@ -218,7 +218,8 @@ typedef enum {
         IMB_CIPHER_CNTR_BITLEN,       /* 128-EEA2/NEA2 (3GPP) */
         IMB_CIPHER_ZUC_EEA3,          /* 128-EEA3/NEA3 (3GPP) */
         IMB_CIPHER_SNOW3G_UEA2_BITLEN,/* 128-UEA2 (3GPP) */
-        IMB_CIPHER_KASUMI_UEA1_BITLEN /* 128-UEA1 (3GPP) */
+        IMB_CIPHER_KASUMI_UEA1_BITLEN,/* 128-UEA1 (3GPP) */
+        IMB_CIPHER_NUM
 } JOB_CIPHER_MODE;
 
 typedef enum {
@@ -250,6 +251,7 @@ typedef enum {
         IMB_AUTH_DOCSIS_CRC32,       /* with DOCSIS_SEC_BPI only */
         IMB_AUTH_SNOW3G_UIA2_BITLEN, /* 128-UIA2 (3GPP) */
         IMB_AUTH_KASUMI_UIA1,        /* 128-UIA1 (3GPP) */
+        IMB_AUTH_NUM
 } JOB_HASH_ALG;
 
 typedef enum {
@@ -509,6 +511,7 @@ typedef IMB_JOB *(*submit_job_t)(struct IMB_MGR *);
 typedef IMB_JOB *(*get_completed_job_t)(struct IMB_MGR *);
 typedef IMB_JOB *(*flush_job_t)(struct IMB_MGR *);
 typedef uint32_t (*queue_size_t)(struct IMB_MGR *);
+typedef uint32_t (*burst_fn_t)(struct IMB_MGR *, IMB_JOB **, const uint32_t);
 typedef void (*keyexp_t)(const void *, void *, void *);
 typedef void (*cmac_subkey_gen_t)(const void *, void *, void *);
 typedef void (*hash_one_block_t)(const void *, void *);
@@ -660,6 +663,11 @@ typedef void
                                  const void * const [], const void * const [],
                                  void *[], const uint32_t[]);
 
+typedef void
+(*snow3g_f8_16_buffer_multikey_t)(const snow3g_key_schedule_t * const [],
+                                  const void * const [], const void * const [],
+                                  void *[], const uint32_t[]);
+
 typedef void (*snow3g_f8_n_buffer_t)(const snow3g_key_schedule_t *,
                                      const void * const [],
                                      const void * const [],
@@ -677,17 +685,74 @@ typedef void (*snow3g_f9_1_buffer_t)(const snow3g_key_schedule_t *,
                                      const void *, const void *,
                                      const uint64_t, void *);
 
+typedef void (*snow3g_f9_n_buffer_t)(const snow3g_key_schedule_t *,
+                                     const void * const [],
+                                     const void * const [],
+                                     const uint64_t [], void *[],
+                                     const uint32_t);
+
+typedef void
+(*snow3g_f9_n_buffer_multikey_t)(const snow3g_key_schedule_t * const [],
+                                 const void * const [],
+                                 const void * const [],
+                                 const uint64_t [], void *[],
+                                 const uint32_t);
+
 typedef int (*snow3g_init_key_sched_t)(const void *,
                                        snow3g_key_schedule_t *);
 
 typedef size_t (*snow3g_key_sched_size_t)(void);
 
+/* ========================================================================== */
+/* CRC types passed to crc_n_buffer() */
+
+typedef enum {
+        IMB_CRC_TYPE_CRC32_ETHERNET_FCS = 0, /* Ethernet FCS (reflected) */
+        IMB_CRC_TYPE_CRC16_CCITT,       /* 3GPP gCRC16 (TS 38.212) */
+        IMB_CRC_TYPE_CRC24_A,           /* 3GPP gCRC24A (TS 38.212) */
+        IMB_CRC_TYPE_CRC24_B,           /* 3GPP gCRC24B (TS 38.212) */
+        IMB_CRC_TYPE_CRC11,             /* 3GPP gCRC11 (TS 38.212) */
+        IMB_CRC_TYPE_CRC6,              /* 3GPP gCRC6 (TS 38.212) */
+        IMB_CRC_TYPE_NUM
+} IMB_CRC_TYPE;
+
+typedef uint32_t (*crc32_fn_t)(const void *, const uint64_t);
+
+typedef void (*crc_n_buffer_t)(const IMB_CRC_TYPE, const void * const [],
+                               const uint64_t [], uint32_t [],
+                               const uint32_t);
+
 /* ========================================================================== */
 /* Multi-buffer manager flags passed to alloc_mb_mgr() */
 
 #define IMB_FLAG_SHANI_OFF (1ULL << 0) /* disable use of SHANI extension */
 #define IMB_FLAG_AESNI_OFF (1ULL << 1) /* disable use of AESNI extension */
 
+/* ========================================================================== */
+/* Algorithm groups passed to alloc_mb_mgr_algos()
+ * - out-of-order managers get allocated and initialized only
+ *   for the selected groups
+ * - jobs from other groups get rejected with STS_INVALID_ARGS
+ */
+
+#define IMB_ALGO_AES_CBC   (1ULL << 0)  /* AES-CBC */
+#define IMB_ALGO_AES_CTR   (1ULL << 1)  /* AES-CTR */
+#define IMB_ALGO_AES_GCM   (1ULL << 2)  /* AES-GCM and AES-GMAC */
+#define IMB_ALGO_AES_CCM   (1ULL << 3)  /* AES-CCM */
+#define IMB_ALGO_AES_CMAC  (1ULL << 4)  /* AES-CMAC */
+#define IMB_ALGO_AES_XCBC  (1ULL << 5)  /* AES-XCBC */
+#define IMB_ALGO_HMAC_SHA1 (1ULL << 6)  /* HMAC-SHA1 */
+#define IMB_ALGO_HMAC_SHA2 (1ULL << 7)  /* HMAC-SHA224/256/384/512 */
+#define IMB_ALGO_HMAC_MD5  (1ULL << 8)  /* HMAC-MD5 */
+#define IMB_ALGO_SHA       (1ULL << 9)  /* plain SHA1/224/256/384/512 */
+#define IMB_ALGO_DES       (1ULL << 10) /* DES and 3DES */
+#define IMB_ALGO_DOCSIS    (1ULL << 11) /* DOCSIS SEC BPI and DOCSIS DES */
+#define IMB_ALGO_ZUC       (1ULL << 12) /* ZUC-EEA3 and ZUC-EIA3 */
+#define IMB_ALGO_SNOW3G    (1ULL << 13) /* SNOW3G-UEA2 and SNOW3G-UIA2 */
+#define IMB_ALGO_KASUMI    (1ULL << 14) /* KASUMI-UEA1 and KASUMI-UIA1 */
+#define IMB_ALGO_PON       (1ULL << 15) /* PON AES-CTR with CRC and BIP */
+#define IMB_ALGO_ALL       ((1ULL << 16) - 1)
+
 /* ========================================================================== */
 /* Multi-buffer manager detected features
  * - if bit is set then hardware supports given extension
@@ -715,24 +780,55 @@ typedef size_t (*snow3g_key_sched_size_t)(void);
 #define IMB_FEATURE_SAFE_DATA  (1ULL << 14)
 #define IMB_FEATURE_SAFE_PARAM (1ULL << 15)
 #define IMB_FEATURE_GFNI       (1ULL << 16)
+#define IMB_FEATURE_STATS      (1ULL << 17)
 
 /* ========================================================================== */
 /* TOP LEVEL (IMB_MGR) Data structure fields */
 
 #define MAX_JOBS 128
 
+/*
+ * Performance counters of multi-buffer manager instance,
+ * available with MB_STATS builds only (see imb_get_mb_mgr_stats()).
+ *
+ * Cipher and hash stage counters are indexed with
+ * JOB_CIPHER_MODE and JOB_HASH_ALG values respectively.
+ * Lane histograms count jobs leaving a stage by number of jobs of
+ * the same kind (mode, direction and key size) in the stage at the time,
+ * i.e. the number of lanes occupied when the job got completed.
+ * Bucket IMB_STATS_MAX_LANES accumulates all higher values.
+ */
+#define IMB_STATS_MAX_LANES 32
+
+typedef struct {
+        uint64_t submit_calls;    /* submit_job() & submit_burst() jobs */
+        uint64_t submit_empty;    /* submit_job() calls returning NULL */
+        uint64_t flush_calls;     /* flush_job() & flush_burst() calls */
+        uint64_t forced_flushes;  /* jobs completed by flushing managers */
+        uint64_t cipher_jobs[IMB_CIPHER_NUM];
+        uint64_t cipher_bytes[IMB_CIPHER_NUM];
+        uint64_t cipher_flushes[IMB_CIPHER_NUM];
+        uint64_t cipher_lanes[IMB_CIPHER_NUM][IMB_STATS_MAX_LANES + 1];
+        uint64_t hash_jobs[IMB_AUTH_NUM];
+        uint64_t hash_bytes[IMB_AUTH_NUM];
+        uint64_t hash_flushes[IMB_AUTH_NUM];
+        uint64_t hash_lanes[IMB_AUTH_NUM][IMB_STATS_MAX_LANES + 1];
+} IMB_MGR_STATS;
+
 typedef struct IMB_MGR {
         /*
          * flags - passed to alloc_mb_mgr()
          * features - reflects features of multi-buffer instance
+         * algos - algorithm groups with out-of-order managers allocated
          */
         uint64_t flags;
         uint64_t features;
+        uint64_t algos;
 
         /*
          * Reserved for the future
          */
-        uint64_t reserved[6];
+        uint64_t reserved[5];
 
         /*
          * ARCH handlers / API
@@ -828,6 +924,24 @@ typedef struct IMB_MGR {
         aes_gcm_init_var_iv_t   gcm192_init_var_iv;
         aes_gcm_init_var_iv_t   gcm256_init_var_iv;
 
+        burst_fn_t              get_next_burst;
+        burst_fn_t              submit_burst;
+        burst_fn_t              submit_burst_nocheck;
+        burst_fn_t              get_completed_burst;
+        burst_fn_t              flush_burst;
+
+        snow3g_f9_n_buffer_t snow3g_f9_n_buffer;
+        snow3g_f9_n_buffer_multikey_t snow3g_f9_n_buffer_multikey;
+        snow3g_f8_16_buffer_multikey_t snow3g_f8_16_buffer_multikey;
+
+        crc32_fn_t              crc32_ethernet_fcs;
+        crc32_fn_t              crc16_ccitt;
+        crc32_fn_t              crc24_a;
+        crc32_fn_t              crc24_b;
+        crc32_fn_t              crc11;
+        crc32_fn_t              crc6;
+        crc_n_buffer_t          crc_n_buffer;
+
         /* in-order scheduler fields */
         int              earliest_job; /* byte offset, -1 if none */
         int              next_job;     /* byte offset */
@@ -859,6 +973,38 @@ typedef struct IMB_MGR {
         void *aes_cmac_ooo;
         void *zuc_eea3_ooo;
         void *zuc_eia3_ooo;
+        void *aes128_cntr_ooo;
+        void *aes192_cntr_ooo;
+        void *aes256_cntr_ooo;
+        void *aes128_gcm_ooo;
+        void *aes192_gcm_ooo;
+        void *aes256_gcm_ooo;
+        void *snow3g_uea2_ooo;
+        void *kasumi_uea1_ooo;
+        void *kasumi_uia1_ooo;
+        void *snow3g_uia2_ooo;
+        void *sha_1_ooo;
+        void *sha_224_ooo;
+        void *sha_256_ooo;
+        void *sha_384_ooo;
+        void *sha_512_ooo;
+        void *hmac_sha_1_ni_ooo;
+        void *hmac_sha_224_ni_ooo;
+        void *hmac_sha_256_ni_ooo;
+        void *pon_enc_ooo;
+        void *pon_dec_ooo;
+        void *docsis128_dec_ooo;
+        void *docsis256_dec_ooo;
+
+        void *stats; /* MB_STATS builds only, NULL otherwise */
+
+        /*
+         * Latency budget of the oldest job in flight, 0 - disabled
+         * (see imb_set_flush_budget())
+         */
+        uint32_t flush_budget_jobs;
+        uint64_t flush_budget_cycles;
+        uint64_t job_submit_tsc[MAX_JOBS]; /* valid with cycle budget */
 } IMB_MGR;
 
 /* ========================================================================== */
@@ -892,6 +1038,139 @@ IMB_DLL_EXPORT unsigned imb_get_version(void);
 IMB_DLL_EXPORT IMB_MGR *alloc_mb_mgr(uint64_t flags);
 IMB_DLL_EXPORT void free_mb_mgr(IMB_MGR *state);
 
+/**
+ * @brief Allocates memory for multi-buffer manager instance
+ *        with out-of-order managers for selected algorithms only
+ *
+ * Unselected algorithms cost neither memory nor initialization time.
+ * Jobs using them get rejected by submit_job() with STS_INVALID_ARGS
+ * (submit_job_nocheck() must not be used with them).
+ *
+ * @param flags multi-buffer manager flags (see alloc_mb_mgr())
+ * @param algos algorithm groups to be used (IMB_ALGO_xxx)
+ *
+ * @return Pointer to allocated memory for IMB_MGR structure,
+ *         to be released with free_mb_mgr()
+ * @retval NULL on allocation error
+ */
+IMB_DLL_EXPORT IMB_MGR *alloc_mb_mgr_algos(uint64_t flags, uint64_t algos);
+
+/**
+ * @brief Calculates necessary memory size for IMB_MGR
+ *
+ * Size covers IMB_MGR and all out-of-order managers it points to.
+ *
+ * @return Size for IMB_MGR (aligned to 64 bytes)
+ */
+IMB_DLL_EXPORT size_t imb_get_mb_mgr_size(void);
+
+/**
+ * @brief Sets up IMB_MGR in memory provided by the caller
+ *
+ * IMB_MGR and all out-of-order managers are laid out contiguously
+ * in the provided memory block, e.g. allocated from hugepages
+ * or NUMA local memory, with the most commonly used managers
+ * placed next to each other. It is an alternative to alloc_mb_mgr().
+ * The memory is owned by the caller and free_mb_mgr() must not
+ * be used on the returned pointer.
+ *
+ * init_mb_mgr_xxx() still needs to be called on the returned IMB_MGR.
+ *
+ * @param mem_ptr   pointer to 64 byte aligned memory
+ *                  of at least imb_get_mb_mgr_size() bytes
+ * @param flags     multi-buffer manager flags (see alloc_mb_mgr())
+ * @param reset_mgr if non-zero, memory block gets zeroed first
+ *
+ * @return Pointer to IMB_MGR structure (equal to \a mem_ptr)
+ * @retval NULL on invalid parameters
+ */
+IMB_DLL_EXPORT IMB_MGR *imb_set_pointers_mb_mgr(void *mem_ptr,
+                                                const uint64_t flags,
+                                                const unsigned reset_mgr);
+
+/**
+ * @brief Calculates necessary memory size for IMB_MGR
+ *        with out-of-order managers for selected algorithms only
+ *
+ * @param algos algorithm groups to be used (IMB_ALGO_xxx)
+ *
+ * @return Size for IMB_MGR (aligned to 64 bytes)
+ */
+IMB_DLL_EXPORT size_t imb_get_mb_mgr_size_algos(const uint64_t algos);
+
+/**
+ * @brief Sets up IMB_MGR in memory provided by the caller
+ *        with out-of-order managers for selected algorithms only
+ *
+ * Same as imb_set_pointers_mb_mgr() except that only managers of
+ * the selected algorithm groups get placed in the memory block
+ * (see alloc_mb_mgr_algos()).
+ *
+ * @param mem_ptr   pointer to 64 byte aligned memory
+ *                  of at least imb_get_mb_mgr_size_algos() bytes
+ * @param flags     multi-buffer manager flags (see alloc_mb_mgr())
+ * @param reset_mgr if non-zero, memory block gets zeroed first
+ * @param algos     algorithm groups to be used (IMB_ALGO_xxx)
+ *
+ * @return Pointer to IMB_MGR structure (equal to \a mem_ptr)
+ * @retval NULL on invalid parameters
+ */
+IMB_DLL_EXPORT IMB_MGR *imb_set_pointers_mb_mgr_algos(void *mem_ptr,
+                                                      const uint64_t flags,
+                                                      const unsigned reset_mgr,
+                                                      const uint64_t algos);
+
+/**
+ * @brief Sets latency budget of jobs waiting in partially filled lanes
+ *
+ * Out-of-order managers keep a job in a lane until enough jobs
+ * arrive to fill the lanes or the job gets flushed.
+ * With a budget set, submit_job() flushes the manager of the oldest
+ * job in flight once:
+ * - \a max_jobs jobs have been submitted after it, or
+ * - it has been in flight for more than \a max_cycles TSC cycles
+ *
+ * Flushed jobs get returned in order by submit_job() and
+ * get_completed_job(). get_completed_job() and get_completed_burst()
+ * check the budget too, so that it is kept when no further jobs
+ * get submitted. The budget is reset by init_mb_mgr_xxx().
+ *
+ * @param state      pointer to initialized IMB_MGR structure
+ * @param max_jobs   budget in submitted jobs, 0 - no limit
+ * @param max_cycles budget in TSC cycles, 0 - no limit
+ *
+ * @return 0 on success, -1 on invalid parameters
+ */
+IMB_DLL_EXPORT int imb_set_flush_budget(IMB_MGR *state,
+                                        const uint32_t max_jobs,
+                                        const uint64_t max_cycles);
+
+/**
+ * @brief Retrieves performance counters of multi-buffer manager
+ *
+ * Counters are only maintained when the library is built
+ * with MB_STATS=y (IMB_FEATURE_STATS set in \a features).
+ * They are cleared by init_mb_mgr_xxx() and imb_reset_mb_mgr_stats().
+ *
+ * @param state pointer to IMB_MGR structure
+ * @param stats pointer to structure to store the counters in
+ *
+ * @return 0 on success, -1 on invalid parameters
+ *         or when counters are not available
+ */
+IMB_DLL_EXPORT int imb_get_mb_mgr_stats(const IMB_MGR *state,
+                                        IMB_MGR_STATS *stats);
+
+/**
+ * @brief Clears performance counters of multi-buffer manager
+ *
+ * @param state pointer to IMB_MGR structure
+ *
+ * @return 0 on success, -1 on invalid parameters
+ *         or when counters are not available
+ */
+IMB_DLL_EXPORT int imb_reset_mb_mgr_stats(IMB_MGR *state);
+
 IMB_DLL_EXPORT void init_mb_mgr_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_nocheck_avx(IMB_MGR *state);
@@ -899,6 +1178,16 @@ IMB_DLL_EXPORT IMB_JOB *flush_job_avx(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_avx(IMB_MGR *state);
+IMB_DLL_EXPORT uint32_t get_next_burst_avx(IMB_MGR *state, IMB_JOB **jobs,
+                                           const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_avx(IMB_MGR *state, IMB_JOB **jobs,
+                                         const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_nocheck_avx(IMB_MGR *state, IMB_JOB **jobs,
+                                                 const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t get_completed_burst_avx(IMB_MGR *state, IMB_JOB **jobs,
+                                                const uint32_t max_jobs);
+IMB_DLL_EXPORT uint32_t flush_burst_avx(IMB_MGR *state, IMB_JOB **jobs,
+                                        const uint32_t max_jobs);
 
 IMB_DLL_EXPORT void init_mb_mgr_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_avx2(IMB_MGR *state);
@@ -907,6 +1196,17 @@ IMB_DLL_EXPORT IMB_JOB *flush_job_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_avx2(IMB_MGR *state);
+IMB_DLL_EXPORT uint32_t get_next_burst_avx2(IMB_MGR *state, IMB_JOB **jobs,
+                                            const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_avx2(IMB_MGR *state, IMB_JOB **jobs,
+                                          const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_nocheck_avx2(IMB_MGR *state,
+                                                  IMB_JOB **jobs,
+                                                  const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t get_completed_burst_avx2(IMB_MGR *state, IMB_JOB **jobs,
+                                                 const uint32_t max_jobs);
+IMB_DLL_EXPORT uint32_t flush_burst_avx2(IMB_MGR *state, IMB_JOB **jobs,
+                                         const uint32_t max_jobs);
 
 IMB_DLL_EXPORT void init_mb_mgr_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_avx512(IMB_MGR *state);
@@ -915,6 +1215,18 @@ IMB_DLL_EXPORT IMB_JOB *flush_job_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_avx512(IMB_MGR *state);
+IMB_DLL_EXPORT uint32_t get_next_burst_avx512(IMB_MGR *state, IMB_JOB **jobs,
+                                              const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_avx512(IMB_MGR *state, IMB_JOB **jobs,
+                                            const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_nocheck_avx512(IMB_MGR *state,
+                                                    IMB_JOB **jobs,
+                                                    const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t get_completed_burst_avx512(IMB_MGR *state,
+                                                   IMB_JOB **jobs,
+                                                   const uint32_t max_jobs);
+IMB_DLL_EXPORT uint32_t flush_burst_avx512(IMB_MGR *state, IMB_JOB **jobs,
+                                           const uint32_t max_jobs);
 
 IMB_DLL_EXPORT void init_mb_mgr_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_sse(IMB_MGR *state);
@@ -923,6 +1235,16 @@ IMB_DLL_EXPORT IMB_JOB *flush_job_sse(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
+IMB_DLL_EXPORT uint32_t get_next_burst_sse(IMB_MGR *state, IMB_JOB **jobs,
+                                           const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_sse(IMB_MGR *state, IMB_JOB **jobs,
+                                         const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t submit_burst_nocheck_sse(IMB_MGR *state, IMB_JOB **jobs,
+                                                 const uint32_t n_jobs);
+IMB_DLL_EXPORT uint32_t get_completed_burst_sse(IMB_MGR *state, IMB_JOB **jobs,
+                                                const uint32_t max_jobs);
+IMB_DLL_EXPORT uint32_t flush_burst_sse(IMB_MGR *state, IMB_JOB **jobs,
+                                        const uint32_t max_jobs);
 
 /*
  * Wrapper macros to call arch API's set up
@@ -953,6 +1275,33 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_FLUSH_JOB(_mgr)          ((_mgr)->flush_job((_mgr)))
 #define IMB_QUEUE_SIZE(_mgr)         ((_mgr)->queue_size((_mgr)))
 
+/*
+ * Burst API's
+ *
+ * get_next_burst returns up to _n free job objects (consecutive slots of
+ * the job queue) in _jobs. The return value is the number of job objects
+ * available, which is limited by the space left in the queue.
+ * All of them must be filled in and passed to submit_burst (in the same
+ * order) before get_next_burst or get_next_job is called again.
+ * submit_burst returns the number of submitted jobs (0 on invalid
+ * parameters). Jobs failing the parameter checks complete with
+ * STS_INVALID_ARGS status.
+ * get_completed_burst and flush_burst return up to _n completed job objects
+ * in submission order. flush_burst forces completion of the jobs still
+ * in flight. Returned job objects cease to be usable at the next call
+ * to get_next_burst or get_next_job.
+ */
+#define IMB_GET_NEXT_BURST(_mgr, _jobs, _n)             \
+        ((_mgr)->get_next_burst((_mgr), (_jobs), (_n)))
+#define IMB_SUBMIT_BURST(_mgr, _jobs, _n)               \
+        ((_mgr)->submit_burst((_mgr), (_jobs), (_n)))
+#define IMB_SUBMIT_BURST_NOCHECK(_mgr, _jobs, _n)       \
+        ((_mgr)->submit_burst_nocheck((_mgr), (_jobs), (_n)))
+#define IMB_GET_COMPLETED_BURST(_mgr, _jobs, _n)        \
+        ((_mgr)->get_completed_burst((_mgr), (_jobs), (_n)))
+#define IMB_FLUSH_BURST(_mgr, _jobs, _n)                \
+        ((_mgr)->flush_burst((_mgr), (_jobs), (_n)))
+
 /* Key expansion and generation API's */
 #define IMB_AES_KEYEXP_128(_mgr, _raw, _enc, _dec)      \
         ((_mgr)->keyexp_128((_raw), (_enc), (_dec)))
@@ -1497,6 +1846,22 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
         ((_mgr)->snow3g_f8_8_buffer_multikey((_ctx), (_iv), (_in), (_out),\
                                              (_len)))
 
+/**
+ * This function performs snow3g f8 operation on sixteen buffers. They will
+ * be processed with individual keys, which have already been scheduled
+ * with snow3g_init_key_sched().
+ *
+ * @param[in]  mgr      Pointer to multi-buffer structure
+ * @param[in]  ctx      Array of 16 Contexts, where the scheduled keys are stored
+ * @param[in]  iv       Array of 16 IV values
+ * @param[in]  in       Array of 16 input buffers
+ * @param[out] out      Array of 16 output buffers
+ * @param[in]  lens     Array of 16 corresponding input buffer lengths
+ */
+#define IMB_SNOW3G_F8_16_BUFFER_MULTIKEY(_mgr, _ctx, _iv, _in, _out, _len) \
+        ((_mgr)->snow3g_f8_16_buffer_multikey((_ctx), (_iv), (_in), (_out),\
+                                              (_len)))
+
 /**
  * This function performs snow3g f8 operation in parallel on N buffers. All
  * input buffers can have different lengths and they will be processed with the
@@ -1552,6 +1917,43 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_SNOW3G_F9_1_BUFFER(_mgr, _ctx, _iv, _in, _len, _digest)     \
         ((_mgr)->snow3g_f9_1_buffer((_ctx), (_iv), (_in), (_len), (_digest)))
 
+/**
+ * This function performs snow3g f9 operation in parallel on N buffers.
+ * All buffers use the same key, which has already been scheduled with
+ * snow3g_init_key_sched(). Input buffers can have different lengths.
+ *
+ * @param[in]  mgr      Pointer to multi-buffer structure
+ * @param[in]  ctx      Context where the scheduled keys are stored
+ * @param[in]  iv       Array of IV's (see IMB_SNOW3G_F9_1_BUFFER)
+ * @param[in]  in       Array of input buffers
+ * @param[in]  len      Array of lengths in bits of the data to be hashed
+ * @param[out] digest   Array of pointers to the computed digests
+ * @param[in]  count    Number of input buffers
+ */
+#define IMB_SNOW3G_F9_N_BUFFER(_mgr, _ctx, _iv, _in, _len, _digest,     \
+                               _count)                                  \
+        ((_mgr)->snow3g_f9_n_buffer((_ctx), (_iv), (_in), (_len),       \
+                                    (_digest), (_count)))
+
+/**
+ * This function performs snow3g f9 operation in parallel on N buffers.
+ * Each buffer uses its own key, scheduled with snow3g_init_key_sched().
+ * Input buffers can have different lengths.
+ *
+ * @param[in]  mgr      Pointer to multi-buffer structure
+ * @param[in]  ctx      Array of contexts, where the scheduled keys are stored
+ * @param[in]  iv       Array of IV's (see IMB_SNOW3G_F9_1_BUFFER)
+ * @param[in]  in       Array of input buffers
+ * @param[in]  len      Array of lengths in bits of the data to be hashed
+ * @param[out] digest   Array of pointers to the computed digests
+ * @param[in]  count    Number of input buffers
+ */
+#define IMB_SNOW3G_F9_N_BUFFER_MULTIKEY(_mgr, _ctx, _iv, _in, _len,     \
+                                        _digest, _count)                \
+        ((_mgr)->snow3g_f9_n_buffer_multikey((_ctx), (_iv), (_in),      \
+                                             (_len), (_digest),         \
+                                             (_count)))
+
 /**
  * Snow3g key schedule init function.
  *
@@ -1576,6 +1978,53 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
  ******************************************************************************/
 #define IMB_SNOW3G_KEY_SCHED_SIZE(_mgr)((_mgr)->snow3g_key_sched_size())
 
+/**
+ * Computes Ethernet FCS (CRC32, as used by IEEE 802.3) of a buffer.
+ *
+ * @param[in]  mgr      Pointer to multi-buffer structure
+ * @param[in]  in       Pointer to the data
+ * @param[in]  len      Length of the data in bytes
+ * @return CRC value
+ */
+#define IMB_CRC32_ETHERNET_FCS(_mgr, _in, _len) \
+        ((_mgr)->crc32_ethernet_fcs((_in), (_len)))
+
+/**
+ * 3GPP CRCs as defined in TS 38.212, section 5.1.
+ * Data is processed most significant bit first, with zero initial
+ * value and no final XOR. CRC value is returned in the least
+ * significant bits (e.g. bits 23:0 for CRC24A).
+ *
+ * @param[in]  mgr      Pointer to multi-buffer structure
+ * @param[in]  in       Pointer to the data
+ * @param[in]  len      Length of the data in bytes
+ * @return CRC value
+ */
+#define IMB_CRC16_CCITT(_mgr, _in, _len) \
+        ((_mgr)->crc16_ccitt((_in), (_len)))
+#define IMB_CRC24_A(_mgr, _in, _len) \
+        ((_mgr)->crc24_a((_in), (_len)))
+#define IMB_CRC24_B(_mgr, _in, _len) \
+        ((_mgr)->crc24_b((_in), (_len)))
+#define IMB_CRC11(_mgr, _in, _len) \
+        ((_mgr)->crc11((_in), (_len)))
+#define IMB_CRC6(_mgr, _in, _len) \
+        ((_mgr)->crc6((_in), (_len)))
+
+/**
+ * Computes CRC of the selected type on N buffers.
+ * Input buffers can have different lengths.
+ *
+ * @param[in]  mgr      Pointer to multi-buffer structure
+ * @param[in]  type     CRC type (see IMB_CRC_TYPE)
+ * @param[in]  in       Array of input buffers
+ * @param[in]  len      Array of lengths in bytes of the input buffers
+ * @param[out] out      Array of computed CRC values
+ * @param[in]  num      Number of input buffers
+ */
+#define IMB_CRC_N_BUFFER(_mgr, _type, _in, _len, _out, _num)            \
+        ((_mgr)->crc_n_buffer((_type), (_in), (_len), (_out), (_num)))
+
 
 /* Auxiliary functions */
 
@@ -54,16 +54,88 @@
 #define AVX2_NUM_SHA256_LANES   8
 #define AVX2_NUM_SHA512_LANES   4
 #define AVX2_NUM_MD5_LANES      16
+#define AVX2_NUM_DES_LANES      8
 
 #define AVX_NUM_SHA1_LANES      4
 #define AVX_NUM_SHA256_LANES    4
 #define AVX_NUM_SHA512_LANES    2
 #define AVX_NUM_MD5_LANES       8
+#define AVX_NUM_DES_LANES       4
 
 #define SSE_NUM_SHA1_LANES   AVX_NUM_SHA1_LANES
 #define SSE_NUM_SHA256_LANES AVX_NUM_SHA256_LANES
 #define SSE_NUM_SHA512_LANES AVX_NUM_SHA512_LANES
 #define SSE_NUM_MD5_LANES    AVX_NUM_MD5_LANES
+#define SSE_NUM_DES_LANES    AVX_NUM_DES_LANES
+
+/*
+ * AES-CTR multi-buffer manager lanes (SSE and AVX).
+ * Longer jobs fill the pipeline of the single buffer implementation
+ * and are not submitted to the manager.
+ */
+#define AES_CNTR_OOO_NUM_LANES  8
+#define AES_CNTR_OOO_MAX_LEN    256
+
+/*
+ * AES-CBC encrypt, AES-XCBC and AES-CMAC multi-buffer manager lanes (AVX2).
+ * Unused lanes keep length 0xFFFF.
+ */
+#define AES_CBC_OOO_NUM_LANES   8
+
+/*
+ * AES-XCBC multi-buffer manager lanes with VAES (AVX512).
+ * All nibbles of unused_lanes are used with 16 lanes,
+ * so num_lanes_inuse tells if the manager is full.
+ */
+#define AES_XCBC_VAES_NUM_LANES 16
+
+/*
+ * AES-GCM multi-buffer manager lanes (SSE and AVX).
+ * Only jobs with 12 byte IV and up to AES_GCM_OOO_MAX_LEN bytes
+ * of message are submitted to the manager.
+ */
+#define AES_GCM_OOO_NUM_LANES   8
+#define AES_GCM_OOO_MAX_LEN     512
+
+/*
+ * Offset of (HashKey<<1 mod poly) in struct gcm_key_data
+ * (see include/gcm_keys_sse_avx.asm and include/gcm_keys_avx2_avx512.asm).
+ * VAES precompute uses another layout, the manager is not used with it.
+ */
+#define AES_GCM_OOO_HKEY_OFFSET (16 * 22)
+
+/*
+ * SNOW3G-UEA2/UIA2 multi-buffer manager lanes.
+ * Only byte aligned UEA2 jobs (no bit offset, length multiple of 8 bits)
+ * are submitted to the manager.
+ * UEA2 lanes that are empty on flush process the scratch buffer.
+ * SSE, AVX and AVX2 managers use the first 8 lanes,
+ * the AVX512 manager uses all 16 lanes on CPUs with VAES and GFNI
+ * (num_lanes_inuse tells if the manager is full then).
+ */
+#define SNOW3G_OOO_NUM_LANES    16
+#define SNOW3G_OOO_SCRATCH_SIZE 256
+
+/*
+ * KASUMI F8/F9 multi-buffer manager lanes.
+ * Only byte aligned F8 jobs (no bit offset, length multiple of 8 bits)
+ * are submitted to the manager.
+ * All nibbles of unused_lanes are used with 16 lanes,
+ * so num_lanes_inuse tells if the manager is full.
+ */
+#define KASUMI_OOO_NUM_LANES    16
+
+/*
+ * PON (AES128-CTR + CRC32 + BIP) multi-buffer manager lanes
+ * with VAES and VPCLMULQDQ (AVX512).
+ * Lane length is the number of full 16 byte blocks covered by the CRC,
+ * the rest of the frame is done when the job completes.
+ * Jobs without a full CRC block complete on submit.
+ * All nibbles of unused_lanes are used with 16 lanes,
+ * so num_lanes_inuse tells if the manager is full.
+ */
+#define PON_OOO_NUM_LANES       16
+#define PON_OOO_NUM_ROUNDS      10
 
 /*
  * Each row is sized to hold enough lanes for AVX2, AVX1 and SSE use a subset
@@ -88,29 +160,31 @@ typedef struct {
 
 typedef struct {
         DECLARE_ALIGNED(uint32_t digest[SHA1_DIGEST_SZ], 32);
-        uint8_t *data_ptr[AVX512_NUM_SHA1_LANES];
+        const uint8_t *data_ptr[AVX512_NUM_SHA1_LANES];
 } SHA1_ARGS;
 
 typedef struct {
         DECLARE_ALIGNED(uint32_t digest[SHA256_DIGEST_SZ], 32);
-        uint8_t *data_ptr[AVX512_NUM_SHA256_LANES];
+        const uint8_t *data_ptr[AVX512_NUM_SHA256_LANES];
 } SHA256_ARGS;
 
 typedef struct {
         DECLARE_ALIGNED(uint64_t digest[SHA512_DIGEST_SZ], 32);
-        uint8_t *data_ptr[AVX512_NUM_SHA512_LANES];
+        const uint8_t *data_ptr[AVX512_NUM_SHA512_LANES];
 }  SHA512_ARGS;
 
 typedef struct {
         DECLARE_ALIGNED(uint32_t digest[MD5_DIGEST_SZ], 32);
-        uint8_t *data_ptr[AVX512_NUM_MD5_LANES];
+        const uint8_t *data_ptr[AVX512_NUM_MD5_LANES];
 } MD5_ARGS;
 
 typedef struct {
-        const uint8_t *in[8];
-        const uint32_t *keys[8];
-        DECLARE_ALIGNED(imb_uint128_t ICV[8], 32);
-} AES_XCBC_ARGS_x8;
+        const uint8_t *in[16];
+        const uint32_t *keys[16];
+        DECLARE_ALIGNED(imb_uint128_t ICV[16], 32);
+        /* VAES: round keys, key_tab[round][lane] */
+        DECLARE_ALIGNED(imb_uint128_t key_tab[11][16], 64);
+} AES_XCBC_ARGS_x16;
 
 typedef struct {
         const uint8_t *in[AVX512_NUM_DES_LANES];
@@ -142,6 +216,20 @@ typedef struct {
         uint64_t num_lanes_inuse;
 } MB_MGR_AES_OOO;
 
+/* AES-GCM out-of-order scheduler fields */
+typedef struct {
+        AES_ARGS args; /* args.IV holds the byte reflected counter block */
+        DECLARE_ALIGNED(imb_uint128_t ghash[16], 16);
+        DECLARE_ALIGNED(uint16_t lens[16], 16);
+        uint8_t decrypt[16];
+        /* each nibble is index (0...7) of an unused lane,
+         * the last nibble is set to F as a flag
+         */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[16];
+        uint64_t num_lanes_inuse;
+} MB_MGR_GCM_OOO;
+
 /* DOCSIS AES out-of-order scheduler fields */
 typedef struct {
         AES_ARGS args;
@@ -165,13 +253,14 @@ typedef struct {
 } XCBC_LANE_DATA;
 
 typedef struct {
-        AES_XCBC_ARGS_x8 args;
-        DECLARE_ALIGNED(uint16_t lens[8], 16);
+        AES_XCBC_ARGS_x16 args;
+        DECLARE_ALIGNED(uint16_t lens[16], 32);
         /* each byte is index (0...3) of unused lanes
          * byte 4 is set to FF as a flag
          */
         uint64_t unused_lanes;
-        XCBC_LANE_DATA ldata[8];
+        XCBC_LANE_DATA ldata[16];
+        uint64_t num_lanes_inuse;
 } MB_MGR_AES_XCBC_OOO;
 
 /* AES-CCM out-of-order scheduler structure */
@@ -225,6 +314,83 @@ typedef struct {
         uint64_t num_lanes_inuse;
 } MB_MGR_ZUC_OOO;
 
+typedef struct {
+        const snow3g_key_schedule_t *keys[SNOW3G_OOO_NUM_LANES];
+        const void *iv[SNOW3G_OOO_NUM_LANES];
+        const void *in[SNOW3G_OOO_NUM_LANES];
+        void *out[SNOW3G_OOO_NUM_LANES]; /* UIA2: digest */
+} SNOW3G_ARGS_x16;
+
+/* SNOW3G-UEA2 and SNOW3G-UIA2 out-of-order scheduler fields */
+typedef struct {
+        SNOW3G_ARGS_x16 args;
+        uint32_t lens[SNOW3G_OOO_NUM_LANES]; /* UEA2: bytes, UIA2: bits */
+        /* each nibble is index (0...7 or 0...15) of an unused lane,
+         * with 8 lanes the last nibble is set to F as a flag
+         */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[SNOW3G_OOO_NUM_LANES];
+        uint64_t num_lanes_inuse;
+        /* bit mask of processed lanes, which jobs are not returned yet */
+        uint64_t done_lanes;
+        DECLARE_ALIGNED(uint8_t scratch[SNOW3G_OOO_SCRATCH_SIZE], 32);
+} MB_MGR_SNOW3G_OOO;
+
+typedef struct {
+        const kasumi_key_sched_t *keys[KASUMI_OOO_NUM_LANES];
+        const uint8_t *in[KASUMI_OOO_NUM_LANES];
+        uint8_t *out[KASUMI_OOO_NUM_LANES];
+        /* F8: next key stream block, F9: A register */
+        uint64_t blk[KASUMI_OOO_NUM_LANES];
+        /* F8: modifier, F9: B register */
+        uint64_t mod[KASUMI_OOO_NUM_LANES];
+        /* F8: block counter */
+        uint32_t blkcnt[KASUMI_OOO_NUM_LANES];
+        /* AVX2/AVX512: key schedules, subkey i of all lanes in sk16[i] */
+        DECLARE_ALIGNED(uint16_t sk16[KASUMI_KEY_SCHEDULE_SIZE]
+                        [KASUMI_OOO_NUM_LANES], 32);
+} KASUMI_ARGS_x16;
+
+/* KASUMI-UEA1 and KASUMI-UIA1 out-of-order scheduler fields */
+typedef struct {
+        KASUMI_ARGS_x16 args;
+        uint32_t lens[KASUMI_OOO_NUM_LANES];
+        /* each nibble is index (0...15) of an unused lane */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[KASUMI_OOO_NUM_LANES];
+        uint64_t num_lanes_inuse;
+} MB_MGR_KASUMI_OOO;
+
+typedef struct {
+        const uint8_t *in[PON_OOO_NUM_LANES];
+        uint8_t *out[PON_OOO_NUM_LANES];
+        /* AES-CTR counter blocks (little endian) */
+        DECLARE_ALIGNED(imb_uint128_t ctr[PON_OOO_NUM_LANES], 64);
+        /* CRC32 folding state */
+        DECLARE_ALIGNED(imb_uint128_t crc[PON_OOO_NUM_LANES], 64);
+        /* BIP state (4 x 32-bit running XOR) */
+        DECLARE_ALIGNED(imb_uint128_t bip[PON_OOO_NUM_LANES], 64);
+        /* round keys, round r of all lanes in key_tab[r] */
+        DECLARE_ALIGNED(imb_uint128_t key_tab[PON_OOO_NUM_ROUNDS + 1]
+                        [PON_OOO_NUM_LANES], 64);
+        /* 2 bits (64-bit words) per lane: lanes doing AES-CTR */
+        uint32_t ctr_mask;
+        /* 2 bits (64-bit words) per lane: lanes starting the CRC */
+        uint32_t crc_first_mask;
+        /* 1 bit per lane: lanes with a job, their output gets stored */
+        uint32_t store_mask;
+} PON_ARGS_x16;
+
+/* PON out-of-order scheduler fields (encrypt or decrypt) */
+typedef struct {
+        PON_ARGS_x16 args;
+        DECLARE_ALIGNED(uint16_t lens[PON_OOO_NUM_LANES], 32);
+        /* each nibble is index (0...15) of an unused lane */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[PON_OOO_NUM_LANES];
+        uint64_t num_lanes_inuse;
+} MB_MGR_PON_OOO;
+
 /* HMAC-SHA1 and HMAC-SHA256/224 */
 typedef struct {
         /* YMM aligned access to extra_block */
@@ -283,11 +449,51 @@ typedef struct {
         DECLARE_ALIGNED(uint16_t lens[AVX512_NUM_MD5_LANES], 16);
         /*
          * In the avx2 case, all 16 nibbles of unused lanes are used.
-         * In that case num_lanes_inuse is used to detect the end of the list
+         * In that case num_lanes_inuse is used to detect the end of the list.
+         * In the avx512 case (32 lanes), unused_lanes is a bit mask
+         * of free lanes.
          */
         uint64_t unused_lanes;
         HMAC_SHA1_LANE_DATA ldata[AVX512_NUM_MD5_LANES];
         uint32_t num_lanes_inuse;
 } MB_MGR_HMAC_MD5_OOO;
 
+/* SHA-1/224/256/384/512 (plain digest) lane data */
+typedef struct {
+        /* padded last message block(s) */
+        DECLARE_ALIGNED(uint8_t extra_block[2 * SHA_512_BLOCK_SIZE], 32);
+        IMB_JOB *job_in_lane;
+        uint32_t extra_blocks; /* num extra blocks still to process */
+} SHA_LANE_DATA;
+
+/*
+ * SHA-1/224/256/384/512 (plain digest) out-of-order scheduler fields.
+ * Arguments are at the start of the structure,
+ * as expected by the multi-buffer SHA kernels.
+ */
+typedef struct {
+        union {
+                SHA1_ARGS sha1;
+                SHA256_ARGS sha256;
+                SHA512_ARGS sha512;
+        } args;
+        DECLARE_ALIGNED(uint16_t lens[16], 32);
+        /* each nibble is index (0...15) of an unused lane */
+        uint64_t unused_lanes;
+        SHA_LANE_DATA ldata[AVX512_NUM_SHA1_LANES];
+        uint32_t num_lanes_inuse;
+} MB_MGR_SHA_OOO;
+
+/*
+ * Performance counters (MB_STATS builds).
+ * Jobs in flight are tracked per cipher mode, direction and key size
+ * (AES-128/DES, AES-192/3DES, AES-256) and per hash algorithm,
+ * which approximates occupancy of the out-of-order manager lanes.
+ */
+typedef struct {
+        IMB_MGR_STATS pub;
+        uint32_t cipher_in_flight[IMB_CIPHER_NUM][2][3];
+        uint32_t hash_in_flight[IMB_AUTH_NUM];
+} MB_MGR_STATS;
+
 #endif /* IMB_IPSEC_MB_INTERNAL_H */
@@ -40,6 +40,11 @@
  */
 
 #include <string.h> /* memcpy(), memset() */
+#ifdef _WIN32
+#include <intrin.h> /* __rdtsc() */
+#else
+#include <x86intrin.h> /* __rdtsc() */
+#endif
 
 #include "include/clear_regs_mem.h"
 #include "include/des.h"
@@ -264,6 +269,12 @@ submit_snow3g_uea2_job(IMB_MGR *state, IMB_JOB *job)
         } else {
                 const uint32_t msg_bytelen = msg_bitlen >> 3;
 
+#ifdef SUBMIT_JOB_SNOW3G_UEA2
+                /* byte length jobs go to the multi-buffer manager */
+                if (msg_bytelen != 0)
+                        return SUBMIT_JOB_SNOW3G_UEA2(state->snow3g_uea2_ooo,
+                                                      job);
+#endif /* SUBMIT_JOB_SNOW3G_UEA2 */
                 IMB_SNOW3G_F8_1_BUFFER(state, key, job->iv, job->src,
                                        job->dst, msg_bytelen);
         }
@@ -294,6 +305,12 @@ submit_kasumi_uea1_job(IMB_MGR *state, IMB_JOB *job)
         } else {
                 const uint32_t msg_bytelen = msg_bitlen >> 3;
 
+#ifdef SUBMIT_JOB_KASUMI_UEA1
+                /* byte length jobs go to the multi-buffer manager */
+                if (msg_bytelen != 0)
+                        return SUBMIT_JOB_KASUMI_UEA1(state->kasumi_uea1_ooo,
+                                                      job);
+#endif /* SUBMIT_JOB_KASUMI_UEA1 */
                 IMB_KASUMI_F8_1_BUFFER(state, key, iv, job->src, job->dst,
                                        msg_bytelen);
         }
@@ -368,6 +385,18 @@ __forceinline
 IMB_JOB *
 submit_docsis_dec_job(IMB_MGR *state, IMB_JOB *job)
 {
+#ifdef SUBMIT_JOB_DOCSIS128_SEC_DEC_OOO
+        /* one lane manager for jobs with and without CRC */
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_DOCSIS_AES_OOO *p_ooo = state->docsis128_dec_ooo;
+
+                return SUBMIT_JOB_DOCSIS128_SEC_DEC_OOO(p_ooo, job);
+        } else { /* 32 */
+                MB_MGR_DOCSIS_AES_OOO *p_ooo = state->docsis256_dec_ooo;
+
+                return SUBMIT_JOB_DOCSIS256_SEC_DEC_OOO(p_ooo, job);
+        }
+#else
         if (16 == job->key_len_in_bytes) {
                 if (job->hash_alg == IMB_AUTH_DOCSIS_CRC32) {
                         MB_MGR_DOCSIS_AES_OOO *p_ooo =
@@ -393,7 +422,143 @@ submit_docsis_dec_job(IMB_MGR *state, IMB_JOB *job)
                         return SUBMIT_JOB_DOCSIS256_SEC_DEC(p_ooo, job);
                 }
         }
+#endif /* SUBMIT_JOB_DOCSIS128_SEC_DEC_OOO */
+}
+
+/* ========================================================================= */
+/* AES-CTR submit & flush functions */
+/* ========================================================================= */
+#ifdef SUBMIT_JOB_AES128_CNTR
+/*
+ * Decides if an AES-CTR job goes to the out-of-order manager.
+ *
+ * Long buffers fill the single buffer pipeline on their own.
+ * If the manager defines AES_CNTR_OOO_SKIP_FEATURES, its single buffer
+ * code is faster than the AES-NI lanes on CPUs with these features
+ * (e.g. VAES) and is used for all lengths.
+ */
+__forceinline
+int
+is_aes_cntr_ooo_job(const IMB_MGR *state, const IMB_JOB *job)
+{
+#ifdef AES_CNTR_OOO_SKIP_FEATURES
+        if ((state->features & AES_CNTR_OOO_SKIP_FEATURES) ==
+            AES_CNTR_OOO_SKIP_FEATURES)
+                return 0;
+#else
+        (void) state;
+#endif
+        return job->msg_len_to_cipher_in_bytes <= AES_CNTR_OOO_MAX_LEN;
+}
+
+__forceinline
+IMB_JOB *
+submit_aes_cntr_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (!is_aes_cntr_ooo_job(state, job))
+                return SUBMIT_JOB_AES_CNTR(job);
+
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_AES_OOO *p_ooo = state->aes128_cntr_ooo;
+
+                return SUBMIT_JOB_AES128_CNTR(p_ooo, job);
+        } else if (24 == job->key_len_in_bytes) {
+                MB_MGR_AES_OOO *p_ooo = state->aes192_cntr_ooo;
+
+                return SUBMIT_JOB_AES192_CNTR(p_ooo, job);
+        } else { /* assume 32 */
+                MB_MGR_AES_OOO *p_ooo = state->aes256_cntr_ooo;
+
+                return SUBMIT_JOB_AES256_CNTR(p_ooo, job);
+        }
+}
+
+__forceinline
+IMB_JOB *
+flush_aes_cntr_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (!is_aes_cntr_ooo_job(state, job))
+                return NULL;
+
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_AES_OOO *p_ooo = state->aes128_cntr_ooo;
+
+                return FLUSH_JOB_AES128_CNTR(p_ooo);
+        } else if (24 == job->key_len_in_bytes) {
+                MB_MGR_AES_OOO *p_ooo = state->aes192_cntr_ooo;
+
+                return FLUSH_JOB_AES192_CNTR(p_ooo);
+        } else { /* assume 32 */
+                MB_MGR_AES_OOO *p_ooo = state->aes256_cntr_ooo;
+
+                return FLUSH_JOB_AES256_CNTR(p_ooo);
+        }
 }
+#endif /* SUBMIT_JOB_AES128_CNTR */
+
+/* ========================================================================= */
+/* AES-GCM submit & flush functions */
+/* ========================================================================= */
+#ifdef SUBMIT_JOB_AES128_GCM
+/*
+ * Decides if an AES-GCM job goes to the out-of-order manager.
+ *
+ * Long buffers fill the single buffer pipeline on their own.
+ * AES_GCM_OOO_SKIP_FEATURES works as AES_CNTR_OOO_SKIP_FEATURES.
+ */
+__forceinline
+int
+is_aes_gcm_ooo_job(const IMB_MGR *state, const IMB_JOB *job)
+{
+#ifdef AES_GCM_OOO_SKIP_FEATURES
+        if ((state->features & AES_GCM_OOO_SKIP_FEATURES) ==
+            AES_GCM_OOO_SKIP_FEATURES)
+                return 0;
+#else
+        (void) state;
+#endif
+        return (job->iv_len_in_bytes == 12) &&
+                (job->msg_len_to_cipher_in_bytes <= AES_GCM_OOO_MAX_LEN);
+}
+
+__forceinline
+IMB_JOB *
+submit_aes_gcm_ooo_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_GCM_OOO *p_ooo = state->aes128_gcm_ooo;
+
+                return SUBMIT_JOB_AES128_GCM(p_ooo, job);
+        } else if (24 == job->key_len_in_bytes) {
+                MB_MGR_GCM_OOO *p_ooo = state->aes192_gcm_ooo;
+
+                return SUBMIT_JOB_AES192_GCM(p_ooo, job);
+        } else { /* assume 32 */
+                MB_MGR_GCM_OOO *p_ooo = state->aes256_gcm_ooo;
+
+                return SUBMIT_JOB_AES256_GCM(p_ooo, job);
+        }
+}
+
+__forceinline
+IMB_JOB *
+flush_aes_gcm_ooo_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_GCM_OOO *p_ooo = state->aes128_gcm_ooo;
+
+                return FLUSH_JOB_AES128_GCM(p_ooo);
+        } else if (24 == job->key_len_in_bytes) {
+                MB_MGR_GCM_OOO *p_ooo = state->aes192_gcm_ooo;
+
+                return FLUSH_JOB_AES192_GCM(p_ooo);
+        } else { /* assume 32 */
+                MB_MGR_GCM_OOO *p_ooo = state->aes256_gcm_ooo;
+
+                return FLUSH_JOB_AES256_GCM(p_ooo);
+        }
+}
+#endif /* SUBMIT_JOB_AES128_GCM */
 
 /* ========================================================================= */
 /* Cipher submit & flush functions */
@@ -416,7 +581,11 @@ SUBMIT_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
                         return SUBMIT_JOB_AES256_ENC(aes256_ooo, job);
                 }
         } else if (IMB_CIPHER_CNTR == job->cipher_mode) {
+#ifdef SUBMIT_JOB_AES128_CNTR
+                return submit_aes_cntr_job(state, job);
+#else
                 return SUBMIT_JOB_AES_CNTR(job);
+#endif /* SUBMIT_JOB_AES128_CNTR */
         } else if (IMB_CIPHER_CNTR_BITLEN == job->cipher_mode) {
                 return SUBMIT_JOB_AES_CNTR_BIT(job);
         } else if (IMB_CIPHER_ECB == job->cipher_mode) {
@@ -430,11 +599,19 @@ SUBMIT_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
         } else if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
                 return submit_docsis_enc_job(state, job);
         } else if (IMB_CIPHER_PON_AES_CNTR == job->cipher_mode) {
+#ifdef SUBMIT_JOB_PON_ENC_OOO
+                return SUBMIT_JOB_PON_ENC_OOO(state->pon_enc_ooo, job);
+#else
                 if (job->msg_len_to_cipher_in_bytes == 0)
                         return SUBMIT_JOB_PON_ENC_NO_CTR(job);
                 else
                         return SUBMIT_JOB_PON_ENC(job);
+#endif /* SUBMIT_JOB_PON_ENC_OOO */
         } else if (IMB_CIPHER_GCM == job->cipher_mode) {
+#ifdef SUBMIT_JOB_AES128_GCM
+                if (is_aes_gcm_ooo_job(state, job))
+                        return submit_aes_gcm_ooo_job(state, job);
+#endif /* SUBMIT_JOB_AES128_GCM */
                 return SUBMIT_JOB_AES_GCM_ENC(state, job);
         } else if (IMB_CIPHER_CUSTOM == job->cipher_mode) {
                 return SUBMIT_JOB_CUSTOM_CIPHER(job);
@@ -495,6 +672,10 @@ FLUSH_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
                         return FLUSH_JOB_AES256_ENC(aes256_ooo);
                 }
         } else if (IMB_CIPHER_GCM == job->cipher_mode) {
+#ifdef FLUSH_JOB_AES128_GCM
+                if (is_aes_gcm_ooo_job(state, job))
+                        return flush_aes_gcm_ooo_job(state, job);
+#endif /* FLUSH_JOB_AES128_GCM */
                 return FLUSH_JOB_AES_GCM_ENC(state, job);
         } else if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
                 return flush_docsis_enc_job(state, job);
@@ -520,6 +701,22 @@ FLUSH_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
                 return FLUSH_JOB_CUSTOM_CIPHER(job);
         } else if (IMB_CIPHER_ZUC_EEA3 == job->cipher_mode) {
                 return FLUSH_JOB_ZUC_EEA3(zuc_eea3_ooo);
+#ifdef FLUSH_JOB_AES128_CNTR
+        } else if (IMB_CIPHER_CNTR == job->cipher_mode) {
+                return flush_aes_cntr_job(state, job);
+#endif /* FLUSH_JOB_AES128_CNTR */
+#ifdef FLUSH_JOB_SNOW3G_UEA2
+        } else if (IMB_CIPHER_SNOW3G_UEA2_BITLEN == job->cipher_mode) {
+                return FLUSH_JOB_SNOW3G_UEA2(state->snow3g_uea2_ooo);
+#endif /* FLUSH_JOB_SNOW3G_UEA2 */
+#ifdef FLUSH_JOB_KASUMI_UEA1
+        } else if (IMB_CIPHER_KASUMI_UEA1_BITLEN == job->cipher_mode) {
+                return FLUSH_JOB_KASUMI_UEA1(state->kasumi_uea1_ooo);
+#endif /* FLUSH_JOB_KASUMI_UEA1 */
+#ifdef FLUSH_JOB_PON_ENC_OOO
+        } else if (IMB_CIPHER_PON_AES_CNTR == job->cipher_mode) {
+                return FLUSH_JOB_PON_ENC_OOO(state->pon_enc_ooo);
+#endif /* FLUSH_JOB_PON_ENC_OOO */
         /* assume IMB_CIPHER_CNTR/CNTR_BITLEN, IMB_CIPHER_ECB,
          * IMB_CIPHER_CCM or IMB_CIPHER_NULL */
         } else {
@@ -542,7 +739,11 @@ SUBMIT_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
                         return SUBMIT_JOB_AES256_DEC(job);
                 }
         } else if (IMB_CIPHER_CNTR == job->cipher_mode) {
+#ifdef SUBMIT_JOB_AES128_CNTR
+                return submit_aes_cntr_job(state, job);
+#else
                 return SUBMIT_JOB_AES_CNTR(job);
+#endif /* SUBMIT_JOB_AES128_CNTR */
         } else if (IMB_CIPHER_CNTR_BITLEN == job->cipher_mode) {
                 return SUBMIT_JOB_AES_CNTR_BIT(job);
         } else if (IMB_CIPHER_ECB == job->cipher_mode) {
@@ -556,11 +757,19 @@ SUBMIT_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
         } else if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
                 return submit_docsis_dec_job(state, job);
         } else if (IMB_CIPHER_PON_AES_CNTR == job->cipher_mode) {
+#ifdef SUBMIT_JOB_PON_DEC_OOO
+                return SUBMIT_JOB_PON_DEC_OOO(state->pon_dec_ooo, job);
+#else
                 if (job->msg_len_to_cipher_in_bytes == 0)
                         return SUBMIT_JOB_PON_DEC_NO_CTR(job);
                 else
                         return SUBMIT_JOB_PON_DEC(job);
+#endif /* SUBMIT_JOB_PON_DEC_OOO */
         } else if (IMB_CIPHER_GCM == job->cipher_mode) {
+#ifdef SUBMIT_JOB_AES128_GCM
+                if (is_aes_gcm_ooo_job(state, job))
+                        return submit_aes_gcm_ooo_job(state, job);
+#endif /* SUBMIT_JOB_AES128_GCM */
                 return SUBMIT_JOB_AES_GCM_DEC(state, job);
         } else if (IMB_CIPHER_DES == job->cipher_mode) {
 #ifdef SUBMIT_JOB_DES_CBC_DEC
@@ -611,8 +820,13 @@ FLUSH_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
 {
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
 
-        if (IMB_CIPHER_GCM == job->cipher_mode)
+        if (IMB_CIPHER_GCM == job->cipher_mode) {
+#ifdef FLUSH_JOB_AES128_GCM
+                if (is_aes_gcm_ooo_job(state, job))
+                        return flush_aes_gcm_ooo_job(state, job);
+#endif /* FLUSH_JOB_AES128_GCM */
                 return FLUSH_JOB_AES_GCM_DEC(state, job);
+        }
 #ifdef FLUSH_JOB_DES_CBC_DEC
         MB_MGR_DES_OOO *des_dec_ooo = state->des_dec_ooo;
 
@@ -633,6 +847,32 @@ FLUSH_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
 #endif /* FLUSH_JOB_DOCSIS_DES_DEC */
         if (IMB_CIPHER_ZUC_EEA3 == job->cipher_mode)
                 return FLUSH_JOB_ZUC_EEA3(zuc_eea3_ooo);
+#ifdef FLUSH_JOB_AES128_CNTR
+        if (IMB_CIPHER_CNTR == job->cipher_mode)
+                return flush_aes_cntr_job(state, job);
+#endif /* FLUSH_JOB_AES128_CNTR */
+#ifdef FLUSH_JOB_SNOW3G_UEA2
+        if (IMB_CIPHER_SNOW3G_UEA2_BITLEN == job->cipher_mode)
+                return FLUSH_JOB_SNOW3G_UEA2(state->snow3g_uea2_ooo);
+#endif /* FLUSH_JOB_SNOW3G_UEA2 */
+#ifdef FLUSH_JOB_KASUMI_UEA1
+        if (IMB_CIPHER_KASUMI_UEA1_BITLEN == job->cipher_mode)
+                return FLUSH_JOB_KASUMI_UEA1(state->kasumi_uea1_ooo);
+#endif /* FLUSH_JOB_KASUMI_UEA1 */
+#ifdef FLUSH_JOB_PON_DEC_OOO
+        if (IMB_CIPHER_PON_AES_CNTR == job->cipher_mode)
+                return FLUSH_JOB_PON_DEC_OOO(state->pon_dec_ooo);
+#endif /* FLUSH_JOB_PON_DEC_OOO */
+#ifdef FLUSH_JOB_DOCSIS128_SEC_DEC_OOO
+        if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
+                if (16 == job->key_len_in_bytes)
+                        return FLUSH_JOB_DOCSIS128_SEC_DEC_OOO
+                                (state->docsis128_dec_ooo);
+                else /* 32 */
+                        return FLUSH_JOB_DOCSIS256_SEC_DEC_OOO
+                                (state->docsis256_dec_ooo);
+        }
+#endif /* FLUSH_JOB_DOCSIS128_SEC_DEC_OOO */
         (void) state;
         return NULL;
 }
@@ -641,6 +881,51 @@ FLUSH_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
 /* Hash submit & flush functions */
 /* ========================================================================= */
 
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+/*
+ * Decides if a new HMAC-SHA1/224/256 job goes to the SHA-NI or
+ * to the SIMD out-of-order scheduler.
+ *
+ * SHA-NI lanes are used while the SIMD scheduler is empty and there are
+ * fewer jobs in flight than SIMD lanes (HASH_USE_SHAEXT_ADAPTIVE),
+ * i.e. when the SIMD lanes would not fill up without a flush.
+ * Once the SIMD scheduler holds a job, new jobs join it.
+ */
+__forceinline
+int
+hmac_use_shani(const IMB_MGR *state, const HMAC_SHA1_LANE_DATA *ldata)
+{
+        unsigned i;
+
+        if (!(state->features & IMB_FEATURE_SHANI))
+                return 0;
+
+        if (state->earliest_job >= 0) {
+                const int a = state->next_job / sizeof(IMB_JOB);
+                const int b = state->earliest_job / sizeof(IMB_JOB);
+
+                if (((a - b) & (MAX_JOBS - 1)) >= HASH_USE_SHAEXT_ADAPTIVE)
+                        return 0;
+        }
+
+        for (i = 0; i < HASH_USE_SHAEXT_ADAPTIVE; i++)
+                if (ldata[i].job_in_lane != NULL)
+                        return 0;
+
+        return 1;
+}
+
+/*
+ * Checks if the job is in one of the two lanes of a SHA-NI scheduler
+ */
+__forceinline
+int
+hmac_shani_has_job(const HMAC_SHA1_LANE_DATA *ldata, const IMB_JOB *job)
+{
+        return ldata[0].job_in_lane == job || ldata[1].job_in_lane == job;
+}
+#endif /* HASH_USE_SHAEXT_ADAPTIVE */
+
 __forceinline
 IMB_JOB *
 SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
@@ -664,6 +949,11 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
 #ifdef HASH_USE_SHAEXT
                 if (state->features & IMB_FEATURE_SHANI)
                         return SUBMIT_JOB_HMAC_NI(hmac_sha_1_ooo, job);
+#endif
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+                if (hmac_use_shani(state, hmac_sha_1_ooo->ldata))
+                        return SUBMIT_JOB_HMAC_NI(state->hmac_sha_1_ni_ooo,
+                                                  job);
 #endif
                 return SUBMIT_JOB_HMAC(hmac_sha_1_ooo, job);
         case IMB_AUTH_HMAC_SHA_224:
@@ -671,6 +961,11 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 if (state->features & IMB_FEATURE_SHANI)
                         return SUBMIT_JOB_HMAC_SHA_224_NI
                                 (hmac_sha_224_ooo, job);
+#endif
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+                if (hmac_use_shani(state, hmac_sha_224_ooo->ldata))
+                        return SUBMIT_JOB_HMAC_SHA_224_NI
+                                (state->hmac_sha_224_ni_ooo, job);
 #endif
                 return SUBMIT_JOB_HMAC_SHA_224(hmac_sha_224_ooo, job);
         case IMB_AUTH_HMAC_SHA_256:
@@ -678,6 +973,11 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 if (state->features & IMB_FEATURE_SHANI)
                         return SUBMIT_JOB_HMAC_SHA_256_NI
                                 (hmac_sha_256_ooo, job);
+#endif
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+                if (hmac_use_shani(state, hmac_sha_256_ooo->ldata))
+                        return SUBMIT_JOB_HMAC_SHA_256_NI
+                                (state->hmac_sha_256_ni_ooo, job);
 #endif
                 return SUBMIT_JOB_HMAC_SHA_256(hmac_sha_256_ooo, job);
         case IMB_AUTH_HMAC_SHA_384:
@@ -703,30 +1003,45 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
         case IMB_AUTH_AES_CMAC_BITLEN:
                 return SUBMIT_JOB_AES_CMAC_AUTH(aes_cmac_ooo, job);
         case IMB_AUTH_SHA_1:
+#ifdef SUBMIT_JOB_SHA1
+                return SUBMIT_JOB_SHA1(state->sha_1_ooo, job);
+#endif /* SUBMIT_JOB_SHA1 */
                 IMB_SHA1(state,
                          job->src + job->hash_start_src_offset_in_bytes,
                          job->msg_len_to_hash_in_bytes, job->auth_tag_output);
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
         case IMB_AUTH_SHA_224:
+#ifdef SUBMIT_JOB_SHA224
+                return SUBMIT_JOB_SHA224(state->sha_224_ooo, job);
+#endif /* SUBMIT_JOB_SHA224 */
                 IMB_SHA224(state,
                            job->src + job->hash_start_src_offset_in_bytes,
                            job->msg_len_to_hash_in_bytes, job->auth_tag_output);
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
         case IMB_AUTH_SHA_256:
+#ifdef SUBMIT_JOB_SHA256
+                return SUBMIT_JOB_SHA256(state->sha_256_ooo, job);
+#endif /* SUBMIT_JOB_SHA256 */
                 IMB_SHA256(state,
                            job->src + job->hash_start_src_offset_in_bytes,
                            job->msg_len_to_hash_in_bytes, job->auth_tag_output);
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
         case IMB_AUTH_SHA_384:
+#ifdef SUBMIT_JOB_SHA384
+                return SUBMIT_JOB_SHA384(state->sha_384_ooo, job);
+#endif /* SUBMIT_JOB_SHA384 */
                 IMB_SHA384(state,
                            job->src + job->hash_start_src_offset_in_bytes,
                            job->msg_len_to_hash_in_bytes, job->auth_tag_output);
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
         case IMB_AUTH_SHA_512:
+#ifdef SUBMIT_JOB_SHA512
+                return SUBMIT_JOB_SHA512(state->sha_512_ooo, job);
+#endif /* SUBMIT_JOB_SHA512 */
                 IMB_SHA512(state,
                            job->src + job->hash_start_src_offset_in_bytes,
                            job->msg_len_to_hash_in_bytes, job->auth_tag_output);
@@ -735,6 +1050,9 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
         case IMB_AUTH_ZUC_EIA3_BITLEN:
                 return SUBMIT_JOB_ZUC_EIA3(zuc_eia3_ooo, job);
         case IMB_AUTH_SNOW3G_UIA2_BITLEN:
+#ifdef SUBMIT_JOB_SNOW3G_UIA2
+                return SUBMIT_JOB_SNOW3G_UIA2(state->snow3g_uia2_ooo, job);
+#endif /* SUBMIT_JOB_SNOW3G_UIA2 */
                 IMB_SNOW3G_F9_1_BUFFER(state, (const snow3g_key_schedule_t *)
                                job->u.SNOW3G_UIA2._key,
                                job->u.SNOW3G_UIA2._iv,
@@ -744,6 +1062,9 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
         case IMB_AUTH_KASUMI_UIA1:
+#ifdef SUBMIT_JOB_KASUMI_UIA1
+                return SUBMIT_JOB_KASUMI_UIA1(state->kasumi_uia1_ooo, job);
+#endif /* SUBMIT_JOB_KASUMI_UIA1 */
                 IMB_KASUMI_F9_1_BUFFER(state, (const kasumi_key_sched_t *)
                                job->u.KASUMI_UIA1._key,
                                job->src + job->hash_start_src_offset_in_bytes,
@@ -777,6 +1098,11 @@ FLUSH_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
 #ifdef HASH_USE_SHAEXT
                 if (state->features & IMB_FEATURE_SHANI)
                         return FLUSH_JOB_HMAC_NI(hmac_sha_1_ooo);
+#endif
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+                if (hmac_shani_has_job(((MB_MGR_HMAC_SHA_1_OOO *)
+                                        state->hmac_sha_1_ni_ooo)->ldata, job))
+                        return FLUSH_JOB_HMAC_NI(state->hmac_sha_1_ni_ooo);
 #endif
                 return FLUSH_JOB_HMAC(hmac_sha_1_ooo);
         case IMB_AUTH_HMAC_SHA_224:
@@ -784,6 +1110,13 @@ FLUSH_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 if (state->features & IMB_FEATURE_SHANI)
                         return FLUSH_JOB_HMAC_SHA_224_NI
                                 (hmac_sha_224_ooo);
+#endif
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+                if (hmac_shani_has_job(((MB_MGR_HMAC_SHA_256_OOO *)
+                                        state->hmac_sha_224_ni_ooo)->ldata,
+                                       job))
+                        return FLUSH_JOB_HMAC_SHA_224_NI
+                                (state->hmac_sha_224_ni_ooo);
 #endif
                 return FLUSH_JOB_HMAC_SHA_224(hmac_sha_224_ooo);
         case IMB_AUTH_HMAC_SHA_256:
@@ -791,6 +1124,13 @@ FLUSH_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 if (state->features & IMB_FEATURE_SHANI)
                         return FLUSH_JOB_HMAC_SHA_256_NI
                                 (hmac_sha_256_ooo);
+#endif
+#ifdef HASH_USE_SHAEXT_ADAPTIVE
+                if (hmac_shani_has_job(((MB_MGR_HMAC_SHA_256_OOO *)
+                                        state->hmac_sha_256_ni_ooo)->ldata,
+                                       job))
+                        return FLUSH_JOB_HMAC_SHA_256_NI
+                                (state->hmac_sha_256_ni_ooo);
 #endif
                 return FLUSH_JOB_HMAC_SHA_256(hmac_sha_256_ooo);
         case IMB_AUTH_HMAC_SHA_384:
@@ -810,6 +1150,34 @@ FLUSH_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 return FLUSH_JOB_AES_CMAC_AUTH(aes_cmac_ooo);
         case IMB_AUTH_ZUC_EIA3_BITLEN:
                 return FLUSH_JOB_ZUC_EIA3(zuc_eia3_ooo);
+#ifdef FLUSH_JOB_SNOW3G_UIA2
+        case IMB_AUTH_SNOW3G_UIA2_BITLEN:
+                return FLUSH_JOB_SNOW3G_UIA2(state->snow3g_uia2_ooo);
+#endif /* FLUSH_JOB_SNOW3G_UIA2 */
+#ifdef FLUSH_JOB_KASUMI_UIA1
+        case IMB_AUTH_KASUMI_UIA1:
+                return FLUSH_JOB_KASUMI_UIA1(state->kasumi_uia1_ooo);
+#endif /* FLUSH_JOB_KASUMI_UIA1 */
+#ifdef FLUSH_JOB_SHA1
+        case IMB_AUTH_SHA_1:
+                return FLUSH_JOB_SHA1(state->sha_1_ooo);
+#endif /* FLUSH_JOB_SHA1 */
+#ifdef FLUSH_JOB_SHA224
+        case IMB_AUTH_SHA_224:
+                return FLUSH_JOB_SHA224(state->sha_224_ooo);
+#endif /* FLUSH_JOB_SHA224 */
+#ifdef FLUSH_JOB_SHA256
+        case IMB_AUTH_SHA_256:
+                return FLUSH_JOB_SHA256(state->sha_256_ooo);
+#endif /* FLUSH_JOB_SHA256 */
+#ifdef FLUSH_JOB_SHA384
+        case IMB_AUTH_SHA_384:
+                return FLUSH_JOB_SHA384(state->sha_384_ooo);
+#endif /* FLUSH_JOB_SHA384 */
+#ifdef FLUSH_JOB_SHA512
+        case IMB_AUTH_SHA_512:
+                return FLUSH_JOB_SHA512(state->sha_512_ooo);
+#endif /* FLUSH_JOB_SHA512 */
         default: /* assume GCM or IMB_AUTH_NULL */
                 if (!(job->status & STS_COMPLETED_HMAC)) {
                         job->status |= STS_COMPLETED_HMAC;
@@ -1758,6 +2126,259 @@ is_job_invalid(const IMB_JOB *job)
         return 0;
 }
 
+/*
+ * Returns algorithm groups (IMB_ALGO_xxx) which out-of-order
+ * managers the job may be submitted to
+ */
+__forceinline uint64_t
+job_algos(const IMB_JOB *job)
+{
+        uint64_t algos = 0;
+
+        switch (job->cipher_mode) {
+        case IMB_CIPHER_CBC:
+                algos |= IMB_ALGO_AES_CBC;
+                break;
+        case IMB_CIPHER_CNTR:
+        case IMB_CIPHER_CNTR_BITLEN:
+                algos |= IMB_ALGO_AES_CTR;
+                break;
+        case IMB_CIPHER_GCM:
+                algos |= IMB_ALGO_AES_GCM;
+                break;
+        case IMB_CIPHER_CCM:
+                algos |= IMB_ALGO_AES_CCM;
+                break;
+        case IMB_CIPHER_DES:
+        case IMB_CIPHER_DES3:
+                algos |= IMB_ALGO_DES;
+                break;
+        case IMB_CIPHER_DOCSIS_SEC_BPI:
+        case IMB_CIPHER_DOCSIS_DES:
+                algos |= IMB_ALGO_DOCSIS;
+                break;
+        case IMB_CIPHER_ZUC_EEA3:
+                algos |= IMB_ALGO_ZUC;
+                break;
+        case IMB_CIPHER_SNOW3G_UEA2_BITLEN:
+                algos |= IMB_ALGO_SNOW3G;
+                break;
+        case IMB_CIPHER_KASUMI_UEA1_BITLEN:
+                algos |= IMB_ALGO_KASUMI;
+                break;
+        case IMB_CIPHER_PON_AES_CNTR:
+                algos |= IMB_ALGO_PON;
+                break;
+        default:
+                break;
+        }
+
+        switch (job->hash_alg) {
+        case IMB_AUTH_HMAC_SHA_1:
+                algos |= IMB_ALGO_HMAC_SHA1;
+                break;
+        case IMB_AUTH_HMAC_SHA_224:
+        case IMB_AUTH_HMAC_SHA_256:
+        case IMB_AUTH_HMAC_SHA_384:
+        case IMB_AUTH_HMAC_SHA_512:
+                algos |= IMB_ALGO_HMAC_SHA2;
+                break;
+        case IMB_AUTH_MD5:
+                algos |= IMB_ALGO_HMAC_MD5;
+                break;
+        case IMB_AUTH_AES_XCBC:
+                algos |= IMB_ALGO_AES_XCBC;
+                break;
+        case IMB_AUTH_AES_GMAC:
+                algos |= IMB_ALGO_AES_GCM;
+                break;
+        case IMB_AUTH_AES_CCM:
+                algos |= IMB_ALGO_AES_CCM;
+                break;
+        case IMB_AUTH_AES_CMAC:
+        case IMB_AUTH_AES_CMAC_BITLEN:
+                algos |= IMB_ALGO_AES_CMAC;
+                break;
+        case IMB_AUTH_SHA_1:
+        case IMB_AUTH_SHA_224:
+        case IMB_AUTH_SHA_256:
+        case IMB_AUTH_SHA_384:
+        case IMB_AUTH_SHA_512:
+                algos |= IMB_ALGO_SHA;
+                break;
+        case IMB_AUTH_DOCSIS_CRC32:
+                algos |= IMB_ALGO_DOCSIS;
+                break;
+        case IMB_AUTH_ZUC_EIA3_BITLEN:
+                algos |= IMB_ALGO_ZUC;
+                break;
+        case IMB_AUTH_SNOW3G_UIA2_BITLEN:
+                algos |= IMB_ALGO_SNOW3G;
+                break;
+        case IMB_AUTH_KASUMI_UIA1:
+                algos |= IMB_ALGO_KASUMI;
+                break;
+        default:
+                break;
+        }
+
+        return algos;
+}
+
+/*
+ * Checks the job against algorithm groups selected at allocation
+ * (see alloc_mb_mgr_algos())
+ */
+__forceinline int
+is_job_algo_unavailable(const IMB_MGR *state, const IMB_JOB *job)
+{
+        if (state->algos == IMB_ALGO_ALL)
+                return 0;
+
+        if ((job_algos(job) & ~state->algos) != 0) {
+                INVALID_PRN("cipher_mode:%d hash_alg:%d not allocated\n",
+                            job->cipher_mode, job->hash_alg);
+                return 1;
+        }
+        return 0;
+}
+
+#ifdef MB_STATS
+#define STATS_INC(state, field)                                         \
+        do {                                                            \
+                if ((state)->stats != NULL)                             \
+                        ((MB_MGR_STATS *) (state)->stats)->pub.field++; \
+        } while (0)
+
+__forceinline
+uint32_t *
+stats_cipher_in_flight(MB_MGR_STATS *stats, const IMB_JOB *job,
+                       const unsigned mode)
+{
+        const unsigned dir = (job->cipher_direction == IMB_DIR_ENCRYPT) ? 0 : 1;
+        unsigned key = 0;
+
+        if (job->key_len_in_bytes == 24)
+                key = 1;
+        else if (job->key_len_in_bytes == 32)
+                key = 2;
+
+        return &stats->cipher_in_flight[mode][dir][key];
+}
+
+__forceinline
+uint64_t
+stats_cipher_bytes(const IMB_JOB *job)
+{
+        switch (job->cipher_mode) {
+        case IMB_CIPHER_CNTR_BITLEN:
+        case IMB_CIPHER_SNOW3G_UEA2_BITLEN:
+        case IMB_CIPHER_KASUMI_UEA1_BITLEN:
+                return (job->msg_len_to_cipher_in_bits + 7) / 8;
+        default:
+                return job->msg_len_to_cipher_in_bytes;
+        }
+}
+
+__forceinline
+uint64_t
+stats_hash_bytes(const IMB_JOB *job)
+{
+        switch (job->hash_alg) {
+        case IMB_AUTH_AES_CMAC_BITLEN:
+        case IMB_AUTH_ZUC_EIA3_BITLEN:
+        case IMB_AUTH_SNOW3G_UIA2_BITLEN:
+                return (job->msg_len_to_hash_in_bits + 7) / 8;
+        default:
+                return job->msg_len_to_hash_in_bytes;
+        }
+}
+
+/* job enters the cipher stage */
+__forceinline
+void
+stats_cipher_in(IMB_MGR *state, const IMB_JOB *job)
+{
+        MB_MGR_STATS *stats = (MB_MGR_STATS *) state->stats;
+        const unsigned mode = (unsigned) job->cipher_mode;
+
+        if (stats == NULL || mode >= IMB_CIPHER_NUM)
+                return;
+
+        (*stats_cipher_in_flight(stats, job, mode))++;
+}
+
+/* job leaves the cipher stage, \a flushed if returned by a flush */
+__forceinline
+void
+stats_cipher_out(IMB_MGR *state, const IMB_JOB *job, const int flushed)
+{
+        MB_MGR_STATS *stats = (MB_MGR_STATS *) state->stats;
+        const unsigned mode = (unsigned) job->cipher_mode;
+        uint32_t *in_flight;
+
+        if (stats == NULL || mode >= IMB_CIPHER_NUM)
+                return;
+
+        in_flight = stats_cipher_in_flight(stats, job, mode);
+        if (*in_flight == 0)
+                return;
+
+        stats->pub.cipher_lanes[mode][(*in_flight > IMB_STATS_MAX_LANES) ?
+                                      IMB_STATS_MAX_LANES : *in_flight]++;
+        (*in_flight)--;
+        stats->pub.cipher_jobs[mode]++;
+        stats->pub.cipher_bytes[mode] += stats_cipher_bytes(job);
+        if (flushed) {
+                stats->pub.cipher_flushes[mode]++;
+                stats->pub.forced_flushes++;
+        }
+}
+
+/* job enters the hash stage */
+__forceinline
+void
+stats_hash_in(IMB_MGR *state, const IMB_JOB *job)
+{
+        MB_MGR_STATS *stats = (MB_MGR_STATS *) state->stats;
+        const unsigned alg = (unsigned) job->hash_alg;
+
+        if (stats == NULL || alg >= IMB_AUTH_NUM)
+                return;
+
+        stats->hash_in_flight[alg]++;
+}
+
+/* job leaves the hash stage, \a flushed if returned by a flush */
+__forceinline
+void
+stats_hash_out(IMB_MGR *state, const IMB_JOB *job, const int flushed)
+{
+        MB_MGR_STATS *stats = (MB_MGR_STATS *) state->stats;
+        const unsigned alg = (unsigned) job->hash_alg;
+        uint32_t *in_flight;
+
+        if (stats == NULL || alg >= IMB_AUTH_NUM)
+                return;
+
+        in_flight = &stats->hash_in_flight[alg];
+        if (*in_flight == 0)
+                return;
+
+        stats->pub.hash_lanes[alg][(*in_flight > IMB_STATS_MAX_LANES) ?
+                                   IMB_STATS_MAX_LANES : *in_flight]++;
+        (*in_flight)--;
+        stats->pub.hash_jobs[alg]++;
+        stats->pub.hash_bytes[alg] += stats_hash_bytes(job);
+        if (flushed) {
+                stats->pub.hash_flushes[alg]++;
+                stats->pub.forced_flushes++;
+        }
+}
+#else
+#define STATS_INC(state, field) do { } while (0)
+#endif /* MB_STATS */
+
 __forceinline
 IMB_JOB *SUBMIT_JOB_AES(IMB_MGR *state, IMB_JOB *job)
 {
@@ -1780,15 +2401,69 @@ IMB_JOB *FLUSH_JOB_AES(IMB_MGR *state, IMB_JOB *job)
 	return job;
 }
 
+/*
+ * Cipher and hash stage entry points,
+ * with performance counters updated in MB_STATS builds
+ */
+__forceinline
+IMB_JOB *submit_cipher_stage(IMB_MGR *state, IMB_JOB *job)
+{
+#ifdef MB_STATS
+        stats_cipher_in(state, job);
+        job = SUBMIT_JOB_AES(state, job);
+        if (job != NULL)
+                stats_cipher_out(state, job, 0);
+        return job;
+#else
+        return SUBMIT_JOB_AES(state, job);
+#endif
+}
+
+__forceinline
+IMB_JOB *flush_cipher_stage(IMB_MGR *state, IMB_JOB *job)
+{
+        job = FLUSH_JOB_AES(state, job);
+#ifdef MB_STATS
+        if (job != NULL)
+                stats_cipher_out(state, job, 1);
+#endif
+        return job;
+}
+
+__forceinline
+IMB_JOB *submit_hash_stage(IMB_MGR *state, IMB_JOB *job)
+{
+#ifdef MB_STATS
+        stats_hash_in(state, job);
+        job = SUBMIT_JOB_HASH(state, job);
+        if (job != NULL)
+                stats_hash_out(state, job, 0);
+        return job;
+#else
+        return SUBMIT_JOB_HASH(state, job);
+#endif
+}
+
+__forceinline
+IMB_JOB *flush_hash_stage(IMB_MGR *state, IMB_JOB *job)
+{
+        job = FLUSH_JOB_HASH(state, job);
+#ifdef MB_STATS
+        if (job != NULL)
+                stats_hash_out(state, job, 1);
+#endif
+        return job;
+}
+
 /* submit a half-completed job, based on the status */
 __forceinline
 IMB_JOB *RESUBMIT_JOB(IMB_MGR *state, IMB_JOB *job)
 {
         while (job != NULL && job->status < STS_COMPLETED) {
                 if (job->status == STS_COMPLETED_HMAC)
-                        job = SUBMIT_JOB_AES(state, job);
+                        job = submit_cipher_stage(state, job);
                 else /* assumed job->status = STS_COMPLETED_AES */
-                        job = SUBMIT_JOB_HASH(state, job);
+                        job = submit_hash_stage(state, job);
         }
 
 	return job;
@@ -1798,9 +2473,9 @@ __forceinline
 IMB_JOB *submit_new_job(IMB_MGR *state, IMB_JOB *job)
 {
 	if (job->chain_order == IMB_ORDER_CIPHER_HASH)
-		job = SUBMIT_JOB_AES(state, job);
+		job = submit_cipher_stage(state, job);
 	else
-		job = SUBMIT_JOB_HASH(state, job);
+		job = submit_hash_stage(state, job);
 
         job = RESUBMIT_JOB(state, job);
 	return job;
@@ -1812,26 +2487,86 @@ void complete_job(IMB_MGR *state, IMB_JOB *job)
         if (job->chain_order == IMB_ORDER_CIPHER_HASH) {
                 /* while() loop optimized for cipher_hash order */
                 while (job->status < STS_COMPLETED) {
-                        IMB_JOB *tmp = FLUSH_JOB_AES(state, job);
+                        IMB_JOB *tmp = flush_cipher_stage(state, job);
 
                         if (tmp == NULL)
-                                tmp = FLUSH_JOB_HASH(state, job);
+                                tmp = flush_hash_stage(state, job);
 
                         (void) RESUBMIT_JOB(state, tmp);
                 }
         } else {
                 /* while() loop optimized for hash_cipher order */
                 while (job->status < STS_COMPLETED) {
-                        IMB_JOB *tmp = FLUSH_JOB_HASH(state, job);
+                        IMB_JOB *tmp = flush_hash_stage(state, job);
 
                         if (tmp == NULL)
-                                tmp = FLUSH_JOB_AES(state, job);
+                                tmp = flush_cipher_stage(state, job);
 
                         (void) RESUBMIT_JOB(state, tmp);
                 }
         }
 }
 
+/*
+ * Checks if the oldest job in flight is over its latency budget
+ * (see imb_set_flush_budget()). The queue must not be empty.
+ */
+__forceinline
+int
+flush_budget_exceeded(const IMB_MGR *state)
+{
+        const int earliest = state->earliest_job / sizeof(IMB_JOB);
+
+        if (state->flush_budget_jobs != 0) {
+                /* number of jobs submitted after the oldest one */
+                const uint32_t n = ((state->next_job / sizeof(IMB_JOB)) -
+                                    earliest - 1) & (MAX_JOBS - 1);
+
+                if (n >= state->flush_budget_jobs)
+                        return 1;
+        }
+
+        if (state->flush_budget_cycles != 0 &&
+            (__rdtsc() - state->job_submit_tsc[earliest]) >
+            state->flush_budget_cycles)
+                return 1;
+
+        return 0;
+}
+
+/*
+ * Completes the oldest job in flight if it is over its latency budget.
+ * Used by get completed job/burst, as at low load no further
+ * submissions may arrive to enforce the budget.
+ * Returns 1 if the job got completed.
+ */
+__forceinline
+int
+flush_budget_complete_job(IMB_MGR *state, IMB_JOB *job)
+{
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+
+        if (!flush_budget_exceeded(state))
+                return 0;
+
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        complete_job(state, job);
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+        return 1;
+}
+
 __forceinline
 IMB_JOB *
 submit_job_and_check(IMB_MGR *state, const int run_check)
@@ -1851,9 +2586,15 @@ submit_job_and_check(IMB_MGR *state, const int run_check)
 #endif
 
         job = JOBS(state, state->next_job);
+        STATS_INC(state, submit_calls);
+
+        if (state->flush_budget_cycles != 0)
+                state->job_submit_tsc[state->next_job / sizeof(IMB_JOB)] =
+                        __rdtsc();
 
         if (run_check) {
-                if (is_job_invalid(job)) {
+                if (is_job_invalid(job) ||
+                    is_job_algo_unavailable(state, job)) {
                         job->status = STS_INVALID_ARGS;
                 } else {
                         job->status = STS_BEING_PROCESSED;
@@ -1885,12 +2626,18 @@ submit_job_and_check(IMB_MGR *state, const int run_check)
         /* not full */
         job = JOBS(state, state->earliest_job);
         if (job->status < STS_COMPLETED) {
-                job = NULL;
-                goto exit;
+                if (!flush_budget_exceeded(state)) {
+                        job = NULL;
+                        goto exit;
+                }
+                /* latency budget exceeded, flush the oldest job */
+                complete_job(state, job);
         }
 
         ADV_JOBS(&state->earliest_job);
 exit:
+        if (job == NULL)
+                STATS_INC(state, submit_empty);
 #ifdef SAFE_DATA
         CLEAR_SCRATCH_GPS();
         CLEAR_SCRATCH_SIMD_REGS();
@@ -1931,6 +2678,7 @@ FLUSH_JOB(IMB_MGR *state)
         if (state->earliest_job < 0)
                 return NULL; /* empty */
 
+        STATS_INC(state, flush_calls);
 #ifndef LINUX
         SAVE_XMMS(xmm_save);
 #endif
@@ -1989,7 +2737,8 @@ GET_COMPLETED_JOB(IMB_MGR *state)
                 return NULL;
 
         job = JOBS(state, state->earliest_job);
-        if (job->status < STS_COMPLETED)
+        if (job->status < STS_COMPLETED &&
+            !flush_budget_complete_job(state, job))
                 return NULL;
 
         ADV_JOBS(&state->earliest_job);
@@ -2012,4 +2761,201 @@ GET_NEXT_JOB(IMB_MGR *state)
         return JOBS(state, state->next_job);
 }
 
+/* ========================================================================= */
+/* Burst API */
+/* ========================================================================= */
+
+__forceinline
+uint32_t
+queue_free_slots(IMB_MGR *state)
+{
+        /* one slot is always kept free to tell full and empty queue apart */
+        return (MAX_JOBS - 1) - QUEUE_SIZE(state);
+}
+
+uint32_t
+GET_NEXT_BURST(IMB_MGR *state, IMB_JOB **jobs, const uint32_t n_jobs)
+{
+#ifdef SAFE_PARAM
+        if (state == NULL || jobs == NULL) {
+                DEBUG_PUTS("get next burst\n");
+                return 0;
+        }
+#endif
+        const uint32_t n_free = queue_free_slots(state);
+        const uint32_t n = (n_jobs < n_free) ? n_jobs : n_free;
+        int offset = state->next_job;
+        uint32_t i;
+
+        for (i = 0; i < n; i++) {
+                jobs[i] = JOBS(state, offset);
+                ADV_JOBS(&offset);
+        }
+
+        return n;
+}
+
+/*
+ * Submits all jobs of the burst in one pass and updates
+ * the in-order queue pointers once at the end.
+ * Jobs are left in the queue regardless of their completion status;
+ * they get returned by GET_COMPLETED_BURST() or FLUSH_BURST().
+ */
+__forceinline
+uint32_t
+submit_burst_and_check(IMB_MGR *state, IMB_JOB **jobs, const uint32_t n_jobs,
+                       const int run_check)
+{
+        int offset;
+        uint32_t i;
+#ifdef SAFE_PARAM
+        if (state == NULL || jobs == NULL) {
+                DEBUG_PUTS("submit burst\n");
+                return 0;
+        }
+        if (n_jobs > queue_free_slots(state)) {
+                DEBUG_PUTS("submit burst: not enough space in the queue\n");
+                return 0;
+        }
+        /* jobs have to be the ones returned by GET_NEXT_BURST() */
+        offset = state->next_job;
+        for (i = 0; i < n_jobs; i++) {
+                if (jobs[i] != JOBS(state, offset)) {
+                        DEBUG_PUTS("submit burst: invalid job pointer\n");
+                        return 0;
+                }
+                ADV_JOBS(&offset);
+        }
+#endif
+        if (n_jobs == 0)
+                return 0;
+
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+
+        SAVE_XMMS(xmm_save);
+#endif
+        offset = state->next_job;
+
+        for (i = 0; i < n_jobs; i++) {
+                IMB_JOB *job = jobs[i];
+
+                STATS_INC(state, submit_calls);
+                if (state->flush_budget_cycles != 0)
+                        state->job_submit_tsc[offset / sizeof(IMB_JOB)] =
+                                __rdtsc();
+
+                if (run_check && (is_job_invalid(job) ||
+                                  is_job_algo_unavailable(state, job))) {
+                        job->status = STS_INVALID_ARGS;
+                } else {
+                        job->status = STS_BEING_PROCESSED;
+                        (void) submit_new_job(state, job);
+                }
+                ADV_JOBS(&offset);
+        }
+
+        if (state->earliest_job < 0)
+                state->earliest_job = state->next_job;
+        state->next_job = offset;
+
+        /* latency budget exceeded, flush the oldest job */
+        if (JOBS(state, state->earliest_job)->status < STS_COMPLETED &&
+            flush_budget_exceeded(state))
+                complete_job(state, JOBS(state, state->earliest_job));
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+        return n_jobs;
+}
+
+uint32_t
+SUBMIT_BURST(IMB_MGR *state, IMB_JOB **jobs, const uint32_t n_jobs)
+{
+        return submit_burst_and_check(state, jobs, n_jobs, 1);
+}
+
+uint32_t
+SUBMIT_BURST_NOCHECK(IMB_MGR *state, IMB_JOB **jobs, const uint32_t n_jobs)
+{
+        return submit_burst_and_check(state, jobs, n_jobs, 0);
+}
+
+uint32_t
+GET_COMPLETED_BURST(IMB_MGR *state, IMB_JOB **jobs, const uint32_t max_jobs)
+{
+#ifdef SAFE_PARAM
+        if (state == NULL || jobs == NULL) {
+                DEBUG_PUTS("get completed burst\n");
+                return 0;
+        }
+#endif
+        uint32_t i = 0;
+
+        while (i < max_jobs && state->earliest_job >= 0) {
+                IMB_JOB *job = JOBS(state, state->earliest_job);
+
+                if (job->status < STS_COMPLETED &&
+                    !flush_budget_complete_job(state, job))
+                        break;
+
+                jobs[i++] = job;
+                ADV_JOBS(&state->earliest_job);
+
+                if (state->earliest_job == state->next_job)
+                        state->earliest_job = -1; /* becomes empty */
+        }
+
+        return i;
+}
+
+uint32_t
+FLUSH_BURST(IMB_MGR *state, IMB_JOB **jobs, const uint32_t max_jobs)
+{
+#ifdef SAFE_PARAM
+        if (state == NULL || jobs == NULL) {
+                DEBUG_PUTS("flush burst\n");
+                return 0;
+        }
+#endif
+        uint32_t i = 0;
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+
+        if (state->earliest_job < 0 || max_jobs == 0)
+                return 0; /* empty */
+
+        STATS_INC(state, flush_calls);
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        while (i < max_jobs && state->earliest_job >= 0) {
+                IMB_JOB *job = JOBS(state, state->earliest_job);
+
+                complete_job(state, job);
+                jobs[i++] = job;
+                ADV_JOBS(&state->earliest_job);
+
+                if (state->earliest_job == state->next_job)
+                        state->earliest_job = -1; /* becomes empty */
+        }
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+        return i;
+}
+
 #endif /* MB_MGR_CODE_H */
@@ -37,6 +37,7 @@
 #include "include/kasumi_internal.h"
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
+#include "include/crc.h"
 
 #include "save_xmms.h"
 #include "asm.h"
@@ -202,6 +203,11 @@ JOB_AES_HMAC *flush_job_zuc_eia3_sse_no_aesni(MB_MGR_ZUC_OOO *state);
 #define SUBMIT_JOB_NOCHECK submit_job_nocheck_sse_no_aesni
 #define GET_NEXT_JOB       get_next_job_sse_no_aesni
 #define GET_COMPLETED_JOB  get_completed_job_sse_no_aesni
+#define GET_NEXT_BURST       get_next_burst_sse_no_aesni
+#define SUBMIT_BURST         submit_burst_sse_no_aesni
+#define SUBMIT_BURST_NOCHECK submit_burst_nocheck_sse_no_aesni
+#define GET_COMPLETED_BURST  get_completed_burst_sse_no_aesni
+#define FLUSH_BURST          flush_burst_sse_no_aesni
 
 #define SUBMIT_JOB_AES128_DEC submit_job_aes128_dec_sse_no_aesni
 #define SUBMIT_JOB_AES192_DEC submit_job_aes192_dec_sse_no_aesni
@@ -438,313 +444,351 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
 
         /* Init AES out-of-order fields */
-        memset(aes128_ooo->lens, 0xFF,
-               sizeof(aes128_ooo->lens));
-        memset(&aes128_ooo->lens[0], 0,
-               sizeof(aes128_ooo->lens[0]) * 4);
-        memset(aes128_ooo->job_in_lane, 0,
-               sizeof(aes128_ooo->job_in_lane));
-        aes128_ooo->unused_lanes = 0xF3210;
-        aes128_ooo->num_lanes_inuse = 0;
-
-
-        memset(aes192_ooo->lens, 0xFF,
-               sizeof(aes192_ooo->lens));
-        memset(&aes192_ooo->lens[0], 0,
-               sizeof(aes192_ooo->lens[0]) * 4);
-        memset(aes192_ooo->job_in_lane, 0,
-               sizeof(aes192_ooo->job_in_lane));
-        aes192_ooo->unused_lanes = 0xF3210;
-        aes192_ooo->num_lanes_inuse = 0;
-
-
-        memset(aes256_ooo->lens, 0xFF,
-               sizeof(aes256_ooo->lens));
-        memset(&aes256_ooo->lens[0], 0,
-               sizeof(aes256_ooo->lens[0]) * 4);
-        memset(aes256_ooo->job_in_lane, 0,
-               sizeof(aes256_ooo->job_in_lane));
-        aes256_ooo->unused_lanes = 0xF3210;
-        aes256_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_AES_CBC) {
+                memset(aes128_ooo->lens, 0xFF,
+                       sizeof(aes128_ooo->lens));
+                memset(&aes128_ooo->lens[0], 0,
+                       sizeof(aes128_ooo->lens[0]) * 4);
+                memset(aes128_ooo->job_in_lane, 0,
+                       sizeof(aes128_ooo->job_in_lane));
+                aes128_ooo->unused_lanes = 0xF3210;
+                aes128_ooo->num_lanes_inuse = 0;
+
+
+                memset(aes192_ooo->lens, 0xFF,
+                       sizeof(aes192_ooo->lens));
+                memset(&aes192_ooo->lens[0], 0,
+                       sizeof(aes192_ooo->lens[0]) * 4);
+                memset(aes192_ooo->job_in_lane, 0,
+                       sizeof(aes192_ooo->job_in_lane));
+                aes192_ooo->unused_lanes = 0xF3210;
+                aes192_ooo->num_lanes_inuse = 0;
+
+
+                memset(aes256_ooo->lens, 0xFF,
+                       sizeof(aes256_ooo->lens));
+                memset(&aes256_ooo->lens[0], 0,
+                       sizeof(aes256_ooo->lens[0]) * 4);
+                memset(aes256_ooo->job_in_lane, 0,
+                       sizeof(aes256_ooo->job_in_lane));
+                aes256_ooo->unused_lanes = 0xF3210;
+                aes256_ooo->num_lanes_inuse = 0;
+        }
 
 
         /* DOCSIS SEC BPI uses same settings as AES CBC */
-        memset(docsis128_sec_ooo->lens, 0xFF,
-               sizeof(docsis128_sec_ooo->lens));
-        memset(&docsis128_sec_ooo->lens[0], 0,
-               sizeof(docsis128_sec_ooo->lens[0]) * 4);
-        memset(docsis128_sec_ooo->job_in_lane, 0,
-               sizeof(docsis128_sec_ooo->job_in_lane));
-        docsis128_sec_ooo->unused_lanes = 0xF3210;
-        docsis128_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis128_crc32_sec_ooo->lens, 0xFF,
-               sizeof(docsis128_crc32_sec_ooo->lens));
-        memset(&docsis128_crc32_sec_ooo->lens[0], 0,
-               sizeof(docsis128_crc32_sec_ooo->lens[0]) * 4);
-        memset(docsis128_crc32_sec_ooo->job_in_lane, 0,
-               sizeof(docsis128_crc32_sec_ooo->job_in_lane));
-        docsis128_crc32_sec_ooo->unused_lanes = 0xF3210;
-        docsis128_crc32_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis256_sec_ooo->lens, 0xFF,
-               sizeof(docsis256_sec_ooo->lens));
-        memset(&docsis256_sec_ooo->lens[0], 0,
-               sizeof(docsis256_sec_ooo->lens[0]) * 4);
-        memset(docsis256_sec_ooo->job_in_lane, 0,
-               sizeof(docsis256_sec_ooo->job_in_lane));
-        docsis256_sec_ooo->unused_lanes = 0xF3210;
-        docsis256_sec_ooo->num_lanes_inuse = 0;
-
-        memset(docsis256_crc32_sec_ooo->lens, 0xFF,
-               sizeof(docsis256_crc32_sec_ooo->lens));
-        memset(&docsis256_crc32_sec_ooo->lens[0], 0,
-               sizeof(docsis256_crc32_sec_ooo->lens[0]) * 4);
-        memset(docsis256_crc32_sec_ooo->job_in_lane, 0,
-               sizeof(docsis256_crc32_sec_ooo->job_in_lane));
-        docsis256_crc32_sec_ooo->unused_lanes = 0xF3210;
-        docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_DOCSIS) {
+                memset(docsis128_sec_ooo->lens, 0xFF,
+                       sizeof(docsis128_sec_ooo->lens));
+                memset(&docsis128_sec_ooo->lens[0], 0,
+                       sizeof(docsis128_sec_ooo->lens[0]) * 4);
+                memset(docsis128_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_sec_ooo->job_in_lane));
+                docsis128_sec_ooo->unused_lanes = 0xF3210;
+                docsis128_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis128_crc32_sec_ooo->lens, 0xFF,
+                       sizeof(docsis128_crc32_sec_ooo->lens));
+                memset(&docsis128_crc32_sec_ooo->lens[0], 0,
+                       sizeof(docsis128_crc32_sec_ooo->lens[0]) * 4);
+                memset(docsis128_crc32_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis128_crc32_sec_ooo->job_in_lane));
+                docsis128_crc32_sec_ooo->unused_lanes = 0xF3210;
+                docsis128_crc32_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_sec_ooo->lens, 0xFF,
+                       sizeof(docsis256_sec_ooo->lens));
+                memset(&docsis256_sec_ooo->lens[0], 0,
+                       sizeof(docsis256_sec_ooo->lens[0]) * 4);
+                memset(docsis256_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_sec_ooo->job_in_lane));
+                docsis256_sec_ooo->unused_lanes = 0xF3210;
+                docsis256_sec_ooo->num_lanes_inuse = 0;
+
+                memset(docsis256_crc32_sec_ooo->lens, 0xFF,
+                       sizeof(docsis256_crc32_sec_ooo->lens));
+                memset(&docsis256_crc32_sec_ooo->lens[0], 0,
+                       sizeof(docsis256_crc32_sec_ooo->lens[0]) * 4);
+                memset(docsis256_crc32_sec_ooo->job_in_lane, 0,
+                       sizeof(docsis256_crc32_sec_ooo->job_in_lane));
+                docsis256_crc32_sec_ooo->unused_lanes = 0xF3210;
+                docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
+        }
 
         /* Init ZUC out-of-order fields */
-        memset(zuc_eea3_ooo->lens, 0xFF,
-               sizeof(zuc_eea3_ooo->lens));
-        memset(zuc_eea3_ooo->job_in_lane, 0,
-               sizeof(zuc_eea3_ooo->job_in_lane));
-        zuc_eea3_ooo->unused_lanes = 0xFF03020100;
-        zuc_eea3_ooo->num_lanes_inuse = 0;
-
-        memset(zuc_eia3_ooo->lens, 0xFF,
-               sizeof(zuc_eia3_ooo->lens));
-        memset(zuc_eia3_ooo->job_in_lane, 0,
-               sizeof(zuc_eia3_ooo->job_in_lane));
-        zuc_eia3_ooo->unused_lanes = 0xFF03020100;
-        zuc_eia3_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_ZUC) {
+                memset(zuc_eea3_ooo->lens, 0xFF,
+                       sizeof(zuc_eea3_ooo->lens));
+                memset(zuc_eea3_ooo->job_in_lane, 0,
+                       sizeof(zuc_eea3_ooo->job_in_lane));
+                zuc_eea3_ooo->unused_lanes = 0xFF03020100;
+                zuc_eea3_ooo->num_lanes_inuse = 0;
+
+                memset(zuc_eia3_ooo->lens, 0xFF,
+                       sizeof(zuc_eia3_ooo->lens));
+                memset(zuc_eia3_ooo->job_in_lane, 0,
+                       sizeof(zuc_eia3_ooo->job_in_lane));
+                zuc_eia3_ooo->unused_lanes = 0xFF03020100;
+                zuc_eia3_ooo->num_lanes_inuse = 0;
+        }
 
         /* Init HMAC/SHA1 out-of-order fields */
-        hmac_sha_1_ooo->lens[0] = 0;
-        hmac_sha_1_ooo->lens[1] = 0;
-        hmac_sha_1_ooo->lens[2] = 0;
-        hmac_sha_1_ooo->lens[3] = 0;
-        hmac_sha_1_ooo->lens[4] = 0xFFFF;
-        hmac_sha_1_ooo->lens[5] = 0xFFFF;
-        hmac_sha_1_ooo->lens[6] = 0xFFFF;
-        hmac_sha_1_ooo->lens[7] = 0xFFFF;
-        hmac_sha_1_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < SSE_NUM_SHA1_LANES; j++) {
-                hmac_sha_1_ooo->ldata[j].job_in_lane = NULL;
-                hmac_sha_1_ooo->ldata[j].extra_block[64] = 0x80;
-                memset(hmac_sha_1_ooo->ldata[j].extra_block + 65,
-                       0x00,
-                       64+7);
-                p = hmac_sha_1_ooo->ldata[j].outer_block;
-                memset(p + 5*4 + 1,
-                       0x00,
-                       64 - 5*4 - 1 - 2);
-                p[5*4] = 0x80;
-                p[64-2] = 0x02;
-                p[64-1] = 0xA0;
+        if (state->algos & IMB_ALGO_HMAC_SHA1) {
+                hmac_sha_1_ooo->lens[0] = 0;
+                hmac_sha_1_ooo->lens[1] = 0;
+                hmac_sha_1_ooo->lens[2] = 0;
+                hmac_sha_1_ooo->lens[3] = 0;
+                hmac_sha_1_ooo->lens[4] = 0xFFFF;
+                hmac_sha_1_ooo->lens[5] = 0xFFFF;
+                hmac_sha_1_ooo->lens[6] = 0xFFFF;
+                hmac_sha_1_ooo->lens[7] = 0xFFFF;
+                hmac_sha_1_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < SSE_NUM_SHA1_LANES; j++) {
+                        hmac_sha_1_ooo->ldata[j].job_in_lane = NULL;
+                        hmac_sha_1_ooo->ldata[j].extra_block[64] = 0x80;
+                        memset(hmac_sha_1_ooo->ldata[j].extra_block + 65,
+                               0x00,
+                               64+7);
+                        p = hmac_sha_1_ooo->ldata[j].outer_block;
+                        memset(p + 5*4 + 1,
+                               0x00,
+                               64 - 5*4 - 1 - 2);
+                        p[5*4] = 0x80;
+                        p[64-2] = 0x02;
+                        p[64-1] = 0xA0;
+                }
         }
 
         /* Init HMAC/SHA224 out-of-order fields */
-        hmac_sha_224_ooo->lens[0] = 0;
-        hmac_sha_224_ooo->lens[1] = 0;
-        hmac_sha_224_ooo->lens[2] = 0;
-        hmac_sha_224_ooo->lens[3] = 0;
-        hmac_sha_224_ooo->lens[4] = 0xFFFF;
-        hmac_sha_224_ooo->lens[5] = 0xFFFF;
-        hmac_sha_224_ooo->lens[6] = 0xFFFF;
-        hmac_sha_224_ooo->lens[7] = 0xFFFF;
-        hmac_sha_224_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < SSE_NUM_SHA256_LANES; j++) {
-                hmac_sha_224_ooo->ldata[j].job_in_lane = NULL;
-
-                p = hmac_sha_224_ooo->ldata[j].extra_block;
-                size = sizeof(hmac_sha_224_ooo->ldata[j].extra_block);
-                memset (p, 0x00, size);
-                p[64] = 0x80;
-
-                p = hmac_sha_224_ooo->ldata[j].outer_block;
-                size = sizeof(hmac_sha_224_ooo->ldata[j].outer_block);
-                memset(p, 0x00, size);
-                p[7*4] = 0x80;  /* digest 7 words long */
-                p[64-2] = 0x02; /* length in little endian = 0x02E0 */
-                p[64-1] = 0xE0;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_224_ooo->lens[0] = 0;
+                hmac_sha_224_ooo->lens[1] = 0;
+                hmac_sha_224_ooo->lens[2] = 0;
+                hmac_sha_224_ooo->lens[3] = 0;
+                hmac_sha_224_ooo->lens[4] = 0xFFFF;
+                hmac_sha_224_ooo->lens[5] = 0xFFFF;
+                hmac_sha_224_ooo->lens[6] = 0xFFFF;
+                hmac_sha_224_ooo->lens[7] = 0xFFFF;
+                hmac_sha_224_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < SSE_NUM_SHA256_LANES; j++) {
+                        hmac_sha_224_ooo->ldata[j].job_in_lane = NULL;
+
+                        p = hmac_sha_224_ooo->ldata[j].extra_block;
+                        size = sizeof(hmac_sha_224_ooo->ldata[j].extra_block);
+                        memset (p, 0x00, size);
+                        p[64] = 0x80;
+
+                        p = hmac_sha_224_ooo->ldata[j].outer_block;
+                        size = sizeof(hmac_sha_224_ooo->ldata[j].outer_block);
+                        memset(p, 0x00, size);
+                        p[7*4] = 0x80;  /* digest 7 words long */
+                        p[64-2] = 0x02; /* length in little endian = 0x02E0 */
+                        p[64-1] = 0xE0;
+                }
         }
 
         /* Init HMAC/SHA_256 out-of-order fields */
-        hmac_sha_256_ooo->lens[0] = 0;
-        hmac_sha_256_ooo->lens[1] = 0;
-        hmac_sha_256_ooo->lens[2] = 0;
-        hmac_sha_256_ooo->lens[3] = 0;
-        hmac_sha_256_ooo->lens[4] = 0xFFFF;
-        hmac_sha_256_ooo->lens[5] = 0xFFFF;
-        hmac_sha_256_ooo->lens[6] = 0xFFFF;
-        hmac_sha_256_ooo->lens[7] = 0xFFFF;
-        hmac_sha_256_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < SSE_NUM_SHA256_LANES; j++) {
-                hmac_sha_256_ooo->ldata[j].job_in_lane = NULL;
-                hmac_sha_256_ooo->ldata[j].extra_block[64] = 0x80;
-                memset(hmac_sha_256_ooo->ldata[j].extra_block + 65,
-                       0x00,
-                       64+7);
-                p = hmac_sha_256_ooo->ldata[j].outer_block;
-                memset(p + 8*4 + 1,
-                       0x00,
-                       64 - 8*4 - 1 - 2); /* digest is 8*4 bytes long */
-                p[8*4] = 0x80;
-                p[64-2] = 0x03; /* length of (opad (64*8) bits + 256 bits)
-                                 * in hex is 0x300 */
-                p[64-1] = 0x00;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_256_ooo->lens[0] = 0;
+                hmac_sha_256_ooo->lens[1] = 0;
+                hmac_sha_256_ooo->lens[2] = 0;
+                hmac_sha_256_ooo->lens[3] = 0;
+                hmac_sha_256_ooo->lens[4] = 0xFFFF;
+                hmac_sha_256_ooo->lens[5] = 0xFFFF;
+                hmac_sha_256_ooo->lens[6] = 0xFFFF;
+                hmac_sha_256_ooo->lens[7] = 0xFFFF;
+                hmac_sha_256_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < SSE_NUM_SHA256_LANES; j++) {
+                        hmac_sha_256_ooo->ldata[j].job_in_lane = NULL;
+                        hmac_sha_256_ooo->ldata[j].extra_block[64] = 0x80;
+                        memset(hmac_sha_256_ooo->ldata[j].extra_block + 65,
+                               0x00,
+                               64+7);
+                        p = hmac_sha_256_ooo->ldata[j].outer_block;
+                        memset(p + 8*4 + 1,
+                               0x00,
+                               64 - 8*4 - 1 - 2); /* digest is 8*4 bytes long */
+                        p[8*4] = 0x80;
+                        /*
+                         * length of (opad (64*8) bits + 256 bits)
+                         * in hex is 0x300
+                         */
+                        p[64-2] = 0x03;
+                        p[64-1] = 0x00;
+                }
         }
 
         /* Init HMAC/SHA384 out-of-order fields */
-        hmac_sha_384_ooo->lens[0] = 0;
-        hmac_sha_384_ooo->lens[1] = 0;
-        hmac_sha_384_ooo->lens[2] = 0xFFFF;
-        hmac_sha_384_ooo->lens[3] = 0xFFFF;
-        hmac_sha_384_ooo->lens[4] = 0xFFFF;
-        hmac_sha_384_ooo->lens[5] = 0xFFFF;
-        hmac_sha_384_ooo->lens[6] = 0xFFFF;
-        hmac_sha_384_ooo->lens[7] = 0xFFFF;
-        hmac_sha_384_ooo->unused_lanes = 0xFF0100;
-        for (j = 0; j < SSE_NUM_SHA512_LANES; j++) {
-                MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_384_ooo;
-
-                ctx->ldata[j].job_in_lane = NULL;
-                ctx->ldata[j].extra_block[SHA_384_BLOCK_SIZE] = 0x80;
-                memset(ctx->ldata[j].extra_block + (SHA_384_BLOCK_SIZE + 1),
-                       0x00, SHA_384_BLOCK_SIZE + 7);
-
-                p = ctx->ldata[j].outer_block;
-                memset(p + SHA384_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
-                       /* special end point because this length is constant */
-                       SHA_384_BLOCK_SIZE -
-                       SHA384_DIGEST_SIZE_IN_BYTES - 1 - 2);
-                p[SHA384_DIGEST_SIZE_IN_BYTES] = 0x80; /* mark the end */
-                /*
-                 * hmac outer block length always of fixed size, it is OKey
-                 * length, a whole message block length, 1024 bits, with padding
-                 * plus the length of the inner digest, which is 384 bits
-                 * 1408 bits == 0x0580. The input message block needs to be
-                 * converted to big endian within the sha implementation
-                 * before use.
-                 */
-                p[SHA_384_BLOCK_SIZE - 2] = 0x05;
-                p[SHA_384_BLOCK_SIZE - 1] = 0x80;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_384_ooo->lens[0] = 0;
+                hmac_sha_384_ooo->lens[1] = 0;
+                hmac_sha_384_ooo->lens[2] = 0xFFFF;
+                hmac_sha_384_ooo->lens[3] = 0xFFFF;
+                hmac_sha_384_ooo->lens[4] = 0xFFFF;
+                hmac_sha_384_ooo->lens[5] = 0xFFFF;
+                hmac_sha_384_ooo->lens[6] = 0xFFFF;
+                hmac_sha_384_ooo->lens[7] = 0xFFFF;
+                hmac_sha_384_ooo->unused_lanes = 0xFF0100;
+                for (j = 0; j < SSE_NUM_SHA512_LANES; j++) {
+                        MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_384_ooo;
+
+                        ctx->ldata[j].job_in_lane = NULL;
+                        ctx->ldata[j].extra_block[SHA_384_BLOCK_SIZE] = 0x80;
+                        memset(ctx->ldata[j].extra_block +
+                               (SHA_384_BLOCK_SIZE + 1),
+                               0x00, SHA_384_BLOCK_SIZE + 7);
+
+                        p = ctx->ldata[j].outer_block;
+                        memset(p + SHA384_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
+                               /* special end point, constant length */
+                               SHA_384_BLOCK_SIZE -
+                               SHA384_DIGEST_SIZE_IN_BYTES - 1 - 2);
+                        /* mark the end */
+                        p[SHA384_DIGEST_SIZE_IN_BYTES] = 0x80;
+                        /*
+                         * hmac outer block length always of fixed size, it is
+                         * OKey length, a whole message block length, 1024 bits,
+                         * with padding plus the length of the inner digest,
+                         * which is 384 bits 1408 bits == 0x0580. The input
+                         * message block needs to be converted to big endian
+                         * within the sha implementation before use.
+                         */
+                        p[SHA_384_BLOCK_SIZE - 2] = 0x05;
+                        p[SHA_384_BLOCK_SIZE - 1] = 0x80;
+                }
         }
 
         /* Init HMAC/SHA512 out-of-order fields */
-        hmac_sha_512_ooo->lens[0] = 0;
-        hmac_sha_512_ooo->lens[1] = 0;
-        hmac_sha_512_ooo->lens[2] = 0xFFFF;
-        hmac_sha_512_ooo->lens[3] = 0xFFFF;
-        hmac_sha_512_ooo->lens[4] = 0xFFFF;
-        hmac_sha_512_ooo->lens[5] = 0xFFFF;
-        hmac_sha_512_ooo->lens[6] = 0xFFFF;
-        hmac_sha_512_ooo->lens[7] = 0xFFFF;
-        hmac_sha_512_ooo->unused_lanes = 0xFF0100;
-        for (j = 0; j < SSE_NUM_SHA512_LANES; j++) {
-                MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_512_ooo;
-
-                ctx->ldata[j].job_in_lane = NULL;
-                ctx->ldata[j].extra_block[SHA_512_BLOCK_SIZE] = 0x80;
-                memset(ctx->ldata[j].extra_block + (SHA_512_BLOCK_SIZE + 1),
-                       0x00, SHA_512_BLOCK_SIZE + 7);
-
-                p = ctx->ldata[j].outer_block;
-                memset(p + SHA512_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
-                       /* special end point because this length is constant */
-                       SHA_512_BLOCK_SIZE -
-                       SHA512_DIGEST_SIZE_IN_BYTES  - 1 - 2);
-                p[SHA512_DIGEST_SIZE_IN_BYTES] = 0x80; /* mark the end */
-                /*
-                 * hmac outer block length always of fixed size, it is OKey
-                 * length, a whole message block length, 1024 bits, with padding
-                 * plus the length of the inner digest, which is 512 bits
-                 * 1536 bits == 0x600. The input message block needs to be
-                 * converted to big endian within the sha implementation
-                 * before use.
-                 */
-                p[SHA_512_BLOCK_SIZE - 2] = 0x06;
-                p[SHA_512_BLOCK_SIZE - 1] = 0x00;
+        if (state->algos & IMB_ALGO_HMAC_SHA2) {
+                hmac_sha_512_ooo->lens[0] = 0;
+                hmac_sha_512_ooo->lens[1] = 0;
+                hmac_sha_512_ooo->lens[2] = 0xFFFF;
+                hmac_sha_512_ooo->lens[3] = 0xFFFF;
+                hmac_sha_512_ooo->lens[4] = 0xFFFF;
+                hmac_sha_512_ooo->lens[5] = 0xFFFF;
+                hmac_sha_512_ooo->lens[6] = 0xFFFF;
+                hmac_sha_512_ooo->lens[7] = 0xFFFF;
+                hmac_sha_512_ooo->unused_lanes = 0xFF0100;
+                for (j = 0; j < SSE_NUM_SHA512_LANES; j++) {
+                        MB_MGR_HMAC_SHA_512_OOO *ctx = hmac_sha_512_ooo;
+
+                        ctx->ldata[j].job_in_lane = NULL;
+                        ctx->ldata[j].extra_block[SHA_512_BLOCK_SIZE] = 0x80;
+                        memset(ctx->ldata[j].extra_block +
+                               (SHA_512_BLOCK_SIZE + 1),
+                               0x00, SHA_512_BLOCK_SIZE + 7);
+
+                        p = ctx->ldata[j].outer_block;
+                        memset(p + SHA512_DIGEST_SIZE_IN_BYTES  + 1, 0x00,
+                               /* special end point, constant length */
+                               SHA_512_BLOCK_SIZE -
+                               SHA512_DIGEST_SIZE_IN_BYTES  - 1 - 2);
+                        /* mark the end */
+                        p[SHA512_DIGEST_SIZE_IN_BYTES] = 0x80;
+                        /*
+                         * hmac outer block length always of fixed size, it is
+                         * OKey length, a whole message block length, 1024 bits,
+                         * with padding plus the length of the inner digest,
+                         * which is 512 bits 1536 bits == 0x600. The input
+                         * message block needs to be converted to big endian
+                         * within the sha implementation before use.
+                         */
+                        p[SHA_512_BLOCK_SIZE - 2] = 0x06;
+                        p[SHA_512_BLOCK_SIZE - 1] = 0x00;
+                }
         }
 
         /* Init HMAC/MD5 out-of-order fields */
-        hmac_md5_ooo->lens[0] = 0;
-        hmac_md5_ooo->lens[1] = 0;
-        hmac_md5_ooo->lens[2] = 0;
-        hmac_md5_ooo->lens[3] = 0;
-        hmac_md5_ooo->lens[4] = 0;
-        hmac_md5_ooo->lens[5] = 0;
-        hmac_md5_ooo->lens[6] = 0;
-        hmac_md5_ooo->lens[7] = 0;
-        hmac_md5_ooo->lens[8] = 0xFFFF;
-        hmac_md5_ooo->lens[9] = 0xFFFF;
-        hmac_md5_ooo->lens[10] = 0xFFFF;
-        hmac_md5_ooo->lens[11] = 0xFFFF;
-        hmac_md5_ooo->lens[12] = 0xFFFF;
-        hmac_md5_ooo->lens[13] = 0xFFFF;
-        hmac_md5_ooo->lens[14] = 0xFFFF;
-        hmac_md5_ooo->lens[15] = 0xFFFF;
-        hmac_md5_ooo->unused_lanes = 0xF76543210;
-        for (j = 0; j < SSE_NUM_MD5_LANES; j++) {
-                hmac_md5_ooo->ldata[j].job_in_lane = NULL;
-
-                p = hmac_md5_ooo->ldata[j].extra_block;
-                size = sizeof(hmac_md5_ooo->ldata[j].extra_block);
-                memset (p, 0x00, size);
-                p[64] = 0x80;
-
-                p = hmac_md5_ooo->ldata[j].outer_block;
-                size = sizeof(hmac_md5_ooo->ldata[j].outer_block);
-                memset(p, 0x00, size);
-                p[4*4] = 0x80;
-                p[64-7] = 0x02;
-                p[64-8] = 0x80;
+        if (state->algos & IMB_ALGO_HMAC_MD5) {
+                hmac_md5_ooo->lens[0] = 0;
+                hmac_md5_ooo->lens[1] = 0;
+                hmac_md5_ooo->lens[2] = 0;
+                hmac_md5_ooo->lens[3] = 0;
+                hmac_md5_ooo->lens[4] = 0;
+                hmac_md5_ooo->lens[5] = 0;
+                hmac_md5_ooo->lens[6] = 0;
+                hmac_md5_ooo->lens[7] = 0;
+                hmac_md5_ooo->lens[8] = 0xFFFF;
+                hmac_md5_ooo->lens[9] = 0xFFFF;
+                hmac_md5_ooo->lens[10] = 0xFFFF;
+                hmac_md5_ooo->lens[11] = 0xFFFF;
+                hmac_md5_ooo->lens[12] = 0xFFFF;
+                hmac_md5_ooo->lens[13] = 0xFFFF;
+                hmac_md5_ooo->lens[14] = 0xFFFF;
+                hmac_md5_ooo->lens[15] = 0xFFFF;
+                hmac_md5_ooo->unused_lanes = 0xF76543210;
+                for (j = 0; j < SSE_NUM_MD5_LANES; j++) {
+                        hmac_md5_ooo->ldata[j].job_in_lane = NULL;
+
+                        p = hmac_md5_ooo->ldata[j].extra_block;
+                        size = sizeof(hmac_md5_ooo->ldata[j].extra_block);
+                        memset (p, 0x00, size);
+                        p[64] = 0x80;
+
+                        p = hmac_md5_ooo->ldata[j].outer_block;
+                        size = sizeof(hmac_md5_ooo->ldata[j].outer_block);
+                        memset(p, 0x00, size);
+                        p[4*4] = 0x80;
+                        p[64-7] = 0x02;
+                        p[64-8] = 0x80;
+                }
         }
 
         /* Init AES/XCBC OOO fields */
-        aes_xcbc_ooo->lens[0] = 0;
-        aes_xcbc_ooo->lens[1] = 0;
-        aes_xcbc_ooo->lens[2] = 0;
-        aes_xcbc_ooo->lens[3] = 0;
-        aes_xcbc_ooo->lens[4] = 0xFFFF;
-        aes_xcbc_ooo->lens[5] = 0xFFFF;
-        aes_xcbc_ooo->lens[6] = 0xFFFF;
-        aes_xcbc_ooo->lens[7] = 0xFFFF;
-        aes_xcbc_ooo->unused_lanes = 0xFF03020100;
-        for (j = 0; j < 4; j++) {
-                aes_xcbc_ooo->ldata[j].job_in_lane = NULL;
-                aes_xcbc_ooo->ldata[j].final_block[16] = 0x80;
-                memset(aes_xcbc_ooo->ldata[j].final_block + 17, 0x00, 15);
+        if (state->algos & IMB_ALGO_AES_XCBC) {
+                aes_xcbc_ooo->lens[0] = 0;
+                aes_xcbc_ooo->lens[1] = 0;
+                aes_xcbc_ooo->lens[2] = 0;
+                aes_xcbc_ooo->lens[3] = 0;
+                aes_xcbc_ooo->lens[4] = 0xFFFF;
+                aes_xcbc_ooo->lens[5] = 0xFFFF;
+                aes_xcbc_ooo->lens[6] = 0xFFFF;
+                aes_xcbc_ooo->lens[7] = 0xFFFF;
+                aes_xcbc_ooo->unused_lanes = 0xFF03020100;
+                for (j = 0; j < 4; j++) {
+                        aes_xcbc_ooo->ldata[j].job_in_lane = NULL;
+                        aes_xcbc_ooo->ldata[j].final_block[16] = 0x80;
+                        memset(aes_xcbc_ooo->ldata[j].final_block +
+                               17, 0x00, 15);
+                }
         }
 
         /* Init AES-CCM auth out-of-order fields */
-        memset(aes_ccm_ooo, 0, sizeof(MB_MGR_CCM_OOO));
-        for (j = 4; j < 16; j++)
-                aes_ccm_ooo->lens[j] = 0xFFFF;
-        aes_ccm_ooo->unused_lanes = 0xF3210;
-        aes_ccm_ooo->num_lanes_inuse = 0;
+        if (state->algos & IMB_ALGO_AES_CCM) {
+                memset(aes_ccm_ooo, 0, sizeof(MB_MGR_CCM_OOO));
+                for (j = 4; j < 16; j++)
+                        aes_ccm_ooo->lens[j] = 0xFFFF;
+                aes_ccm_ooo->unused_lanes = 0xF3210;
+                aes_ccm_ooo->num_lanes_inuse = 0;
+        }
 
         /* Init AES-CMAC auth out-of-order fields */
-        aes_cmac_ooo->lens[0] = 0;
-        aes_cmac_ooo->lens[1] = 0;
-        aes_cmac_ooo->lens[2] = 0;
-        aes_cmac_ooo->lens[3] = 0;
-        aes_cmac_ooo->lens[4] = 0xFFFF;
-        aes_cmac_ooo->lens[5] = 0xFFFF;
-        aes_cmac_ooo->lens[6] = 0xFFFF;
-        aes_cmac_ooo->lens[7] = 0xFFFF;
-        for (j = 0; j < 4; j++) {
-                aes_cmac_ooo->init_done[j] = 0;
-                aes_cmac_ooo->job_in_lane[j] = NULL;
+        if (state->algos & IMB_ALGO_AES_CMAC) {
+                aes_cmac_ooo->lens[0] = 0;
+                aes_cmac_ooo->lens[1] = 0;
+                aes_cmac_ooo->lens[2] = 0;
+                aes_cmac_ooo->lens[3] = 0;
+                aes_cmac_ooo->lens[4] = 0xFFFF;
+                aes_cmac_ooo->lens[5] = 0xFFFF;
+                aes_cmac_ooo->lens[6] = 0xFFFF;
+                aes_cmac_ooo->lens[7] = 0xFFFF;
+                for (j = 0; j < 4; j++) {
+                        aes_cmac_ooo->init_done[j] = 0;
+                        aes_cmac_ooo->job_in_lane[j] = NULL;
+                }
+                aes_cmac_ooo->unused_lanes = 0xF3210;
+                aes_cmac_ooo->num_lanes_inuse = 0;
         }
-        aes_cmac_ooo->unused_lanes = 0xF3210;
-        aes_cmac_ooo->num_lanes_inuse = 0;
 
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->flush_budget_jobs = 0;
+        state->flush_budget_cycles = 0;
+#ifdef MB_STATS
+        if (state->stats != NULL)
+                memset(state->stats, 0, sizeof(MB_MGR_STATS));
+#endif
 
         /* set SSE NO AESNI handlers */
         state->get_next_job        = get_next_job_sse_no_aesni;
@@ -753,6 +797,11 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_sse_no_aesni;
         state->flush_job           = flush_job_sse_no_aesni;
         state->queue_size          = queue_size_sse_no_aesni;
+        state->get_next_burst      = get_next_burst_sse_no_aesni;
+        state->submit_burst        = submit_burst_sse_no_aesni;
+        state->submit_burst_nocheck = submit_burst_nocheck_sse_no_aesni;
+        state->get_completed_burst = get_completed_burst_sse_no_aesni;
+        state->flush_burst         = flush_burst_sse_no_aesni;
         state->keyexp_128          = aes_keyexp_128_sse_no_aesni;
         state->keyexp_192          = aes_keyexp_192_sse_no_aesni;
         state->keyexp_256          = aes_keyexp_256_sse_no_aesni;
@@ -798,12 +847,25 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         state->snow3g_f8_n_buffer  = snow3g_f8_n_buffer_sse_no_aesni;
         state->snow3g_f8_8_buffer_multikey =
                 snow3g_f8_8_buffer_multikey_sse_no_aesni;
+        state->snow3g_f8_16_buffer_multikey =
+                snow3g_f8_16_buffer_multikey_sse_no_aesni;
         state->snow3g_f8_n_buffer_multikey =
                 snow3g_f8_n_buffer_multikey_sse_no_aesni;
         state->snow3g_f9_1_buffer = snow3g_f9_1_buffer_sse_no_aesni;
+        state->snow3g_f9_n_buffer = snow3g_f9_n_buffer_sse_no_aesni;
+        state->snow3g_f9_n_buffer_multikey =
+                snow3g_f9_n_buffer_multikey_sse_no_aesni;
         state->snow3g_init_key_sched = snow3g_init_key_sched_sse_no_aesni;
         state->snow3g_key_sched_size = snow3g_key_sched_size_sse_no_aesni;
 
+        state->crc32_ethernet_fcs  = crc32_ethernet_fcs_sse;
+        state->crc16_ccitt         = crc16_ccitt_sse;
+        state->crc24_a             = crc24_a_sse;
+        state->crc24_b             = crc24_b_sse;
+        state->crc11               = crc11_sse;
+        state->crc6                = crc6_sse;
+        state->crc_n_buffer        = crc_n_buffer_sse;
+
         state->gcm128_enc          = aes_gcm_enc_128_sse_no_aesni;
         state->gcm192_enc          = aes_gcm_enc_192_sse_no_aesni;
         state->gcm256_enc          = aes_gcm_enc_256_sse_no_aesni;
@@ -37,7 +37,7 @@
 %define SUBMIT_JOB_AES_XCBC submit_job_aes_xcbc_sse
 %endif
 
-; void AES_XCBC_X4(AES_XCBC_ARGS_x8 *args, UINT64 len_in_bytes);
+; void AES_XCBC_X4(AES_XCBC_ARGS_x16 *args, UINT64 len_in_bytes);
 extern AES_XCBC_X4
 
 section .data
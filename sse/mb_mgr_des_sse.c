@@ -0,0 +1,44 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+#define CLEAR_SCRATCH_SIMD_REGS clear_scratch_xmms_sse
+
+#define SUBMIT_JOB_DES_CBC_ENC     submit_job_des_cbc_enc_sse
+#define FLUSH_JOB_DES_CBC_ENC      flush_job_des_cbc_enc_sse
+#define SUBMIT_JOB_DES_CBC_DEC     submit_job_des_cbc_dec_sse
+#define FLUSH_JOB_DES_CBC_DEC      flush_job_des_cbc_dec_sse
+#define SUBMIT_JOB_3DES_CBC_ENC    submit_job_3des_cbc_enc_sse
+#define FLUSH_JOB_3DES_CBC_ENC     flush_job_3des_cbc_enc_sse
+#define SUBMIT_JOB_3DES_CBC_DEC    submit_job_3des_cbc_dec_sse
+#define FLUSH_JOB_3DES_CBC_DEC     flush_job_3des_cbc_dec_sse
+#define SUBMIT_JOB_DOCSIS_DES_ENC  submit_job_docsis_des_enc_sse
+#define FLUSH_JOB_DOCSIS_DES_ENC   flush_job_docsis_des_enc_sse
+#define SUBMIT_JOB_DOCSIS_DES_DEC  submit_job_docsis_des_dec_sse
+#define FLUSH_JOB_DOCSIS_DES_DEC   flush_job_docsis_des_dec_sse
+
+#include "include/des_ooo_common.h"
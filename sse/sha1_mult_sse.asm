@@ -32,6 +32,7 @@
 
 %include "mb_mgr_datastruct.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 section .data
 default rel
@@ -432,6 +433,9 @@ lloop:
 
 	ret
 
+;; void call_sha1_mult_sse_from_c(SHA1_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha1_mult_sse_from_c, sha1_mult_sse, sse
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
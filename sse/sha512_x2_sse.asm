@@ -42,6 +42,7 @@
 %include "include/os.asm"
 %include "mb_mgr_datastruct.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 ;%define DO_DBGPRINT
 %include "include/dbgprint.asm"
@@ -445,6 +446,9 @@ Lrounds_16_xx:
 DBGPRINTL "====================== exit sha512_x2_sse code =====================\n"
 	ret
 
+;; void call_sha512_x2_sse_from_c(SHA512_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha512_x2_sse_from_c, sha512_x2_sse, sse
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
@@ -41,6 +41,7 @@
 %include "include/os.asm"
 %include "mb_mgr_datastruct.asm"
 %include "include/clear_regs.asm"
+%include "include/call_from_c.asm"
 
 ;%define DO_DBGPRINT
 %include "include/dbgprint.asm"
@@ -453,6 +454,9 @@ Lrounds_16_xx:
 	; outer calling routine restores XMM and other GP registers
 	ret
 
+;; void call_sha_256_mult_sse_from_c(SHA256_ARGS *args, UINT64 num_blocks);
+CALL_FROM_C call_sha_256_mult_sse_from_c, sha_256_mult_sse, sse
+
 %ifdef LINUX
 section .note.GNU-stack noalloc noexec nowrite progbits
 %endif
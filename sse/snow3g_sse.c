@@ -33,8 +33,11 @@
 #define SNOW3G_F8_8_BUFFER snow3g_f8_8_buffer_sse
 #define SNOW3G_F8_N_BUFFER snow3g_f8_n_buffer_sse
 #define SNOW3G_F8_8_BUFFER_MULTIKEY snow3g_f8_8_buffer_multikey_sse
+#define SNOW3G_F8_16_BUFFER_MULTIKEY snow3g_f8_16_buffer_multikey_sse
 #define SNOW3G_F8_N_BUFFER_MULTIKEY snow3g_f8_n_buffer_multikey_sse
 #define SNOW3G_F9_1_BUFFER snow3g_f9_1_buffer_sse
+#define SNOW3G_F9_N_BUFFER snow3g_f9_n_buffer_sse
+#define SNOW3G_F9_N_BUFFER_MULTIKEY snow3g_f9_n_buffer_multikey_sse
 #define SNOW3G_INIT_KEY_SCHED snow3g_init_key_sched_sse
 #define SNOW3G_KEY_SCHED_SIZE snow3g_key_sched_size_sse
 #define CLEAR_SCRATCH_SIMD_REGS clear_scratch_xmms_sse
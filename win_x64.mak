@@ -35,6 +35,8 @@
 # SAFE_PARAM=y  - this option will add extra input parameter checks
 # SAFE_LOOKUP=y - this option will perform constant-time lookups depending on
 # 		  sensitive data (default)
+# MB_STATS=y    - this option will collect multi-buffer manager
+# 		  performance counters (see imb_get_mb_mgr_stats())
 
 !if !defined(SHARED)
 SHARED = y
@@ -88,6 +90,10 @@ DCFLAGS = $(DCFLAGS) /DSAFE_LOOKUP
 DAFLAGS = $(DAFLAGS) -DSAFE_LOOKUP
 !endif
 
+!if "$(MB_STATS)" == "y"
+DCFLAGS = $(DCFLAGS) /DMB_STATS
+!endif
+
 CC = cl
 CFLAGS_ALL = $(EXTRA_CFLAGS) /I. /Iinclude /Ino-aesni \
 	/nologo /Y- /W3 /WX- /Gm- /fp:precise /EHsc
@@ -225,8 +231,42 @@ lib_objs1 = \
 	$(OBJ_DIR)\snow3g_sse_no_aesni.obj \
 	$(OBJ_DIR)\snow3g_avx.obj \
 	$(OBJ_DIR)\snow3g_avx2.obj \
+	$(OBJ_DIR)\snow3g_avx512.obj \
 	$(OBJ_DIR)\snow3g_tables.obj \
         $(OBJ_DIR)\snow3g_iv.obj \
+	$(OBJ_DIR)\crc_sse.obj \
+	$(OBJ_DIR)\crc_avx.obj \
+	$(OBJ_DIR)\crc_avx512.obj \
+	$(OBJ_DIR)\crc_tables.obj \
+	$(OBJ_DIR)\mb_mgr_aes_cntr_sse.obj \
+	$(OBJ_DIR)\mb_mgr_aes_cntr_avx.obj \
+	$(OBJ_DIR)\mb_mgr_aes_gcm_sse.obj \
+	$(OBJ_DIR)\mb_mgr_aes_gcm_avx.obj \
+	$(OBJ_DIR)\mb_mgr_aes_avx2.obj \
+	$(OBJ_DIR)\aes_docsis_crc32_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_aes_xcbc_vaes_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_pon_vaes_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uea2_sse.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uea2_avx.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uea2_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_kasumi_sse.obj \
+	$(OBJ_DIR)\mb_mgr_kasumi_avx.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uia2_sse.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uia2_avx.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uia2_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uea2_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_snow3g_uia2_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_kasumi_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_kasumi_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_md5_avx512.obj \
+	$(OBJ_DIR)\aes_ecb_vaes_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_sha_sse.obj \
+	$(OBJ_DIR)\mb_mgr_sha_avx.obj \
+	$(OBJ_DIR)\mb_mgr_sha_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_sha_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_des_sse.obj \
+	$(OBJ_DIR)\mb_mgr_des_avx.obj \
+	$(OBJ_DIR)\mb_mgr_des_avx2.obj \
 	$(OBJ_DIR)\aes_xcbc_expand_key.obj \
 	$(OBJ_DIR)\md5_one_block.obj \
 	$(OBJ_DIR)\sha_one_block.obj \
@@ -475,6 +515,10 @@ help:
 	@echo "          - Lookups depending on sensitive data might not be constant time"
 	@echo "SAFE_LOOKUP=y (default)"
 	@echo "          - Lookups depending on sensitive data are constant time"
+	@echo "MB_STATS=n (default)"
+	@echo "          - Multi-buffer manager performance counters not collected"
+	@echo "MB_STATS=y"
+	@echo "          - Multi-buffer manager performance counters collected"
 
 clean:
 	-del /q $(lib_objs1)